@@ -0,0 +1,59 @@
+#ifndef REBOURS_MAL_RECOGNISER_DETAIL_DECODER_X86_64_LINUX_HPP_INCLUDED
+#   define REBOURS_MAL_RECOGNISER_DETAIL_DECODER_X86_64_LINUX_HPP_INCLUDED
+
+#   include <rebours/MAL/recogniser/recognise.hpp>
+#   include <capstone/capstone.h>
+#   include <capstone/x86.h>
+#   include <vector>
+#   include <cstdint>
+
+namespace mal { namespace recogniser { namespace detail { namespace x86_64_Linux {
+
+
+/**
+ * It owns a Capstone handle (opened in the 64-bit x86 mode with details turned on) and
+ * a preallocated instruction record. There is exactly one decoder per thread, so neither
+ * the handle nor the record is ever shared between threads. Both live until the thread ends.
+ */
+struct  decoder
+{
+    static uint8_t const  max_instruction_size = 15U;
+
+    static decoder&  of_this_thread();
+
+    ~decoder();
+
+    bool  is_open() const noexcept { return m_is_open; }
+    csh  handle() const noexcept { return m_handle; }
+
+    /**
+     * Decodes the first instruction in the passed bytes. It returns nullptr, if the bytes
+     * do not start with a complete valid instruction. Otherwise, the returned record stays
+     * valid only till the next call to 'decode' on this decoder.
+     */
+    cs_insn const*  decode(uint8_t const*  begin, uint64_t const  num_bytes, uint64_t const  address = 0ULL);
+
+private:
+    decoder();
+
+    decoder(decoder const&) = delete;
+    decoder&  operator=(decoder const&) = delete;
+
+    csh  m_handle;
+    bool  m_is_open;
+    cs_insn*  m_instruction;
+};
+
+
+/**
+ * Reads bytes at addresses from 'address' up to 'address + decoder::max_instruction_size' (excluded)
+ * into 'window' (its original content is discarded), all with the passed access 'rights'.
+ * The reading stops at the first byte for which 'mem_fn' returns a negative value. That value is then
+ * returned from the function. Otherwise the function returns 0.
+ */
+int16_t  fetch_instruction_window(mem_fn_type const&  mem_fn, uint64_t const  address, uint8_t const  rights, std::vector<uint8_t>&  window);
+
+
+}}}}
+
+#endif
@@ -32,6 +32,8 @@ struct recognition_data
     uint64_t  error_address() const noexcept { return m_error_address; }
     uint8_t  error_rights() const noexcept { return m_error_rights; }
     std::vector<uint8_t> const&  buffer() const noexcept { return m_buffer; }
+    std::vector<recognised_instruction> const&  instructions() const noexcept { return m_instructions; }
+    bool  ends_basic_block() const noexcept { return m_ends_basic_block; }
 
     void  set_asm_text(std::string const&  value) { m_asm_text = value; }
     void  set_asm_bytes(std::string const&  value) { m_asm_bytes = value; }
@@ -39,6 +41,8 @@ struct recognition_data
     void  set_error_address(uint64_t const  value) noexcept { m_error_address = value; }
     void  set_error_rights(uint8_t const  value) noexcept;
     std::vector<uint8_t>&  buffer() { return m_buffer; }
+    std::vector<recognised_instruction>&  instructions() { return m_instructions; }
+    void  set_ends_basic_block(bool const  value) noexcept { m_ends_basic_block = value; }
 
 private:
     uint64_t  m_start_address;
@@ -55,6 +59,8 @@ private:
     uint64_t  m_error_address;
     uint8_t  m_error_rights;
     std::vector<uint8_t>  m_buffer;
+    std::vector<recognised_instruction>  m_instructions;
+    bool  m_ends_basic_block;
 };
 
 
@@ -12,8 +12,7 @@ namespace mal { namespace recogniser { namespace detail { namespace x86_64_Linux
 
 struct  recognition_engine
 {
-    recognition_engine(csh const  handle, cs_insn*  instruction);
-    ~recognition_engine();
+    recognition_engine(csh const  handle, cs_insn const*  instruction);
 
     csh  handle() const noexcept { return m_handle; }
     cs_insn const&  instruction() const noexcept { return *m_instruction; }
@@ -57,8 +56,8 @@ struct  recognition_engine
 
 private:
     csh  m_handle;
-    cs_insn* m_instruction;
-    cs_x86* m_details;
+    cs_insn const*  m_instruction;
+    cs_x86 const*  m_details;
 };
 
 
@@ -3,6 +3,8 @@
 
 #   include <rebours/program/program.hpp>
 #   include <functional>
+#   include <string>
+#   include <vector>
 #   include <memory>
 #   include <cstdint>
 
@@ -22,6 +24,18 @@ std::shared_ptr<recognition_data const>  get_implementation_details(recognition_
 namespace mal { namespace recogniser {
 
 
+/**
+ * Describes one native instruction inside a recognised Microcode program.
+ */
+struct recognised_instruction
+{
+    microcode::program_component::node_id  node;    //!< A node in the start component, where the Microcode of the instruction begins.
+    uint64_t  address;                              //!< The address of the instruction (i.e. the value of IP, when the 'node' is reached).
+    std::string  asm_text;                          //!< A text of the body of an annotation 'ASM.TEXT' of the 'node'.
+    std::string  asm_bytes;                         //!< A text of the body of an annotation 'ASM.BYTES' of the 'node'.
+};
+
+
 struct recognition_result
 {
     explicit recognition_result(std::shared_ptr<detail::recognition_data> const  data);
@@ -77,6 +91,22 @@ struct recognition_result
      */
     std::vector<uint8_t> const&  buffer() const noexcept;
 
+    /**
+     * Native instructions represented by the recognised program, in the order of their execution.
+     * The first instruction always begins at the entry node of the start component. A result of the
+     * function 'recognise' holds exactly one instruction, while a result of 'recognise_basic_block'
+     * may hold more.
+     * The return value matters only if 'program()' returns a valid pointer.
+     */
+    std::vector<recognised_instruction> const&  instructions() const noexcept;
+
+    /**
+     * Returns true, if the last recognised instruction may transfer the control elsewhere than to
+     * the following instruction (e.g. jumps, calls, returns, and system calls).
+     * The return value matters only if 'program()' returns a valid pointer.
+     */
+    bool  ends_basic_block() const noexcept;
+
 
 private:
     std::shared_ptr<detail::recognition_data>  m_data;
@@ -92,6 +122,25 @@ using  recognise_callback_fn = std::function<recognition_result(uint64_t, reg_fn
 recognition_result  recognise(descriptor::storage const&  description, uint64_t const  start_address, reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn);
 
 
+/**
+ * It recognises a straight-line sequence of instructions starting at 'start_address' (i.e. a basic block)
+ * and returns it as a single Microcode program. The sequence ends by the first instruction which ends a basic block
+ * (see 'recognition_result::ends_basic_block'), or after 'max_num_instructions' instructions, or before the first
+ * instruction which cannot be recognised. Instructions are recognised one by one via 'recognise_instruction'.
+ *
+ * Only the first instruction in the block is given the 'reg' function, because values in REG may change while
+ * the preceding instructions are executed. Each following instruction receives a 'reg' function returning -1, and so
+ * an instruction depending on REG values (e.g. a system call) always starts a new block.
+ *
+ * If the first instruction cannot be recognised, then the result is the same as for the call to 'recognise_instruction'.
+ */
+recognition_result  recognise_basic_block(recognise_callback_fn const&  recognise_instruction,
+                                          uint64_t const  start_address,
+                                          reg_fn_type const&  reg_fn,
+                                          mem_fn_type const&  mem_fn,
+                                          uint64_t const  max_num_instructions = 64ULL);
+
+
 using  recognition_result_dump_fn = std::function<bool(recognition_result const&,   //!< Results containing info about instruction to be dumped
                                                        std::string const&           //!< Pathname of the output file the instruction will be dumped into.
                                                        )>;
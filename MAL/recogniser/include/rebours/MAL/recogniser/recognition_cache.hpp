@@ -0,0 +1,92 @@
+#ifndef REBOURS_MAL_RECOGNISER_RECOGNITION_CACHE_HPP_INCLUDED
+#   define REBOURS_MAL_RECOGNISER_RECOGNITION_CACHE_HPP_INCLUDED
+
+#   include <rebours/MAL/recogniser/recognise.hpp>
+#   include <unordered_map>
+#   include <vector>
+#   include <memory>
+#   include <mutex>
+#   include <cstdint>
+
+namespace mal { namespace recogniser {
+
+
+/**
+ * It keeps successful recognition results so that the same instruction is not decoded
+ * and translated into Microcode again and again whenever it is reached in later executions.
+ *
+ * A cached result is identified by its start address together with all values the recogniser
+ * has read through the valuation functions during the recognition, i.e. bytes of the instruction
+ * (via 'mem') and bytes of registers the translation depends on (via 'reg'; e.g. the number of
+ * a system call). A cached result is used only if all those values are still the same.
+ * If the instruction bytes differ (i.e. the code was modified), the cached result is discarded.
+ *
+ * Each returned result holds a fresh copy of the cached Microcode program (with fresh node IDs),
+ * so that it can be merged into the recovered program any number of times.
+ *
+ * The cache can be shared by several threads.
+ */
+struct recognition_cache
+{
+    recognition_cache();
+
+    /**
+     * It has the same semantics as the function 'mal::recogniser::recognise', but it first
+     * tries to find a matching result in the cache. A successful recognition is stored
+     * in the cache; failed ones are never cached.
+     */
+    recognition_result  recognise(descriptor::storage const&  description, uint64_t const  start_address,
+                                  reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn);
+
+    /**
+     * The same as above, but instructions missing in the cache are recognised by 'recognise_instruction'.
+     * The function must always recognise the same instruction from the same values of the valuation functions.
+     */
+    recognition_result  recognise(recognise_callback_fn const&  recognise_instruction, uint64_t const  start_address,
+                                  reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn);
+
+    /**
+     * Discards all cached results whose instruction bytes intersect the range [begin,end).
+     * It allows a client to invalidate the cache eagerly, once it learns about a write into code.
+     */
+    void  invalidate(uint64_t const  begin, uint64_t const  end);
+
+    void  clear();
+
+    uint64_t  size() const;
+    uint64_t  num_hits() const;
+    uint64_t  num_misses() const;
+    uint64_t  num_invalidations() const;
+
+private:
+
+    struct  read_value
+    {
+        uint64_t  address;
+        uint8_t  rights;    //!< Passed to the 'mem' function; it is always 0 for the 'reg' function.
+        uint8_t  value;
+    };
+
+    using  read_values = std::vector<read_value>;
+
+    struct  cache_entry
+    {
+        read_values  mem_values;
+        read_values  reg_values;
+        std::shared_ptr<detail::recognition_data const>  data;
+    };
+
+    std::unordered_map<uint64_t,std::vector<cache_entry> >  m_entries;   //!< Keyed by the start address of the instruction.
+    uint64_t  m_num_hits;
+    uint64_t  m_num_misses;
+    uint64_t  m_num_invalidations;
+    mutable std::mutex  m_mutex;
+};
+
+
+using  recognition_cache_ptr = std::shared_ptr<recognition_cache>;
+
+
+}}
+
+#endif
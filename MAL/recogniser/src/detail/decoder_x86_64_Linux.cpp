@@ -0,0 +1,69 @@
+#include <rebours/MAL/recogniser/detail/decoder_x86_64_Linux.hpp>
+#include <rebours/MAL/recogniser/assumptions.hpp>
+#include <rebours/MAL/recogniser/invariants.hpp>
+
+namespace mal { namespace recogniser { namespace detail { namespace x86_64_Linux {
+
+
+uint8_t const  decoder::max_instruction_size;
+
+
+decoder&  decoder::of_this_thread()
+{
+    static thread_local decoder  dec;
+    return dec;
+}
+
+decoder::decoder()
+    : m_handle(0)
+    , m_is_open(false)
+    , m_instruction(nullptr)
+{
+    if (cs_open(CS_ARCH_X86, CS_MODE_64, &m_handle) != CS_ERR_OK)
+        return;
+    cs_option(m_handle, CS_OPT_DETAIL, CS_OPT_ON);
+    m_instruction = cs_malloc(m_handle);
+    if (m_instruction == nullptr)
+    {
+        cs_close(&m_handle);
+        return;
+    }
+    m_is_open = true;
+}
+
+decoder::~decoder()
+{
+    if (is_open())
+    {
+        cs_free(m_instruction, 1ULL);
+        cs_close(&m_handle);
+    }
+}
+
+cs_insn const*  decoder::decode(uint8_t const*  begin, uint64_t const  num_bytes, uint64_t const  address)
+{
+    ASSUMPTION(is_open());
+    uint8_t const*  code = begin;
+    size_t  size = num_bytes;
+    uint64_t  adr = address;
+    return cs_disasm_iter(m_handle,&code,&size,&adr,m_instruction) ? m_instruction : nullptr;
+}
+
+
+int16_t  fetch_instruction_window(mem_fn_type const&  mem_fn, uint64_t const  address, uint8_t const  rights, std::vector<uint8_t>&  window)
+{
+    window.clear();
+    window.reserve(decoder::max_instruction_size);
+    for (uint64_t  i = 0ULL; i < decoder::max_instruction_size; ++i)
+    {
+        int16_t const  res_val = mem_fn(address + i,rights);
+        ASSUMPTION(res_val >= -3 && res_val < 256);
+        if (res_val < 0)
+            return res_val;
+        window.push_back((uint8_t)res_val);
+    }
+    return 0;
+}
+
+
+}}}}
@@ -1,4 +1,5 @@
 #include <rebours/MAL/recogniser/detail/recognise_x86_64_Linux.hpp>
+#include <rebours/MAL/recogniser/detail/decoder_x86_64_Linux.hpp>
 #include <rebours/MAL/recogniser/assumptions.hpp>
 #include <rebours/MAL/recogniser/invariants.hpp>
 #include <rebours/MAL/recogniser/msgstream.hpp>
@@ -49,36 +50,32 @@ bool  recognition_data::dump(std::string const&  dump_file_pathname) const
     ostr << "</head>\n";
     ostr << "<body>\n";
 
-    csh handle;
-    if (cs_open(CS_ARCH_X86, CS_MODE_64, &handle) != CS_ERR_OK)
+    decoder&  dec = decoder::of_this_thread();
+    if (!dec.is_open())
     {
         ostr << "<p>"
                 "ERROR: cannot open the capstone-next library ('cs_open' has FAILED)."
                 "</p>\n</body>\n</html>\n";
-        return ostr;
+        return false;
     }
+    csh const  handle = dec.handle();
 
-    cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
-
-    cs_insn*  insn;
-    size_t const  count = cs_disasm(handle,buffer().data(),buffer().size(),0ULL,1ULL,&insn);
-    if (count != 1ULL)
+    cs_insn const* const  instr = dec.decode(buffer().data(),buffer().size());
+    if (instr == nullptr)
     {
         ostr << "<p>"
                 "ERROR: Cannot diassemly the instruction ('cs_disasm' has FAILED)."
                 "</p>\n</body>\n</html>\n";
-        return ostr;
+        return false;
     }
 
-    cs_insn const* instr = &(insn[0ULL]);
-
     cs_detail *detail = instr->detail;
     if (detail == nullptr)
     {
         ostr << "<p>"
                 "ERROR: Cannot access details of the disassembled instruction."
                 "</p>\n</body>\n</html>\n";
-        return ostr;
+        return false;
     }
 
     cs_x86 const* const  x86 = &(detail->x86);
@@ -545,9 +542,6 @@ bool  recognition_data::dump(std::string const&  dump_file_pathname) const
         ostr << "</table>";
     }
 
-    cs_free(insn, count);
-    cs_close(&handle);
-
     ostr << "</body>\n";
     ostr << "</html>\n";
 
@@ -1,4 +1,5 @@
 #include <rebours/MAL/recogniser/detail/recognise_x86_64_Linux.hpp>
+#include <rebours/MAL/recogniser/detail/decoder_x86_64_Linux.hpp>
 #include <rebours/MAL/recogniser/detail/recognise_x86_64_Linux_syscall_utils.hpp>
 #include <rebours/MAL/recogniser/detail/recognise_x86_64_Linux_syscall_syscall.hpp>
 #include <rebours/MAL/recogniser/detail/register_info.hpp>
@@ -23,55 +24,33 @@ recognition_data::recognition_data(uint64_t const  start_address, reg_fn_type co
 
 void  recognition_data::recognise(descriptor::storage const&  description)
 {
-    csh handle;
+    decoder&  dec = decoder::of_this_thread();
+    ASSUMPTION(dec.is_open());
 
-    cs_err const open_error = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
-    ASSUMPTION(open_error == CS_ERR_OK);
-    cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
-
-    uint64_t  address = start_address();
     uint8_t const  rights = 2U; //!< Executable
 
-    cs_insn*  insn = nullptr;
-    for (int i = 0; i < 64; ++i, ++address)
+    int16_t const  res_val = fetch_instruction_window(mem_fn(),start_address(),rights,buffer());
+    cs_insn const* const  instr = dec.decode(buffer().data(),buffer().size());
+    if (instr == nullptr)
     {
-        int16_t const  res_val = mem_fn()(address,rights);
-        ASSUMPTION(res_val >= -3 && res_val < 256);
         if (res_val < 0)
         {
-            cs_close(&handle);
-
+            // The instruction is not complete in the bytes we could read.
             set_error_result(1U << (-res_val));
             INVARIANT(error_result() == 2U || error_result() == 4U || error_result() == 8U);
-            set_error_address(address);
+            set_error_address(start_address() + buffer().size());
             set_error_rights(rights);
             return;
         }
-        buffer().push_back(res_val);
-        cs_insn*  ptr = nullptr;
-        size_t const  count = cs_disasm(handle,buffer().data(),buffer().size(),0ULL,1ULL,&ptr);
-        INVARIANT(count < 2ULL);
-        if (count == 1ULL)
-        {
-            ASSUMPTION(ptr != nullptr);
-            insn = ptr;
-            break;
-        }
-    }
-
-    if (insn == nullptr)
-    {
-        set_error_result(16U);
+        set_error_result(254U);
         set_error_address(start_address());
         return;
     }
-
-    cs_insn* const  instr = &(insn[0ULL]);
+    INVARIANT(instr->size <= buffer().size());
+    buffer().resize(instr->size);
 
     if (instr->detail == nullptr)
     {
-        cs_free(insn, 1ULL);
-        cs_close(&handle);
         set_error_result(254U);
         return;
     }
@@ -85,7 +64,7 @@ void  recognition_data::recognise(descriptor::storage const&  description)
         set_asm_bytes(mstr.str());
     }
 
-    recognition_engine const  re(handle,instr);
+    recognition_engine const  re(dec.handle(),instr);
     bool  success;
 
     switch (re.instruction_id())
@@ -254,6 +233,34 @@ void  recognition_data::recognise(descriptor::storage const&  description)
     {
         set_error_result(255U);
         set_error_address(start_address());
+        return;
+    }
+    if (error_result() != 0U)
+        return;
+
+    instructions().push_back({ component().entry(), start_address(), asm_text(), asm_bytes() });
+
+    switch (re.instruction_id())
+    {
+    case X86_INS_JMP:
+    case X86_INS_JNE:
+    case X86_INS_JE:
+    case X86_INS_JS:
+    case X86_INS_JNS:
+    case X86_INS_JA:
+    case X86_INS_JAE:
+    case X86_INS_JG:
+    case X86_INS_JLE:
+    case X86_INS_JB:
+    case X86_INS_JBE:
+    case X86_INS_CALL:
+    case X86_INS_RET:
+    case X86_INS_INT:
+    case X86_INS_SYSCALL:
+        set_ends_basic_block(true);
+        break;
+    default:
+        break;
     }
 }
 
@@ -21,6 +21,8 @@ recognition_data::recognition_data(uint64_t const  start_address, reg_fn_type co
     , m_error_address(0ULL)
     , m_error_rights(0U)
     , m_buffer()
+    , m_instructions()
+    , m_ends_basic_block(false)
 {}
 
 void  recognition_data::set_error_result(uint8_t const  value) noexcept
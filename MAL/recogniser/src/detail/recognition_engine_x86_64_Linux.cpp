@@ -24,18 +24,12 @@ register_info  get_register_info(std::string const&  register_name, descriptor::
 namespace mal { namespace recogniser { namespace detail { namespace x86_64_Linux {
 
 
-recognition_engine::recognition_engine(csh const handle, cs_insn* instruction)
+recognition_engine::recognition_engine(csh const handle, cs_insn const* instruction)
     : m_handle(handle)
     , m_instruction(instruction)
     , m_details(&instruction->detail->x86)
 {}
 
-recognition_engine::~recognition_engine()
-{
-    cs_free(m_instruction, 1ULL);
-    cs_close(&m_handle);
-}
-
 uint8_t  recognition_engine::get_byte_of_instruction(uint8_t const  idx) const
 {
     ASSUMPTION(idx < num_bytes_of_instruction());
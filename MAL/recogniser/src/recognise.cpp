@@ -4,6 +4,8 @@
 #include <rebours/MAL/recogniser/invariants.hpp>
 #include <rebours/MAL/recogniser/detail/recognition_data.hpp>
 #include <rebours/MAL/descriptor/storage.hpp>
+#include <fstream>
+#include <iterator>
 
 namespace mal { namespace recogniser { namespace detail {
 
@@ -16,6 +18,98 @@ recognition_data_ptr  recognise(descriptor::storage const&  description, uint64_
 }
 
 
+namespace {
+
+
+struct  basic_block_recognition_data : public recognition_data
+{
+    basic_block_recognition_data(recognition_result const&  first, reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn);
+
+    void  recognise(descriptor::storage const&) { UNREACHABLE(); }
+    bool  dump(std::string const&  dump_file_pathname) const;
+
+    bool  can_append() const { return !ends_basic_block() && program()->start_component().exits().size() == 1ULL; }
+    void  append(recognition_result const&  next);
+
+private:
+    std::shared_ptr<recognition_data const>  m_first;
+};
+
+
+basic_block_recognition_data::basic_block_recognition_data(recognition_result const&  first, reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn)
+    : recognition_data(first.instructions().front().address,reg_fn,mem_fn)
+    , m_first(get_implementation_details(first))
+{
+    set_asm_text(first.asm_text());
+    set_asm_bytes(first.asm_bytes());
+    buffer() = first.buffer();
+    append(first);
+}
+
+/**
+ * The details are dumped only for the first instruction of the block. The remaining instructions are listed
+ * in a table appended to the body of the dumped file.
+ */
+bool  basic_block_recognition_data::dump(std::string const&  dump_file_pathname) const
+{
+    if (!m_first->dump(dump_file_pathname))
+        return false;
+    if (instructions().size() == 1ULL)
+        return true;
+
+    std::string  html;
+    {
+        std::ifstream  istr{dump_file_pathname,std::ifstream::binary};
+        html.assign(std::istreambuf_iterator<char>(istr),std::istreambuf_iterator<char>());
+    }
+    std::string::size_type const  body_end = html.rfind("</body>");
+    if (body_end == std::string::npos)
+        return false;
+
+    msgstream  table;
+    table << "<table>\n"
+             "  <caption>All instructions of the recognised basic block.</caption>\n"
+             "  <tr>\n"
+             "    <th>Address</th>\n"
+             "    <th>Instruction</th>\n"
+             "    <th>Bytes</th>\n"
+             "  </tr>\n";
+    for (recognised_instruction const&  info : instructions())
+        table << "  <tr>\n"
+                 "    <td>" << std::hex << info.address << "</td>\n"
+                 "    <td>" << info.asm_text << "</td>\n"
+                 "    <td>" << info.asm_bytes << "</td>\n"
+                 "  </tr>\n";
+    table << "</table>\n";
+    html.insert(body_end,table.str());
+
+    std::ofstream  ostr{dump_file_pathname,std::ofstream::binary};
+    ostr << html;
+    return ostr.good();
+}
+
+void  basic_block_recognition_data::append(recognition_result const&  next)
+{
+    ASSUMPTION(next.program().operator bool() && !next.instructions().empty());
+
+    microcode::program_component&  C = program()->start_component();
+    ASSUMPTION(C.exits().size() == 1ULL);
+    microcode::program_component::node_id const  exit = *C.exits().cbegin();
+    microcode::program_component const&  other = next.program()->start_component();
+
+    C.append_by_merging_exit_and_entry(other,exit);
+    for (recognised_instruction const&  info : next.instructions())
+        instructions().push_back({ info.node == other.entry() ? exit : info.node, info.address, info.asm_text, info.asm_bytes });
+    for (uint64_t i = 1ULL; i < next.program()->num_components(); ++i)
+        program()->push_back(next.program()->share_component(i));
+
+    set_ends_basic_block(next.ends_basic_block());
+}
+
+
+}
+
+
 }}}
 
 namespace mal { namespace recogniser {
@@ -61,6 +155,16 @@ std::vector<uint8_t> const&  recognition_result::buffer() const noexcept
     return m_data->buffer();
 }
 
+std::vector<recognised_instruction> const&  recognition_result::instructions() const noexcept
+{
+    return m_data->instructions();
+}
+
+bool  recognition_result::ends_basic_block() const noexcept
+{
+    return m_data->ends_basic_block();
+}
+
 
 recognition_result  recognise(descriptor::storage const&  description,
                               uint64_t const  start_address,
@@ -76,4 +180,36 @@ recognition_result  recognise(descriptor::storage const&  description,
 }
 
 
+recognition_result  recognise_basic_block(recognise_callback_fn const&  recognise_instruction,
+                                          uint64_t const  start_address,
+                                          reg_fn_type const&  reg_fn,
+                                          mem_fn_type const&  mem_fn,
+                                          uint64_t const  max_num_instructions)
+{
+    ASSUMPTION(max_num_instructions > 0ULL);
+
+    recognition_result const  first = recognise_instruction(start_address,reg_fn,mem_fn);
+    if (!first.program().operator bool() || first.ends_basic_block() || first.program()->start_component().exits().size() != 1ULL)
+        return first;
+    ASSUMPTION(first.instructions().size() == 1ULL && first.instructions().front().address == start_address);
+
+    std::shared_ptr<detail::basic_block_recognition_data> const  block =
+            std::make_shared<detail::basic_block_recognition_data>(first,reg_fn,mem_fn);
+
+    reg_fn_type const  unknown_reg_fn = [](uint64_t) -> int16_t { return -1; };
+    uint64_t  address = start_address + first.buffer().size();
+    for (uint64_t  i = 1ULL; i < max_num_instructions && block->can_append(); ++i)
+    {
+        recognition_result const  next = recognise_instruction(address,unknown_reg_fn,mem_fn);
+        if (!next.program().operator bool())
+            break;
+        ASSUMPTION(next.instructions().size() == 1ULL && next.instructions().front().address == address);
+        block->append(next);
+        address += next.buffer().size();
+    }
+
+    return recognition_result(block);
+}
+
+
 }}
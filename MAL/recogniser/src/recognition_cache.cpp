@@ -0,0 +1,257 @@
+#include <rebours/MAL/recogniser/recognition_cache.hpp>
+#include <rebours/MAL/recogniser/detail/recognition_data.hpp>
+#include <rebours/MAL/recogniser/assumptions.hpp>
+#include <rebours/MAL/recogniser/invariants.hpp>
+#include <unordered_map>
+#include <algorithm>
+
+namespace mal { namespace recogniser { namespace detail { namespace {
+
+
+using  node_id = microcode::program_component::node_id;
+using  edge_id = microcode::program_component::edge_id;
+
+
+std::unordered_map<node_id,node_id>  copy_component_with_fresh_nodes(microcode::program_component const&  src, microcode::program_component&  dst)
+{
+    ASSUMPTION(dst.nodes().size() == 1ULL && dst.edges().empty());
+
+    std::unordered_map<node_id,node_id>  renaming{ { src.entry(), dst.entry() } };
+    std::vector<node_id>  new_nodes;
+    for (node_id const  u : src.nodes())
+        if (u != src.entry())
+        {
+            node_id const  v = microcode::generate_next_fresh_node_id();
+            renaming.insert({u,v});
+            new_nodes.push_back(v);
+        }
+    if (!new_nodes.empty())
+        dst.insert_nodes(new_nodes);
+
+    // We preserve the order of successors, since the interpreter distinguishes branches by it.
+    std::vector< std::pair<edge_id,microcode::instruction> >  new_edges;
+    for (node_id const  u : src.nodes())
+        for (node_id const  v : src.successors(u))
+            new_edges.push_back({ {renaming.at(u),renaming.at(v)}, src.instruction({u,v}) });
+    if (!new_edges.empty())
+        dst.insert_edges(new_edges);
+
+    dst.name() = src.name();
+
+    return renaming;
+}
+
+
+struct  cached_recognition_data : public recognition_data
+{
+    cached_recognition_data(std::shared_ptr<recognition_data const> const  origin, reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn);
+
+    void  recognise(descriptor::storage const&) { UNREACHABLE(); }
+    bool  dump(std::string const&  dump_file_pathname) const { return m_origin->dump(dump_file_pathname); }
+
+private:
+    std::shared_ptr<recognition_data const>  m_origin;
+};
+
+
+cached_recognition_data::cached_recognition_data(std::shared_ptr<recognition_data const> const  origin, reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn)
+    : recognition_data(origin->start_address(),reg_fn,mem_fn)
+    , m_origin(origin)
+{
+    ASSUMPTION(m_origin->error_result() == 0U);
+
+    microcode::program const&  src = *m_origin->program();
+    microcode::program&  dst = *program();
+    dst.name() = src.name();
+    std::unordered_map<node_id,node_id> const  renaming = copy_component_with_fresh_nodes(src.start_component(),dst.start_component());
+    for (recognised_instruction const&  info : m_origin->instructions())
+        instructions().push_back({ renaming.at(info.node), info.address, info.asm_text, info.asm_bytes });
+    set_ends_basic_block(m_origin->ends_basic_block());
+    for (uint64_t  i = 1ULL; i < src.num_components(); ++i)
+    {
+        dst.push_back(std::make_shared<microcode::program_component>());
+        copy_component_with_fresh_nodes(src.component(i),dst.component(i));
+    }
+
+    set_asm_text(m_origin->asm_text());
+    set_asm_bytes(m_origin->asm_bytes());
+    buffer() = m_origin->buffer();
+}
+
+
+}}}}
+
+namespace mal { namespace recogniser {
+
+
+recognition_cache::recognition_cache()
+    : m_entries()
+    , m_num_hits(0ULL)
+    , m_num_misses(0ULL)
+    , m_num_invalidations(0ULL)
+    , m_mutex()
+{}
+
+recognition_result  recognition_cache::recognise(descriptor::storage const&  description, uint64_t const  start_address,
+                                                 reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn)
+{
+    return recognise([&description](uint64_t const  adr, reg_fn_type const&  reg, mem_fn_type const&  mem) {
+                         return mal::recogniser::recognise(description,adr,reg,mem);
+                     },
+                     start_address,reg_fn,mem_fn);
+}
+
+recognition_result  recognition_cache::recognise(recognise_callback_fn const&  recognise_instruction, uint64_t const  start_address,
+                                                 reg_fn_type const&  reg_fn, mem_fn_type const&  mem_fn)
+{
+    auto const  values_match =
+            [&reg_fn,&mem_fn](read_values const&  values, bool const  is_mem, bool&  is_modified) -> bool {
+                for (read_value const&  rv : values)
+                {
+                    int16_t const  value = is_mem ? mem_fn(rv.address,rv.rights) : reg_fn(rv.address);
+                    if (value < 0)
+                        return false;
+                    if (value != rv.value)
+                    {
+                        is_modified = true;
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+    {
+        std::lock_guard<std::mutex> const  lock(m_mutex);
+
+        auto const  it = m_entries.find(start_address);
+        if (it != m_entries.end())
+        {
+            std::vector<cache_entry>&  entries = it->second;
+            for (uint64_t  i = 0ULL; i < entries.size(); )
+            {
+                bool  is_code_modified = false;
+                if (!values_match(entries.at(i).mem_values,true,is_code_modified))
+                {
+                    if (is_code_modified)
+                    {
+                        // The instruction bytes have changed (self-modifying code), so the entry is stale.
+                        entries.erase(entries.begin() + i);
+                        ++m_num_invalidations;
+                    }
+                    else
+                        ++i;
+                    continue;
+                }
+                bool  is_reg_modified = false;
+                if (values_match(entries.at(i).reg_values,false,is_reg_modified))
+                {
+                    ++m_num_hits;
+                    return recognition_result(std::make_shared<detail::cached_recognition_data>(entries.at(i).data,reg_fn,mem_fn));
+                }
+                ++i;
+            }
+            if (entries.empty())
+                m_entries.erase(it);
+        }
+        ++m_num_misses;
+    }
+
+    cache_entry  entry;
+    recognition_result const  result =
+            recognise_instruction(
+                    start_address,
+                    [&entry,&reg_fn](uint64_t const  adr) -> int16_t {
+                        int16_t const  value = reg_fn(adr);
+                        if (value >= 0)
+                            entry.reg_values.push_back({adr,0U,(uint8_t)value});
+                        return value;
+                    },
+                    [&entry,&mem_fn](uint64_t const  adr, uint8_t const  rights) -> int16_t {
+                        int16_t const  value = mem_fn(adr,rights);
+                        if (value >= 0)
+                            entry.mem_values.push_back({adr,rights,(uint8_t)value});
+                        return value;
+                    }
+                    );
+    if (!result.program().operator bool())
+        return result;
+
+    // The recogniser may read a few bytes past the end of the instruction. Those bytes
+    // do not affect the result, so we do not want the entry to depend on them.
+    uint64_t const  end_of_instruction = start_address + result.buffer().size();
+    entry.mem_values.erase(std::remove_if(entry.mem_values.begin(),entry.mem_values.end(),
+                                          [start_address,end_of_instruction](read_value const&  rv) -> bool {
+                                              return rv.rights == 2U && (rv.address < start_address || rv.address >= end_of_instruction);
+                                          }),
+                           entry.mem_values.end());
+
+    entry.data = detail::get_implementation_details(result);
+    std::shared_ptr<detail::recognition_data const> const  data = entry.data;
+    {
+        std::lock_guard<std::mutex> const  lock(m_mutex);
+        m_entries[start_address].push_back(entry);
+    }
+
+    // The cached program must never leave the cache, because the caller is free to modify
+    // (or merge) the returned program. So, even the first result is a copy.
+    return recognition_result(std::make_shared<detail::cached_recognition_data>(data,reg_fn,mem_fn));
+}
+
+void  recognition_cache::invalidate(uint64_t const  begin, uint64_t const  end)
+{
+    ASSUMPTION(begin <= end);
+    std::lock_guard<std::mutex> const  lock(m_mutex);
+    for (auto  it = m_entries.begin(); it != m_entries.end(); )
+    {
+        std::vector<cache_entry>&  entries = it->second;
+        auto const  new_end = std::remove_if(entries.begin(),entries.end(),
+                                             [begin,end](cache_entry const&  entry) -> bool {
+                                                 for (read_value const&  rv : entry.mem_values)
+                                                     if (rv.address >= begin && rv.address < end)
+                                                         return true;
+                                                 return false;
+                                             });
+        m_num_invalidations += entries.end() - new_end;
+        entries.erase(new_end,entries.end());
+        if (entries.empty())
+            it = m_entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+void  recognition_cache::clear()
+{
+    std::lock_guard<std::mutex> const  lock(m_mutex);
+    m_entries.clear();
+}
+
+uint64_t  recognition_cache::size() const
+{
+    std::lock_guard<std::mutex> const  lock(m_mutex);
+    uint64_t  result = 0ULL;
+    for (auto const&  adr_entries : m_entries)
+        result += adr_entries.second.size();
+    return result;
+}
+
+uint64_t  recognition_cache::num_hits() const
+{
+    std::lock_guard<std::mutex> const  lock(m_mutex);
+    return m_num_hits;
+}
+
+uint64_t  recognition_cache::num_misses() const
+{
+    std::lock_guard<std::mutex> const  lock(m_mutex);
+    return m_num_misses;
+}
+
+uint64_t  recognition_cache::num_invalidations() const
+{
+    std::lock_guard<std::mutex> const  lock(m_mutex);
+    return m_num_invalidations;
+}
+
+
+}}
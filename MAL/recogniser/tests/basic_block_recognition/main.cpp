@@ -0,0 +1,173 @@
+#include "../fake_recogniser.hpp"
+#include <rebours/MAL/recogniser/recognise.hpp>
+#include <rebours/MAL/recogniser/dump.hpp>
+#include <rebours/MAL/recogniser/test.hpp>
+#include <vector>
+#include <string>
+#include <iterator>
+#include <cstdio>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+
+static mal::recogniser::recognition_result  recognise_block(std::vector<uint8_t> const&  code, uint64_t const  max_num_instructions = 64ULL)
+{
+    return mal::recogniser::recognise_basic_block(&recognise_fake_instruction,0x2000ULL,&unknown_reg_fn,make_mem_fn(0x2000ULL,code),
+                                                  max_num_instructions);
+}
+
+/**
+ * It checks the block consists of the passed instructions and that each of them begins at a node of the start component.
+ */
+static bool  has_instructions(mal::recogniser::recognition_result const&  block, std::vector<std::string> const&  asm_texts)
+{
+    if (!block.program().operator bool() || block.instructions().size() != asm_texts.size())
+        return false;
+    microcode::program_component const&  C = block.program()->start_component();
+    if (block.instructions().front().node != C.entry())
+        return false;
+    uint64_t  address = 0x2000ULL;
+    for (uint64_t  i = 0ULL; i < asm_texts.size(); ++i)
+    {
+        mal::recogniser::recognised_instruction const&  info = block.instructions().at(i);
+        if (info.asm_text != asm_texts.at(i) || info.address != address || C.nodes().count(info.node) == 0ULL)
+            return false;
+        address += info.asm_text == "JE" ? 2ULL : info.asm_text == "CALL" ? 5ULL : 1ULL;
+    }
+    return true;
+}
+
+
+static void test_end_by_branch()
+{
+    std::cout << "Starting: test_end_by_branch()\n";
+
+    uint64_t const  num_recognitions = num_fake_recognitions();
+    mal::recogniser::recognition_result const  block = recognise_block({ 0x90U, 0x90U, 0x74U, 0x05U, 0x90U });
+    TEST_SUCCESS(has_instructions(block,{ "NOP", "NOP", "JE" }));
+    TEST_SUCCESS(block.ends_basic_block());
+    TEST_SUCCESS(block.program()->start_component().exits().size() == 2ULL);
+    TEST_SUCCESS(num_fake_recognitions() == num_recognitions + 3ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_end_by_call()
+{
+    std::cout << "Starting: test_end_by_call()\n";
+
+    mal::recogniser::recognition_result const  block = recognise_block({ 0x90U, 0xE8U, 0x00U, 0x00U, 0x00U, 0x00U, 0x90U });
+    TEST_SUCCESS(has_instructions(block,{ "NOP", "CALL" }));
+    TEST_SUCCESS(block.ends_basic_block());
+    TEST_SUCCESS(block.program()->start_component().exits().size() == 1ULL);
+
+    // A call at the start forms a block of its own.
+    mal::recogniser::recognition_result const  call = recognise_block({ 0xE8U, 0x00U, 0x00U, 0x00U, 0x00U, 0x90U });
+    TEST_SUCCESS(has_instructions(call,{ "CALL" }));
+    TEST_SUCCESS(call.ends_basic_block());
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_end_by_return()
+{
+    std::cout << "Starting: test_end_by_return()\n";
+
+    mal::recogniser::recognition_result const  block = recognise_block({ 0x90U, 0x90U, 0x90U, 0xC3U, 0x90U });
+    TEST_SUCCESS(has_instructions(block,{ "NOP", "NOP", "NOP", "RET" }));
+    TEST_SUCCESS(block.ends_basic_block());
+    TEST_SUCCESS(block.program()->start_component().exits().size() == 1ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_end_of_readable_region()
+{
+    std::cout << "Starting: test_end_of_readable_region()\n";
+
+    mal::recogniser::recognition_result const  block = recognise_block({ 0x90U, 0x90U });
+    TEST_SUCCESS(has_instructions(block,{ "NOP", "NOP" }));
+    TEST_SUCCESS(!block.ends_basic_block());
+    TEST_SUCCESS(block.program()->start_component().exits().size() == 1ULL);
+
+    // The region ends inside an instruction.
+    mal::recogniser::recognition_result const  cut = recognise_block({ 0x90U, 0xE8U, 0x00U });
+    TEST_SUCCESS(has_instructions(cut,{ "NOP" }));
+    TEST_SUCCESS(!cut.ends_basic_block());
+
+    // Nothing is readable, so the result is the one of the first instruction.
+    mal::recogniser::recognition_result const  none = recognise_block({});
+    TEST_SUCCESS(!none.program().operator bool());
+    TEST_SUCCESS(none.result() == 4U && none.address() == 0x2000ULL && none.rights() == 2U);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_instruction_limit()
+{
+    std::cout << "Starting: test_instruction_limit()\n";
+
+    mal::recogniser::recognition_result const  block = recognise_block(std::vector<uint8_t>(10ULL,0x90U),4ULL);
+    TEST_SUCCESS(has_instructions(block,{ "NOP", "NOP", "NOP", "NOP" }));
+    TEST_SUCCESS(!block.ends_basic_block());
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_dump()
+{
+    std::cout << "Starting: test_dump()\n";
+
+    std::string const  pathname = "./basic_block_recognition_dump.html";
+    mal::recogniser::recognition_result const  block = recognise_block({ 0x90U, 0x90U, 0x74U, 0x05U });
+    TEST_SUCCESS(mal::recogniser::dump_details_of_recognised_instruction(block,pathname));
+
+    std::string  html;
+    {
+        std::ifstream  istr(pathname,std::ifstream::binary);
+        html.assign(std::istreambuf_iterator<char>(istr),std::istreambuf_iterator<char>());
+    }
+    std::remove(pathname.c_str());
+
+    // The details of the first instruction are followed by all instructions of the block.
+    std::string::size_type const  table = html.find("<table>");
+    TEST_SUCCESS(html.find("<h2>NOP 90h</h2>") < table && table < html.rfind("</body>"));
+    TEST_SUCCESS(html.find("<td>2001</td>",table) != std::string::npos);
+    TEST_SUCCESS(html.find("<td>2002</td>",table) != std::string::npos && html.find("<td>74h,05h</td>",table) != std::string::npos);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("basic_block_recognition_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_end_by_branch();
+        test_end_by_call();
+        test_end_by_return();
+        test_end_of_readable_region();
+        test_instruction_limit();
+        test_dump();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "./fake_recogniser.hpp"
+#include <rebours/MAL/recogniser/detail/recognition_data.hpp>
+#include <rebours/MAL/recogniser/msgstream.hpp>
+#include <rebours/program/program.hpp>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <memory>
+
+namespace {
+
+
+uint64_t  num_calls = 0ULL;
+
+
+struct fake_recognition_data : public mal::recogniser::detail::recognition_data
+{
+    fake_recognition_data(uint64_t const  start_address, mal::recogniser::reg_fn_type const&  reg_fn,
+                          mal::recogniser::mem_fn_type const&  mem_fn)
+        : mal::recogniser::detail::recognition_data(start_address,reg_fn,mem_fn)
+    {}
+
+    void  recognise(mal::descriptor::storage const&) { recognise(); }
+    bool  dump(std::string const&  dump_file_pathname) const;
+
+    void  recognise();
+
+private:
+    bool  read_byte(uint64_t const  address);
+};
+
+
+bool  fake_recognition_data::read_byte(uint64_t const  address)
+{
+    int16_t const  value = mem_fn()(address,2U);
+    if (value < 0)
+    {
+        set_error_result(value == -1 ? 2U : 4U);
+        set_error_address(address);
+        if (value == -2)
+            set_error_rights(2U);
+        return false;
+    }
+    buffer().push_back((uint8_t)value);
+    return true;
+}
+
+bool  fake_recognition_data::dump(std::string const&  dump_file_pathname) const
+{
+    std::ofstream  ostr{dump_file_pathname,std::ofstream::binary};
+    ostr << "<!DOCTYPE html>\n<html>\n<body>\n<h2>" << asm_text() << " " << asm_bytes() << "</h2>\n</body>\n</html>\n";
+    return ostr.good();
+}
+
+void  fake_recognition_data::recognise()
+{
+    if (!read_byte(start_address()))
+        return;
+
+    std::string  name;
+    uint64_t  num_operand_bytes = 0ULL;
+    switch (buffer().front())
+    {
+    case 0x90U: name = "NOP"; break;
+    case 0x74U: name = "JE"; num_operand_bytes = 1ULL; break;
+    case 0xE8U: name = "CALL"; num_operand_bytes = 4ULL; break;
+    case 0xC3U: name = "RET"; break;
+    default:
+        set_error_result(254U);
+        set_error_address(start_address());
+        return;
+    }
+    for (uint64_t  i = 1ULL; i <= num_operand_bytes; ++i)
+        if (!read_byte(start_address() + i))
+            return;
+
+    microcode::program_component&  C = program()->start_component();
+    if (name == "JE")
+        C.insert_branching(microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO,1U,0ULL,C.entry());
+    else
+        C.insert_sequence(C.entry(),{ microcode::create_MISCELLANEOUS__NOP() });
+
+    set_asm_text(name);
+    msgstream  mstr;
+    for (uint64_t  i = 0ULL; i < buffer().size(); ++i)
+        mstr << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)buffer().at(i) << "h" << (i + 1ULL != buffer().size() ? "," : "");
+    set_asm_bytes(mstr.str());
+    instructions().push_back({ C.entry(), start_address(), asm_text(), asm_bytes() });
+    set_ends_basic_block(name != "NOP");
+}
+
+
+}
+
+
+mal::recogniser::recognition_result  recognise_fake_instruction(uint64_t const  start_address,
+                                                                 mal::recogniser::reg_fn_type const&  reg_fn,
+                                                                 mal::recogniser::mem_fn_type const&  mem_fn)
+{
+    ++num_calls;
+    std::shared_ptr<fake_recognition_data> const  data = std::make_shared<fake_recognition_data>(start_address,reg_fn,mem_fn);
+    data->recognise();
+    return mal::recogniser::recognition_result(data);
+}
+
+uint64_t  num_fake_recognitions()
+{
+    return num_calls;
+}
+
+
+mal::recogniser::mem_fn_type  make_mem_fn(uint64_t const  begin, std::vector<uint8_t> const&  code)
+{
+    return [begin,&code](uint64_t const  address, uint8_t const  rights) -> int16_t {
+        if (rights != 2U || address < begin || address >= begin + code.size())
+            return -2;
+        return code.at(address - begin);
+    };
+}
+
+int16_t  unknown_reg_fn(uint64_t const)
+{
+    return -1;
+}
@@ -0,0 +1,35 @@
+#ifndef REBOURS_MAL_RECOGNISER_TESTS_FAKE_RECOGNISER_HPP_INCLUDED
+#   define REBOURS_MAL_RECOGNISER_TESTS_FAKE_RECOGNISER_HPP_INCLUDED
+
+#   include <rebours/MAL/recogniser/recognise.hpp>
+#   include <vector>
+#   include <cstdint>
+
+
+/**
+ * Recognises an instruction of a tiny instruction set resembling x86-64, so that the recogniser's
+ * infrastructure can be tested without a disassembler:
+ *      90h                 NOP         one successor
+ *      74h xx              JE rel8     two successors, it ends a basic block
+ *      E8h xx xx xx xx     CALL rel32  one successor, it ends a basic block
+ *      C3h                 RET         one successor, it ends a basic block
+ * Any other byte cannot be recognised (the result 254). Bytes are read via 'mem_fn' with the execute rights.
+ * The function counts its calls (see 'num_fake_recognitions'). Results are dumped into a minimal HTML file.
+ */
+mal::recogniser::recognition_result  recognise_fake_instruction(uint64_t const  start_address,
+                                                                 mal::recogniser::reg_fn_type const&  reg_fn,
+                                                                 mal::recogniser::mem_fn_type const&  mem_fn);
+
+uint64_t  num_fake_recognitions();
+
+
+/**
+ * The returned function reads bytes of the passed code placed at 'begin'. The code is referenced, not copied,
+ * so changes of the code are visible through the function. Addresses outside the code are not executable.
+ */
+mal::recogniser::mem_fn_type  make_mem_fn(uint64_t const  begin, std::vector<uint8_t> const&  code);
+
+int16_t  unknown_reg_fn(uint64_t const  address);
+
+
+#endif
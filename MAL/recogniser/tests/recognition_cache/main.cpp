@@ -0,0 +1,142 @@
+#include "../fake_recogniser.hpp"
+#include <rebours/MAL/recogniser/recognition_cache.hpp>
+#include <rebours/MAL/recogniser/test.hpp>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+
+static void test_cache_hit()
+{
+    std::cout << "Starting: test_cache_hit()\n";
+
+    std::vector<uint8_t> const  code{ 0x90U, 0xC3U };
+    mal::recogniser::mem_fn_type const  mem_fn = make_mem_fn(0x1000ULL,code);
+    mal::recogniser::recognition_cache  cache;
+
+    uint64_t const  num_recognitions = num_fake_recognitions();
+    mal::recogniser::recognition_result const  first = cache.recognise(&recognise_fake_instruction,0x1000ULL,&unknown_reg_fn,mem_fn);
+    TEST_SUCCESS(first.program().operator bool());
+    TEST_SUCCESS(cache.num_misses() == 1ULL && cache.num_hits() == 0ULL && cache.size() == 1ULL);
+    TEST_SUCCESS(num_fake_recognitions() == num_recognitions + 1ULL);
+
+    mal::recogniser::recognition_result const  second = cache.recognise(&recognise_fake_instruction,0x1000ULL,&unknown_reg_fn,mem_fn);
+    TEST_SUCCESS(second.program().operator bool());
+    TEST_SUCCESS(cache.num_misses() == 1ULL && cache.num_hits() == 1ULL && cache.size() == 1ULL);
+    TEST_SUCCESS(num_fake_recognitions() == num_recognitions + 1ULL);
+
+    // The hit is a copy of the cached program with fresh nodes, so both results can be merged into one program.
+    TEST_SUCCESS(second.program() != first.program());
+    TEST_SUCCESS(second.program()->start_component().entry() != first.program()->start_component().entry());
+    TEST_SUCCESS(second.program()->start_component().edges().size() == first.program()->start_component().edges().size());
+    TEST_SUCCESS(second.instructions().size() == 1ULL);
+    TEST_SUCCESS(second.instructions().front().node == second.program()->start_component().entry());
+    TEST_SUCCESS(second.instructions().front().address == 0x1000ULL);
+    TEST_SUCCESS(second.asm_text() == "NOP" && second.asm_bytes() == first.asm_bytes());
+    TEST_SUCCESS(second.buffer() == std::vector<uint8_t>{ 0x90U });
+
+    // Failed recognitions are not cached.
+    TEST_SUCCESS(!cache.recognise(&recognise_fake_instruction,0x1002ULL,&unknown_reg_fn,mem_fn).program().operator bool());
+    TEST_SUCCESS(!cache.recognise(&recognise_fake_instruction,0x1002ULL,&unknown_reg_fn,mem_fn).program().operator bool());
+    TEST_SUCCESS(cache.size() == 1ULL && cache.num_misses() == 3ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_miss_after_code_change()
+{
+    std::cout << "Starting: test_miss_after_code_change()\n";
+
+    std::vector<uint8_t>  code{ 0x90U, 0x90U };
+    mal::recogniser::mem_fn_type const  mem_fn = make_mem_fn(0x1000ULL,code);
+    mal::recogniser::recognition_cache  cache;
+
+    TEST_SUCCESS(cache.recognise(&recognise_fake_instruction,0x1000ULL,&unknown_reg_fn,mem_fn).asm_text() == "NOP");
+
+    // Bytes outside of the instruction do not matter.
+    code.at(1ULL) = 0xC3U;
+    TEST_SUCCESS(cache.recognise(&recognise_fake_instruction,0x1000ULL,&unknown_reg_fn,mem_fn).asm_text() == "NOP");
+    TEST_SUCCESS(cache.num_hits() == 1ULL && cache.num_misses() == 1ULL);
+
+    // The code was modified, so the cached NOP is stale.
+    code.at(0ULL) = 0xC3U;
+    uint64_t const  num_recognitions = num_fake_recognitions();
+    mal::recogniser::recognition_result const  result = cache.recognise(&recognise_fake_instruction,0x1000ULL,&unknown_reg_fn,mem_fn);
+    TEST_SUCCESS(num_fake_recognitions() == num_recognitions + 1ULL);
+    TEST_SUCCESS(result.program().operator bool() && result.asm_text() == "RET" && result.ends_basic_block());
+    TEST_SUCCESS(cache.num_hits() == 1ULL && cache.num_misses() == 2ULL && cache.num_invalidations() == 1ULL);
+    TEST_SUCCESS(cache.size() == 1ULL);
+
+    TEST_SUCCESS(cache.recognise(&recognise_fake_instruction,0x1000ULL,&unknown_reg_fn,mem_fn).asm_text() == "RET");
+    TEST_SUCCESS(cache.num_hits() == 2ULL && num_fake_recognitions() == num_recognitions + 1ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_eviction()
+{
+    std::cout << "Starting: test_eviction()\n";
+
+    std::vector<uint8_t> const  code{ 0x90U, 0xE8U, 0x00U, 0x00U, 0x00U, 0x00U, 0xC3U };
+    mal::recogniser::mem_fn_type const  mem_fn = make_mem_fn(0x1000ULL,code);
+    mal::recogniser::recognition_cache  cache;
+
+    for (uint64_t  address : { 0x1000ULL, 0x1001ULL, 0x1006ULL })
+        TEST_SUCCESS(cache.recognise(&recognise_fake_instruction,address,&unknown_reg_fn,mem_fn).program().operator bool());
+    TEST_SUCCESS(cache.size() == 3ULL && cache.num_misses() == 3ULL);
+
+    // Only the CALL has bytes in the range.
+    cache.invalidate(0x1003ULL,0x1004ULL);
+    TEST_SUCCESS(cache.size() == 2ULL && cache.num_invalidations() == 1ULL);
+    TEST_SUCCESS(cache.recognise(&recognise_fake_instruction,0x1000ULL,&unknown_reg_fn,mem_fn).asm_text() == "NOP");
+    TEST_SUCCESS(cache.recognise(&recognise_fake_instruction,0x1006ULL,&unknown_reg_fn,mem_fn).asm_text() == "RET");
+    TEST_SUCCESS(cache.num_hits() == 2ULL);
+    TEST_SUCCESS(cache.recognise(&recognise_fake_instruction,0x1001ULL,&unknown_reg_fn,mem_fn).asm_text() == "CALL");
+    TEST_SUCCESS(cache.num_misses() == 4ULL && cache.size() == 3ULL);
+
+    // The range end is exclusive.
+    cache.invalidate(0x1006ULL,0x1006ULL);
+    cache.invalidate(0x1007ULL,0x2000ULL);
+    TEST_SUCCESS(cache.size() == 3ULL && cache.num_invalidations() == 1ULL);
+    cache.invalidate(0x0000ULL,0x1002ULL);
+    TEST_SUCCESS(cache.size() == 1ULL && cache.num_invalidations() == 3ULL);
+
+    cache.clear();
+    TEST_SUCCESS(cache.size() == 0ULL);
+    TEST_SUCCESS(cache.recognise(&recognise_fake_instruction,0x1006ULL,&unknown_reg_fn,mem_fn).asm_text() == "RET");
+    TEST_SUCCESS(cache.num_misses() == 5ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("recognition_cache_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_cache_hit();
+        test_miss_after_code_change();
+        test_eviction();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
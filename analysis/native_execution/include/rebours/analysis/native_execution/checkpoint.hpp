@@ -0,0 +1,68 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_CHECKPOINT_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_CHECKPOINT_HPP_INCLUDED
+
+#   include <rebours/analysis/native_execution/recovery_properties.hpp>
+#   include <rebours/analysis/native_execution/execution_properties.hpp>
+#   include <rebours/program/program.hpp>
+#   include <rebours/program/assembly.hpp>
+#   include <unordered_map>
+#   include <vector>
+#   include <string>
+#   include <memory>
+#   include <iosfwd>
+#   include <cstdint>
+
+namespace analysis { namespace natexe {
+
+
+using  input_streams_of_executions = std::vector< std::unordered_map<stream_id,std::vector<uint8_t> > >;
+
+
+/**
+ * A checkpoint is the state of the whole recovery between two rounds of native executions: the recovered program
+ * with its annotations (including the dictionary of its instructions, see 'microcode::save_program_as_binary'), all
+ * data in 'recovery_properties', and inputs of executions prepared for the next round. The prologue program is not
+ * stored; it is rebuilt from the analysed binary, and the checkpoint keeps only its fingerprint, so that the recovery
+ * is not resumed with a different prologue (whose IDs of nodes might collide with the recovered program).
+ *
+ * Both functions return an empty string on success and an error message otherwise.
+ */
+std::string  save_checkpoint(std::ostream&  ostr,
+                             microcode::program const&  prologue,
+                             microcode::program const&  program,
+                             microcode::annotations const&  annotations,
+                             recovery_properties const&  rprops,
+                             input_streams_of_executions const&  pending_inputs);
+
+/**
+ * The loaded recovery properties keep the timeout of the passed 'rprops', and their time is measured from the call.
+ */
+std::string  load_checkpoint(std::istream&  istr,
+                             microcode::program const&  prologue,
+                             std::unique_ptr<microcode::program>&  program,
+                             microcode::annotations&  annotations,
+                             recovery_properties&  rprops,
+                             input_streams_of_executions&  pending_inputs);
+
+/**
+ * It stores the checkpoint into a temporary file first and then it renames the file to 'pathname'. So, when the
+ * process is killed in the middle, the previous checkpoint in 'pathname' stays intact.
+ */
+std::string  save_checkpoint_file(std::string const&  pathname,
+                                  microcode::program const&  prologue,
+                                  microcode::program const&  program,
+                                  microcode::annotations const&  annotations,
+                                  recovery_properties const&  rprops,
+                                  input_streams_of_executions const&  pending_inputs);
+
+std::string  load_checkpoint_file(std::string const&  pathname,
+                                  microcode::program const&  prologue,
+                                  std::unique_ptr<microcode::program>&  program,
+                                  microcode::annotations&  annotations,
+                                  recovery_properties&  rprops,
+                                  input_streams_of_executions&  pending_inputs);
+
+
+}}
+
+#endif
@@ -79,7 +79,7 @@ std::string  dump_node_histories_of_executed_threads(
         std::string const&  filename);
 
 std::string  dump_nodes_history_of_one_executed_thread(
-        std::vector<node_id> const&  nodes,
+        compact_trace const&  nodes,
         std::string const&  filename);
 
 std::string  dump_threads_of_performed_executions(
@@ -92,7 +92,7 @@ std::string  dump_interleaving_of_threads(
 
 std::string  dump_input_impacts_of_one_executed_thread(
         std::vector<std::vector<input_impact_value> > const&  impacts,
-        std::vector<node_id> const&  nodes_history,
+        compact_trace const&  nodes_history,
         std::string const&  filename);
 
 std::string  dump_input_impacts_of_executed_threads(
@@ -102,7 +102,7 @@ std::string  dump_input_impacts_of_executed_threads(
 
 std::string  dump_input_impact_links_of_one_executed_thread(
         std::vector<std::unordered_set<input_impact_link> > const&  links,
-        std::vector<node_id> const&  nodes_history,
+        compact_trace const&  nodes_history,
         std::string const&  filename);
 
 std::string  dump_input_impact_links_of_executed_threads(
@@ -117,7 +117,7 @@ std::string  dump_recovery_properties(
 
 std::string  dump_input_frontier_of_thread(
         input_frontier_of_thread const&  frontier,
-        std::vector<node_id> const* const  nodes_history,
+        compact_trace const* const  nodes_history,
         std::string const&  filename);
 
 std::string  dump_thread_properties(
@@ -3,6 +3,7 @@
 
 #   include <rebours/analysis/native_execution/execution_properties.hpp>
 #   include <rebours/program/instruction.hpp>
+#   include <rebours/program/decoded_instruction.hpp>
 #   include <string>
 #   include <cstdint>
 
@@ -18,71 +19,132 @@
  *      microcode::GIK::CONCURRENCY__REG_ASGN_THREAD,
  *      microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO,
  *      microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO.
- * Due to their special nature they are handled directly inside the function 'execution_step', see 'execute_program.cpp'.
+ * Due to their special nature they are handled directly inside the function 'execution_step', see 'execution_step.cpp'.
  */
 
 namespace analysis { namespace natexe {
 
 
-std::string  execute_SETANDCOPY__REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx);
-std::string  execute_SETANDCOPY__REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+enum struct EXECUTION_STATUS : uint8_t
+{
+    SUCCESS,
+    STOPPED,    //!< By the 'STOP' instruction.
+    READ_BEHIND_END_OF_REG_POOL,
+    WRITE_BEHIND_END_OF_REG_POOL,
+    HAVOC_BEHIND_END_OF_REG_POOL,
+    READ_FROM_NOT_ALLOCATED_MEMORY,
+    READ_FROM_NOT_READABLE_MEMORY,
+    WRITE_INTO_NOT_ALLOCATED_MEMORY,
+    WRITE_INTO_NOT_WRITABLE_MEMORY,
+    UNKNOWN_ENDIANNESS_OF_MEMORY,
+    DIVISION_BY_ZERO,
+    MODULO_BY_ZERO,
+    DATA_WRITE_IN_CONCURRENT_EXECUTION,
+    STREAM_ALREADY_OPEN,
+    READ_FROM_NOT_OPEN_STREAM,
+    READ_FROM_NOT_READABLE_STREAM,
+    INVALID_CURSOR_OF_STREAM,
+    WRITE_INTO_NOT_OPEN_STREAM,
+    WRITE_INTO_NOT_WRITABLE_STREAM,
+    NOT_IMPLEMENTED_INSTRUCTION,
+};
 
-std::string  execute_INDIRECTCOPY__REG_ASGN_REG_REG(uint8_t const  n0, uint8_t const  n1, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-std::string  execute_INDIRECTCOPY__REG_REG_ASGN_REG(uint8_t const  n0, uint8_t const  n1, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
 
-std::string  execute_DATATRANSFER__REG_ASGN_DEREF_INV_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-std::string  execute_DATATRANSFER__REG_ASGN_DEREF_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-std::string  execute_DATATRANSFER__DEREF_REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-std::string  execute_DATATRANSFER__DEREF_INV_REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-std::string  execute_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA(uint64_t const  a, uint8_t const*  begin, uint64_t const  num_bytes, execution_context&  ctx);
-std::string  execute_DATATRANSFER__DEREF_REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx);
-std::string  execute_DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx);
-
-std::string  execute_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-std::string  execute_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-
-std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC(uint64_t const  a0, uint64_t const  a1, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx);
-std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, uint64_t const  a3, execution_context&  ctx);
-std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_FREE(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
-std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER(uint64_t const  a0, uint64_t const  a1, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx);
-
-std::string  execute_HAVOC__REG_ASGN_HAVOC(uint64_t const  v, uint64_t const  a, execution_context&  ctx);
-std::string  execute_HAVOC__REG_REG_ASGN_HAVOC(uint8_t const  n, uint64_t const  v, uint64_t const  a, execution_context&  ctx);
-
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint128_t const  v, execution_context&  ctx);
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint128_t const  v, execution_context&  ctx);
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
-
-std::string  execute_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_AND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_OR_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_NOT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_XOR_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint8_t const  v, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint8_t const  v, execution_context&  ctx);
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+/**
+ * A result of an execution of a single instruction. It is as cheap to return as a number, because the text of
+ * an error is built only when the function 'message' is called, i.e. only when an error is reported or dumped.
+ * The operand holds the data the text needs: the number of the stream for stream errors and the GIK of the
+ * instruction for NOT_IMPLEMENTED_INSTRUCTION.
+ */
+struct  execution_status
+{
+    execution_status(EXECUTION_STATUS const  code = EXECUTION_STATUS::SUCCESS, uint64_t const  operand = 0ULL) noexcept
+        : m_code(code)
+        , m_operand(operand)
+    {}
+
+    EXECUTION_STATUS  code() const noexcept { return m_code; }
+    uint64_t  operand() const noexcept { return m_operand; }
+    bool  succeeded() const noexcept { return m_code == EXECUTION_STATUS::SUCCESS; }
+
+    std::string  message() const;   //!< It is empty for SUCCESS.
+
+private:
+    EXECUTION_STATUS  m_code;
+    uint64_t  m_operand;
+};
+
+
+execution_status  execute_SETANDCOPY__REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx);
+execution_status  execute_SETANDCOPY__REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+
+execution_status  execute_INDIRECTCOPY__REG_ASGN_REG_REG(uint8_t const  n0, uint8_t const  n1, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+execution_status  execute_INDIRECTCOPY__REG_REG_ASGN_REG(uint8_t const  n0, uint8_t const  n1, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+
+execution_status  execute_DATATRANSFER__REG_ASGN_DEREF_INV_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+execution_status  execute_DATATRANSFER__REG_ASGN_DEREF_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+execution_status  execute_DATATRANSFER__DEREF_REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+execution_status  execute_DATATRANSFER__DEREF_INV_REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+execution_status  execute_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA(uint64_t const  a, uint8_t const*  begin, uint64_t const  num_bytes, execution_context&  ctx);
+execution_status  execute_DATATRANSFER__DEREF_REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx);
+execution_status  execute_DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx);
+
+execution_status  execute_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+execution_status  execute_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+
+execution_status  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC(uint64_t const  a0, uint64_t const  a1, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx);
+execution_status  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, uint64_t const  a3, execution_context&  ctx);
+execution_status  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_FREE(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+execution_status  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER(uint64_t const  a0, uint64_t const  a1, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx);
+
+execution_status  execute_HAVOC__REG_ASGN_HAVOC(uint64_t const  v, uint64_t const  a, execution_context&  ctx);
+execution_status  execute_HAVOC__REG_REG_ASGN_HAVOC(uint8_t const  n, uint64_t const  v, uint64_t const  a, execution_context&  ctx);
+
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint128_t const  v, execution_context&  ctx);
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint128_t const  v, execution_context&  ctx);
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+
+execution_status  execute_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_AND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_OR_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_NOT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_XOR_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint8_t const  v, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint8_t const  v, execution_context&  ctx);
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+
+execution_status  execute_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER(uint64_t const  a, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx);
+execution_status  execute_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER(uint64_t const  a, uint64_t const  v, execution_context&  ctx);
+execution_status  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG(uint64_t const  a0, uint64_t const  v, uint64_t const  a1, execution_context&  ctx);
+execution_status  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
+
+execution_status  execute_MISCELLANEOUS__REG_ASGN_PARITY_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
 
-std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER(uint64_t const  a, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx);
-std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER(uint64_t const  a, uint64_t const  v, execution_context&  ctx);
-std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG(uint64_t const  a0, uint64_t const  v, uint64_t const  a1, execution_context&  ctx);
-std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx);
 
-std::string  execute_MISCELLANEOUS__REG_ASGN_PARITY_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx);
+/**
+ * This is the 'root' function whose job is to call one particular function from those above, according to the type of the passed instruction.
+ * It reads arguments from the decoded form of the instruction, i.e. it does not parse the instruction itself.
+ */
+execution_status  execution_instruction(microcode::decoded_instruction const& I, execution_context&  ctx, bool const  is_sequential);
 
 
 /**
- * This is the 'root' function whose job is to call one particular function from those above, according to the type of the passed instruction.
+ * A handler reads arguments from the decoded form of an instruction and calls the related function from those above.
+ * The function returns the handler of instructions of the passed kind, or nullptr for the kinds not handled here.
+ * So, a caller executing an instruction repeatedly (e.g. the threaded code) can find the handler only once.
+ * NOTE: The handler of 'DATATRANSFER__DEREF_ADDRESS_ASGN_DATA' does not check the execution is sequential.
  */
-std::string  execution_instruction(microcode::instruction const& I, execution_context&  ctx, bool const  is_sequential);
+using  instruction_handler = execution_status (*)(microcode::decoded_instruction const&, execution_context&);
+instruction_handler  find_instruction_handler(microcode::GIK const  gik);
 
 
 }}
@@ -3,6 +3,8 @@
 
 #   include <rebours/analysis/native_execution/execution_properties.hpp>
 #   include <rebours/analysis/native_execution/recovery_properties.hpp>
+#   include <rebours/analysis/native_execution/prologue_snapshot.hpp>
+#   include <rebours/analysis/native_execution/threaded_code.hpp>
 #   include <rebours/program/program.hpp>
 #   include <rebours/program/assembly.hpp>
 #   include <rebours/MAL/recogniser/recognise.hpp>
@@ -41,11 +43,15 @@ std::string  perform_single_native_program_execution(
                         //!< This callback only improves logging output. It is not used in the analysis itself. So, you
                         //!< can pass a function doing nothing (no logging). Also, it is used only if 'logging_root_dir'
                         //!< not empty.
-                std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers = {}
+                std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers = {},
                         //!< A map from ranges in REG pool to names of CPU registers mapped into the ranges. This map is used
                         //!< only for user-friendly output into log files. The map is not used in the analysis itself. So, you
                         //!< can pass empty map without affecting results of the analysis. Also it is used only if 'logging_root_dir'
                         //!< not empty.
+                prologue_snapshot_ptr* const  snapshot = nullptr
+                        //!< If 'eprops' were forked from a snapshot (i.e. they already have final REG pools), then the execution of
+                        //!< the prologue is skipped and '*snapshot' must point to that snapshot. Otherwise, if 'snapshot' is not null,
+                        //!< then the state right after the execution of the prologue is saved to '*snapshot'.
                 );
 
 
@@ -84,23 +90,26 @@ std::string  execute_program(
  * and applying an inconsistency check afterwards.
  */
 std::string  execution_step(
-                microcode::program const&  P,   //!< A program the single execition step will be performed in.
+                microcode::program&  P,   //!< A program the single execition step will be performed in.
                 std::vector<thread>&  in_thds,  //!< Threads scheduled for performing the step for.
                 execution_properties&  eprops,  //!< Data related to the current execution of the program.
-                recovery_properties* const  rprops, //!< Data about the whole program colleced during all preceeding native executions of the program.
+                recovery_properties&  rprops, //!< Data about the whole program colleced during all preceeding native executions of the program.
                 std::vector<thread>&  out_thds, //!< Resulting threads after execution step is performed to the scheduled threads.
                 /// Next follow parameters related to generation of log files from the analysis.
-                std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers = {}
+                std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers = {},
+                /// When passed, a thread running alone is first executed by 'execution_run'. When it performs some steps, no step
+                /// is performed by the graph walker (so that the caller can check a timeout or extend the program first).
+                threaded_code* const  code = nullptr
                 );
 
 /**
  * It applies an effect of the current instruction of a passed thread.
  */
 std::string  execution_step(
-                microcode::program const&  P,   //!< A program the single execition step will be performed in.
+                microcode::program&  P,   //!< A program the single execition step will be performed in.
                 thread&  thd,   //!< A thread whose current instruction will be executed.
                 execution_properties&  eprops,  //!< Data related to the current execution of the program.
-                recovery_properties* const  rprops, //!< Data about the whole program colleced during all preceeding native executions of the program.
+                recovery_properties&  rprops, //!< Data about the whole program colleced during all preceeding native executions of the program.
                 std::vector<thread>&  thds, //!< Resulting threads after execution step is performed to the passed thread 'thd'.
                 mem_access_set&  w_d, mem_access_set&  r_d, mem_access_set&  w_c, mem_access_set&  r_c,
                     //!< The function updates these sets according to memory accesses performed during execution of the current instruction.
@@ -109,6 +118,22 @@ std::string  execution_step(
                 /// Next follow parameters related to generation of log files from the analysis.
                 std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers = {});
 
+/**
+ * It performs steps of a thread running alone (i.e. the execution is sequential) along records of the threaded code, till
+ * the thread reaches a node left to the graph walker, an error occurs, or 'max_num_steps' steps are performed. Effects and
+ * records of each step are the same as those of 'execution_step'. The number of performed steps is stored to 'num_steps'.
+ * When the threaded code has the native tier, hot regions of records are performed by their machine code.
+ */
+std::string  execution_run(
+                microcode::program const&  P,
+                threaded_code&  code,
+                thread&  thd,
+                execution_properties&  eprops,
+                recovery_properties&  rprops,
+                uint64_t const  max_num_steps,
+                uint64_t&  num_steps
+                );
+
 /**
  * Given a set of threads it chooses its subsets. The chosen threads represent those scheduled for performing next execution step.
  */
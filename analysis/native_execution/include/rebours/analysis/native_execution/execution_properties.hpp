@@ -6,6 +6,7 @@
 #   include <rebours/analysis/native_execution/assumptions.hpp>
 #   include <rebours/analysis/native_execution/development.hpp>
 #   include <rebours/analysis/native_execution/std_pair_hash.hpp>
+#   include <rebours/analysis/native_execution/mem_access_set.hpp>
 #   include <rebours/program/program.hpp>
 #   include <memory>
 #   include <vector>
@@ -112,10 +113,6 @@ private:
     bool  m_is_in_big_endian;
     bool  m_has_mutable_endian;
 };
-using  memory_allocations = std::map<address,                   //!< A start address of an allocated memory block.
-                                     memory_allocation_info     //!< Properties of the allocated memory block.
-                                     >;
-
 /**
  * This is an abstraction of the struct 'memory_allocation_info' above for queries over any address ranges in the MEM pool.
  */
@@ -156,6 +153,69 @@ struct memory_block_info
     BOOL3  has_mutable_endian;
 };
 
+/**
+ * It is a collection of allocated memory blocks in the MEM pool ordered by their start addresses. Beside the blocks
+ * it also maintains a permission index: for each queried memory page it remembers whether all bytes of the page
+ * have the same properties (i.e. either none of the bytes is allocated, or all of them are allocated with the same
+ * rights and endianity), and if so, then also the 'memory_block_info' of the page. A query for a range inside
+ * such a page is thus answered without walking the blocks. The last hit page is remembered separately, because
+ * the successive queries mostly go to the same page (e.g. fetching instruction bytes one by one). Each insertion
+ * and erasure of a block invalidates the index for pages covered by the block.
+ *
+ * NOTE: The index is updated also during queries (i.e. via const methods). Therefore, a single instance may not be
+ *       queried from several OS threads simultaneously.
+ */
+struct memory_allocations
+{
+    using  container_type = std::map<address,                   //!< A start address of an allocated memory block.
+                                     memory_allocation_info     //!< Properties of the allocated memory block.
+                                     >;
+    using  value_type = container_type::value_type;
+    using  const_iterator = container_type::const_iterator;
+    using  iterator = const_iterator;   //!< Blocks cannot be modified in place, because the index would not be updated.
+
+    memory_allocations();
+
+    bool  empty() const noexcept { return m_blocks.empty(); }
+    natexe::size  size() const noexcept { return m_blocks.size(); }
+
+    const_iterator  begin() const noexcept { return m_blocks.cbegin(); }
+    const_iterator  end() const noexcept { return m_blocks.cend(); }
+    const_iterator  cbegin() const noexcept { return m_blocks.cbegin(); }
+    const_iterator  cend() const noexcept { return m_blocks.cend(); }
+
+    const_iterator  find(address const  begin) const { return m_blocks.find(begin); }
+    const_iterator  lower_bound(address const  begin) const { return m_blocks.lower_bound(begin); }
+
+    std::pair<const_iterator,bool>  insert(value_type const&  adr_info);
+    const_iterator  erase(const_iterator const  it);
+
+    /**
+     * It returns a pointer to the 'memory_block_info' of the passed page, if all bytes of the page have the same
+     * properties, and nullptr otherwise. The returned info thus holds for any range inside the page.
+     */
+    memory_block_info const*  find_uniform_page_info(address const  page_begin) const;
+
+private:
+    struct page_info
+    {
+        page_info(address const  page_begin_, bool const  is_uniform_, memory_block_info const&  info_)
+            : page_begin(page_begin_), is_uniform(is_uniform_), info(info_)
+        {}
+
+        address  page_begin;
+        bool  is_uniform;
+        memory_block_info  info;
+    };
+
+    page_info  compute_page_info(address const  page_begin) const;
+    void  invalidate_pages(address const  begin, natexe::size const  num_bytes);
+
+    container_type  m_blocks;
+    mutable std::unordered_map<address,page_info>  m_pages_index;
+    mutable page_info  m_last_hit;
+};
+
 /**
  * It computes an abstaction 'memory_block_info' for a query over address ranges in the MEM pool.
  */
@@ -168,6 +228,9 @@ size constexpr  memory_page_size = 0x1000ULL;   //!< ~ 4kB
 uint64_t  align_to_memory_page_size(uint64_t const  value);
 
 
+inline byte  default_uninitialised_value() { return 0xcdU; } //!< The value of each byte of a page, which was not written yet.
+
+
 struct memory_page
 {
     using data_type = std::array<byte,memory_page_size>;
@@ -185,9 +248,97 @@ private:
     std::array<byte,memory_page_size>  m_data;
 };
 
-using  memory_content = std::map<address,           //!< Start address.
-                                 memory_page        //!< Values of bytes from the start address.
-                                 >;
+/**
+ * It is a content of a memory pool (i.e. of REG or MEM) stored in memory pages. Pages are created lazily on the first
+ * write (or havoc) into them. A read from a page which was not written yet does NOT create the page; all its bytes
+ * are read as 'default_uninitialised_value()'.
+ *
+ * Pages in the range [0,num_dense_pages * memory_page_size) are stored in a dedicated dense array. That range covers
+ * all registers and most of temporaries in the REG pool, so accesses to them never reach the page table. The remaining
+ * pages are stored in a hash table. A small direct-mapped cache (TLB) of recently accessed pages is placed in front of
+ * the hash table. Since each thread has its own REG pool, each thread also has its own TLB for its REG pool.
+ *
+ * A copy of the content is copy-on-write: the copy shares the page table and all pages with the original. The first
+ * write into either of them clones the page table (only pointers to pages are copied) and then each written page
+ * is cloned on the first write into it. So, a fork of a thread costs O(1) until either thread writes into its REG pool.
+ *
+ * NOTE: The TLB is updated also during reads (i.e. via const methods). Therefore, a single instance may not be read
+ *       from several OS threads simultaneously.
+ */
+struct memory_content
+{
+    static natexe::size constexpr  num_dense_pages = 16ULL;    //!< The dense array thus covers addresses [0,0x10000).
+    static natexe::size constexpr  num_tlb_entries = 64ULL;    //!< Must be a power of 2.
+
+    memory_content();
+    memory_content(memory_content const&  other);
+    memory_content(memory_content&&  other);
+    memory_content&  operator=(memory_content const&  other);
+    memory_content&  operator=(memory_content&&  other);
+
+    natexe::size  size() const noexcept { return m_table.operator bool() ? m_table->num_pages : 0ULL; } //!< The number of created pages.
+    bool  empty() const noexcept { return size() == 0ULL; }
+
+    /**
+     * It returns a pointer to the page starting at the passed address, or nullptr, if the page was not created yet.
+     * The page is NOT created, if it does not exist.
+     */
+    memory_page const*  find_page(address const  page_begin) const;
+
+    /**
+     * It returns the page starting at the passed address. The page is created, if it does not exist yet.
+     */
+    memory_page&  page(address const  page_begin);
+
+    /**
+     * It erases all created pages lying completely inside the range [begin,end).
+     */
+    void  erase_pages(address const  begin, address const  end);
+
+    /**
+     * It returns all created pages sorted by their start addresses.
+     */
+    std::vector< std::pair<address,memory_page const*> >  pages() const;
+
+    void  swap(memory_content&  other);
+
+private:
+    struct page_table
+    {
+        page_table() : dense_pages(), pages(), num_pages(0ULL) {}
+
+        std::array<std::shared_ptr<memory_page>,num_dense_pages>  dense_pages;
+        std::unordered_map<address,std::shared_ptr<memory_page> >  pages;
+        natexe::size  num_pages;
+    };
+
+    struct tlb_entry
+    {
+        address  page_begin;
+        memory_page*  page;
+        bool  is_owned;     //!< When true, the page is not shared with any other content, so it can be written.
+    };
+
+    static address constexpr  invalid_tlb_tag = ~0ULL;  //!< Not aligned to page size, so it never matches a page.
+
+    static natexe::size  tlb_index(address const  page_begin) noexcept { return (page_begin / memory_page_size) & (num_tlb_entries - 1ULL); }
+
+    void  invalidate_tlb() const;
+
+    /**
+     * It returns the page table, which is not shared with any other content. The table is cloned, if it is shared.
+     */
+    page_table&  owned_table();
+
+    /**
+     * It returns the page, which is not shared with any other page table. The page is created, if it does not exist,
+     * or cloned, if it is shared.
+     */
+    static memory_page&  owned_page(std::shared_ptr<memory_page>&  ptr, natexe::size&  num_pages);
+
+    std::shared_ptr<page_table>  m_table;   //!< It is nullptr until the first page is created.
+    mutable std::array<tlb_entry,num_tlb_entries>  m_tlb;
+};
 
 
 inline byte  default_havoc_value() { return 0xdcU; } //!< TODO: Instead of using this fixed value we might consider to do bookkeeping
@@ -384,64 +535,262 @@ void  stream_write(stream_content&  content, index const  begin, T  value, bool
 
 
 
+/**
+ * Each byte of the REG pool, MEM pool, and streams of a thread may be impacted by the input of the program. We track
+ * such bytes in shadow pages parallel to pages of the pools and streams. A shadow page holds for each byte of the page
+ * a compact label: zero for a byte with no input impact, and otherwise an index (from 1) into a table of labels of the
+ * thread, which maps the label to the 'input_impact_link' of the last input impact value written into the byte.
+ * A shadow page is created only when a label is stored into it and it is released as soon as all its labels are
+ * zero again. So, queries over bytes having no input impact are answered mostly by a look-up of a page.
+ * The table of labels is a union table: all bytes linked to the same input impact value share one label, and
+ * a label no longer stored in any byte is reused. So, the number of labels never exceeds the number of bytes
+ * with an input impact.
+ */
+using  taint_label = uint32_t;
+
+
+struct shadow_page
+{
+    shadow_page() : m_num_labelled(0ULL), m_labels() { m_labels.fill(0U); }
+
+    natexe::size  num_labelled() const noexcept { return m_num_labelled; } //!< The number of non-zero labels in the page.
+    taint_label  label(index const  i) const { return m_labels[i]; }
+    void  set_label(index const  i, taint_label const  label);
+
+private:
+    natexe::size  m_num_labelled;
+    std::array<taint_label,memory_page_size>  m_labels;
+};
+
+
+/**
+ * Like 'memory_content', a copy of a shadow memory is copy-on-write: it shares the page table and all pages with
+ * the original until either of them stores a label.
+ */
+struct shadow_memory
+{
+    shadow_memory() : m_pages() {}
+
+    bool  empty() const noexcept { return !m_pages.operator bool() || m_pages->empty(); }
+
+    taint_label  label(address const  adr) const;
+    taint_label  set_label(address const  adr, taint_label const  label); //!< It returns the label the byte had before.
+
+    /**
+     * It returns true, if no byte in the range [begin,begin+num_bytes) has a non-zero label.
+     */
+    bool  is_clean(address const  begin, natexe::size const  num_bytes) const;
+
+    /**
+     * It sets zero labels to all bytes in the range [begin,begin+num_bytes).
+     */
+    void  clear(address const  begin, natexe::size const  num_bytes);
+
+    /**
+     * It returns all bytes with a non-zero label sorted by their addresses.
+     */
+    std::map<address,taint_label>  labels() const;
+
+private:
+    using  page_table = std::unordered_map<address,std::shared_ptr<shadow_page> >;
+
+    page_table&  owned_pages();
+    static shadow_page&  owned_page(std::shared_ptr<shadow_page>&  ptr);
+
+    std::shared_ptr<page_table>  m_pages;   //!< It is nullptr until the first label is stored.
+};
+
+
+/**
+ * Labels of a thread forked from another thread refer to input impact values of that other thread (or of its own
+ * ancestors). Such an inherited label is turned into a label of the thread itself only when the thread reads it,
+ * see 'owner()' and 'set_link()'. So, the fork of a thread does not need to copy any label nor any shadow page.
+ * The table of labels is split into chunks shared by copy-on-write, so a change of a label copies only the chunk
+ * of the label.
+ *
+ * NOTE: It changes the input impacts recorded for the forked thread. An eager copy of the frontier at the fork
+ *       recorded a copy of the input impact value of each labelled byte. Now a value is copied only if the forked
+ *       thread reads the byte before overwriting it. The copy is still recorded under the node counter of the fork
+ *       (see 'fork_counter()'), but in the order of the reads. So, input impact links of the thread refer to copies
+ *       of the same values as before, only their indices under the node counter of the fork may differ.
+ */
 struct input_frontier_of_thread
 {
-    input_frontier_of_thread() : m_reg_impacts(), m_mem_impacts(), m_stream_impacts() {}
+    explicit input_frontier_of_thread(thread_id const  tid);
+
+    /**
+     * It creates the frontier of a thread 'tid' forked from the thread of the frontier 'parent' at the moment,
+     * when the node counter of the thread 'tid' was 'fork_counter'.
+     */
+    input_frontier_of_thread(input_frontier_of_thread const&  parent, thread_id const  tid, node_counter_type const  fork_counter);
 
-    std::unordered_map<address,input_impact_link> const&  reg_impacts() const noexcept { return m_reg_impacts; }
-    std::unordered_map<address,input_impact_link> const&  mem_impacts() const noexcept { return m_mem_impacts; }
-    std::unordered_map<std::pair<stream_id,address>,input_impact_link> const&  stream_impacts() const noexcept { return m_stream_impacts; }
+    thread_id  get_thread_id() const noexcept { return m_thread_id; }
+    node_counter_type  fork_counter() const noexcept { return m_fork_counter; }
 
-    void  on_reg_impact(address const  adr, input_impact_link const&  link);
-    void  on_mem_impact(address const  adr, input_impact_link const&  link);
-    void  on_stream_impact(stream_id const&  sid, address const  shift, input_impact_link const&  link);
+    std::map<address,input_impact_link>  reg_impacts() const { return impacts(m_reg); }
+    std::map<address,input_impact_link>  mem_impacts() const { return impacts(m_mem); }
+    std::map<std::pair<stream_id,address>,input_impact_link>  stream_impacts() const;
+    std::map<std::pair<stream_id,address>,taint_label>  stream_labels() const;
 
-    void  delete_reg_impact(address const  adr) { m_reg_impacts.erase(adr); }
-    void  delete_mem_impact(address const  adr) { m_mem_impacts.erase(adr); }
-    void  delete_stream_impact(stream_id const&  sid, address const  shift) { m_stream_impacts.erase({sid,shift}); }
+    void  on_reg_impact(address const  adr, input_impact_link const&  link) { store_label(m_reg,adr,use_label(link)); }
+    void  on_mem_impact(address const  adr, input_impact_link const&  link) { store_label(m_mem,adr,use_label(link)); }
+    void  on_stream_impact(stream_id const&  sid, address const  shift, input_impact_link const&  link) { store_label(m_streams[sid],shift,use_label(link)); }
 
-    input_impact_link const* find_in_reg(address const  adr) const;
-    input_impact_link const* find_in_mem(address const  adr) const;
+    void  delete_reg_impact(address const  adr) { store_label(m_reg,adr,0U); }
+    void  delete_mem_impact(address const  adr) { store_label(m_mem,adr,0U); }
+    void  delete_stream_impact(stream_id const&  sid, address const  shift);
+
+    void  delete_reg_impacts(address const  begin, natexe::size const  num_bytes) { clear_labels(m_reg,begin,num_bytes); }
+    void  delete_mem_impacts(address const  begin, natexe::size const  num_bytes) { clear_labels(m_mem,begin,num_bytes); }
+    void  delete_stream_impacts(stream_id const&  sid, address const  begin, natexe::size const  num_bytes);
+
+    input_impact_link const* find_in_reg(address const  adr) const { return find_link(m_reg.label(adr)); }
+    input_impact_link const* find_in_mem(address const  adr) const { return find_link(m_mem.label(adr)); }
     input_impact_link const* find_in_stream(stream_id const&  sid, address const  adr) const;
 
+    shadow_memory const&  reg_shadow() const noexcept { return m_reg; }
+    shadow_memory const&  mem_shadow() const noexcept { return m_mem; }
+    shadow_memory const*  find_stream_shadow(stream_id const&  sid) const;
+
+    input_impact_link const&  link(taint_label const  label) const { return info(label).link; }
+    input_impact_link const*  find_link(taint_label const  label) const { return label == 0U ? nullptr : &link(label); }
+    thread_id  owner(taint_label const  label) const { return info(label).owner; } //!< The thread whose input impact value the link refers to.
+    void  set_link(taint_label const  label, input_impact_link const&  link); //!< The thread of the frontier becomes the owner of the label.
+
+    natexe::size  num_labels() const noexcept { return m_labels.operator bool() ? m_labels->num_used : 0ULL; } //!< Labels stored in at least one byte.
+    natexe::size  capacity_of_labels() const noexcept { return m_labels.operator bool() ? m_labels->size : 0ULL; } //!< Including free labels.
+
 private:
-    std::unordered_map<address,input_impact_link>  m_reg_impacts;
-    std::unordered_map<address,input_impact_link>  m_mem_impacts;
-    std::unordered_map<std::pair<stream_id,address>,input_impact_link>  m_stream_impacts;
+    static natexe::size constexpr  label_chunk_size = 256ULL;
+
+    struct label_info
+    {
+        input_impact_link  link;    //!< For a free label it holds the next free label in 'link.first'.
+        thread_id  owner;
+        natexe::size  num_uses;     //!< The number of bytes having the label. Zero for a free label.
+    };
+
+    using  label_chunk = std::array<label_info,label_chunk_size>;
+
+    struct label_table
+    {
+        label_table() : chunks(), size(0ULL), first_free(0U), num_used(0ULL) {}
+
+        std::vector<std::shared_ptr<label_chunk> >  chunks; //!< The info of a label 'l' is at the index 'l-1' of the chunks.
+        natexe::size  size;                 //!< The number of created labels.
+        taint_label  first_free;            //!< The head of the list of free labels; zero for the empty list.
+        natexe::size  num_used;             //!< The number of labels, which are not free.
+    };
+
+    /**
+     * It returns the label of the link owned by the thread of the frontier with its number of uses incremented.
+     * A new label is created (or a free one is reused) only if no byte has the link yet.
+     */
+    taint_label  use_label(input_impact_link const&  link);
+    void  release_label(taint_label const  label);
+    void  store_label(shadow_memory&  shadow, address const  adr, taint_label const  label) { release_label(shadow.set_label(adr,label)); }
+    void  clear_labels(shadow_memory&  shadow, address const  begin, natexe::size const  num_bytes);
+
+    std::map<address,input_impact_link>  impacts(shadow_memory const&  shadow) const;
+    label_info const&  info(taint_label const  label) const;
+    label_info&  owned_info(taint_label const  label);   //!< It copies the shared chunk of the label (if it is shared).
+    label_table&  owned_labels();                       //!< It copies the shared table of chunks (if it is shared), but no chunk.
+
+    thread_id  m_thread_id;
+    node_counter_type  m_fork_counter;
+    std::shared_ptr<label_table>  m_labels;    //!< Shared with forked threads.
+    std::unordered_map<input_impact_link,taint_label>  m_own_labels;   //!< Labels owned by the thread indexed by their links.
+    shadow_memory  m_reg;
+    shadow_memory  m_mem;
+    std::unordered_map<stream_id,shadow_memory>  m_streams;
 };
 
-struct io_relation_location
+
+/**
+ * A contiguous range of bytes in the REG pool, MEM pool, or in a stream accessed by an instruction. A range of
+ * a stream refers to the stream id stored in 'stream_allocations' (stream ids are never removed from there).
+ * The bytes of a reversed range are enumerated from the last one to the first one.
+ */
+struct io_range
 {
-    io_relation_location(
-            bool const  is_in_reg_pool,
-            address const  shift_from_begin
-            );
-    io_relation_location(
-            stream_id const&  sid,
-            address const  shift_from_begin
-            );
+    io_range() : io_range(true,0ULL,0ULL) {}
+    io_range(bool const  is_in_reg_pool, address const  begin, natexe::size const  num_bytes)
+        : m_stream_id(nullptr), m_begin(begin), m_num_bytes(num_bytes), m_is_in_reg_pool(is_in_reg_pool), m_is_reversed(false)
+    {}
+    io_range(stream_id const&  sid, address const  begin, natexe::size const  num_bytes);
+
     bool  is_in_reg_pool() const noexcept { return !is_in_stream() && m_is_in_reg_pool; }
     bool  is_in_mem_pool() const noexcept { return !is_in_stream() && !m_is_in_reg_pool; }
-    bool  is_in_stream() const noexcept { return !m_stream_id.empty(); }
-    stream_id const&  stream() const noexcept { return m_stream_id; }
-    address  shift_from_begin() const noexcept { return m_shift; }
+    bool  is_in_stream() const noexcept { return m_stream_id != nullptr; }
+    stream_id const&  stream() const noexcept { return *m_stream_id; }
+    address  begin() const noexcept { return m_begin; }
+    natexe::size  num_bytes() const noexcept { return m_num_bytes; }
+    bool  is_reversed() const noexcept { return m_is_reversed; }
+
+    address  location(index const  i) const noexcept { return m_begin + (m_is_reversed ? m_num_bytes - 1ULL - i : i); } //!< Of i-th byte.
+
+    io_range  sub_range(index const  start, index const  end) const;
+    void  reverse() noexcept { m_is_reversed = !m_is_reversed; }
+
 private:
+    stream_id const*  m_stream_id;
+    address  m_begin;
+    natexe::size  m_num_bytes;
     bool  m_is_in_reg_pool;
-    stream_id  m_stream_id;
-    address  m_shift;
+    bool  m_is_reversed;
 };
 
-struct io_relation_value
+
+/**
+ * A small sequence of ranges. No instruction accesses more than 'capacity' ranges at once, so we avoid dynamic allocations.
+ */
+struct io_ranges
 {
-    io_relation_value(uint8_t const  value, io_relation_location const&  location) : m_value(value), m_location(location) {}
-    uint8_t  value() const noexcept { return m_value; }
-    io_relation_location const&  location() const noexcept { return m_location; }
+    static natexe::size constexpr  capacity = 4ULL;
+
+    io_ranges() : m_ranges(), m_size(0ULL) {}
+
+    bool  empty() const noexcept { return m_size == 0ULL; }
+    natexe::size  size() const noexcept { return m_size; }
+    io_range const&  at(index const  i) const { ASSUMPTION(i < m_size); return m_ranges[i]; }
+    io_range const*  begin() const noexcept { return m_ranges.data(); }
+    io_range const*  end() const noexcept { return m_ranges.data() + m_size; }
+
+    void  push_back(io_range const&  range) { ASSUMPTION(m_size < capacity); m_ranges[m_size++] = range; }
+    void  clear() noexcept { m_size = 0ULL; }
+    void  reverse() { ASSUMPTION(m_size == 1ULL); m_ranges[0].reverse(); }
+
 private:
-    uint8_t  m_value;
-    io_relation_location  m_location;
+    std::array<io_range,capacity>  m_ranges;
+    natexe::size  m_size;
 };
 
-using  io_relation = std::vector<std::pair<io_relation_value, std::vector<io_relation_location> > >;
+
+/**
+ * It describes how bytes written by an instruction depend on bytes read by the instruction. For the kind
+ * BYTE_TO_BYTE the i-th written byte depends on the i-th bytes of all the read ranges. For the kind ALL_TO_BYTE
+ * each written byte depends on all bytes of all the read ranges. An instruction may produce several rules;
+ * they are applied in the order they were produced. Values of the written bytes are not stored; they are read
+ * from the pools and streams after the instruction is executed.
+ */
+struct io_relation_rule
+{
+    enum struct KIND : uint8_t
+    {
+        BYTE_TO_BYTE    = 0U,
+        ALL_TO_BYTE     = 1U,
+    };
+
+    io_relation_rule(KIND const  kind_, io_range const&  written_, io_ranges const&  read_)
+        : kind(kind_), written(written_), read(read_)
+    {}
+
+    KIND  kind;
+    io_range  written;
+    io_ranges  read;
+};
+
+using  io_relation = std::vector<io_relation_rule>;
 
 
 
@@ -475,6 +824,12 @@ struct execution_properties
             uint64_t const  temporaries_begin
             );
 
+    /**
+     * It creates properties of the execution 'eid', which continues from the state 'origin' of another execution.
+     * Pages of REG and MEM pools and of shadow memories are shared with 'origin' until they are written to.
+     */
+    execution_properties(execution_properties const&  origin, execution_id const  eid);
+
     execution_id  get_execution_id() const noexcept { return m_execution_id; }
 
     memory_allocations const&  mem_allocations() const noexcept { return m_mem_allocations; }
@@ -498,7 +853,8 @@ struct execution_properties
     uint64_t temporaries_begin() const noexcept { return m_temporaries_begin; }
 
     std::unordered_map<thread_id,input_frontier_of_thread> const&  input_frontier_of_threads() const  noexcept { return m_input_frontier_of_threads; }
-    input_frontier_of_thread&  input_frontier(thread_id const  tid) { return m_input_frontier_of_threads[tid]; }
+    input_frontier_of_thread&  input_frontier(thread_id const  tid);
+    input_frontier_of_thread&  fork_input_frontier(thread_id const  parent_tid, thread_id const  tid, node_counter_type const  fork_counter);
     input_frontier_of_thread const&  input_frontier(thread_id const  tid) const { return m_input_frontier_of_threads.at(tid); }
 
 private:
@@ -567,9 +923,6 @@ private:
 };
 
 
-using  mem_access_set = std::set<address>;
-
-
 /**
  * Threads share MEM pool and streams. This data structure holds all this common data
  * necessary for performing execution steps of threads. This also include data for
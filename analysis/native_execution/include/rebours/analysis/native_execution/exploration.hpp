@@ -6,6 +6,7 @@
 #   include <string>
 #   include <vector>
 #   include <unordered_map>
+#   include <unordered_set>
 #   include <utility>
 #   include <cstdint>
 
@@ -14,7 +15,9 @@ namespace analysis { namespace natexe {
 
 std::string  merge_recovered_traces(microcode::program&  program, recovery_properties&  rprops);
 
-std::string  choose_next_unexplored_exit(microcode::program const&  program, recovery_properties const&  rprops, node_id&  exit);
+std::string  choose_next_unexplored_exit(microcode::program const&  program, recovery_properties const&  rprops, node_id&  exit,
+                                         std::unordered_set<node_id> const&  excluded = {} //!< Exits already chosen for executions performed in parallel.
+                                         );
 
 std::string  find_next_goal_from_unexplored_exit(microcode::program const&  program, recovery_properties const&  rprops, node_id const  exit, edge_id&  next_goal);
 
@@ -0,0 +1,59 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_MEM_ACCESS_SET_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_MEM_ACCESS_SET_HPP_INCLUDED
+
+#   include <unordered_map>
+#   include <vector>
+#   include <array>
+#   include <utility>
+#   include <cstdint>
+
+namespace analysis { namespace natexe {
+
+
+/**
+ * A set of addresses of bytes accessed by threads in a single execution step. Instructions access contiguous
+ * ranges of bytes, so the set is a sorted vector of disjoint and non-adjacent ranges. An access of 8 bytes is
+ * thus a single range (usually merged with a previous one), and an intersection of two sets is a single pass
+ * over both vectors. When a set gets fragmented into more than 'max_num_ranges' ranges, it switches to bitmaps
+ * of pages, where the cost of both insertion and intersection does not grow with fragmentation.
+ */
+struct  mem_access_set
+{
+    using  range = std::pair<uint64_t,  //!< The first address in the range.
+                             uint64_t   //!< The last address in the range (i.e. the range is closed).
+                             >;
+
+    static uint64_t constexpr  max_num_ranges = 64ULL;
+    static uint64_t constexpr  page_size = 4096ULL;  //!< The number of bytes (i.e. bits) covered by a bitmap page.
+
+    using  page_bitmap = std::array<uint64_t,page_size / 64ULL>;
+
+    mem_access_set();
+
+    bool  empty() const noexcept { return m_ranges.empty() && m_pages.empty(); }
+    void  clear();
+
+    void  insert(uint64_t const  adr, uint64_t const  num_bytes = 1ULL);
+    void  insert(mem_access_set const&  other);
+
+    bool  contains(uint64_t const  adr) const;
+    bool  intersects(mem_access_set const&  other) const;
+
+    bool  uses_bitmaps() const noexcept { return m_uses_bitmaps; }
+    std::vector<range> const&  ranges() const noexcept { return m_ranges; } //!< Valid only when bitmaps are not used.
+
+private:
+    void  insert_range(uint64_t  first, uint64_t  last);
+    void  insert_range_to_bitmaps(uint64_t  first, uint64_t const  last);
+    bool  bitmaps_intersect_range(uint64_t const  first, uint64_t const  last) const;
+    void  switch_to_bitmaps();
+
+    std::vector<range>  m_ranges;
+    std::unordered_map<uint64_t,page_bitmap>  m_pages;  //!< Keys are addresses divided by 'page_size'.
+    bool  m_uses_bitmaps;
+};
+
+
+}}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_NATIVE_CODE_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_NATIVE_CODE_HPP_INCLUDED
+
+#   include <rebours/analysis/native_execution/execution_properties.hpp>
+#   include <rebours/program/program.hpp>
+#   include <rebours/program/decoded_instruction.hpp>
+#   include <vector>
+#   include <memory>
+#   include <utility>
+#   include <cstdint>
+
+namespace analysis { namespace natexe {
+
+
+struct  threaded_code;
+
+
+/**
+ * An optional tier of 'threaded_code' translating hot regions of a component into x86-64 machine code. It is available
+ * only on x86-64 Linux; elsewhere 'is_supported()' returns false and no region is ever compiled.
+ *
+ * Each execution of a record (i.e. of the out-going edge of its node) is counted. When a record becomes hot, a region
+ * starting at it is compiled: a chain of records with instructions working with registers only (see the function
+ * 'is_native_instruction'), optionally closed by a branching. When a successor of the branching is the first record of
+ * the region, the region is a loop, and the machine code iterates it till the other successor is taken. The machine code
+ * reads and writes bytes of the REG pool directly in dense pages of 'memory_content'. So, a region never contains an
+ * access to the MEM pool, to a stream, nor an exit of the component; the thread leaves the machine code right before
+ * them and the threaded code (or the graph walker) takes over. Instructions of a region cannot fail.
+ *
+ * The machine code does not maintain shadows of input impacts. Therefore, the thread enters a region only when none of
+ * registers accessed in the region has an input impact. Then the input impacts are not changed by the region. Records of
+ * steps (node histories, branchings, etc.) are produced by 'execution_run' after the machine code returns.
+ */
+struct  native_code
+{
+    static uint64_t constexpr  hot_threshold = 64ULL;   //!< The number of executions of a record making it hot.
+    static uint64_t constexpr  max_num_records_of_region = 64ULL;
+    static uint64_t constexpr  no_loop = ~0ULL;
+
+    /**
+     * The machine code of a region. It receives an array of pointers to data of dense pages of the REG pool (only those
+     * accessed in the region are valid) and the maximal number of passes through the region. It returns the number of
+     * performed passes shifted by one bit to the left together with the index of the successor of the last record taken
+     * in the last pass (in the lowest bit).
+     */
+    using  entry_function = uint64_t (*)(byte* const*, uint64_t);
+
+    struct  region
+    {
+        std::vector<uint64_t>  records;     //!< Indices of records in the threaded code. Only the last one may be a branching.
+        uint64_t  loop_successor;           //!< The successor of the last record leading to the first one, or 'no_loop'.
+        std::vector< std::pair<address,natexe::size> >  accessed_ranges;  //!< All ranges of registers read or written.
+        std::vector<address>  read_pages;       //!< Dense pages which are only read in the region.
+        std::vector<address>  written_pages;
+        entry_function  entry;
+        microcode::program_component const*  component;
+        uint64_t  version;  //!< The version of the component when the region was compiled.
+    };
+
+    static bool  is_supported() noexcept;
+
+    native_code();
+    ~native_code();
+
+    native_code(native_code const&) = delete;
+    native_code&  operator=(native_code const&) = delete;
+
+    /**
+     * It counts the execution of the passed record of the threaded code. It returns an up-to-date region starting at the
+     * record, when there is one, or when the record just became hot and a region was compiled for it. Otherwise it returns
+     * nullptr.
+     */
+    region const*  find_region(microcode::program const&  P, threaded_code&  code, uint64_t const  index);
+
+    /**
+     * It runs the machine code of the region in the passed REG pool. It returns the number of performed passes through
+     * the region and the index of the successor taken by the last record in the last pass is stored into 'k'. The returned
+     * number is zero, when the region cannot be entered, because some accessed register has an input impact.
+     */
+    uint64_t  run(region const&  R, memory_content&  reg, shadow_memory const&  reg_shadow, uint64_t const  max_num_passes, uint64_t&  k);
+
+    uint64_t  num_regions() const noexcept { return m_regions.size(); }
+    uint64_t  num_compilations() const noexcept { return m_num_compilations; }
+    uint64_t  num_refused_entries() const noexcept { return m_num_refused_entries; }
+
+private:
+    static uint64_t constexpr  no_region = ~0ULL;
+
+    struct  head
+    {
+        uint64_t  counter;
+        uint64_t  region;
+        microcode::program_component const*  refused_component; //!< The last compilation failed for this version of this
+        uint64_t  refused_version;                               //!< component, so it is not tried again till it changes.
+    };
+
+    bool  compile(microcode::program const&  P, threaded_code&  code, uint64_t const  index);
+
+    std::vector<head>  m_heads;     //!< Indexed by records of the threaded code.
+    std::vector< std::unique_ptr<region> >  m_regions;
+    std::vector< std::pair<void*,natexe::size> >  m_blocks;  //!< Executable memory of the regions.
+    memory_page const  m_uninitialised_page;  //!< It is read instead of a dense page, which was not created yet.
+    bool  m_is_enabled;     //!< It is false, when executable memory cannot be allocated.
+    uint64_t  m_num_compilations;
+    uint64_t  m_num_refused_entries;
+};
+
+
+/**
+ * It returns true, if the machine code of a region may contain the passed instruction.
+ */
+bool  is_native_instruction(microcode::decoded_instruction const&  I);
+
+
+}}
+
+#endif
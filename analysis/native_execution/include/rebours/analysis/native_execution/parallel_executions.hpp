@@ -0,0 +1,89 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_PARALLEL_EXECUTIONS_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_PARALLEL_EXECUTIONS_HPP_INCLUDED
+
+#   include <rebours/analysis/native_execution/execution_properties.hpp>
+#   include <rebours/analysis/native_execution/recovery_properties.hpp>
+#   include <rebours/analysis/native_execution/prologue_snapshot.hpp>
+#   include <rebours/analysis/native_execution/worker_pool.hpp>
+#   include <rebours/program/program.hpp>
+#   include <rebours/program/assembly.hpp>
+#   include <rebours/MAL/recogniser/recognise.hpp>
+#   include <unordered_set>
+#   include <string>
+#   include <vector>
+#   include <map>
+#   include <utility>
+#   include <cstdint>
+
+namespace analysis { namespace natexe {
+
+
+/**
+ * Differences of a component of a program against the same component in a copy of the program.
+ */
+struct  component_changes
+{
+    uint64_t  index;    //!< Index of the component in the program.
+    node_id  entry;
+    std::vector<node_id>  inserted_nodes;
+    std::vector<node_id>  erased_nodes;
+    std::vector< std::pair<edge_id,microcode::instruction> >  inserted_edges;
+    std::vector<edge_id>  erased_edges;
+};
+
+/**
+ * Code recovered during a native execution of a private copy of a program. Since copies preserve IDs of nodes
+ * and fresh IDs are unique across all threads, the changes can be applied to the original program.
+ */
+struct  program_changes
+{
+    std::vector<component_changes>  components;
+    std::vector<microcode::program_component_ptr>  new_components;
+    std::unordered_set<node_id>  modified_nodes;    //!< Nodes of the original program referenced by the changes.
+};
+
+program_changes  compute_program_changes(microcode::program const&  original, microcode::program&  modified);
+
+/**
+ * It applies the changes to the program, unless some of its modified nodes was already modified by changes applied
+ * before (those nodes are accumulated in 'modified_nodes'), or a new component has the same entry as a different
+ * component of the program. The function returns false in that case and the program is left untouched. The check
+ * is conservative; it refuses also changes which only insert an edge to a node extended by previously applied changes.
+ * A new component, which is already in the program (i.e. it is shared), is not inserted again.
+ */
+bool  apply_program_changes(program_changes const&  changes, microcode::program&  program, std::unordered_set<node_id>&  modified_nodes);
+
+
+/**
+ * It performs native executions of 'prologue' followed by 'program' for all passed execution properties in parallel,
+ * using the threads of the 'pool'. The execution properties must have consecutive IDs starting from the number of
+ * executions recorded in 'rprops'. Each execution runs on its own copy of 'program', 'annotations', and 'rprops', and
+ * its results are merged back into the shared data in the order of 'eprops' once all executions finish. So, the
+ * recovered program does not depend on the scheduling of the threads, except for values of fresh IDs of nodes
+ * and threads. When the recovered code of an
+ * execution conflicts with code merged from a preceding execution, the execution is not merged at all and its index
+ * into 'eprops' is appended to 'refused', so that it can be repeated later.
+ *
+ * The function returns error messages of the executions in the order of 'eprops'.
+ */
+std::vector<std::string>  perform_parallel_native_program_executions(
+                worker_pool&  pool,
+                recovery_properties&  rprops,   //!< Data about the whole program colleced during all preceeding native executions of the program.
+                std::vector<execution_properties>&  eprops,   //!< Data related to the individual executions to be performed.
+                microcode::program&  prologue,
+                microcode::program&  program,   //!< A program to be recovered from a binary file.
+                microcode::annotations&  annotations,
+                mal::recogniser::recognise_callback_fn const&  recognise,  //!< Calls to the callback are serialised.
+                std::vector<uint64_t>&  refused,
+                /// Next follow parameters related to generation of log files from the analysis.
+                std::string const&  logging_root_dir = "",
+                bool const  log_also_prologue_program = false,
+                mal::recogniser::recognition_result_dump_fn const&  dump_recognition_results = [](mal::recogniser::recognition_result const& , std::string const&) -> bool { return false; },
+                std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers = {},
+                prologue_snapshot_ptr const&  snapshot = nullptr  //!< The snapshot from which were forked those 'eprops' having final REG pools.
+                );
+
+
+}}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_PROLOGUE_SNAPSHOT_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_PROLOGUE_SNAPSHOT_HPP_INCLUDED
+
+#   include <rebours/analysis/native_execution/execution_properties.hpp>
+#   include <rebours/analysis/native_execution/recovery_properties.hpp>
+#   include <unordered_map>
+#   include <unordered_set>
+#   include <vector>
+#   include <memory>
+#   include <cstdint>
+
+namespace analysis { namespace natexe {
+
+
+/**
+ * The state of an execution right after the prologue program has terminated. The prologue allocates and fills in
+ * sections of the executable, opens streams, etc., and it does so equally in all executions, unless they differ in
+ * contents of streams read by the prologue. So, an execution whose input differs only in other streams can start
+ * from the snapshot (see 'fork' and 'restore_records') instead of executing the whole prologue again.
+ */
+struct  prologue_snapshot
+{
+    prologue_snapshot(execution_properties const&  eprops, recovery_properties const&  rprops);
+
+    execution_properties const&  eprops() const noexcept { return m_eprops; }
+    execution_records const&  records() const noexcept { return m_records; }
+    std::unordered_set<stream_id> const&  read_streams() const noexcept { return m_read_streams; } //!< Streams read by the prologue.
+
+    bool  can_fork(std::unordered_map<stream_id,std::vector<uint8_t> > const&  input_streams) const;
+
+    /**
+     * It returns properties of the execution 'eid' in the state of the snapshot, where contents of streams are
+     * replaced by the passed ones. The properties share all pages with the snapshot until they are written to.
+     */
+    execution_properties  fork(execution_id const  eid, std::unordered_map<stream_id,std::vector<uint8_t> > const&  input_streams) const;
+
+    /**
+     * It stores data which the prologue has recorded to 'rprops' as the first data of the execution 'eid'.
+     */
+    void  restore_records(recovery_properties&  rprops, execution_id const  eid) const;
+
+private:
+    execution_properties  m_eprops;
+    execution_records  m_records;
+    std::unordered_set<stream_id>  m_read_streams;
+};
+
+
+using  prologue_snapshot_ptr = std::shared_ptr<prologue_snapshot const>;
+
+
+}}
+
+#endif
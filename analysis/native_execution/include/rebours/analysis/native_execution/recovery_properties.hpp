@@ -3,6 +3,7 @@
 
 #   include <rebours/analysis/native_execution/execution_properties.hpp>
 #   include <rebours/analysis/native_execution/std_pair_hash.hpp>
+#   include <rebours/analysis/native_execution/trace_store.hpp>
 #   include <rebours/program/program.hpp>
 #   include <unordered_map>
 #   include <unordered_set>
@@ -20,6 +21,12 @@ namespace analysis { namespace natexe {
 struct  switch_info
 {
     explicit switch_info(node_id const  head_node);
+    switch_info(
+            node_id const  head_node,
+            node_id const  default_node,
+            std::unordered_map<address,node_id> const&  cases,
+            microcode::instruction const  havoc_instruction
+            );
 
     node_id  head_node() const noexcept { return m_head_node; }
     node_id  default_node() const noexcept { return m_default_node; }
@@ -64,7 +71,7 @@ using  important_code_ranges = std::map<uint64_t,   //!< End address.
                                         >;
 
 using  branchings_of_threads = std::unordered_map<thread_id,std::vector<node_counter_type> >;
-using  nodes_history_of_threads = std::unordered_map<thread_id,std::vector<node_id> >;
+using  nodes_history_of_threads = std::unordered_map<thread_id,compact_trace>;
 
 struct  input_impact_value
 {
@@ -106,6 +113,20 @@ private:
 using  input_impacts_of_threads = std::unordered_map<thread_id,std::vector<std::vector<input_impact_value> > >;
 using  input_impact_links_of_threads = std::unordered_map<thread_id,std::vector<std::unordered_set<input_impact_link> > >;
 
+/**
+ * All data which 'recovery_properties' hold for a single execution.
+ */
+struct  execution_records
+{
+    nodes_history_of_threads  node_histories;
+    std::vector<thread_id>  threads;
+    compact_trace  interleaving_of_threads;
+    std::vector<node_counter_type>  begins_of_concurrent_groups;
+    branchings_of_threads  branchings;
+    input_impacts_of_threads  input_impacts;
+    input_impact_links_of_threads  input_impact_links;
+};
+
 struct  recovery_properties
 {
     recovery_properties(
@@ -148,7 +169,7 @@ struct  recovery_properties
     bool  execution_has_thread(execution_id const  eid, thread_id const  tid) const;
 
     void  on_thread_step(execution_id const  eid, thread_id const  tid);
-    std::vector<thread_id> const&  interleaving_of_threads(execution_id const  eid) const;
+    compact_trace const&  interleaving_of_threads(execution_id const  eid) const;
 
     void  on_concurrent_group_begin(execution_id const  eid);
     std::vector<node_counter_type> const&  begins_of_concurrent_groups(execution_id const  eid) const;
@@ -172,6 +193,29 @@ struct  recovery_properties
     void  add_input_impact_links(execution_id const  eid, thread_id const  tid, std::vector<input_impact_link> const&  links)
     { return add_input_impact_links(eid,tid,links,node_couter(eid,tid)); }
 
+    execution_records  records_of_execution(execution_id const  eid) const;
+
+    /**
+     * It starts the execution 'eid' (which must be the next execution) with the passed records, e.g. with records
+     * of a part of another execution, which the execution 'eid' continues from.
+     */
+    void  set_records_of_execution(execution_id const  eid, execution_records const&  records);
+
+    /**
+     * It returns private properties for a single execution 'eid', which is performed in parallel with other executions.
+     * The result shares no data with this object. It gets copies of switches, unexplored exits, and visited branchings,
+     * but data of all preceeding executions are left empty. Insertions and erasures of unexplored exits are journaled
+     * in the result, so that they can later be replayed by 'merge_execution'.
+     */
+    recovery_properties  fork_execution(execution_id const  eid) const;
+
+    /**
+     * It moves data of the execution 'eid' from the forked properties 'other' to this object, where they become data
+     * of the execution 'num_executions_performed()'. Switches, unexplored exits, and visited branchings are merged as
+     * well. The function returns the ID under which the execution was merged.
+     */
+    execution_id  merge_execution(recovery_properties&  other, execution_id const  eid);
+
 private:
     uint64_t  m_heap_begin;
     uint64_t  m_heap_end;
@@ -183,12 +227,15 @@ private:
     std::unordered_map<node_id,unexplored_info>  m_unexplored;
     std::vector<nodes_history_of_threads>  m_node_histories;
     std::vector< std::vector<thread_id> >  m_threads_of_executions;
-    std::vector< std::vector<thread_id> >  m_interleaving_of_threads;
+    std::vector<compact_trace>  m_interleaving_of_threads;
     std::vector< std::vector<node_counter_type> >  m_begins_of_concurrent_groups;
     std::vector<branchings_of_threads>  m_branchings;
     std::unordered_set<edge_id>  m_visided_branchings;
     std::vector<input_impacts_of_threads>  m_input_impacts;
     std::vector<input_impact_links_of_threads>  m_input_impact_links;
+    bool  m_is_fork;
+    std::vector< std::pair<bool,    //!< True for insertion, false for erasure.
+                           unexplored_info> >  m_unexplored_journal;   //!< Used only in forked properties.
 };
 
 
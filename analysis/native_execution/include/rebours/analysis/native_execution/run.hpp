@@ -18,6 +18,8 @@ namespace analysis { namespace natexe {
  * This is the entry function to the whole analysis. It performs a series of native executions of the analysed
  * program until all code is recovered or a given timeout is exceeded. Each native execution is started on input
  * data computed from the information about program's behaviour collected during all preceeding executions.
+ * When 'num_workers' is greater than one, then up to 'num_workers' executions (each for input leading to a different
+ * unexplored exit) are performed in parallel and their results are merged in a deterministic order.
  */
 std::string  run(microcode::program&  prologue,
                  microcode::program&  program,  //!< A program to be recovered from a binary file.
@@ -50,11 +52,21 @@ std::string  run(microcode::program&  prologue,
                         //!< This callback only improves logging output. It is not used in the analysis itself. So, you
                         //!< can pass a function doing nothing (no logging). Also, it is used only if 'logging_root_dir'
                         //!< not empty.
-                 std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers = {}
+                 std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers = {},
                         //!< A map from ranges in REG pool to names of CPU registers mapped into the ranges. This map is used
                         //!< only for user-friendly output into log files. The map is not used in the analysis itself. So, you
                         //!< can pass empty map without affecting results of the analysis. Also it is used only if 'logging_root_dir'
                         //!< not empty.
+                 uint32_t const  num_workers = 1U,  //!< The maximal number of native executions performed in parallel.
+                 std::string const&  checkpoint_pathname = "",
+                        //!< A pathname of a file into which the state of the recovery is saved after the first round of
+                        //!< executions, then after rounds of executions, and at the end of the analysis (see 'checkpoint.hpp').
+                        //!< When the analysis times out, the file keeps the state of the last saved round. If the file exists
+                        //!< when the function is called, then the recovery resumes from the saved state, and 'program',
+                        //!< 'annotations', 'important_code' and 'unexplored_exits' are replaced by the saved ones. The empty
+                        //!< string disables checkpoints.
+                 uint32_t const  checkpoint_period_in_seconds = 0U  //!< The minimal time between two checkpoints. For 0 the state
+                                                                     //!< is saved after each round.
                  );
 
 
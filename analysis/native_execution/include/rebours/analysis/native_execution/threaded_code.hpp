@@ -0,0 +1,84 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_THREADED_CODE_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_THREADED_CODE_HPP_INCLUDED
+
+#   include <rebours/analysis/native_execution/execute_instruction.hpp>
+#   include <rebours/analysis/native_execution/native_code.hpp>
+#   include <rebours/program/program.hpp>
+#   include <rebours/program/decoded_instruction.hpp>
+#   include <unordered_map>
+#   include <vector>
+#   include <array>
+#   include <memory>
+#   include <cstdint>
+
+namespace analysis { namespace natexe {
+
+
+/**
+ * A compiled form of a program for a thread running alone (i.e. for a sequential execution). A node of a component is
+ * lowered (when it is reached for the first time) into a record holding the handler of the instruction on the out-going
+ * edge, the decoded instruction itself, and indices of records of successors. So, a step of the thread is a call of the
+ * handler and a jump to the next record, instead of a search for the component of the node, for its successors, and
+ * for the case of the switch on GIK. A record is lowered again, when its component was modified since (e.g. when
+ * the recogniser appended code to the component, or when a case was added to a switch).
+ *
+ * Only nodes with ordinary instructions and branchings are lowered. Exits of components, calls, creations of threads,
+ * and switches are left to the graph walker (i.e. to 'execution_step'). See the function 'execution_run'.
+ *
+ * When constructed with 'use_native_code' (and when supported on the platform), hot regions of records are further
+ * compiled into machine code. See 'native_code'.
+ */
+struct  threaded_code
+{
+    static uint64_t constexpr  no_record = ~0ULL;
+    static uint64_t constexpr  max_num_steps_of_run = 4096ULL;  //!< Callers of 'execution_run' check a timeout at least this often.
+
+    enum struct KIND : uint8_t
+    {
+        WALKER,         //!< The node is left to the graph walker.
+        INSTRUCTION,    //!< A single out-going edge with an instruction executed by the handler.
+        BRANCHING,      //!< Two out-going edges with guards. The first guard is in the record.
+    };
+
+    struct  record
+    {
+        KIND  kind;
+        node_id  node;
+        instruction_handler  handler;
+        microcode::decoded_instruction const*  instruction;
+        std::array<node_id,2ULL>  successors;
+        std::array<uint64_t,2ULL>  next;    //!< Indices of records of successors, or 'no_record' when not resolved yet.
+        microcode::program_component const*  component;
+        uint64_t  version;  //!< The version of the component when the record was lowered.
+    };
+
+    explicit threaded_code(bool const  use_native_code = false);
+
+    /**
+     * Both functions return the index of an up-to-date record. The latter one returns the record of the k-th successor
+     * of the node of the passed record.
+     */
+    uint64_t  find_record(microcode::program const&  P, node_id const  node);
+    uint64_t  successor_record(microcode::program const&  P, uint64_t const  index, uint64_t const  k);
+
+    record const&  at(uint64_t const  index) const { return m_records.at(index); }
+
+    uint64_t  num_records() const noexcept { return m_records.size(); }
+    uint64_t  num_lowerings() const noexcept { return m_num_lowerings; }
+
+    native_code*  native() const noexcept { return m_native.get(); } //!< It is nullptr, when the native tier is not used.
+
+private:
+    bool  is_up_to_date(record const&  r) const noexcept { return r.component->version() == r.version; }
+    void  lower(microcode::program const&  P, uint64_t const  index);
+
+    std::vector<record>  m_records;
+    std::unordered_map<node_id,uint64_t>  m_indices;
+    uint64_t  m_num_lowerings;
+    std::unique_ptr<native_code>  m_native;
+};
+
+
+}}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_TRACE_STORE_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_TRACE_STORE_HPP_INCLUDED
+
+#   include <initializer_list>
+#   include <iterator>
+#   include <vector>
+#   include <memory>
+#   include <cstddef>
+#   include <cstdint>
+
+namespace analysis { namespace natexe {
+
+
+struct  trace_chunk;
+
+
+/**
+ * A sequence of numbers (e.g. IDs of nodes visited by a thread), which can only grow at its end. Numbers are
+ * kept in chunks of 'chunk_size' elements. Only the last chunk is a plain vector; full chunks are sealed, i.e.
+ * their numbers are stored as differences of successive numbers packed into varints. So, a typical step takes
+ * a byte or two instead of eight. While the sealed chunks of all traces in the process do not exceed the budget
+ * (see 'set_trace_memory_budget'), they are kept in memory. Other chunks are spilled to a memory-mapped file,
+ * so that the OS pages them in only when they are accessed.
+ *
+ * Sealed chunks are immutable and shared between copies of a trace. Therefore, a copy of a trace is cheap and
+ * distinct traces can be used from distinct threads without synchronisation.
+ */
+struct  compact_trace
+{
+    using  value_type = uint64_t;
+
+    static uint64_t constexpr  chunk_size = 256ULL;
+    static uint64_t constexpr  checkpoint_stride = 16ULL;  //!< A sealed chunk remembers each such value and its position.
+
+    struct  const_iterator
+    {
+        using  iterator_category = std::forward_iterator_tag;
+        using  value_type = uint64_t;
+        using  difference_type = std::ptrdiff_t;
+        using  pointer = uint64_t const*;
+        using  reference = uint64_t const&;
+
+        const_iterator(compact_trace const* const  trace, uint64_t const  index);
+
+        uint64_t const&  operator*() const noexcept { return m_value; }
+        const_iterator&  operator++();
+        const_iterator  operator++(int) { const_iterator const  old = *this; ++*this; return old; }
+
+        bool  operator==(const_iterator const&  other) const noexcept { return m_index == other.m_index; }
+        bool  operator!=(const_iterator const&  other) const noexcept { return !(*this == other); }
+
+    private:
+        void  load_value();
+
+        compact_trace const*  m_trace;
+        uint64_t  m_index;
+        uint8_t const*  m_cursor;   //!< The next byte to decode, when 'm_index' points into a sealed chunk.
+        uint64_t  m_value;
+    };
+
+    compact_trace();
+    compact_trace(std::initializer_list<uint64_t> const  values);
+
+    uint64_t  size() const noexcept { return m_chunks.size() * chunk_size + m_tail.size(); }
+    bool  empty() const noexcept { return size() == 0ULL; }
+
+    void  push_back(uint64_t const  value);
+
+    /**
+     * Random access starts at the nearest preceding checkpoint of the chunk, so it decodes less than
+     * 'checkpoint_stride' numbers. Sequential access should use the iterators.
+     */
+    uint64_t  at(uint64_t const  index) const;
+    uint64_t  back() const;
+
+    const_iterator  begin() const { return const_iterator(this,0ULL); }
+    const_iterator  end() const { return const_iterator(this,size()); }
+
+    bool  operator==(compact_trace const&  other) const;
+    bool  operator!=(compact_trace const&  other) const { return !(*this == other); }
+
+private:
+    std::vector< std::shared_ptr<trace_chunk const> >  m_chunks;
+    std::vector<uint64_t>  m_tail;
+};
+
+
+/**
+ * The number of bytes of sealed chunks of all traces in the process, which may stay in memory. When the budget
+ * is exhausted, further sealed chunks are spilled into a temporary file. The space in the file is not reused,
+ * because traces of performed executions are kept until the end of the analysis. The default is 256MB.
+ */
+void  set_trace_memory_budget(uint64_t const  num_bytes);
+uint64_t  trace_memory_budget();
+
+uint64_t  num_bytes_of_traces_in_memory();  //!< Only sealed chunks are counted.
+uint64_t  num_bytes_of_traces_spilled();
+
+
+}}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_WORKER_POOL_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_WORKER_POOL_HPP_INCLUDED
+
+#   include <functional>
+#   include <thread>
+#   include <mutex>
+#   include <condition_variable>
+#   include <exception>
+#   include <vector>
+#   include <deque>
+#   include <cstdint>
+
+namespace analysis { namespace natexe {
+
+
+/**
+ * A fixed set of threads performing submitted tasks. Tasks are started in the order of their submission.
+ * The pool does not define any order in which the tasks finish. So, callers wanting deterministic results
+ * store results of tasks into slots prepared in advance and process them after 'wait()' returns.
+ */
+struct  worker_pool
+{
+    explicit worker_pool(uint32_t const  num_workers);
+    ~worker_pool();
+
+    worker_pool(worker_pool const& ) = delete;
+    worker_pool& operator=(worker_pool const& ) = delete;
+
+    uint32_t  num_workers() const noexcept { return (uint32_t)m_workers.size(); }
+
+    void  submit(std::function<void()> const&  task);
+
+    /**
+     * It blocks until all submitted tasks are finished. If some task has thrown an exception, then the first
+     * such exception is re-thrown here.
+     */
+    void  wait();
+
+private:
+    void  worker_loop();
+
+    std::vector<std::thread>  m_workers;
+    std::deque< std::function<void()> >  m_tasks;
+    uint64_t  m_num_running;
+    bool  m_stop;
+    std::exception_ptr  m_exception;
+    std::mutex  m_mutex;
+    std::condition_variable  m_task_ready;
+    std::condition_variable  m_all_done;
+};
+
+
+}}
+
+#endif
@@ -0,0 +1,503 @@
+#include <rebours/analysis/native_execution/checkpoint.hpp>
+#include <rebours/analysis/native_execution/msgstream.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+#include <rebours/program/binary.hpp>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+namespace analysis { namespace natexe { namespace detail {
+
+
+std::string const  checkpoint_magic = "REBOURS.NATEXE.CHECKPOINT";
+uint64_t const  checkpoint_version = 1ULL;
+
+
+using  microcode::write_varint;
+using  microcode::read_varint;
+
+
+uint64_t  compute_fingerprint(microcode::program const&  P)
+{
+    // It is the FNV-1a hash of the binary form of the program.
+    std::ostringstream  ostr;
+    microcode::save_program_as_binary(ostr,P,nullptr);
+    uint64_t  hash = 0xcbf29ce484222325ULL;
+    for (char const  c : ostr.str())
+    {
+        hash ^= (uint8_t)c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+template<typename map_type>
+std::vector<typename map_type::key_type>  sorted_keys(map_type const&  map)
+{
+    std::vector<typename map_type::key_type>  keys;
+    for (auto const&  key_value : map)
+        keys.push_back(key_value.first);
+    std::sort(keys.begin(),keys.end());
+    return keys;
+}
+
+/**
+ * Sequences of numbers are either vectors or compact traces; both are stored the same way.
+ */
+template<typename sequence_type>
+void  write_numbers(std::ostream&  ostr, sequence_type const&  numbers)
+{
+    write_varint(ostr,numbers.size());
+    for (uint64_t const  n : numbers)
+        write_varint(ostr,n);
+}
+
+template<typename sequence_type>
+bool  read_numbers(std::istream&  istr, sequence_type&  numbers)
+{
+    uint64_t  size;
+    if (!read_varint(istr,size))
+        return false;
+    numbers = sequence_type{};
+    for (uint64_t  i = 0ULL; i < size; ++i)
+    {
+        uint64_t  n;
+        if (!read_varint(istr,n))
+            return false;
+        numbers.push_back(n);
+    }
+    return true;
+}
+
+void  write_pair(std::ostream&  ostr, std::pair<uint64_t,uint64_t> const&  p)
+{
+    write_varint(ostr,p.first);
+    write_varint(ostr,p.second);
+}
+
+bool  read_pair(std::istream&  istr, std::pair<uint64_t,uint64_t>&  p)
+{
+    return read_varint(istr,p.first) && read_varint(istr,p.second);
+}
+
+template<typename sequence_type>
+void  write_numbers_of_threads(std::ostream&  ostr, std::unordered_map<thread_id,sequence_type> const&  numbers)
+{
+    write_varint(ostr,numbers.size());
+    for (thread_id const  tid : sorted_keys(numbers))
+    {
+        write_varint(ostr,tid);
+        write_numbers(ostr,numbers.at(tid));
+    }
+}
+
+template<typename sequence_type>
+bool  read_numbers_of_threads(std::istream&  istr, std::unordered_map<thread_id,sequence_type>&  numbers)
+{
+    uint64_t  size;
+    if (!read_varint(istr,size))
+        return false;
+    for (uint64_t  i = 0ULL; i < size; ++i)
+    {
+        thread_id  tid;
+        if (!read_varint(istr,tid) || !read_numbers(istr,numbers[tid]))
+            return false;
+    }
+    return true;
+}
+
+void  write_input_impact_value(std::ostream&  ostr, input_impact_value const&  value)
+{
+    ostr.put((char)value.value());
+    ostr.put(value.is_in_stream() ? 2 : value.is_in_reg_pool() ? 1 : 0);
+    if (value.is_in_stream())
+        microcode::write_string(ostr,value.stream());
+    write_varint(ostr,value.shift_from_begin());
+    write_varint(ostr,value.links().size());
+    for (input_impact_link const&  link : value.links())
+        write_pair(ostr,link);
+}
+
+bool  read_input_impact_value(std::istream&  istr, std::vector<input_impact_value>&  values)
+{
+    std::istream::int_type const  value = istr.get();
+    std::istream::int_type const  kind = istr.get();
+    if (value == std::istream::traits_type::eof() || kind < 0 || kind > 2)
+        return false;
+    stream_id  sid;
+    if (kind == 2 && (!microcode::read_string(istr,sid) || sid.size() < 2ULL))
+        return false;
+    address  shift;
+    uint64_t  num_links;
+    if (!read_varint(istr,shift) || !read_varint(istr,num_links))
+        return false;
+    std::vector<input_impact_link>  links;
+    for (uint64_t  i = 0ULL; i < num_links; ++i)
+    {
+        links.push_back({});
+        if (!read_pair(istr,links.back()))
+            return false;
+    }
+    if (kind == 2)
+        values.push_back({(uint8_t)value,sid,shift,links});
+    else
+        values.push_back({(uint8_t)value,kind == 1,shift,links});
+    return true;
+}
+
+void  write_execution_records(std::ostream&  ostr, execution_records const&  records)
+{
+    write_numbers_of_threads(ostr,records.node_histories);
+    write_numbers(ostr,records.threads);
+    write_numbers(ostr,records.interleaving_of_threads);
+    write_numbers(ostr,records.begins_of_concurrent_groups);
+    write_numbers_of_threads(ostr,records.branchings);
+
+    write_varint(ostr,records.input_impacts.size());
+    for (thread_id const  tid : sorted_keys(records.input_impacts))
+    {
+        write_varint(ostr,tid);
+        write_varint(ostr,records.input_impacts.at(tid).size());
+        for (std::vector<input_impact_value> const&  values : records.input_impacts.at(tid))
+        {
+            write_varint(ostr,values.size());
+            for (input_impact_value const&  value : values)
+                write_input_impact_value(ostr,value);
+        }
+    }
+
+    write_varint(ostr,records.input_impact_links.size());
+    for (thread_id const  tid : sorted_keys(records.input_impact_links))
+    {
+        write_varint(ostr,tid);
+        write_varint(ostr,records.input_impact_links.at(tid).size());
+        for (std::unordered_set<input_impact_link> const&  links : records.input_impact_links.at(tid))
+        {
+            std::vector<input_impact_link>  sorted(links.cbegin(),links.cend());
+            std::sort(sorted.begin(),sorted.end());
+            write_varint(ostr,sorted.size());
+            for (input_impact_link const&  link : sorted)
+                write_pair(ostr,link);
+        }
+    }
+}
+
+bool  read_execution_records(std::istream&  istr, execution_records&  records)
+{
+    if (!read_numbers_of_threads(istr,records.node_histories) ||
+            !read_numbers(istr,records.threads) ||
+            !read_numbers(istr,records.interleaving_of_threads) ||
+            !read_numbers(istr,records.begins_of_concurrent_groups) ||
+            !read_numbers_of_threads(istr,records.branchings))
+        return false;
+
+    uint64_t  num_threads;
+    if (!read_varint(istr,num_threads))
+        return false;
+    for (uint64_t  i = 0ULL; i < num_threads; ++i)
+    {
+        thread_id  tid;
+        uint64_t  num_counters;
+        if (!read_varint(istr,tid) || !read_varint(istr,num_counters))
+            return false;
+        std::vector<std::vector<input_impact_value> >&  values_of_counters = records.input_impacts[tid];
+        for (uint64_t  j = 0ULL; j < num_counters; ++j)
+        {
+            uint64_t  num_values;
+            if (!read_varint(istr,num_values))
+                return false;
+            values_of_counters.push_back({});
+            for (uint64_t  k = 0ULL; k < num_values; ++k)
+                if (!read_input_impact_value(istr,values_of_counters.back()))
+                    return false;
+        }
+    }
+
+    if (!read_varint(istr,num_threads))
+        return false;
+    for (uint64_t  i = 0ULL; i < num_threads; ++i)
+    {
+        thread_id  tid;
+        uint64_t  num_counters;
+        if (!read_varint(istr,tid) || !read_varint(istr,num_counters))
+            return false;
+        std::vector<std::unordered_set<input_impact_link> >&  links_of_counters = records.input_impact_links[tid];
+        for (uint64_t  j = 0ULL; j < num_counters; ++j)
+        {
+            uint64_t  num_links;
+            if (!read_varint(istr,num_links))
+                return false;
+            links_of_counters.push_back({});
+            for (uint64_t  k = 0ULL; k < num_links; ++k)
+            {
+                input_impact_link  link;
+                if (!read_pair(istr,link))
+                    return false;
+                links_of_counters.back().insert(link);
+            }
+        }
+    }
+    return true;
+}
+
+void  write_recovery_properties(std::ostream&  ostr, recovery_properties const&  rprops)
+{
+    write_varint(ostr,rprops.heap_begin());
+    write_varint(ostr,rprops.heap_end());
+    write_varint(ostr,rprops.temporaries_begin());
+
+    write_varint(ostr,rprops.important_code().size());
+    for (auto const&  end_begin : rprops.important_code())
+        write_pair(ostr,{ end_begin.second, end_begin.first });
+
+    write_varint(ostr,rprops.switches().size());
+    for (node_id const  head : sorted_keys(rprops.switches()))
+    {
+        switch_info const&  info = rprops.switches().at(head);
+        write_varint(ostr,head);
+        write_varint(ostr,info.default_node());
+        write_varint(ostr,info.cases().size());
+        for (address const  adr : sorted_keys(info.cases()))
+            write_pair(ostr,{ adr, info.cases().at(adr) });
+        ostr.put(info.havoc_instruction().operator bool() ? 1 : 0);
+        if (info.havoc_instruction().operator bool())
+        {
+            microcode::write_bytes(ostr,microcode::instruction_separators(info.havoc_instruction()));
+            microcode::write_bytes(ostr,microcode::instruction_data(info.havoc_instruction()));
+        }
+    }
+
+    write_varint(ostr,rprops.unexplored().size());
+    for (node_id const  node : sorted_keys(rprops.unexplored()))
+        write_pair(ostr,{ node, rprops.unexplored().at(node).IP() });
+
+    std::vector<edge_id>  visited(rprops.visited_branchings().cbegin(),rprops.visited_branchings().cend());
+    std::sort(visited.begin(),visited.end());
+    write_varint(ostr,visited.size());
+    for (edge_id const&  e : visited)
+        write_pair(ostr,e);
+
+    write_varint(ostr,rprops.num_executions_performed());
+    for (execution_id  eid = 0ULL; eid < rprops.num_executions_performed(); ++eid)
+        write_execution_records(ostr,rprops.records_of_execution(eid));
+}
+
+std::string  read_recovery_properties(std::istream&  istr, recovery_properties&  rprops)
+{
+    uint64_t  heap_begin, heap_end, temporaries_begin, num_ranges;
+    if (!read_varint(istr,heap_begin) || !read_varint(istr,heap_end) || !read_varint(istr,temporaries_begin) ||
+            heap_begin > heap_end || temporaries_begin < 8ULL || !read_varint(istr,num_ranges) || num_ranges == 0ULL)
+        return "Wrong header of recovery properties.";
+    std::map<uint64_t,uint64_t>  important_code;
+    for (uint64_t  i = 0ULL; i < num_ranges; ++i)
+    {
+        std::pair<uint64_t,uint64_t>  begin_end;
+        if (!read_pair(istr,begin_end) || begin_end.first > begin_end.second)
+            return "Wrong range of important code.";
+        important_code.insert(begin_end);
+    }
+    recovery_properties  loaded(heap_begin,heap_end,temporaries_begin,important_code,rprops.timeout_in_milliseconds());
+
+    uint64_t  num_switches;
+    if (!read_varint(istr,num_switches))
+        return "Wrong number of switches.";
+    for (uint64_t  i = 0ULL; i < num_switches; ++i)
+    {
+        node_id  head, default_node;
+        uint64_t  num_cases;
+        if (!read_varint(istr,head) || !read_varint(istr,default_node) || !read_varint(istr,num_cases) || loaded.has_switch(head))
+            return "Wrong switch.";
+        std::unordered_map<address,node_id>  cases;
+        for (uint64_t  j = 0ULL; j < num_cases; ++j)
+        {
+            std::pair<uint64_t,uint64_t>  adr_node;
+            if (!read_pair(istr,adr_node))
+                return "Wrong case of a switch.";
+            cases.insert(adr_node);
+        }
+        microcode::instruction  havoc;
+        std::istream::int_type const  has_havoc = istr.get();
+        if (has_havoc == 1)
+        {
+            std::vector<uint8_t>  separators, data;
+            if (!microcode::read_bytes(istr,separators) || !microcode::read_bytes(istr,data))
+                return "Wrong havoc instruction of a switch.";
+            havoc = microcode::create_instruction_from_representation(separators,data);
+            if (!havoc.operator bool() || havoc.GIK() != microcode::GIK::HAVOC__REG_ASGN_HAVOC)
+                return "Wrong havoc instruction of a switch.";
+        }
+        else if (has_havoc != 0)
+            return "Wrong havoc instruction of a switch.";
+        loaded.add_switch(head)->second = switch_info(head,default_node,cases,havoc);
+    }
+
+    uint64_t  num_unexplored;
+    if (!read_varint(istr,num_unexplored))
+        return "Wrong number of unexplored exits.";
+    for (uint64_t  i = 0ULL; i < num_unexplored; ++i)
+    {
+        std::pair<uint64_t,uint64_t>  node_ip;
+        if (!read_pair(istr,node_ip) || loaded.unexplored().count(node_ip.first) != 0ULL)
+            return "Wrong unexplored exit.";
+        loaded.add_unexplored_exits(node_ip.second,{ node_ip.first });
+    }
+
+    uint64_t  num_visited;
+    if (!read_varint(istr,num_visited))
+        return "Wrong number of visited branchings.";
+    for (uint64_t  i = 0ULL; i < num_visited; ++i)
+    {
+        edge_id  e;
+        if (!read_pair(istr,e))
+            return "Wrong visited branching.";
+        loaded.on_branching_visited(e);
+    }
+
+    uint64_t  num_executions;
+    if (!read_varint(istr,num_executions))
+        return "Wrong number of executions.";
+    for (execution_id  eid = 0ULL; eid < num_executions; ++eid)
+    {
+        execution_records  records;
+        if (!read_execution_records(istr,records) || records.threads.empty())
+            return msgstream() << "Wrong records of the execution " << eid << ".";
+        loaded.set_records_of_execution(eid,records);
+    }
+
+    rprops = loaded;
+    return "";
+}
+
+
+}}}
+
+namespace analysis { namespace natexe {
+
+
+std::string  save_checkpoint(std::ostream&  ostr,
+                             microcode::program const&  prologue,
+                             microcode::program const&  program,
+                             microcode::annotations const&  annotations,
+                             recovery_properties const&  rprops,
+                             input_streams_of_executions const&  pending_inputs)
+{
+    microcode::write_string(ostr,detail::checkpoint_magic);
+    microcode::write_varint(ostr,detail::checkpoint_version);
+    microcode::write_varint(ostr,detail::compute_fingerprint(prologue));
+    microcode::save_program_as_binary(ostr,program,&annotations);
+    detail::write_recovery_properties(ostr,rprops);
+
+    microcode::write_varint(ostr,pending_inputs.size());
+    for (auto const&  input_streams : pending_inputs)
+    {
+        microcode::write_varint(ostr,input_streams.size());
+        for (stream_id const&  sid : detail::sorted_keys(input_streams))
+        {
+            microcode::write_string(ostr,sid);
+            microcode::write_bytes(ostr,input_streams.at(sid));
+        }
+    }
+
+    return ostr.good() ? "" : "Writing of the checkpoint has failed.";
+}
+
+std::string  load_checkpoint(std::istream&  istr,
+                             microcode::program const&  prologue,
+                             std::unique_ptr<microcode::program>&  program,
+                             microcode::annotations&  annotations,
+                             recovery_properties&  rprops,
+                             input_streams_of_executions&  pending_inputs)
+{
+    std::string  magic;
+    uint64_t  version, fingerprint;
+    if (!microcode::read_string(istr,magic) || magic != detail::checkpoint_magic ||
+            !microcode::read_varint(istr,version) || version != detail::checkpoint_version)
+        return "The input is not a checkpoint of a supported version.";
+    if (!microcode::read_varint(istr,fingerprint) || fingerprint != detail::compute_fingerprint(prologue))
+        return "The checkpoint was created for a different prologue program.";
+
+    std::string  error_message;
+    std::pair<std::unique_ptr<microcode::program>,std::unique_ptr<microcode::annotations> >  loaded =
+            microcode::create_program_from_binary(istr,error_message);
+    if (!error_message.empty())
+        return error_message;
+
+    recovery_properties  loaded_rprops = rprops;
+    error_message = detail::read_recovery_properties(istr,loaded_rprops);
+    if (!error_message.empty())
+        return error_message;
+
+    input_streams_of_executions  loaded_inputs;
+    uint64_t  num_inputs;
+    if (!microcode::read_varint(istr,num_inputs))
+        return "Wrong number of pending inputs.";
+    for (uint64_t  i = 0ULL; i < num_inputs; ++i)
+    {
+        uint64_t  num_streams;
+        if (!microcode::read_varint(istr,num_streams))
+            return "Wrong pending input.";
+        loaded_inputs.push_back({});
+        for (uint64_t  j = 0ULL; j < num_streams; ++j)
+        {
+            stream_id  sid;
+            if (!microcode::read_string(istr,sid) || !microcode::read_bytes(istr,loaded_inputs.back()[sid]))
+                return "Wrong pending input.";
+        }
+    }
+
+    program = std::move(loaded.first);
+    annotations = std::move(*loaded.second);
+    rprops = loaded_rprops;
+    pending_inputs.swap(loaded_inputs);
+    return "";
+}
+
+std::string  save_checkpoint_file(std::string const&  pathname,
+                                  microcode::program const&  prologue,
+                                  microcode::program const&  program,
+                                  microcode::annotations const&  annotations,
+                                  recovery_properties const&  rprops,
+                                  input_streams_of_executions const&  pending_inputs)
+{
+    std::string const  temporary_pathname = pathname + ".tmp";
+    {
+        std::ofstream  ostr(temporary_pathname,std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!ostr.is_open())
+            return msgstream() << "Cannot open the checkpoint file '" << temporary_pathname << "'.";
+        std::string const  error_message = save_checkpoint(ostr,prologue,program,annotations,rprops,pending_inputs);
+        if (!error_message.empty())
+            return error_message;
+        ostr.flush();
+        if (!ostr.good())
+            return msgstream() << "Cannot write the checkpoint file '" << temporary_pathname << "'.";
+    }
+    if (std::rename(temporary_pathname.c_str(),pathname.c_str()) != 0)
+    {
+        // On some systems 'rename' does not replace an existing file.
+        std::remove(pathname.c_str());
+        if (std::rename(temporary_pathname.c_str(),pathname.c_str()) != 0)
+            return msgstream() << "Cannot rename the checkpoint file '" << temporary_pathname << "' to '" << pathname << "'.";
+    }
+    return "";
+}
+
+std::string  load_checkpoint_file(std::string const&  pathname,
+                                  microcode::program const&  prologue,
+                                  std::unique_ptr<microcode::program>&  program,
+                                  microcode::annotations&  annotations,
+                                  recovery_properties&  rprops,
+                                  input_streams_of_executions&  pending_inputs)
+{
+    std::ifstream  istr(pathname,std::ios_base::in | std::ios_base::binary);
+    if (!istr.is_open())
+        return msgstream() << "Cannot open the checkpoint file '" << pathname << "'.";
+    std::string const  error_message = load_checkpoint(istr,prologue,program,annotations,rprops,pending_inputs);
+    if (!error_message.empty())
+        return msgstream() << "Cannot load the checkpoint file '" << pathname << "': " << error_message;
+    return "";
+}
+
+
+}}
@@ -7,17 +7,18 @@
 namespace analysis { namespace natexe {
 
 
-std::string  choose_next_unexplored_exit(microcode::program const&  program, recovery_properties const&  rprops, node_id&  exit)
+std::string  choose_next_unexplored_exit(microcode::program const&  program, recovery_properties const&  rprops, node_id&  exit,
+                                         std::unordered_set<node_id> const&  excluded)
 {
     (void)program;
     for (auto const& u_i : rprops.unexplored())
-        if (is_inside_important_code(u_i.second.IP(),rprops.important_code()))
+        if (is_inside_important_code(u_i.second.IP(),rprops.important_code()) && excluded.count(u_i.first) == 0ULL)
         {
             exit = u_i.first;
             return "";
         }
     for (auto const& u_i : rprops.unexplored())
-        if (!is_inside_important_code(u_i.second.IP(),rprops.important_code()))
+        if (!is_inside_important_code(u_i.second.IP(),rprops.important_code()) && excluded.count(u_i.first) == 0ULL)
         {
             exit = u_i.first;
             return "";
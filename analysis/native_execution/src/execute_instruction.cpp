@@ -5,137 +5,74 @@
 #include <rebours/analysis/native_execution/development.hpp>
 #include <rebours/analysis/native_execution/msgstream.hpp>
 #include <type_traits>
-#include <sstream>
+#include <string>
 #include <limits>
 
 namespace analysis { namespace natexe { namespace {
 
 
-void  in_reg(std::vector<io_relation_location>&  reads, address const  shift_from_begin, uint8_t const  n)
+/**
+ * Numbers of streams are also their names in 'stream_allocations', prefixed by '#'.
+ */
+stream_id  stream_id_of_number(uint64_t const  number)
 {
-    for (uint8_t  i = 0U; i < n; ++i)
-        reads.push_back({ true, shift_from_begin + i });
+    return '#' + std::to_string(number);
 }
 
-void  in_mem(std::vector<io_relation_location>&  reads, address const  shift_from_begin, uint8_t const  n)
-{
-    for (uint8_t  i = 0U; i < n; ++i)
-        reads.push_back({ false, shift_from_begin + i });
-}
-
-void  in_stream(std::vector<io_relation_location>&  reads, stream_id const&  sid, address const  shift_from_begin, uint8_t const  n)
-{
-    for (uint8_t  i = 0U; i < n; ++i)
-        reads.push_back({ sid, shift_from_begin + i });
-}
-
-template<typename  T>
-void  in_reg(std::vector<io_relation_value>&  writes, T  value, address const  shift_from_begin, uint8_t const  n)
-{
-    static_assert(std::is_integral<T>::value,"We support only read of integral types.");
-    ASSUMPTION(sizeof(T) >= n);
-    byte*  ptr = reinterpret_cast<byte*>(&value);
-    if (is_this_little_endian_machine())
-        std::reverse(ptr,ptr + sizeof(value));
-    ptr += (sizeof(T) - n);
-    for (uint8_t  i = 0U; i < n; ++i)
-        writes.push_back({ *(ptr + i), { true, shift_from_begin + i } });
-}
-
-template<typename  T>
-void  in_mem(std::vector<io_relation_value>&  writes, T  value, address const  shift_from_begin, uint8_t const  n)
-{
-    static_assert(std::is_integral<T>::value,"We support only read of integral types.");
-    ASSUMPTION(sizeof(T) >= n);
-    byte*  ptr = reinterpret_cast<byte*>(&value);
-    if (is_this_little_endian_machine())
-        std::reverse(ptr,ptr + sizeof(value));
-    ptr += (sizeof(T) - n);
-    for (uint8_t  i = 0U; i < n; ++i)
-        writes.push_back({ *(ptr + i), { false, shift_from_begin + i } });
-}
-
-template<typename  T>
-void  in_stream(std::vector<io_relation_value>&  writes, T  value, stream_id const&  sid, address const  shift_from_begin, uint8_t const  n)
-{
-    static_assert(std::is_integral<T>::value,"We support only read of integral types.");
-    ASSUMPTION(sizeof(T) >= n);
-    byte*  ptr = reinterpret_cast<byte*>(&value);
-    if (is_this_little_endian_machine())
-        std::reverse(ptr,ptr + sizeof(value));
-    ptr += (sizeof(T) - n);
-    for (uint8_t  i = 0U; i < n; ++i)
-        writes.push_back({ *(ptr + i), { sid, shift_from_begin + i } });
-}
 
-void  in_reg(std::vector<io_relation_value>&  writes, uint128_t  value, address const  shift_from_begin, uint8_t const  n)
+void  in_reg(io_ranges&  ranges, address const  shift_from_begin, natexe::size const  n)
 {
-    ASSUMPTION(value.size() >= n);
-    byte*  ptr = value.data();
-    if (is_this_little_endian_machine())
-        std::reverse(ptr,ptr + sizeof(value));
-    ptr += (value.size() - n);
-    for (uint8_t  i = 0U; i < n; ++i)
-        writes.push_back({ *(ptr + i), { true, shift_from_begin + i } });
+    ranges.push_back({ true, shift_from_begin, n });
 }
 
-void  in_mem(std::vector<io_relation_value>&  writes, uint128_t  value, address const  shift_from_begin, uint8_t const  n)
+void  in_mem(io_ranges&  ranges, address const  shift_from_begin, natexe::size const  n)
 {
-    ASSUMPTION(value.size() >= n);
-    byte*  ptr = value.data();
-    if (is_this_little_endian_machine())
-        std::reverse(ptr,ptr + sizeof(value));
-    ptr += (value.size() - n);
-    for (uint8_t  i = 0U; i < n; ++i)
-        writes.push_back({ *(ptr + i), { false, shift_from_begin + i } });
+    ranges.push_back({ false, shift_from_begin, n });
 }
 
-void  in_stream(std::vector<io_relation_value>&  writes, uint128_t  value, stream_id const&  sid, address const  shift_from_begin, uint8_t const  n)
+void  in_stream(io_ranges&  ranges, stream_id const&  sid, address const  shift_from_begin, natexe::size const  n)
 {
-    ASSUMPTION(value.size() >= n);
-    byte*  ptr = value.data();
-    if (is_this_little_endian_machine())
-        std::reverse(ptr,ptr + sizeof(value));
-    ptr += (value.size() - n);
-    for (uint8_t  i = 0U; i < n; ++i)
-        writes.push_back({ *(ptr + i), { sid, shift_from_begin + i } });
+    ranges.push_back({ sid, shift_from_begin, n });
 }
 
 
-void  extend_1_to_1(io_relation&  ior,  std::vector<io_relation_location> const&  reads, std::vector<io_relation_value> const&  writes)
+void  extend_1_to_1(io_relation&  ior,  io_ranges const&  reads, io_ranges const&  writes)
 {
-    ASSUMPTION(reads.size() == writes.size());
-    for (index  i = 0ULL; i < reads.size(); ++i)
-        ior.push_back({writes.at(i),{reads.at(i)}});
+    ASSUMPTION(reads.size() == 1ULL && writes.size() == 1ULL && reads.at(0ULL).num_bytes() == writes.at(0ULL).num_bytes());
+    ior.push_back({io_relation_rule::KIND::BYTE_TO_BYTE,writes.at(0ULL),reads});
 }
 
-void  extend_1_to_1(io_relation&  ior,  std::vector<io_relation_location> const&  reads, std::vector<io_relation_value> const&  writes,
-                    index const  start, index const  end)
+/**
+ * Bytes [start,end) of the written range depend 1:1 on the bytes of the read range.
+ */
+void  extend_1_to_1(io_relation&  ior,  io_ranges const&  reads, io_ranges const&  writes, index const  start, index const  end)
 {
-    ASSUMPTION(reads.size() == writes.size() && start < end && end <= reads.size());
-    for (index  i = start; i < end; ++i)
-        ior.push_back({writes.at(i),{reads.at(i)}});
+    ASSUMPTION(reads.size() == 1ULL && writes.size() == 1ULL && reads.at(0ULL).num_bytes() == end - start);
+    ior.push_back({io_relation_rule::KIND::BYTE_TO_BYTE,writes.at(0ULL).sub_range(start,end),reads});
 }
 
-void  extend_1_to_2(io_relation&  ior,  std::vector<io_relation_location> const&  reads0, std::vector<io_relation_location> const&  reads1, std::vector<io_relation_value> const&  writes)
+void  extend_1_to_2(io_relation&  ior,  io_ranges const&  reads0, io_ranges const&  reads1, io_ranges const&  writes)
 {
-    ASSUMPTION(reads0.size() == writes.size() && reads1.size() == writes.size());
-    for (index  i = 0ULL; i < reads0.size(); ++i)
-        ior.push_back({writes.at(i),{reads0.at(i),reads1.at(i)}});
+    ASSUMPTION(reads0.size() == 1ULL && reads1.size() == 1ULL && writes.size() == 1ULL);
+    ASSUMPTION(reads0.at(0ULL).num_bytes() == writes.at(0ULL).num_bytes() && reads1.at(0ULL).num_bytes() == writes.at(0ULL).num_bytes());
+    io_ranges  reads = reads0;
+    reads.push_back(reads1.at(0ULL));
+    ior.push_back({io_relation_rule::KIND::BYTE_TO_BYTE,writes.at(0ULL),reads});
 }
 
-void  extend_1_to_n(io_relation&  ior,  std::vector<io_relation_location> const&  reads, std::vector<io_relation_value> const&  writes)
+void  extend_1_to_n(io_relation&  ior,  io_ranges const&  reads, io_ranges const&  writes)
 {
-    for (io_relation_value const&  value : writes)
-        ior.push_back({value,reads});
+    for (io_range const&  range : writes)
+        ior.push_back({io_relation_rule::KIND::ALL_TO_BYTE,range,reads});
 }
 
-void  extend_1_to_n(io_relation&  ior,  std::vector<io_relation_location> const&  reads, std::vector<io_relation_value> const&  writes,
-                    index const  start, index const  end)
+/**
+ * Bytes [start,end) of the written range depend on all the read bytes.
+ */
+void  extend_1_to_n(io_relation&  ior,  io_ranges const&  reads, io_ranges const&  writes, index const  start, index const  end)
 {
-    ASSUMPTION(start < end && end <= writes.size());
-    for (index  i = start; i < end; ++i)
-        ior.push_back({writes.at(i),reads});
+    ASSUMPTION(writes.size() == 1ULL);
+    ior.push_back({io_relation_rule::KIND::ALL_TO_BYTE,writes.at(0ULL).sub_range(start,end),reads});
 }
 
 
@@ -144,48 +81,110 @@ void  extend_1_to_n(io_relation&  ior,  std::vector<io_relation_location> const&
 namespace analysis { namespace natexe {
 
 
-std::string  execute_SETANDCOPY__REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx)
+std::string  execution_status::message() const
+{
+    switch (m_code)
+    {
+    case EXECUTION_STATUS::SUCCESS:
+        return "";
+    case EXECUTION_STATUS::STOPPED:
+        return "The execution was terminated by the 'STOP' instruction.";
+    case EXECUTION_STATUS::READ_BEHIND_END_OF_REG_POOL:
+        return "Attempt to read behing the end of REG pool.";
+    case EXECUTION_STATUS::WRITE_BEHIND_END_OF_REG_POOL:
+        return "Attempt to write behing the end of REG pool.";
+    case EXECUTION_STATUS::HAVOC_BEHIND_END_OF_REG_POOL:
+        return "Attempt to havoc-write behing the end of REG pool.";
+    case EXECUTION_STATUS::READ_FROM_NOT_ALLOCATED_MEMORY:
+        return "Attempt to read from a not allocated memory.";
+    case EXECUTION_STATUS::READ_FROM_NOT_READABLE_MEMORY:
+        return "Attempt to read from a not readable memory.";
+    case EXECUTION_STATUS::WRITE_INTO_NOT_ALLOCATED_MEMORY:
+        return "Attempt to write into a not allocated memory.";
+    case EXECUTION_STATUS::WRITE_INTO_NOT_WRITABLE_MEMORY:
+        return "Attempt to write into a not writable memory.";
+    case EXECUTION_STATUS::UNKNOWN_ENDIANNESS_OF_MEMORY:
+        return "Cannot determine endiannes of bytes in the MEM pool.";
+    case EXECUTION_STATUS::DIVISION_BY_ZERO:
+        return "Division by zero.";
+    case EXECUTION_STATUS::MODULO_BY_ZERO:
+        return "Division by zero (in modulo).";
+    case EXECUTION_STATUS::DATA_WRITE_IN_CONCURRENT_EXECUTION:
+        return "Execution of 'DATATRANSFER__DEREF_ADDRESS_ASGN_DATA' has failed, because there are running more than one thread.";
+    case EXECUTION_STATUS::STREAM_ALREADY_OPEN:
+        return msgstream() << "The stream '" << stream_id_of_number(m_operand) << "' is already open.";
+    case EXECUTION_STATUS::READ_FROM_NOT_OPEN_STREAM:
+        return msgstream() << "Cannot read a byte from the stream '" << stream_id_of_number(m_operand) << "'. The stream either "
+                              "does not exist or is not open.";
+    case EXECUTION_STATUS::READ_FROM_NOT_READABLE_STREAM:
+        return msgstream() << "Cannot read a byte from the stream '" << stream_id_of_number(m_operand) << "'. The stream is not "
+                              "readable.";
+    case EXECUTION_STATUS::INVALID_CURSOR_OF_STREAM:
+        return msgstream() << "Cannot read a byte from the stream '" << stream_id_of_number(m_operand) << "'. The cursor of the "
+                              "stream has invalid value.";
+    case EXECUTION_STATUS::WRITE_INTO_NOT_OPEN_STREAM:
+        return msgstream() << "Cannot write a byte to the stream '" << stream_id_of_number(m_operand) << "'. The stream either "
+                              "does not exist or is not open.";
+    case EXECUTION_STATUS::WRITE_INTO_NOT_WRITABLE_STREAM:
+        return msgstream() << "Cannot write a byte to the stream '" << stream_id_of_number(m_operand) << "'. The stream is not "
+                              "writable.";
+    case EXECUTION_STATUS::NOT_IMPLEMENTED_INSTRUCTION:
+        {
+            microcode::GIK const  gik = static_cast<microcode::GIK>(m_operand);
+            return msgstream() << "Attempt to execute not implemented instruction "
+                               << "GIK=" << (uint64_t)microcode::num(gik)
+                               << ", GID=" << (uint64_t)microcode::decompose(gik).first
+                               << ", SID=" << (uint64_t)microcode::decompose(gik).second
+                               << ".";
+        }
+    default:
+        UNREACHABLE();
+    }
+}
+
+
+execution_status  execute_SETANDCOPY__REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx)
 {
     memory_write(ctx.reg(),a,n,v);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,v,a,n);
+    io_ranges  writes;
+    in_reg(writes,a,n);
 
-    extend_1_to_n(ctx.ior(),{},writes);
+    extend_1_to_n(ctx.ior(),io_ranges(),writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_SETANDCOPY__REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_SETANDCOPY__REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     uint64_t const  value = memory_read<uint64_t>(ctx.reg(),a1,n);
     memory_write(ctx.reg(),a0,n,value);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,value,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_INDIRECTCOPY__REG_ASGN_REG_REG(uint8_t const  n0, uint8_t const  n1, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_INDIRECTCOPY__REG_ASGN_REG_REG(uint8_t const  n0, uint8_t const  n1, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     address const  src_adr = memory_read<address>(ctx.reg(),a1,n1);
     if (src_adr > std::numeric_limits<address>::max() - n0)
-        return msgstream() << "Attempt to read behing the end of REG pool.";
+        return EXECUTION_STATUS::READ_BEHIND_END_OF_REG_POOL;
     uint64_t const  value = memory_read<uint64_t>(ctx.reg(),src_adr,n0);
     memory_write(ctx.reg(),a0,n0,value);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,value,a0,n0);
+    io_ranges  writes;
+    in_reg(writes,a0,n0);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n1);
     extend_1_to_n(ctx.ior(),reads,writes);
     reads.clear();
@@ -193,22 +192,22 @@ std::string  execute_INDIRECTCOPY__REG_ASGN_REG_REG(uint8_t const  n0, uint8_t c
     extend_1_to_1(ctx.ior(),reads,writes);
 
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INDIRECTCOPY__REG_REG_ASGN_REG(uint8_t const  n0, uint8_t const  n1, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_INDIRECTCOPY__REG_REG_ASGN_REG(uint8_t const  n0, uint8_t const  n1, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     address const  dst_adr = memory_read<address>(ctx.reg(),a0,n1);
     if (dst_adr > std::numeric_limits<address>::max() - n0)
-        return msgstream() << "Attempt to write behing the end of REG pool.";
+        return EXECUTION_STATUS::WRITE_BEHIND_END_OF_REG_POOL;
     uint64_t const  value = memory_read<uint64_t>(ctx.reg(),a1,n0);
     ASSUMPTION(dst_adr > 7ULL);
     memory_write(ctx.reg(),dst_adr,n0,value);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,value,dst_adr,n0);
+    io_ranges  writes;
+    in_reg(writes,dst_adr,n0);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a0,n1);
     extend_1_to_n(ctx.ior(),reads,writes);
     reads.clear();
@@ -216,187 +215,180 @@ std::string  execute_INDIRECTCOPY__REG_REG_ASGN_REG(uint8_t const  n0, uint8_t c
     extend_1_to_1(ctx.ior(),reads,writes);
 
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_DATATRANSFER__REG_ASGN_DEREF_INV_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_DATATRANSFER__REG_ASGN_DEREF_INV_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     address const  src_adr = memory_read<address>(ctx.reg(),a1,(uint8_t)8U);
     memory_block_info  info = compute_memory_block_info(ctx.mem_allocations(),src_adr,n);
     if (info.allocated != BOOL3::YES)
-        return "Attempt to read from a not allocated memory.";
+        return EXECUTION_STATUS::READ_FROM_NOT_ALLOCATED_MEMORY;
     if (info.readable != BOOL3::YES)
-        return "Attempt to read from a not readable memory.";
+        return EXECUTION_STATUS::READ_FROM_NOT_READABLE_MEMORY;
     uint64_t const  value = memory_read<uint64_t>(ctx.mem(),src_adr,n,false);
     memory_write(ctx.reg(),a0,n,value);
-    for (uint8_t i = 0ULL; i < n; ++i)
-        ctx.r_d().insert(src_adr + i);
+    ctx.r_d().insert(src_adr,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,value,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,8U);
     extend_1_to_n(ctx.ior(),reads,writes);
     reads.clear();
     in_mem(reads,src_adr,n);
-    std::reverse(reads.begin(),reads.end());
+    reads.reverse();
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_DATATRANSFER__REG_ASGN_DEREF_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_DATATRANSFER__REG_ASGN_DEREF_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     address const  src_adr = memory_read<address>(ctx.reg(),a1,(uint8_t)8U);
     memory_block_info  info = compute_memory_block_info(ctx.mem_allocations(),src_adr,n);
     if (info.allocated != BOOL3::YES)
-        return "Attempt to read from a not allocated memory.";
+        return EXECUTION_STATUS::READ_FROM_NOT_ALLOCATED_MEMORY;
     if (info.readable != BOOL3::YES)
-        return "Attempt to read from a not readable memory.";
+        return EXECUTION_STATUS::READ_FROM_NOT_READABLE_MEMORY;
     uint64_t const  value = memory_read<uint64_t>(ctx.mem(),src_adr,n,true);
     memory_write(ctx.reg(),a0,n,value);
-    for (uint8_t i = 0ULL; i < n; ++i)
-        ctx.r_d().insert(src_adr + i);
+    ctx.r_d().insert(src_adr,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,value,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,8U);
     extend_1_to_n(ctx.ior(),reads,writes);
     reads.clear();
     in_mem(reads,src_adr,n);
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_DATATRANSFER__DEREF_REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_DATATRANSFER__DEREF_REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     address const  dst_adr = memory_read<address>(ctx.reg(),a0,(uint8_t)8U);
     memory_block_info  info = compute_memory_block_info(ctx.mem_allocations(),dst_adr,n);
     if (info.allocated != BOOL3::YES)
-        return "Attempt to write into a not allocated memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_ALLOCATED_MEMORY;
     if (info.writable != BOOL3::YES)
-        return "Attempt to write into a not writable memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_WRITABLE_MEMORY;
     uint64_t const  value = memory_read<uint64_t>(ctx.reg(),a1,n);
     memory_write(ctx.mem(),dst_adr,n,value);
-    for (uint8_t i = 0ULL; i < n; ++i)
-        ctx.w_d().insert(dst_adr + i);
+    ctx.w_d().insert(dst_adr,n);
 
-    std::vector<io_relation_value>  writes;
-    in_mem(writes,value,dst_adr,n);
+    io_ranges  writes;
+    in_mem(writes,dst_adr,n);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a0,8U);
     extend_1_to_n(ctx.ior(),reads,writes);
     reads.clear();
     in_reg(reads,a1,n);
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_DATATRANSFER__DEREF_INV_REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_DATATRANSFER__DEREF_INV_REG_ASGN_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     address const  dst_adr = memory_read<address>(ctx.reg(),a0,(uint8_t)8U);
     memory_block_info  info = compute_memory_block_info(ctx.mem_allocations(),dst_adr,n);
     if (info.allocated != BOOL3::YES)
-        return "Attempt to write into a not allocated memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_ALLOCATED_MEMORY;
     if (info.writable != BOOL3::YES)
-        return "Attempt to write into a not writable memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_WRITABLE_MEMORY;
     uint64_t const  value = memory_read<uint64_t>(ctx.reg(),a1,n);
     memory_write(ctx.mem(),dst_adr,n,value,false);
-    for (uint8_t i = 0ULL; i < n; ++i)
-        ctx.w_d().insert(dst_adr + i);
+    ctx.w_d().insert(dst_adr,n);
 
-    std::vector<io_relation_value>  writes;
-    in_mem(writes,value,dst_adr,n);
+    io_ranges  writes;
+    in_mem(writes,dst_adr,n);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a0,8U);
     extend_1_to_n(ctx.ior(),reads,writes);
     reads.clear();
     in_reg(reads,a1,n);
-    std::reverse(reads.begin(),reads.end());
+    reads.reverse();
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA(uint64_t const  a, uint8_t const*  begin, uint64_t const  num_bytes, execution_context&  ctx)
+execution_status  execute_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA(uint64_t const  a, uint8_t const*  begin, uint64_t const  num_bytes, execution_context&  ctx)
 {
     memory_block_info  info = compute_memory_block_info(ctx.mem_allocations(),a,num_bytes);
     if (info.allocated != BOOL3::YES)
-        return "Attempt to write into a not allocated memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_ALLOCATED_MEMORY;
     memory_write(ctx.mem(),a,begin,num_bytes);
     // We do not update 'ctx.w_d()', because this instruction assumes there is only one thread executed (i.e. it is a sequential execution).
 
-    std::vector<io_relation_value>  writes;
-    for (uint8_t const*  ptr = begin; ptr != begin + num_bytes; ++ptr)
-        in_mem(writes,*ptr,a,1U);
+    io_ranges  writes;
+    in_mem(writes,a,num_bytes);
 
-    extend_1_to_n(ctx.ior(),{},writes);
+    extend_1_to_n(ctx.ior(),io_ranges(),writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_DATATRANSFER__DEREF_REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx)
+execution_status  execute_DATATRANSFER__DEREF_REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx)
 {
     address const  dst_adr = memory_read<address>(ctx.reg(),a,(uint8_t)8U);
     memory_block_info  info = compute_memory_block_info(ctx.mem_allocations(),dst_adr,n);
     if (info.allocated != BOOL3::YES)
-        return "Attempt to write into a not allocated memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_ALLOCATED_MEMORY;
     if (info.writable != BOOL3::YES)
-        return "Attempt to write into a not writable memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_WRITABLE_MEMORY;
     if (info.in_big_endian == BOOL3::YES_AND_NO)
-        return "Cannot determine endiannes of bytes in the MEM pool.";
+        return EXECUTION_STATUS::UNKNOWN_ENDIANNESS_OF_MEMORY;
     memory_write(ctx.mem(),dst_adr,n,v);
-    for (uint8_t i = 0ULL; i < n; ++i)
-        ctx.w_d().insert(dst_adr + i);
+    ctx.w_d().insert(dst_adr,n);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a,8U);
 
-    std::vector<io_relation_value>  writes;
-    in_mem(writes,v,dst_adr,n);
+    io_ranges  writes;
+    in_mem(writes,dst_adr,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx)
+execution_status  execute_DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER(uint8_t const  n, uint64_t const  a, uint64_t const  v, execution_context&  ctx)
 {
     address const  dst_adr = memory_read<address>(ctx.reg(),a,(uint8_t)8U);
     memory_block_info  info = compute_memory_block_info(ctx.mem_allocations(),dst_adr,n);
     if (info.allocated != BOOL3::YES)
-        return "Attempt to write into a not allocated memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_ALLOCATED_MEMORY;
     if (info.writable != BOOL3::YES)
-        return "Attempt to write into a not writable memory.";
+        return EXECUTION_STATUS::WRITE_INTO_NOT_WRITABLE_MEMORY;
     if (info.in_big_endian == BOOL3::YES_AND_NO)
-        return "Cannot determine endiannes of bytes in the MEM pool.";
+        return EXECUTION_STATUS::UNKNOWN_ENDIANNESS_OF_MEMORY;
     memory_write(ctx.mem(),dst_adr,n,v,false);
-    for (uint8_t i = 0ULL; i < n; ++i)
-        ctx.w_d().insert(dst_adr + i);
+    ctx.w_d().insert(dst_adr,n);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a,8U);
 
-    std::vector<io_relation_value>  writes;
-    in_mem(writes,v,dst_adr,n);
+    io_ranges  writes;
+    in_mem(writes,dst_adr,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  value = memory_read<uint64_t>(ctx.reg(),a1,n);
@@ -412,32 +404,32 @@ std::string  execute_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG(uint8_t const  n, uin
         memory_write(ctx.reg(),a0,(uint8_t)(2U*n),value);
     }
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,value,a0+n,n);
+    io_ranges  writes;
+    in_reg(writes,a0+n,n);
 
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  value = memory_read<uint64_t>(ctx.reg(),a1,n);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
+    io_ranges  writes;
 
     if (n == 8U)
     {
         uint128_t  v(value,(value & 0x8000000000000000) != 0ULL ? 0xffffffffffffffffULL : 0ULL);
         memory_write(ctx.reg(),a0,v,true);
-        in_reg(writes,v,a0,sizeof(v));
+        in_reg(writes,a0,sizeof(v));
     }
     else
     {
@@ -450,17 +442,17 @@ std::string  execute_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG(uint8_t const  n, uin
         default: UNREACHABLE();
         }
         memory_write(ctx.reg(),a0,(uint8_t)(2U*n),result);
-        in_reg(writes,result,a0,2U*n);
+        in_reg(writes,a0,2U*n);
     }
 
     extend_1_to_n(ctx.ior(),reads,writes,0ULL,n);
     extend_1_to_1(ctx.ior(),reads,writes,n,2ULL*n);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC(uint64_t const  a0, uint64_t const  a1, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx)
+execution_status  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC(uint64_t const  a0, uint64_t const  a1, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     memory_block_info  info = compute_memory_block_info(ctx.mem_allocations(),a1,v1);
@@ -475,27 +467,27 @@ std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC(uint64_t const  a0, u
             } });
     memory_write(ctx.reg(),a0,output_value);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,output_value,a0,1U);
+    io_ranges  writes;
+    in_reg(writes,a0,1U);
 
-    extend_1_to_n(ctx.ior(),{},writes);
+    extend_1_to_n(ctx.ior(),io_ranges(),writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, uint64_t const  a3, execution_context&  ctx)
+execution_status  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, uint64_t const  a3, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint8_t const  rights = memory_read<uint8_t>(ctx.reg(),a1);
     uint64_t const  size = align_to_memory_page_size(memory_read<uint64_t>(ctx.reg(),a2));
     uint64_t const  hint_adr = align_to_memory_page_size(memory_read<uint64_t>(ctx.reg(),a3));
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,1U);
     in_reg(reads,a2,8U);
     in_reg(reads,a3,8U);
 
-    std::vector<io_relation_value>  writes;
+    io_ranges  writes;
 
     if (hint_adr >= ctx.heap_begin())
     {
@@ -511,9 +503,9 @@ std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(uint64_t const  a0, ui
                     (rights & 16U) != 0U,
                     } });
             memory_write(ctx.reg(),a0,hint_adr);
-            in_reg(writes,hint_adr,a0,8U);
+            in_reg(writes,a0,8U);
             extend_1_to_n(ctx.ior(),reads,writes);
-            return "";
+            return EXECUTION_STATUS::SUCCESS;
         }
     }
 
@@ -540,53 +532,51 @@ std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(uint64_t const  a0, ui
                     (rights & 16U) != 0U,
                     } });
             memory_write(ctx.reg(),a0,adr);
-            in_reg(writes,adr,a0,8U);
+            in_reg(writes,a0,8U);
             extend_1_to_n(ctx.ior(),reads,writes);
-            return "";
+            return EXECUTION_STATUS::SUCCESS;
         }
     }
 
     memory_write(ctx.reg(),a0,0ULL);
-    in_reg(writes,0ULL,a0,8U);
+    in_reg(writes,a0,8U);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_FREE(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_FREE(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  adr = memory_read<uint64_t>(ctx.reg(),a1);
     uint64_t const  size = align_to_memory_page_size(memory_read<uint64_t>(ctx.reg(),a2));
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,8ULL);
 
-    std::vector<io_relation_value>  writes;
+    io_ranges  writes;
 
     auto const  it = ctx.mem_allocations().find(adr);
     if (it == ctx.mem_allocations().cend() || it->second.num_bytes() != size)
     {
         memory_write(ctx.reg(),a0,(byte)0U);
-        in_reg(writes,0ULL,a0,1U);
+        in_reg(writes,a0,1U);
     }
     else
     {
-        memory_content::iterator  cit = ctx.mem().lower_bound(it->first);
-        while (cit != ctx.mem().end() && cit->first + cit->second.size() <= adr + size)
-            cit = ctx.mem().erase(cit);
+        ctx.mem().erase_pages(it->first,adr + size);
         ctx.mem_allocations().erase(it);
         memory_write(ctx.reg(),a0,(byte)1U);
-        in_reg(writes,1ULL,a0,1U);
+        in_reg(writes,a0,1U);
     }
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER(uint64_t const  a0, uint64_t const  a1, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx)
+execution_status  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER(uint64_t const  a0, uint64_t const  a1, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  adr = memory_read<uint64_t>(ctx.reg(),a1,(byte)8U);
@@ -599,72 +589,70 @@ std::string  execute_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER(uint
                          ? 0U : 1U ;
     memory_write(ctx.reg(),a0,result);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,8ULL);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,result,a0,1U);
+    io_ranges  writes;
+    in_reg(writes,a0,1U);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_HAVOC__REG_ASGN_HAVOC(uint64_t const  v, uint64_t const  a, execution_context&  ctx)
+execution_status  execute_HAVOC__REG_ASGN_HAVOC(uint64_t const  v, uint64_t const  a, execution_context&  ctx)
 {
     ASSUMPTION(a > 7ULL);
     memory_havoc(ctx.reg(),a,v);
 
-    std::vector<io_relation_value>  writes;
-    for (index  i = 0ULL; i < v; ++i)
-        in_reg(writes,default_havoc_value(),a+i,1U);
+    io_ranges  writes;
+    in_reg(writes,a,v);
 
-    extend_1_to_n(ctx.ior(),{},writes);
+    extend_1_to_n(ctx.ior(),io_ranges(),writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_HAVOC__REG_REG_ASGN_HAVOC(uint8_t const  n, uint64_t const  v, uint64_t const  a, execution_context&  ctx)
+execution_status  execute_HAVOC__REG_REG_ASGN_HAVOC(uint8_t const  n, uint64_t const  v, uint64_t const  a, execution_context&  ctx)
 {
     address const  strat_adr = memory_read<address>(ctx.reg(),a,n);
     if (strat_adr > std::numeric_limits<address>::max() - v)
-        return msgstream() << "Attempt to havoc-write behing the end of REG pool.";
+        return EXECUTION_STATUS::HAVOC_BEHIND_END_OF_REG_POOL;
     ASSUMPTION(strat_adr > 7ULL);
     memory_havoc(ctx.reg(),strat_adr,v);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a,n);
 
-    std::vector<io_relation_value>  writes;
-    for (index  i = 0ULL; i < v; ++i)
-        in_reg(writes,default_havoc_value(),strat_adr+i,1U);
+    io_ranges  writes;
+    in_reg(writes,strat_adr,v);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(n <= 8U);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
     uint64_t const  w = u + v;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint128_t const  v, execution_context&  ctx)
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint128_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     ASSUMPTION(n == 16U);
@@ -672,24 +660,24 @@ std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(uint8_t const
     uint128_t const  w = u + v;
     memory_write(ctx.reg(),a0,w,true);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
     in_reg(reads,a2,n);
 
-    std::vector<io_relation_value>  writes;
+    io_ranges  writes;
 
     if (n == 16U)
     {
@@ -698,7 +686,7 @@ std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(uint8_t const  n,
         uint128_t const  v = memory_read<uint128_t>(ctx.reg(),a2,true);
         uint128_t const  w = u + v;
         memory_write(ctx.reg(),a0,w,true);
-        in_reg(writes,w,a0,n);
+        in_reg(writes,a0,n);
     }
     else
     {
@@ -706,15 +694,15 @@ std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(uint8_t const  n,
         uint64_t const  v = memory_read<uint64_t>(ctx.reg(),a2,n);
         uint64_t const  w = u + v;
         memory_write(ctx.reg(),a0,n,w);
-        in_reg(writes,w,a0,n);
+        in_reg(writes,a0,n);
     }
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     ASSUMPTION(n <= 8U);
@@ -722,18 +710,18 @@ std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const
     uint64_t const  w = u * v;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint128_t const  v, execution_context&  ctx)
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint128_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     ASSUMPTION(n == 16U);
@@ -741,128 +729,128 @@ std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(uint8_t const
     uint128_t const  w = u * v;
     memory_write(ctx.reg(),a0,w,true);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
     in_reg(reads,a2,n);
 
-    std::vector<io_relation_value>  writes;
+    io_ranges  writes;
 
     if (n == 16U)
     {
         uint128_t const  u = memory_read<uint128_t>(ctx.reg(),a1,true);
         uint128_t const  v = memory_read<uint128_t>(ctx.reg(),a2,true);
         if (v == uint128_t(0ULL))
-            return "Division by zero.";
+            return EXECUTION_STATUS::DIVISION_BY_ZERO;
         uint128_t const  w = u / v;
         memory_write(ctx.reg(),a0,w,true);
-        in_reg(writes,w,a0,n);
+        in_reg(writes,a0,n);
     }
     else
     {
         uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
         uint64_t const  v = memory_read<uint64_t>(ctx.reg(),a2,n);
         if (v == 0ULL)
-            return "Division by zero.";
+            return EXECUTION_STATUS::DIVISION_BY_ZERO;
         uint64_t const  w = u / v;
         memory_write(ctx.reg(),a0,n,w);
-        in_reg(writes,w,a0,n);
+        in_reg(writes,a0,n);
     }
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
     in_reg(reads,a2,n);
 
-    std::vector<io_relation_value>  writes;
+    io_ranges  writes;
 
     if (n == 16U)
     {
         uint128_t const  u = memory_read<uint128_t>(ctx.reg(),a1,true);
         uint128_t const  v = memory_read<uint128_t>(ctx.reg(),a2,true);
         if (v == uint128_t(0ULL))
-            return "Division by zero (in modulo).";
+            return EXECUTION_STATUS::MODULO_BY_ZERO;
         uint128_t const  w = u % v;
         memory_write(ctx.reg(),a0,w,true);
-        in_reg(writes,w,a0,n);
+        in_reg(writes,a0,n);
     }
     else
     {
         uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
         uint64_t const  v = memory_read<uint64_t>(ctx.reg(),a2,n);
         if (v == 0ULL)
-            return "Division by zero (in modulo).";
+            return EXECUTION_STATUS::MODULO_BY_ZERO;
         uint64_t const  w = u % v;
         memory_write(ctx.reg(),a0,n,w);
-        in_reg(writes,w,a0,n);
+        in_reg(writes,a0,n);
     }
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
     byte const  w = (u == 0ULL) ? 1U : 0U;
     memory_write(ctx.reg(),a0,w);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,1U);
+    io_ranges  writes;
+    in_reg(writes,a0,1U);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
     uint64_t const  w = u & v;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_AND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_AND_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
@@ -870,39 +858,39 @@ std::string  execute_BITOPERATIONS__REG_ASGN_REG_AND_REG(uint8_t const  n, uint6
     uint64_t const  w = u & v;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads0;
+    io_ranges  reads0;
     in_reg(reads0,a1,n);
 
-    std::vector<io_relation_location>  reads1;
+    io_ranges  reads1;
     in_reg(reads1,a2,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_2(ctx.ior(),reads0,reads1,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
     uint64_t const  w = u | v;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_OR_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_OR_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
@@ -910,57 +898,57 @@ std::string  execute_BITOPERATIONS__REG_ASGN_REG_OR_REG(uint8_t const  n, uint64
     uint64_t const  w = u | v;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads0;
+    io_ranges  reads0;
     in_reg(reads0,a1,n);
 
-    std::vector<io_relation_location>  reads1;
+    io_ranges  reads1;
     in_reg(reads1,a2,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_2(ctx.ior(),reads0,reads1,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_NOT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_NOT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
     uint64_t const  w = ~u;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
     uint64_t const  w = u ^ v;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_XOR_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_XOR_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  u = memory_read<uint64_t>(ctx.reg(),a1,n);
@@ -968,39 +956,39 @@ std::string  execute_BITOPERATIONS__REG_ASGN_REG_XOR_REG(uint8_t const  n, uint6
     uint64_t const  w = u ^ v;
     memory_write(ctx.reg(),a0,n,w);
 
-    std::vector<io_relation_location>  reads0;
+    io_ranges  reads0;
     in_reg(reads0,a1,n);
 
-    std::vector<io_relation_location>  reads1;
+    io_ranges  reads1;
     in_reg(reads1,a2,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,w,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_2(ctx.ior(),reads0,reads1,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint8_t const  v, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint8_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t  u = memory_read<uint64_t>(ctx.reg(),a1,n);
     u = u >> v;
     memory_write(ctx.reg(),a0,n,u);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,u,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t  u = memory_read<uint64_t>(ctx.reg(),a1,n);
@@ -1008,37 +996,37 @@ std::string  execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG(uint8_t const  n, ui
     u = u >> v;
     memory_write(ctx.reg(),a0,n,u);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
     in_reg(reads,a2,1U);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,u,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint8_t const  v, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint8_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t  u = memory_read<uint64_t>(ctx.reg(),a1,n);
     u = u << v;
     memory_write(ctx.reg(),a0,n,u);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,u,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t  u = memory_read<uint64_t>(ctx.reg(),a1,n);
@@ -1046,31 +1034,26 @@ std::string  execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG(uint8_t const  n, ui
     u = u << v;
     memory_write(ctx.reg(),a0,n,u);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
     in_reg(reads,a2,1U);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,u,a0,n);
+    io_ranges  writes;
+    in_reg(writes,a0,n);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER(uint64_t const  a, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx)
+execution_status  execute_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER(uint64_t const  a, uint8_t const  v0, uint64_t const  v1, execution_context&  ctx)
 {
     ASSUMPTION(a > 7ULL);
-    std::string  stream_id;
-    {
-        std::stringstream  sstr;
-        sstr << '#' << v1;
-        stream_id = sstr.str();
-    }
+    std::string const  stream_id = stream_id_of_number(v1);
     stream_open_info&  info = ctx.stream_allocations()[stream_id];
     if (info.is_open())
-        return msgstream() << "The stream '" << stream_id << "' is already open.";
+        return { EXECUTION_STATUS::STREAM_ALREADY_OPEN, v1 };
     info.set_is_open(true);
     info.set_readable(v0 == 1U ? true : false);
     info.set_writable(v0 == 2U ? true : false);
@@ -1078,37 +1061,29 @@ std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER(uint64_t const  a,
     info.set_cursor(0ULL);
     memory_write(ctx.reg(),a,v1);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,v1,a,8U);
+    io_ranges  writes;
+    in_reg(writes,a,8U);
 
-    extend_1_to_n(ctx.ior(),{},writes);
+    extend_1_to_n(ctx.ior(),io_ranges(),writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER(uint64_t const  a, uint64_t const  v, execution_context&  ctx)
+execution_status  execute_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER(uint64_t const  a, uint64_t const  v, execution_context&  ctx)
 {
     ASSUMPTION(a > 7ULL);
-    std::string  stream_id;
-    {
-        std::stringstream  sstr;
-        sstr << '#' << v;
-        stream_id = sstr.str();
-    }
+    std::string const  stream_id = stream_id_of_number(v);
     auto const  it = ctx.stream_allocations().find(stream_id);
     if (it == ctx.stream_allocations().end() || !it->second.is_open())
-        return msgstream() << "Cannot read a byte from the stream '" << stream_id << "'. The stream either "
-                              "does not exist or is not open.";
+        return { EXECUTION_STATUS::READ_FROM_NOT_OPEN_STREAM, v };
     if (!it->second.readable())
-        return msgstream() << "Cannot read a byte from the stream '" << stream_id << "'. The stream is not "
-                              "readable.";
+        return { EXECUTION_STATUS::READ_FROM_NOT_READABLE_STREAM, v };
     if (it->second.cursor() >= it->second.size())
-        return msgstream() << "Cannot read a byte from the stream '" << stream_id << "'. The cursor of the "
-                              "stream has invalid value.";
+        return { EXECUTION_STATUS::INVALID_CURSOR_OF_STREAM, v };
     INVARIANT(ctx.contents_of_streams().count(stream_id) != 0ULL);
 
-    std::vector<io_relation_location>  reads;
-    in_stream(reads,stream_id,it->second.cursor(),1U);
+    io_ranges  reads;
+    in_stream(reads,it->first,it->second.cursor(),1U);
 
     byte  value;
     stream_read(ctx.contents_of_streams().at(stream_id),it->second.cursor(),&value,1ULL);
@@ -1116,39 +1091,32 @@ std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER(uint64_t const  a,
     INVARIANT(it->second.cursor() <= it->second.size());
     memory_write(ctx.reg(),a,value);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,value,a,1U);
+    io_ranges  writes;
+    in_reg(writes,a,1U);
 
     extend_1_to_1(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG(uint64_t const  a0, uint64_t const  v, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG(uint64_t const  a0, uint64_t const  v, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint8_t const  value_to_write = memory_read<uint8_t>(ctx.reg(),a1);
 
-    std::string  stream_id;
-    {
-        std::stringstream  sstr;
-        sstr << '#' << v;
-        stream_id = sstr.str();
-    }
+    std::string const  stream_id = stream_id_of_number(v);
     auto const  it = ctx.stream_allocations().find(stream_id);
     if (it == ctx.stream_allocations().end() || !it->second.is_open())
-        return msgstream() << "Cannot write a byte to the stream '" << stream_id << "'. The stream either "
-                              "does not exist or is not open.";
+        return { EXECUTION_STATUS::WRITE_INTO_NOT_OPEN_STREAM, v };
     if (!it->second.writable())
-        return msgstream() << "Cannot write a byte to the stream '" << stream_id << "'. The stream is not "
-                              "writable.";
+        return { EXECUTION_STATUS::WRITE_INTO_NOT_WRITABLE_STREAM, v };
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,1U);
 
-    std::vector<io_relation_value>  writes;
-    in_stream(writes,value_to_write,stream_id,it->second.cursor(),1U);
-    in_reg(writes,1U,a0,1U);
+    io_ranges  writes;
+    in_stream(writes,it->first,it->second.cursor(),1U);
+    in_reg(writes,a0,1U);
     extend_1_to_n(ctx.ior(),reads,writes);
 
     stream_write<uint8_t>(ctx.contents_of_streams()[stream_id],it->second.cursor(),value_to_write);
@@ -1158,36 +1126,29 @@ std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG(uint64_t cons
     INVARIANT(it->second.cursor() <= it->second.size());
     memory_write<uint8_t>(ctx.reg(),a0,(byte)1);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
-std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
+execution_status  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG(uint64_t const  a0, uint64_t const  a1, uint64_t const  a2, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t const  stream_number = memory_read<uint64_t>(ctx.reg(),a1);
     uint8_t const  value_to_write = memory_read<uint8_t>(ctx.reg(),a2);
 
-    std::string  stream_id;
-    {
-        std::stringstream  sstr;
-        sstr << '#' << stream_number;
-        stream_id = sstr.str();
-    }
+    std::string const  stream_id = stream_id_of_number(stream_number);
     auto const  it = ctx.stream_allocations().find(stream_id);
     if (it == ctx.stream_allocations().end() || !it->second.is_open())
-        return msgstream() << "Cannot write a byte to the stream '" << stream_id << "'. The stream either "
-                              "does not exist or is not open.";
+        return { EXECUTION_STATUS::WRITE_INTO_NOT_OPEN_STREAM, stream_number };
     if (!it->second.writable())
-        return msgstream() << "Cannot write a byte to the stream '" << stream_id << "'. The stream is not "
-                              "writable.";
+        return { EXECUTION_STATUS::WRITE_INTO_NOT_WRITABLE_STREAM, stream_number };
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,8U);
     in_reg(reads,a2,1U);
 
-    std::vector<io_relation_value>  writes;
-    in_stream(writes,value_to_write,stream_id,it->second.cursor(),1U);
-    in_reg(writes,1U,a0,1U);
+    io_ranges  writes;
+    in_stream(writes,it->first,it->second.cursor(),1U);
+    in_reg(writes,a0,1U);
     extend_1_to_n(ctx.ior(),reads,writes);
 
     stream_write<uint8_t>(ctx.contents_of_streams()[stream_id],it->second.cursor(),value_to_write);
@@ -1197,11 +1158,11 @@ std::string  execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG(uint64_t const
     INVARIANT(it->second.cursor() <= it->second.size());
     memory_write<uint8_t>(ctx.reg(),a0,(byte)1);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execute_MISCELLANEOUS__REG_ASGN_PARITY_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
+execution_status  execute_MISCELLANEOUS__REG_ASGN_PARITY_REG(uint8_t const  n, uint64_t const  a0, uint64_t const  a1, execution_context&  ctx)
 {
     ASSUMPTION(a0 > 7ULL);
     uint64_t  u = memory_read<uint64_t>(ctx.reg(),a1,n);
@@ -1215,135 +1176,314 @@ std::string  execute_MISCELLANEOUS__REG_ASGN_PARITY_REG(uint8_t const  n, uint64
     byte const  result = (count % 2U) == 0U ? 1U : 0U;
     memory_write(ctx.reg(),a0,result);
 
-    std::vector<io_relation_location>  reads;
+    io_ranges  reads;
     in_reg(reads,a1,n);
 
-    std::vector<io_relation_value>  writes;
-    in_reg(writes,result,a0,1U);
+    io_ranges  writes;
+    in_reg(writes,a0,1U);
 
     extend_1_to_n(ctx.ior(),reads,writes);
 
-    return "";
+    return EXECUTION_STATUS::SUCCESS;
 }
 
 
-std::string  execution_instruction(microcode::instruction const& I, execution_context&  ctx, bool const  is_sequential)
+}}
+
+namespace analysis { namespace natexe { namespace {
+
+
+execution_status  handle_SETANDCOPY__REG_ASGN_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
 {
-    switch (I.GIK())
-    {
-    case microcode::GIK::SETANDCOPY__REG_ASGN_NUMBER:
-        return execute_SETANDCOPY__REG_ASGN_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::SETANDCOPY__REG_ASGN_REG:
-        return execute_SETANDCOPY__REG_ASGN_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-
-    case microcode::GIK::INDIRECTCOPY__REG_ASGN_REG_REG:
-        return execute_INDIRECTCOPY__REG_ASGN_REG_REG(I.argument<uint8_t>(0ULL),I.argument<uint8_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::INDIRECTCOPY__REG_REG_ASGN_REG:
-        return execute_INDIRECTCOPY__REG_REG_ASGN_REG(I.argument<uint8_t>(0ULL),I.argument<uint8_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-
-    case microcode::GIK::DATATRANSFER__REG_ASGN_DEREF_INV_REG:
-        return execute_DATATRANSFER__REG_ASGN_DEREF_INV_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::DATATRANSFER__REG_ASGN_DEREF_REG:
-        return execute_DATATRANSFER__REG_ASGN_DEREF_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::DATATRANSFER__DEREF_REG_ASGN_REG:
-        return execute_DATATRANSFER__DEREF_REG_ASGN_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::DATATRANSFER__DEREF_INV_REG_ASGN_REG:
-        return execute_DATATRANSFER__DEREF_INV_REG_ASGN_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::DATATRANSFER__DEREF_ADDRESS_ASGN_DATA:
-        if (!is_sequential)
-            return "Execution of 'DATATRANSFER__DEREF_ADDRESS_ASGN_DATA' has failed, because there are running more than one thread.";
-        return execute_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA(I.argument<uint64_t>(0ULL),I.argument_begin(1ULL),I.num_arguments() - 1ULL,ctx);
-    case microcode::GIK::DATATRANSFER__DEREF_REG_ASGN_NUMBER:
-        return execute_DATATRANSFER__DEREF_REG_ASGN_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER:
-        return execute_DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-
-    case microcode::GIK::TYPECASTING__REG_ASGN_ZERO_EXTEND_REG:
-        return execute_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::TYPECASTING__REG_ASGN_SIGN_EXTEND_REG:
-        return execute_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-
-    case microcode::GIK::MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC:
-        return execute_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC(I.argument<uint64_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint8_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC:
-        return execute_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(I.argument<uint64_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::MEMORYMANAGEMENT__REG_ASGN_MEM_FREE:
-        return execute_MEMORYMANAGEMENT__REG_ASGN_MEM_FREE(I.argument<uint64_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER:
-        return execute_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER(I.argument<uint64_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint8_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-
-    case microcode::GIK::HAVOC__REG_ASGN_HAVOC:
-        return execute_HAVOC__REG_ASGN_HAVOC(I.argument<uint64_t>(0ULL),I.argument<uint64_t>(1ULL),ctx);
-    case microcode::GIK::HAVOC__REG_REG_ASGN_HAVOC:
-        return execute_HAVOC__REG_REG_ASGN_HAVOC(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-
-    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER:
-        if (I.argument<uint8_t>(0ULL) != 16U)
-            return execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-        else
-            return execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint128_t>(3ULL),ctx);
-    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG:
-        return execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER:
-        if (I.argument<uint8_t>(0ULL) != 16U)
-            return execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-        else
-            return execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint128_t>(3ULL),ctx);
-    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG:
-        return execute_INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG:
-        return execute_INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-
-    case microcode::GIK::ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO:
-        return execute_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_NUMBER:
-        return execute_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_REG:
-        return execute_BITOPERATIONS__REG_ASGN_REG_AND_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_NUMBER:
-        return execute_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_REG:
-        return execute_BITOPERATIONS__REG_ASGN_REG_OR_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_NOT_REG:
-        return execute_BITOPERATIONS__REG_ASGN_NOT_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER:
-        return execute_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_REG:
-        return execute_BITOPERATIONS__REG_ASGN_REG_XOR_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER:
-        return execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint8_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG:
-        return execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER:
-        return execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint8_t>(3ULL),ctx);
-    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG:
-        return execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),I.argument<uint64_t>(3ULL),ctx);
-
-    case microcode::GIK::INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER:
-        return execute_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER(I.argument<uint64_t>(0ULL),I.argument<uint8_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER:
-        return execute_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER(I.argument<uint64_t>(0ULL),I.argument<uint64_t>(1ULL),ctx);
-    case microcode::GIK::INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG:
-        return execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG(I.argument<uint64_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG:
-        return execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG(I.argument<uint64_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-
-    case microcode::GIK::MISCELLANEOUS__REG_ASGN_PARITY_REG:
-        return execute_MISCELLANEOUS__REG_ASGN_PARITY_REG(I.argument<uint8_t>(0ULL),I.argument<uint64_t>(1ULL),I.argument<uint64_t>(2ULL),ctx);
-    case microcode::GIK::MISCELLANEOUS__NOP:
-        return "";
-    case microcode::GIK::MISCELLANEOUS__STOP:
-        return "The execution was terminated by the 'STOP' instruction.";
+    return execute_SETANDCOPY__REG_ASGN_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
 
-    default:
-        return msgstream() << "Attempt to execute not implemented instruction "
-                           << "GIK=" << (uint64_t)microcode::num(I.GIK())
-                           << ", GID=" << (uint64_t)microcode::decompose(I.GIK()).first
-                           << ", SID=" << (uint64_t)microcode::decompose(I.GIK()).second
-                           << ".";
+execution_status  handle_SETANDCOPY__REG_ASGN_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_SETANDCOPY__REG_ASGN_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_INDIRECTCOPY__REG_ASGN_REG_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INDIRECTCOPY__REG_ASGN_REG_REG((uint8_t)I.arg(0ULL),(uint8_t)I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_INDIRECTCOPY__REG_REG_ASGN_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INDIRECTCOPY__REG_REG_ASGN_REG((uint8_t)I.arg(0ULL),(uint8_t)I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_DATATRANSFER__REG_ASGN_DEREF_INV_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_DATATRANSFER__REG_ASGN_DEREF_INV_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_DATATRANSFER__REG_ASGN_DEREF_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_DATATRANSFER__REG_ASGN_DEREF_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_DATATRANSFER__DEREF_REG_ASGN_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_DATATRANSFER__DEREF_REG_ASGN_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_DATATRANSFER__DEREF_INV_REG_ASGN_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_DATATRANSFER__DEREF_INV_REG_ASGN_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA(I.arg(0ULL),I.data_begin(),I.data_size(),ctx);
+}
+
+execution_status  handle_DATATRANSFER__DEREF_REG_ASGN_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_DATATRANSFER__DEREF_REG_ASGN_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC(I.arg(0ULL),I.arg(1ULL),(uint8_t)I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC(I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_MEMORYMANAGEMENT__REG_ASGN_MEM_FREE(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_MEMORYMANAGEMENT__REG_ASGN_MEM_FREE(I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER(I.arg(0ULL),I.arg(1ULL),(uint8_t)I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_HAVOC__REG_ASGN_HAVOC(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_HAVOC__REG_ASGN_HAVOC(I.arg(0ULL),I.arg(1ULL),ctx);
+}
+
+execution_status  handle_HAVOC__REG_REG_ASGN_HAVOC(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_HAVOC__REG_REG_ASGN_HAVOC((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    if ((uint8_t)I.arg(0ULL) != 16U)
+        return execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+    else
+        return execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.wide_arg(),ctx);
+}
+
+execution_status  handle_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    if ((uint8_t)I.arg(0ULL) != 16U)
+        return execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+    else
+        return execute_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.wide_arg(),ctx);
+}
+
+execution_status  handle_INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_AND_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_AND_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_OR_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_OR_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_NOT_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_NOT_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_XOR_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_XOR_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),(uint8_t)I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),(uint8_t)I.arg(3ULL),ctx);
+}
+
+execution_status  handle_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),I.arg(3ULL),ctx);
+}
+
+execution_status  handle_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER(I.arg(0ULL),(uint8_t)I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER(I.arg(0ULL),I.arg(1ULL),ctx);
+}
+
+execution_status  handle_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG(I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG(I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_MISCELLANEOUS__REG_ASGN_PARITY_REG(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    return execute_MISCELLANEOUS__REG_ASGN_PARITY_REG((uint8_t)I.arg(0ULL),I.arg(1ULL),I.arg(2ULL),ctx);
+}
+
+execution_status  handle_MISCELLANEOUS__NOP(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    (void)I;
+    (void)ctx;
+    return EXECUTION_STATUS::SUCCESS;
+}
+
+execution_status  handle_MISCELLANEOUS__STOP(microcode::decoded_instruction const&  I, execution_context&  ctx)
+{
+    (void)I;
+    (void)ctx;
+    return EXECUTION_STATUS::STOPPED;
+}
+
+
+}}}
+
+namespace analysis { namespace natexe {
+
+
+instruction_handler  find_instruction_handler(microcode::GIK const  gik)
+{
+    switch (gik)
+    {
+    case microcode::GIK::SETANDCOPY__REG_ASGN_NUMBER: return &handle_SETANDCOPY__REG_ASGN_NUMBER;
+    case microcode::GIK::SETANDCOPY__REG_ASGN_REG: return &handle_SETANDCOPY__REG_ASGN_REG;
+    case microcode::GIK::INDIRECTCOPY__REG_ASGN_REG_REG: return &handle_INDIRECTCOPY__REG_ASGN_REG_REG;
+    case microcode::GIK::INDIRECTCOPY__REG_REG_ASGN_REG: return &handle_INDIRECTCOPY__REG_REG_ASGN_REG;
+    case microcode::GIK::DATATRANSFER__REG_ASGN_DEREF_INV_REG: return &handle_DATATRANSFER__REG_ASGN_DEREF_INV_REG;
+    case microcode::GIK::DATATRANSFER__REG_ASGN_DEREF_REG: return &handle_DATATRANSFER__REG_ASGN_DEREF_REG;
+    case microcode::GIK::DATATRANSFER__DEREF_REG_ASGN_REG: return &handle_DATATRANSFER__DEREF_REG_ASGN_REG;
+    case microcode::GIK::DATATRANSFER__DEREF_INV_REG_ASGN_REG: return &handle_DATATRANSFER__DEREF_INV_REG_ASGN_REG;
+    case microcode::GIK::DATATRANSFER__DEREF_ADDRESS_ASGN_DATA: return &handle_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA;
+    case microcode::GIK::DATATRANSFER__DEREF_REG_ASGN_NUMBER: return &handle_DATATRANSFER__DEREF_REG_ASGN_NUMBER;
+    case microcode::GIK::DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER: return &handle_DATATRANSFER__DEREF_INV_REG_ASGN_NUMBER;
+    case microcode::GIK::TYPECASTING__REG_ASGN_ZERO_EXTEND_REG: return &handle_TYPECASTING__REG_ASGN_ZERO_EXTEND_REG;
+    case microcode::GIK::TYPECASTING__REG_ASGN_SIGN_EXTEND_REG: return &handle_TYPECASTING__REG_ASGN_SIGN_EXTEND_REG;
+    case microcode::GIK::MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC: return &handle_MEMORYMANAGEMENT__REG_ASGN_MEM_STATIC;
+    case microcode::GIK::MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC: return &handle_MEMORYMANAGEMENT__REG_ASGN_MEM_ALLOC;
+    case microcode::GIK::MEMORYMANAGEMENT__REG_ASGN_MEM_FREE: return &handle_MEMORYMANAGEMENT__REG_ASGN_MEM_FREE;
+    case microcode::GIK::MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER: return &handle_MEMORYMANAGEMENT__REG_ASGN_MEM_VALID_REG_NUMBER_NUMBER;
+    case microcode::GIK::HAVOC__REG_ASGN_HAVOC: return &handle_HAVOC__REG_ASGN_HAVOC;
+    case microcode::GIK::HAVOC__REG_REG_ASGN_HAVOC: return &handle_HAVOC__REG_REG_ASGN_HAVOC;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER: return &handle_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG: return &handle_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER: return &handle_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG: return &handle_INTEGERARITHMETICS__REG_ASGN_REG_DIVIDE_REG;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG: return &handle_INTEGERARITHMETICS__REG_ASGN_REG_MODULO_REG;
+    case microcode::GIK::ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO: return &handle_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_NUMBER: return &handle_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_REG: return &handle_BITOPERATIONS__REG_ASGN_REG_AND_REG;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_NUMBER: return &handle_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_REG: return &handle_BITOPERATIONS__REG_ASGN_REG_OR_REG;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_NOT_REG: return &handle_BITOPERATIONS__REG_ASGN_NOT_REG;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER: return &handle_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_REG: return &handle_BITOPERATIONS__REG_ASGN_REG_XOR_REG;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER: return &handle_BITOPERATIONS__REG_ASGN_REG_RSHIFT_NUMBER;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG: return &handle_BITOPERATIONS__REG_ASGN_REG_RSHIFT_REG;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER: return &handle_BITOPERATIONS__REG_ASGN_REG_LSHIFT_NUMBER;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG: return &handle_BITOPERATIONS__REG_ASGN_REG_LSHIFT_REG;
+    case microcode::GIK::INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER: return &handle_INPUTOUTPUT__REG_ASGN_STREAM_OPEN_NUMBER;
+    case microcode::GIK::INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER: return &handle_INPUTOUTPUT__REG_ASGN_STREAM_READ_NUMBER;
+    case microcode::GIK::INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG: return &handle_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_NUMBER_REG;
+    case microcode::GIK::INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG: return &handle_INPUTOUTPUT__REG_ASGN_STREAM_WRITE_REG_REG;
+    case microcode::GIK::MISCELLANEOUS__REG_ASGN_PARITY_REG: return &handle_MISCELLANEOUS__REG_ASGN_PARITY_REG;
+    case microcode::GIK::MISCELLANEOUS__NOP: return &handle_MISCELLANEOUS__NOP;
+    case microcode::GIK::MISCELLANEOUS__STOP: return &handle_MISCELLANEOUS__STOP;
+    default: return nullptr;
     }
 }
 
+execution_status  execution_instruction(microcode::decoded_instruction const& I, execution_context&  ctx, bool const  is_sequential)
+{
+    if (I.GIK() == microcode::GIK::DATATRANSFER__DEREF_ADDRESS_ASGN_DATA && !is_sequential)
+        return EXECUTION_STATUS::DATA_WRITE_IN_CONCURRENT_EXECUTION;
+    instruction_handler const  handler = find_instruction_handler(I.GIK());
+    if (handler == nullptr)
+        return { EXECUTION_STATUS::NOT_IMPLEMENTED_INSTRUCTION, microcode::num(I.GIK()) };
+    return handler(I,ctx);
+}
+
 
 }}
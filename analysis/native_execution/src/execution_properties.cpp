@@ -2,12 +2,13 @@
 #include <rebours/analysis/native_execution/invariants.hpp>
 #include <rebours/analysis/native_execution/assumptions.hpp>
 #include <rebours/analysis/native_execution/development.hpp>
+#include <algorithm>
 #include <limits>
-//#include <mutex>
+#include <mutex>
 
 namespace analysis { namespace natexe { namespace detail {
 
-//static std::mutex  thread_id_counter_mutex;
+static std::mutex  thread_id_counter_mutex;
 static thread_id  thread_id_counter = 0ULL;
 
 
@@ -18,7 +19,7 @@ namespace analysis { namespace natexe {
 
 thread_id  generate_fresh_thread_id()
 {
-    //std::lock_guard<std::mutex> const  lock(detail::thread_id_counter_mutex);
+    std::lock_guard<std::mutex> const  lock(detail::thread_id_counter_mutex);
     INVARIANT(detail::thread_id_counter != std::numeric_limits<thread_id>::max());
     return ++detail::thread_id_counter;
 }
@@ -41,11 +42,102 @@ memory_allocation_info::memory_allocation_info(
 {}
 
 
+memory_allocations::memory_allocations()
+    : m_blocks()
+    , m_pages_index()
+    , m_last_hit(~0ULL,false,{ BOOL3::NO, BOOL3::NO, BOOL3::NO, BOOL3::NO, BOOL3::YES_AND_NO, BOOL3::YES_AND_NO })
+{}
+
+std::pair<memory_allocations::const_iterator,bool>  memory_allocations::insert(value_type const&  adr_info)
+{
+    std::pair<const_iterator,bool> const  result = m_blocks.insert(adr_info);
+    if (result.second)
+        invalidate_pages(adr_info.first,adr_info.second.num_bytes());
+    return result;
+}
+
+memory_allocations::const_iterator  memory_allocations::erase(const_iterator const  it)
+{
+    ASSUMPTION(it != m_blocks.cend());
+    invalidate_pages(it->first,it->second.num_bytes());
+    return m_blocks.erase(it);
+}
+
+memory_block_info const*  memory_allocations::find_uniform_page_info(address const  page_begin) const
+{
+    ASSUMPTION(page_begin % memory_page_size == 0ULL);
+    if (m_last_hit.page_begin != page_begin)
+    {
+        auto  it = m_pages_index.find(page_begin);
+        if (it == m_pages_index.end())
+            it = m_pages_index.insert({page_begin,compute_page_info(page_begin)}).first;
+        m_last_hit = it->second;
+    }
+    return m_last_hit.is_uniform ? &m_last_hit.info : nullptr;
+}
+
+memory_allocations::page_info  memory_allocations::compute_page_info(address const  page_begin) const
+{
+    address const  page_end = page_begin + memory_page_size;
+
+    const_iterator  it = m_blocks.upper_bound(page_begin);
+    if (it != m_blocks.cbegin() && std::prev(it,1)->first + std::prev(it,1)->second.num_bytes() > page_begin)
+        --it;
+    if (it == m_blocks.cend() || it->first >= page_end)
+        return { page_begin, true, { BOOL3::NO, BOOL3::NO, BOOL3::NO, BOOL3::NO, BOOL3::YES_AND_NO, BOOL3::YES_AND_NO } };
+
+    memory_block_info const  info{it->second};
+    address  covered_end = page_begin;
+    for ( ; it != m_blocks.cend() && it->first < page_end; ++it)
+    {
+        if (it->first > covered_end ||
+            bool3(it->second.readable()) != info.readable ||
+            bool3(it->second.writable()) != info.writable ||
+            bool3(it->second.executable()) != info.executable ||
+            bool3(it->second.is_in_big_endian()) != info.in_big_endian ||
+            bool3(it->second.has_mutable_endian()) != info.has_mutable_endian)
+            return { page_begin, false, info };
+        covered_end = std::max(covered_end,it->first + it->second.num_bytes());
+        if (covered_end >= page_end)
+            return { page_begin, true, info };
+    }
+    return { page_begin, false, info };
+}
+
+void  memory_allocations::invalidate_pages(address const  begin, natexe::size const  num_bytes)
+{
+    m_last_hit.page_begin = ~0ULL;
+    if (num_bytes == 0ULL || m_pages_index.empty())
+        return;
+    address const  first_page = begin & ~(memory_page_size - 1ULL);
+    address const  last_page = (begin + (num_bytes - 1ULL)) & ~(memory_page_size - 1ULL);
+    if ((last_page - first_page) / memory_page_size < m_pages_index.size())
+        for (address  page_begin = first_page; page_begin <= last_page && page_begin >= first_page; page_begin += memory_page_size)
+            m_pages_index.erase(page_begin);
+    else
+        for (auto  it = m_pages_index.begin(); it != m_pages_index.end(); )
+            if (it->first >= first_page && it->first <= last_page)
+                it = m_pages_index.erase(it);
+            else
+                ++it;
+}
+
+
 memory_block_info  compute_memory_block_info(memory_allocations const&  alloc, address  begin, size const  num_bytes)
 {
     ASSUMPTION(begin <= std::numeric_limits<address>::max() - num_bytes);
     ASSUMPTION(num_bytes > 0ULL);
 
+    {
+        address const  page_begin = begin & ~(memory_page_size - 1ULL);
+        if (begin + num_bytes - page_begin <= memory_page_size)
+        {
+            memory_block_info const* const  page_info = alloc.find_uniform_page_info(page_begin);
+            if (page_info != nullptr)
+                return *page_info;
+        }
+    }
+
 //    memory_allocations::const_iterator  block_begin = alloc.lower_bound(begin);
 //    if (block_begin == alloc.cend() || block_begin->first > begin)
 //    {
@@ -86,6 +178,13 @@ memory_block_info  compute_memory_block_info(memory_allocations const&  alloc, a
         size const  block_rest = block_begin->first + block_begin->second.num_bytes() - begin;
         begin += block_rest;
     }
+    if (begin < end)    //!< The range continues behind the last allocated block.
+        return { BOOL3::YES_AND_NO,
+                 weaken_YES(info.readable),
+                 weaken_YES(info.writable),
+                 weaken_YES(info.executable),
+                 BOOL3::YES_AND_NO,
+                 BOOL3::YES_AND_NO };
 
     return info;
 }
@@ -101,7 +200,181 @@ uint64_t  align_to_memory_page_size(uint64_t const  value)
 memory_page::memory_page()
     : m_data()
 {
-    std::fill(data(),data()+size(),0xcdU);
+    std::fill(data(),data()+size(),default_uninitialised_value());
+}
+
+
+natexe::size constexpr  memory_content::num_dense_pages;
+natexe::size constexpr  memory_content::num_tlb_entries;
+address constexpr  memory_content::invalid_tlb_tag;
+
+memory_content::memory_content()
+    : m_table()
+    , m_tlb()
+{
+    invalidate_tlb();
+}
+
+memory_content::memory_content(memory_content const&  other)
+    : m_table(other.m_table)
+    , m_tlb()
+{
+    invalidate_tlb();
+    other.invalidate_tlb();     //!< Pages of the other content are now shared, so they are no longer owned by it.
+}
+
+memory_content::memory_content(memory_content&&  other)
+    : memory_content()
+{
+    swap(other);
+}
+
+memory_content&  memory_content::operator=(memory_content const&  other)
+{
+    if (this != &other)
+    {
+        memory_content  tmp(other);
+        swap(tmp);
+    }
+    return *this;
+}
+
+memory_content&  memory_content::operator=(memory_content&&  other)
+{
+    swap(other);
+    return *this;
+}
+
+memory_page const*  memory_content::find_page(address const  page_begin) const
+{
+    ASSUMPTION(page_begin % memory_page_size == 0ULL);
+    if (!m_table.operator bool())
+        return nullptr;
+    if (page_begin < num_dense_pages * memory_page_size)
+        return m_table->dense_pages[page_begin / memory_page_size].get();
+    tlb_entry&  entry = m_tlb[tlb_index(page_begin)];
+    if (entry.page_begin == page_begin)
+        return entry.page;
+    auto const  it = m_table->pages.find(page_begin);
+    if (it == m_table->pages.cend())
+        return nullptr;    //!< We do not cache misses, so the creation of a page need not look into the TLB.
+    entry.page_begin = page_begin;
+    entry.page = it->second.get();
+    entry.is_owned = false;     //!< We do not check it here; the first write through the entry will do that.
+    return entry.page;
+}
+
+memory_page&  memory_content::page(address const  page_begin)
+{
+    ASSUMPTION(page_begin % memory_page_size == 0ULL);
+    if (page_begin < num_dense_pages * memory_page_size)
+    {
+        page_table&  table = owned_table();
+        return owned_page(table.dense_pages[page_begin / memory_page_size],table.num_pages);
+    }
+    tlb_entry&  entry = m_tlb[tlb_index(page_begin)];
+    if (entry.page_begin == page_begin && entry.is_owned)
+        return *entry.page;
+    page_table&  table = owned_table();
+    memory_page&  result = owned_page(table.pages[page_begin],table.num_pages);
+    entry.page_begin = page_begin;
+    entry.page = &result;
+    entry.is_owned = true;
+    return result;
+}
+
+void  memory_content::erase_pages(address const  begin, address const  end)
+{
+    address const  first_page = align_to_memory_page_size(begin);
+    if (end < first_page + memory_page_size || empty())
+        return;
+    address const  last_page = end - memory_page_size;  //!< Pages starting in [first_page,last_page] lie completely in [begin,end).
+
+    page_table&  table = owned_table();
+
+    for (address  page_begin = first_page; page_begin < num_dense_pages * memory_page_size && page_begin <= last_page;
+         page_begin += memory_page_size)
+    {
+        std::shared_ptr<memory_page>&  ptr = table.dense_pages[page_begin / memory_page_size];
+        if (ptr.operator bool())
+        {
+            ptr.reset();
+            --table.num_pages;
+        }
+    }
+
+    if ((last_page - first_page) / memory_page_size < table.pages.size())
+        for (address  page_begin = first_page; page_begin <= last_page; page_begin += memory_page_size)
+            table.num_pages -= table.pages.erase(page_begin);
+    else
+        for (auto  it = table.pages.begin(); it != table.pages.end(); )
+            if (it->first >= first_page && it->first <= last_page)
+            {
+                it = table.pages.erase(it);
+                --table.num_pages;
+            }
+            else
+                ++it;
+
+    invalidate_tlb();
+}
+
+std::vector< std::pair<address,memory_page const*> >  memory_content::pages() const
+{
+    std::vector< std::pair<address,memory_page const*> >  result;
+    if (empty())
+        return result;
+    result.reserve(size());
+    for (natexe::size  i = 0ULL; i < num_dense_pages; ++i)
+        if (m_table->dense_pages.at(i).operator bool())
+            result.push_back({i * memory_page_size,m_table->dense_pages.at(i).get()});
+    for (auto const&  adr_page : m_table->pages)
+        result.push_back({adr_page.first,adr_page.second.get()});
+    std::sort(result.begin(),result.end(),
+              [](std::pair<address,memory_page const*> const&  left, std::pair<address,memory_page const*> const&  right) {
+                  return left.first < right.first;
+              });
+    return result;
+}
+
+void  memory_content::swap(memory_content&  other)
+{
+    m_table.swap(other.m_table);
+    m_tlb.swap(other.m_tlb);    //!< Cached pointers refer to pages, which were swapped as well.
+}
+
+memory_content::page_table&  memory_content::owned_table()
+{
+    if (!m_table.operator bool())
+        m_table = std::make_shared<page_table>();
+    else if (m_table.use_count() > 1L)
+    {
+        m_table = std::make_shared<page_table>(*m_table);
+        invalidate_tlb();
+    }
+    return *m_table;
+}
+
+memory_page&  memory_content::owned_page(std::shared_ptr<memory_page>&  ptr, natexe::size&  num_pages)
+{
+    if (!ptr.operator bool())
+    {
+        ptr = std::make_shared<memory_page>();
+        ++num_pages;
+    }
+    else if (ptr.use_count() > 1L)
+        ptr = std::make_shared<memory_page>(*ptr);
+    return *ptr;
+}
+
+void  memory_content::invalidate_tlb() const
+{
+    for (tlb_entry&  entry : m_tlb)
+    {
+        entry.page_begin = invalid_tlb_tag;
+        entry.page = nullptr;
+        entry.is_owned = false;
+    }
 }
 
 
@@ -113,16 +386,20 @@ void  memory_read(memory_content const&  content, address const  begin, byte* co
 
     while (num_output_bytes < num_bytes)
     {
-        size const  num_bytes_to_copy = std::min(memory_page_size,num_bytes - num_output_bytes);
-
-        memory_page&  page = const_cast<memory_content&>(content)[page_begin];  //!< The const_cast is used to automatically create
-                                                                                //!< a page with uninitialised data, if it is not in
-                                                                                //!< the map yet.
+        size const  num_bytes_to_copy = std::min(memory_page_size - page_offset, num_bytes - num_output_bytes);
 
+        INVARIANT(num_bytes_to_copy > 0ULL);
         INVARIANT(page_offset + num_bytes_to_copy <= memory_page_size);
-        std::copy(page.data() + page_offset,
-                  page.data() + page_offset + num_bytes_to_copy,
-                  data_begin + num_output_bytes);
+
+        memory_page const* const  page = content.find_page(page_begin);  //!< A missing page is NOT created.
+        if (page == nullptr)
+            std::fill(data_begin + num_output_bytes,
+                      data_begin + num_output_bytes + num_bytes_to_copy,
+                      default_uninitialised_value());
+        else
+            std::copy(page->data() + page_offset,
+                      page->data() + page_offset + num_bytes_to_copy,
+                      data_begin + num_output_bytes);
 
         page_begin += memory_page_size;
         page_offset = 0ULL;
@@ -142,7 +419,7 @@ void  memory_write(memory_content&  content, address const  begin, byte const* c
     {
         size const  num_bytes_to_copy = std::min(memory_page_size - page_offset, num_bytes - num_output_bytes);
 
-        memory_page&  page = content[page_begin];
+        memory_page&  page = content.page(page_begin);
 
         INVARIANT(num_bytes_to_copy > 0ULL);
         INVARIANT(page_offset + num_bytes_to_copy <= memory_page_size);
@@ -178,7 +455,7 @@ void  memory_havoc(memory_content&  content, address const  begin, size const  n
     {
         size const  num_bytes_to_copy = std::min(memory_page_size - page_offset,num_bytes - num_output_bytes);
 
-        memory_page&  page = content[page_begin];
+        memory_page&  page = content.page(page_begin);
 
         INVARIANT(num_bytes_to_copy > 0ULL);
         INVARIANT(page_offset + num_bytes_to_copy <= memory_page_size);
@@ -308,37 +585,288 @@ void  stream_write(stream_content&  content, index const  begin, byte const* con
 }
 
 
-void  input_frontier_of_thread::on_reg_impact(address const  adr, input_impact_link const&  link)
+void  shadow_page::set_label(index const  i, taint_label const  label)
 {
-    m_reg_impacts[adr] = link;
+    if (m_labels[i] == 0U)
+    {
+        if (label != 0U)
+            ++m_num_labelled;
+    }
+    else if (label == 0U)
+    {
+        INVARIANT(m_num_labelled > 0ULL);
+        --m_num_labelled;
+    }
+    m_labels[i] = label;
+}
+
+
+taint_label  shadow_memory::label(address const  adr) const
+{
+    if (empty())
+        return 0U;
+    auto const  it = m_pages->find(adr & ~(memory_page_size - 1ULL));
+    return it == m_pages->cend() ? 0U : it->second->label(adr & (memory_page_size - 1ULL));
+}
+
+taint_label  shadow_memory::set_label(address const  adr, taint_label const  label)
+{
+    address const  page_begin = adr & ~(memory_page_size - 1ULL);
+    taint_label const  old_label = this->label(adr);
+    if (old_label == label)
+        return old_label;   //!< Avoids a clone of a shared page.
+    if (label == 0U)
+    {
+        page_table&  pages = owned_pages();
+        auto const  it = pages.find(page_begin);
+        owned_page(it->second).set_label(adr - page_begin,0U);
+        if (it->second->num_labelled() == 0ULL)
+            pages.erase(it);
+    }
+    else
+        owned_page(owned_pages()[page_begin]).set_label(adr - page_begin,label);
+    return old_label;
 }
 
-void  input_frontier_of_thread::on_mem_impact(address const  adr, input_impact_link const&  link)
+bool  shadow_memory::is_clean(address const  begin, natexe::size const  num_bytes) const
 {
-    m_mem_impacts[adr] = link;
+    if (empty() || num_bytes == 0ULL)
+        return true;
+    address  page_begin = begin & ~(memory_page_size - 1ULL);
+    index  page_offset = begin - page_begin;
+    for (natexe::size  num_checked = 0ULL; num_checked < num_bytes; page_begin += memory_page_size, page_offset = 0ULL)
+    {
+        natexe::size const  num_to_check = std::min(memory_page_size - page_offset,num_bytes - num_checked);
+        auto const  it = m_pages->find(page_begin);
+        if (it != m_pages->cend())
+            for (index  i = page_offset; i != page_offset + num_to_check; ++i)
+                if (it->second->label(i) != 0U)
+                    return false;
+        num_checked += num_to_check;
+    }
+    return true;
 }
 
-void  input_frontier_of_thread::on_stream_impact(stream_id const&  sid, address const  shift, input_impact_link const&  link)
+void  shadow_memory::clear(address const  begin, natexe::size const  num_bytes)
 {
-    m_stream_impacts[{sid,shift}] = link;
+    if (is_clean(begin,num_bytes))
+        return;     //!< Avoids a clone of shared pages.
+    page_table&  pages = owned_pages();
+    address  page_begin = begin & ~(memory_page_size - 1ULL);
+    index  page_offset = begin - page_begin;
+    for (natexe::size  num_cleared = 0ULL; num_cleared < num_bytes; page_begin += memory_page_size, page_offset = 0ULL)
+    {
+        natexe::size const  num_to_clear = std::min(memory_page_size - page_offset,num_bytes - num_cleared);
+        auto const  it = pages.find(page_begin);
+        if (it != pages.end())
+        {
+            shadow_page&  page = owned_page(it->second);
+            for (index  i = page_offset; i != page_offset + num_to_clear; ++i)
+                page.set_label(i,0U);
+            if (page.num_labelled() == 0ULL)
+                pages.erase(it);
+        }
+        num_cleared += num_to_clear;
+    }
 }
 
-input_impact_link const* input_frontier_of_thread::find_in_reg(address const  adr) const
+std::map<address,taint_label>  shadow_memory::labels() const
 {
-    auto const  it = m_reg_impacts.find(adr);
-    return it == m_reg_impacts.cend() ? nullptr : &it->second;
+    std::map<address,taint_label>  result;
+    if (empty())
+        return result;
+    for (auto const&  adr_page : *m_pages)
+        for (index  i = 0ULL; i != memory_page_size; ++i)
+            if (adr_page.second->label(i) != 0U)
+                result.insert({adr_page.first + i,adr_page.second->label(i)});
+    return result;
 }
 
-input_impact_link const* input_frontier_of_thread::find_in_mem(address const  adr) const
+shadow_memory::page_table&  shadow_memory::owned_pages()
 {
-    auto const  it = m_mem_impacts.find(adr);
-    return it == m_mem_impacts.cend() ? nullptr : &it->second;
+    if (!m_pages.operator bool())
+        m_pages = std::make_shared<page_table>();
+    else if (m_pages.use_count() > 1L)
+        m_pages = std::make_shared<page_table>(*m_pages);
+    return *m_pages;
+}
+
+shadow_page&  shadow_memory::owned_page(std::shared_ptr<shadow_page>&  ptr)
+{
+    if (!ptr.operator bool())
+        ptr = std::make_shared<shadow_page>();
+    else if (ptr.use_count() > 1L)
+        ptr = std::make_shared<shadow_page>(*ptr);
+    return *ptr;
+}
+
+
+natexe::size constexpr  input_frontier_of_thread::label_chunk_size;
+
+input_frontier_of_thread::input_frontier_of_thread(thread_id const  tid)
+    : m_thread_id(tid)
+    , m_fork_counter(0ULL)
+    , m_labels()
+    , m_own_labels()
+    , m_reg()
+    , m_mem()
+    , m_streams()
+{}
+
+input_frontier_of_thread::input_frontier_of_thread(input_frontier_of_thread const&  parent, thread_id const  tid,
+                                                   node_counter_type const  fork_counter)
+    : m_thread_id(tid)
+    , m_fork_counter(fork_counter)
+    , m_labels(parent.m_labels)
+    , m_own_labels()        //!< No label is owned by the thread yet.
+    , m_reg(parent.m_reg)
+    , m_mem(parent.m_mem)
+    , m_streams(parent.m_streams)
+{
+    ASSUMPTION(tid != parent.get_thread_id());
+}
+
+std::map<std::pair<stream_id,address>,input_impact_link>  input_frontier_of_thread::stream_impacts() const
+{
+    std::map<std::pair<stream_id,address>,input_impact_link>  result;
+    for (auto const&  sid_adr__label : stream_labels())
+        result.insert({sid_adr__label.first,link(sid_adr__label.second)});
+    return result;
+}
+
+std::map<std::pair<stream_id,address>,taint_label>  input_frontier_of_thread::stream_labels() const
+{
+    std::map<std::pair<stream_id,address>,taint_label>  result;
+    for (auto const&  sid_shadow : m_streams)
+        for (auto const&  adr_label : sid_shadow.second.labels())
+            result.insert({{sid_shadow.first,adr_label.first},adr_label.second});
+    return result;
+}
+
+void  input_frontier_of_thread::delete_stream_impact(stream_id const&  sid, address const  shift)
+{
+    auto const  it = m_streams.find(sid);
+    if (it != m_streams.end())
+        store_label(it->second,shift,0U);
+}
+
+void  input_frontier_of_thread::delete_stream_impacts(stream_id const&  sid, address const  begin, natexe::size const  num_bytes)
+{
+    auto const  it = m_streams.find(sid);
+    if (it != m_streams.end())
+        clear_labels(it->second,begin,num_bytes);
 }
 
 input_impact_link const* input_frontier_of_thread::find_in_stream(stream_id const&  sid, address const  adr) const
 {
-    auto const  it = m_stream_impacts.find({sid,adr});
-    return it == m_stream_impacts.cend() ? nullptr : &it->second;
+    shadow_memory const* const  shadow = find_stream_shadow(sid);
+    return shadow == nullptr ? nullptr : find_link(shadow->label(adr));
+}
+
+shadow_memory const*  input_frontier_of_thread::find_stream_shadow(stream_id const&  sid) const
+{
+    auto const  it = m_streams.find(sid);
+    return it == m_streams.cend() ? nullptr : &it->second;
+}
+
+void  input_frontier_of_thread::set_link(taint_label const  label, input_impact_link const&  link)
+{
+    ASSUMPTION(label != 0U);
+    label_info&  info = owned_info(label);
+    ASSUMPTION(info.num_uses != 0ULL);
+    if (info.owner == m_thread_id)
+        m_own_labels.erase(info.link);
+    info.link = link;
+    info.owner = m_thread_id;
+    m_own_labels[link] = label;
+}
+
+taint_label  input_frontier_of_thread::use_label(input_impact_link const&  link)
+{
+    auto const  it = m_own_labels.find(link);
+    if (it != m_own_labels.cend())
+    {
+        ++owned_info(it->second).num_uses;
+        return it->second;
+    }
+    label_table&  table = owned_labels();
+    taint_label  label = table.first_free;
+    if (label != 0U)
+    {
+        label_info&  info = owned_info(label);
+        table.first_free = (taint_label)info.link.first;
+        info = {link,m_thread_id,1ULL};
+    }
+    else
+    {
+        // The number of labels in use is bounded by the number of bytes with an input impact.
+        INVARIANT(table.size < (natexe::size)std::numeric_limits<taint_label>::max());
+        if (table.size % label_chunk_size == 0ULL)
+            table.chunks.push_back(std::make_shared<label_chunk>());
+        label = (taint_label)++table.size;
+        owned_info(label) = {link,m_thread_id,1ULL};    //!< The last chunk may still be shared with a forked thread.
+    }
+    ++table.num_used;
+    m_own_labels.insert({link,label});
+    return label;
+}
+
+void  input_frontier_of_thread::release_label(taint_label const  label)
+{
+    if (label == 0U)
+        return;
+    label_info&  info = owned_info(label);
+    INVARIANT(info.num_uses != 0ULL);
+    if (--info.num_uses != 0ULL)
+        return;
+    if (info.owner == m_thread_id)
+        m_own_labels.erase(info.link);
+    label_table&  table = owned_labels();
+    info.link = { table.first_free, 0ULL };
+    table.first_free = label;
+    --table.num_used;
+}
+
+void  input_frontier_of_thread::clear_labels(shadow_memory&  shadow, address const  begin, natexe::size const  num_bytes)
+{
+    if (shadow.is_clean(begin,num_bytes))
+        return;     //!< Avoids a clone of the shared table of labels.
+    for (index  i = 0ULL; i != num_bytes; ++i)
+        release_label(shadow.label(begin + i));
+    shadow.clear(begin,num_bytes);
+}
+
+std::map<address,input_impact_link>  input_frontier_of_thread::impacts(shadow_memory const&  shadow) const
+{
+    std::map<address,input_impact_link>  result;
+    for (auto const&  adr_label : shadow.labels())
+        result.insert({adr_label.first,link(adr_label.second)});
+    return result;
+}
+
+input_frontier_of_thread::label_info const&  input_frontier_of_thread::info(taint_label const  label) const
+{
+    ASSUMPTION(label != 0U && m_labels.operator bool() && label <= m_labels->size);
+    return (*m_labels->chunks[(label - 1U) / label_chunk_size])[(label - 1U) % label_chunk_size];
+}
+
+input_frontier_of_thread::label_info&  input_frontier_of_thread::owned_info(taint_label const  label)
+{
+    label_table&  table = owned_labels();
+    ASSUMPTION(label != 0U && label <= table.size);
+    std::shared_ptr<label_chunk>&  chunk = table.chunks[(label - 1U) / label_chunk_size];
+    if (chunk.use_count() > 1L)
+        chunk = std::make_shared<label_chunk>(*chunk);
+    return (*chunk)[(label - 1U) % label_chunk_size];
+}
+
+input_frontier_of_thread::label_table&  input_frontier_of_thread::owned_labels()
+{
+    if (!m_labels.operator bool())
+        m_labels = std::make_shared<label_table>();
+    else if (m_labels.use_count() > 1L)
+        m_labels = std::make_shared<label_table>(*m_labels);
+    return *m_labels;
 }
 
 
@@ -361,6 +889,29 @@ execution_properties::execution_properties(
     , m_input_frontier_of_threads()
 {}
 
+execution_properties::execution_properties(execution_properties const&  origin, execution_id const  eid)
+    : execution_properties(origin)
+{
+    m_execution_id = eid;
+    for (auto&  id_reg : m_final_regs)
+        id_reg.second = std::make_shared<memory_content>(*id_reg.second);
+}
+
+input_frontier_of_thread&  execution_properties::input_frontier(thread_id const  tid)
+{
+    auto  it = m_input_frontier_of_threads.find(tid);
+    if (it == m_input_frontier_of_threads.end())
+        it = m_input_frontier_of_threads.insert({tid,input_frontier_of_thread(tid)}).first;
+    return it->second;
+}
+
+input_frontier_of_thread&  execution_properties::fork_input_frontier(thread_id const  parent_tid, thread_id const  tid, node_counter_type const  fork_counter)
+{
+    ASSUMPTION(m_input_frontier_of_threads.count(tid) == 0ULL);
+    input_frontier_of_thread  frontier(input_frontier(parent_tid),tid,fork_counter);
+    return m_input_frontier_of_threads.insert({tid,std::move(frontier)}).first->second;
+}
+
 void  execution_properties::add_final_reg(thread_id const  id, std::shared_ptr<memory_content> const  reg)
 {
     ASSUMPTION(
@@ -375,25 +926,27 @@ void  execution_properties::add_final_reg(thread_id const  id, std::shared_ptr<m
 }
 
 
-io_relation_location::io_relation_location(
-        bool const  is_in_reg_pool,
-        address const  shift_from_begin
-        )
-    : m_is_in_reg_pool(is_in_reg_pool)
-    , m_stream_id("")
-    , m_shift(shift_from_begin)
-{}
+natexe::size constexpr  io_ranges::capacity;
 
-io_relation_location::io_relation_location(
-        stream_id const&  sid,
-        address const  shift_from_begin
-        )
-    : m_is_in_reg_pool(false)
-    , m_stream_id(sid)
-    , m_shift(shift_from_begin)
+
+io_range::io_range(stream_id const&  sid, address const  begin, natexe::size const  num_bytes)
+    : m_stream_id(&sid)
+    , m_begin(begin)
+    , m_num_bytes(num_bytes)
+    , m_is_in_reg_pool(false)
+    , m_is_reversed(false)
+{
+    ASSUMPTION(m_stream_id->size() > 1ULL);
+    ASSUMPTION(m_stream_id->front() == '#');
+}
+
+io_range  io_range::sub_range(index const  start, index const  end) const
 {
-    ASSUMPTION(m_stream_id.size() > 1ULL);
-    ASSUMPTION(m_stream_id.front() == '#');
+    ASSUMPTION(start <= end && end <= num_bytes() && !is_reversed());
+    io_range  result = *this;
+    result.m_begin += start;
+    result.m_num_bytes = end - start;
+    return result;
 }
 
 
@@ -0,0 +1,588 @@
+#include <rebours/analysis/native_execution/execute_program.hpp>
+#include <rebours/analysis/native_execution/execute_instruction.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+#include <rebours/analysis/native_execution/development.hpp>
+#include <rebours/analysis/native_execution/msgstream.hpp>
+#include <rebours/analysis/native_execution/dump.hpp>
+#include <rebours/program/assembly.hpp>
+#include <algorithm>
+#include <iomanip>
+
+namespace analysis { namespace natexe { namespace detail {
+
+
+shadow_memory const*  find_shadow(input_frontier_of_thread const&  frontier, io_range const&  range)
+{
+    return range.is_in_reg_pool() ? &frontier.reg_shadow() :
+           range.is_in_mem_pool() ? &frontier.mem_shadow() :
+                                    frontier.find_stream_shadow(range.stream()) ;
+}
+
+bool  are_clean(input_frontier_of_thread const&  frontier, io_ranges const&  ranges)
+{
+    for (io_range const&  range : ranges)
+    {
+        shadow_memory const* const  shadow = find_shadow(frontier,range);
+        if (shadow != nullptr && !shadow->is_clean(range.begin(),range.num_bytes()))
+            return false;
+    }
+    return true;
+}
+
+void  clear(input_frontier_of_thread&  frontier, io_range const&  range)
+{
+    if (range.is_in_reg_pool())
+        frontier.delete_reg_impacts(range.begin(),range.num_bytes());
+    else if (range.is_in_mem_pool())
+        frontier.delete_mem_impacts(range.begin(),range.num_bytes());
+    else
+        frontier.delete_stream_impacts(range.stream(),range.begin(),range.num_bytes());
+}
+
+/**
+ * It returns the link of the label. When the label was inherited from another thread, then the input impact
+ * value of that thread is first copied (without its links) to the thread of the frontier, so that the returned
+ * link always refers to a value of the thread of the frontier.
+ */
+input_impact_link  own_link(input_frontier_of_thread&  frontier, taint_label const  label, recovery_properties&  rprops,
+                            execution_id const  eid)
+{
+    if (frontier.owner(label) == frontier.get_thread_id())
+        return frontier.link(label);
+    input_impact_value const*  pvalue = rprops.find_input_impact_value(eid,frontier.owner(label),frontier.link(label));
+    INVARIANT(pvalue != nullptr);
+    input_impact_value  value_copy = *pvalue;
+    value_copy.clear_links();
+    input_impact_link const  link = rprops.add_input_impact(value_copy,eid,frontier.get_thread_id(),frontier.fork_counter());
+    frontier.set_link(label,link);
+    return link;
+}
+
+void  insert_label(std::vector<taint_label>&  labels, taint_label const  label)
+{
+    if (label != 0U && std::find(labels.cbegin(),labels.cend(),label) == labels.cend())
+        labels.push_back(label);
+}
+
+/**
+ * It assigns a fresh input impact to the i-th byte of the written range. The value of the byte is
+ * taken from the pools and streams, because the instruction was already executed.
+ */
+void  on_input_impact(execution_context&  ctx, input_frontier_of_thread&  frontier, recovery_properties&  rprops,
+                      execution_id const  eid, thread_id const  tid, io_range const&  range, index const  i,
+                      std::vector<input_impact_link> const&  links)
+{
+    address const  adr = range.location(i);
+    byte  value;
+    if (range.is_in_reg_pool())
+    {
+        memory_read(ctx.reg(),adr,&value,1ULL);
+        frontier.on_reg_impact(adr,rprops.add_input_impact({value,true,adr,links},eid,tid));
+    }
+    else if (range.is_in_mem_pool())
+    {
+        memory_read(ctx.mem(),adr,&value,1ULL);
+        frontier.on_mem_impact(adr,rprops.add_input_impact({value,false,adr,links},eid,tid));
+    }
+    else
+    {
+        stream_read(ctx.contents_of_streams().at(range.stream()),adr,&value,1ULL);
+        frontier.on_stream_impact(range.stream(),adr,rprops.add_input_impact({value,range.stream(),adr,links},eid,tid));
+    }
+}
+
+void  delete_input_impact(input_frontier_of_thread&  frontier, io_range const&  range, index const  i)
+{
+    if (range.is_in_reg_pool())
+        frontier.delete_reg_impact(range.location(i));
+    else if (range.is_in_mem_pool())
+        frontier.delete_mem_impact(range.location(i));
+    else
+        frontier.delete_stream_impact(range.stream(),range.location(i));
+}
+
+/**
+ * It propagates labels of the input frontier of the thread along the io relation of the last executed instruction.
+ * Labels of read bytes of each rule are collected before any written byte of the rule is updated.
+ */
+void  propagate_input_impacts(execution_context&  ctx, input_frontier_of_thread&  frontier, recovery_properties&  rprops,
+                              execution_id const  eid, thread_id const  tid, node_counter_type const  counter)
+{
+    std::vector<taint_label>  labels;
+    std::vector<input_impact_link>  links;
+    for (io_relation_rule const&  rule : ctx.ior())
+    {
+        if (are_clean(frontier,rule.read))
+        {
+            clear(frontier,rule.written);
+            continue;
+        }
+        switch (rule.kind)
+        {
+        case io_relation_rule::KIND::ALL_TO_BYTE:
+            {
+                labels.clear();
+                for (io_range const&  range : rule.read)
+                {
+                    shadow_memory const* const  shadow = find_shadow(frontier,range);
+                    if (shadow != nullptr)
+                        for (index  j = 0ULL; j < range.num_bytes(); ++j)
+                            insert_label(labels,shadow->label(range.location(j)));
+                }
+                INVARIANT(!labels.empty());
+                links.clear();
+                for (taint_label const  label : labels)
+                    links.push_back(own_link(frontier,label,rprops,eid));
+                for (index  i = 0ULL; i < rule.written.num_bytes(); ++i)
+                    on_input_impact(ctx,frontier,rprops,eid,tid,rule.written,i,links);
+                rprops.add_input_impact_links(eid,tid,links,counter);
+            }
+            break;
+        case io_relation_rule::KIND::BYTE_TO_BYTE:
+            {
+                natexe::size const  num_reads = rule.read.size();
+                labels.resize(rule.written.num_bytes() * num_reads);
+                for (index  k = 0ULL; k < num_reads; ++k)
+                {
+                    io_range const&  range = rule.read.at(k);
+                    INVARIANT(range.num_bytes() == rule.written.num_bytes());
+                    shadow_memory const* const  shadow = find_shadow(frontier,range);
+                    for (index  i = 0ULL; i < range.num_bytes(); ++i)
+                        labels.at(i * num_reads + k) = shadow == nullptr ? 0U : shadow->label(range.location(i));
+                }
+                std::vector<taint_label>  byte_labels;
+                for (index  i = 0ULL; i < rule.written.num_bytes(); ++i)
+                {
+                    byte_labels.clear();
+                    for (index  k = 0ULL; k < num_reads; ++k)
+                        insert_label(byte_labels,labels.at(i * num_reads + k));
+                    if (byte_labels.empty())
+                        delete_input_impact(frontier,rule.written,i);
+                    else
+                    {
+                        links.clear();
+                        for (taint_label const  label : byte_labels)
+                            links.push_back(own_link(frontier,label,rprops,eid));
+                        on_input_impact(ctx,frontier,rprops,eid,tid,rule.written,i,links);
+                        rprops.add_input_impact_links(eid,tid,links,counter);
+                    }
+                }
+            }
+            break;
+        default: UNREACHABLE();
+        }
+    }
+}
+
+
+
+}}}
+
+namespace analysis { namespace natexe {
+
+
+std::string  check_concurrent_accesses(mem_access_set const&  W_d, mem_access_set const&  R_d, mem_access_set const&  W_c, mem_access_set const&  R_c,
+                                       mem_access_set const&  w_d, mem_access_set const&  r_d, mem_access_set const&  w_c, mem_access_set const&  r_c)
+{
+    // An intersection with a union is not empty iff the intersection with some of its operands is not empty.
+    // So, no union is ever built.
+
+    if (R_c.intersects(w_d))
+        return "Undefined behaviour: Illegall concurrent accesses - intersection(R_c,W'_d) is not empty.";
+
+    if (W_c.intersects(w_d) || W_c.intersects(r_d))
+        return "Undefined behaviour: Illegall concurrent accesses - intersection(W_c,union(W'_d,R'_d)) is not empty.";
+
+    if (R_d.intersects(w_d) || R_d.intersects(w_c))
+        return "Undefined behaviour: Illegall concurrent accesses - intersection(R_d,union(W'_d,W'_c)) is not empty.";
+
+    if (W_d.intersects(w_d) || W_d.intersects(r_d) || W_d.intersects(w_c) || W_d.intersects(r_c))
+        return "Undefined behaviour: Illegall concurrent accesses - intersection(W_d,union(W'_d,R'_d,W'_c,R'_c)) is not empty.";
+
+    return "";
+}
+
+
+std::string  execution_step(microcode::program&  P, thread&  thd, execution_properties&  eprops, recovery_properties&  rprops,
+                            std::vector<thread>&  thds, mem_access_set&  w_d, mem_access_set&  r_d, mem_access_set&  w_c, mem_access_set&  r_c,
+                            bool const  is_sequential, std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers)
+{
+    ASSUMPTION(!thd.stack().empty());
+    node_id const  u = thd.stack().back();
+    microcode::program_component&  C = P.component(microcode::find_component(P,u));
+    std::vector<node_id> const&  successors = C.successors(u);
+    std::vector<microcode::decoded_instruction> const&  instructions = C.successor_instructions(u);
+
+    rprops.update_unexplored(u/*,successors*/);
+    rprops.on_thread_step(eprops.get_execution_id(),thd.id());
+
+//if (std::unordered_set<node_id>({194ULL,198ULL,201ULL,205ULL,231ULL}).count(u) != 0ULL)
+//if (memory_read<byte>(thd.reg(),0x3fULL) == 0xff)
+//if (u == 32ULL)
+//{
+//    static uint64_t  counter = 0ULL;
+//    ++counter;
+//    dump_add_file(
+//            msgstream() << "Breakpoint at node " << u << ", hit number " << counter << ".",
+//            dump_at_breakpoint(P,eprops,rprops/*,pprops*/,thd,u,counter,msgstream() << "execution_00000/internal_node_" << u << "_hit_" << counter,ranges_to_registers)
+//            );
+//}
+
+    std::string  error_message;
+
+    if (successors.size() == 0ULL)
+    {
+        INVARIANT(C.exits().count(u) != 0ULL);
+        if (thd.stack().size() == 1ULL)
+        {
+            dump_add_file(
+                    msgstream() << "Correct termination of a thread #" << thd.id() << " at the exit node " << u << ".",
+                    dump_at_breakpoint(P,eprops,rprops/*,pprops*/,thd,u,0ULL,msgstream() << "execution_00000/internal_node_" << u << "_thread_" << thd.id(),ranges_to_registers)
+                    );
+
+            if (P.start_component().exits().count(u) != 0ULL)
+                eprops.add_final_reg(thd.id(),thd.reg_ptr());
+
+            rprops.insert_node_to_history(eprops.get_execution_id(),thd.id(),thd.stack().front());
+
+            return "";
+        }
+        thd.stack().pop_back();
+
+        ASSUMPTION(!thd.stack().empty());
+        rprops.insert_node_to_history(eprops.get_execution_id(),thd.id(),thd.stack().back());
+    }
+    else if (successors.size() == 1ULL)
+    {
+        node_id const  v = successors.front();
+        microcode::decoded_instruction const&  I = instructions.front();
+
+        if (I.GIK() == microcode::GIK::MODULARITY__CALL)
+        {
+            node_id const  entry = I.arg(0ULL);
+            INVARIANT(microcode::find_component_with_entry_node(P,entry) != P.num_components());
+
+            thd.stack().pop_back();
+            thd.stack().push_back(v);
+            thd.stack().push_back(entry);
+
+            rprops.insert_node_to_history(eprops.get_execution_id(),thd.id(),entry);
+        }
+        else if (I.GIK() == microcode::GIK::CONCURRENCY__REG_ASGN_THREAD)
+        {
+            thd.stack().pop_back();
+            thd.stack().push_back(v);
+
+            thds.push_back(thread(thd.stack(),thd.reg()));
+            memory_write<byte>(thds.back().reg(),I.arg(0ULL),1U);
+
+            memory_write<byte>(thd.reg(),I.arg(0ULL),0U);
+
+            rprops.on_new_thread(eprops.get_execution_id(),thds.back().id());
+            rprops.insert_node_to_history(eprops.get_execution_id(),thd.id(),v);
+            rprops.insert_node_to_history(eprops.get_execution_id(),thds.back().id(),v);
+
+            eprops.fork_input_frontier(thd.id(),thds.back().id(),rprops.node_couter(eprops.get_execution_id(),thds.back().id()));
+        }
+        else
+        {
+#define  USE_MEM_BRK()  0
+#if USE_MEM_BRK() != 0
+uint64_t const __brk_adr = 0x7f40003bdd90ULL;
+uint8_t const __brk_size = 0x8U;
+memory_content const&  __brk_mem =
+        //thd.reg();
+        eprops.mem_content();
+uint64_t const __brk_orig_value = memory_read<uint64_t>(__brk_mem,__brk_adr,__brk_size);
+#endif
+
+#define  USE_IP_UPDATE_CHECK()  0
+#if USE_IP_UPDATE_CHECK() != 0
+uint64_t const __old_IP_value = memory_read<uint64_t>(thd.reg(),0ULL,(uint8_t)8U);
+#endif
+
+            execution_context  ctx(thd.reg(),eprops,w_d,r_d,w_c,r_c);
+            execution_status const  status = execution_instruction(I,ctx,is_sequential);
+
+
+#if USE_IP_UPDATE_CHECK() != 0
+uint64_t const __new_IP_value = memory_read<uint64_t>(thd.reg(),0ULL,(uint8_t)8U);
+INVARIANT(__old_IP_value == __new_IP_value
+                || I.GIK() == microcode::GIK::SETANDCOPY__REG_ASGN_NUMBER
+                || I.GIK() == microcode::GIK::SETANDCOPY__REG_ASGN_REG
+                || I.GIK() == microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER
+                || I.GIK() == microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG
+                );
+#endif
+
+#if USE_MEM_BRK() != 0
+uint64_t const __brk_new_value = memory_read<uint64_t>(__brk_mem,__brk_adr,__brk_size);
+if (__brk_new_value != __brk_orig_value)
+{
+    static uint64_t  counter = 0ULL;
+    ++counter;
+    dump_add_file(
+            msgstream() << "Memory breakpoint at " << std::hex << __brk_adr << "h at node " << std::dec << u << ", hit number " << counter << ".",
+            dump_at_breakpoint(P,eprops,rprops,thd,u,counter,msgstream() << "execution_00000/mem_" << std::hex << __brk_adr
+                                                                         << "_node_" << std::dec << u << "_hit_" << counter,ranges_to_registers)
+            );
+}
+#endif
+
+            if (status.succeeded())
+            {
+                if (is_switch_instruction(I.instruction()))
+                {
+                    if (!rprops.has_switch(v))
+                        rprops.add_switch(v);
+                    switch_info&  info = rprops.get_switch(v);
+                    address const  case_IP_value = memory_read<uint64_t>(thd.reg(),0ULL,(uint8_t)8U);
+                    if (info.cases().count(case_IP_value) == 0ULL)
+                    {
+                        node_id  erased = 0ULL;
+                        node_id const  case_begin = add_case_to_switch(C,info,case_IP_value,eprops.temporaries_begin(),erased);
+                        if (erased != 0ULL)
+                            rprops.update_unexplored(erased);
+                        rprops.add_unexplored_exits(case_IP_value,{case_begin,info.default_node()});
+                    }
+                }
+
+                thd.stack().pop_back();
+                thd.stack().push_back(v);
+
+                node_counter_type const  old_counter = rprops.node_couter(eprops.get_execution_id(),thd.id());
+                rprops.insert_node_to_history(eprops.get_execution_id(),thd.id(),v);
+
+                detail::propagate_input_impacts(ctx,eprops.input_frontier(thd.id()),rprops,eprops.get_execution_id(),thd.id(),old_counter);
+            }
+            else
+                error_message = msgstream() << "On edge {" << u << "," << v << " ; " << microcode::assembly_text(I.instruction()) << "} : " << status.message();
+        }
+
+//        if (pprops != nullptr)
+//            pprops->instructions_to_edges()[I].insert({u,v});
+    }
+    else  if (successors.size() == 2ULL)
+    {
+        node_id  v = successors.front();
+        microcode::decoded_instruction const&  I = instructions.front();
+        address const  adr = I.arg(1ULL);
+        byte const  num_bytes = (byte)I.arg(0ULL);
+
+        INVARIANT((I.GIK() == microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO
+                   && instructions.back().GIK() == microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO)
+                  ||
+                  (I.GIK() == microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO
+                   && instructions.back().GIK() == microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO));
+
+        uint64_t const  value = memory_read<uint64_t>(thd.reg(),adr,num_bytes);
+
+        if ( (I.GIK() == microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO && value != 0ULL)       ||
+             (I.GIK() == microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO && value == 0ULL)   )
+        {
+            v = successors.back();
+
+            INVARIANT( adr == instructions.back().arg(1ULL) && num_bytes == (byte)instructions.back().arg(0ULL));
+            INVARIANT( (instructions.back().GIK() == microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO && value == 0ULL) ||
+                       (instructions.back().GIK() == microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO && value != 0ULL) );
+        }
+
+        thd.stack().pop_back();
+        thd.stack().push_back(v);
+
+        for (byte  i = 0U; i < num_bytes; ++i)
+            if (taint_label const  label = eprops.input_frontier(thd.id()).reg_shadow().label(adr + i))
+                rprops.add_input_impact_links(eprops.get_execution_id(),thd.id(),
+                                              {detail::own_link(eprops.input_frontier(thd.id()),label,rprops,eprops.get_execution_id())});
+
+        rprops.insert_branching(eprops.get_execution_id(),thd.id());
+        rprops.on_branching_visited({u,v});
+        rprops.insert_node_to_history(eprops.get_execution_id(),thd.id(),v);
+
+//        if (pprops != nullptr)
+//            pprops->instructions_to_edges()[C.instruction({u,v})].insert({u,v});
+    }
+    else
+        UNREACHABLE();
+
+    thds.push_back(thread());
+    thd.swap(thds.back());
+
+    return error_message;
+}
+
+
+std::string  execution_run(microcode::program const&  P, threaded_code&  code, thread&  thd, execution_properties&  eprops, recovery_properties&  rprops,
+                           uint64_t const  max_num_steps, uint64_t&  num_steps)
+{
+    ASSUMPTION(!thd.stack().empty());
+
+    execution_id const  eid = eprops.get_execution_id();
+    thread_id const  tid = thd.id();
+    input_frontier_of_thread&  frontier = eprops.input_frontier(tid);
+
+    // The sets are required by instructions only. There are no other threads to check accesses against.
+    mem_access_set  w_d;
+    mem_access_set  r_d;
+    mem_access_set  w_c;
+    mem_access_set  r_c;
+
+    // The context is reused by all steps, so the memory of its io relation is allocated only once.
+    execution_context  ctx(thd.reg(),eprops,w_d,r_d,w_c,r_c);
+
+    num_steps = 0ULL;
+    for (uint64_t  index = code.find_record(P,thd.stack().back()); num_steps < max_num_steps; ++num_steps)
+    {
+        if (code.at(index).kind == threaded_code::KIND::WALKER)
+            break;
+
+        if (code.native() != nullptr)
+        {
+            native_code::region const* const  R = code.native()->find_region(P,code,index);
+            uint64_t  k = 0ULL;
+            uint64_t const  num_passes = R == nullptr || R->records.size() > max_num_steps - num_steps ? 0ULL :
+                                         code.native()->run(*R,thd.reg(),frontier.reg_shadow(),(max_num_steps - num_steps) / R->records.size(),k);
+            if (num_passes != 0ULL)
+            {
+                // The machine code does not touch the records, so we produce them for all the performed steps now. Since
+                // no accessed register has an input impact, the region neither creates nor removes any input impact.
+                for (uint64_t  i = 0ULL; i < num_passes; ++i)
+                    for (uint64_t const  j : R->records)
+                    {
+                        threaded_code::record const&  s = code.at(j);
+                        rprops.on_concurrent_group_begin(eid);
+                        rprops.update_unexplored(s.node);
+                        rprops.on_thread_step(eid,tid);
+                        if (s.kind == threaded_code::KIND::BRANCHING)
+                        {
+                            node_id const  v = s.successors.at(i + 1ULL == num_passes ? k : R->loop_successor);
+                            rprops.insert_branching(eid,tid);
+                            rprops.on_branching_visited({s.node,v});
+                            rprops.insert_node_to_history(eid,tid,v);
+                        }
+                        else
+                            rprops.insert_node_to_history(eid,tid,s.successors.front());
+                    }
+                thd.stack().back() = code.at(R->records.back()).successors.at(k);
+                num_steps += num_passes * R->records.size() - 1ULL;   // The loop adds the last one.
+                index = code.successor_record(P,R->records.back(),k);
+                continue;
+            }
+        }
+
+        threaded_code::record const&  r = code.at(index);
+
+        node_id const  u = r.node;
+        uint64_t  k = 0ULL;
+
+        rprops.on_concurrent_group_begin(eid);
+        rprops.update_unexplored(u);
+        rprops.on_thread_step(eid,tid);
+
+        if (r.kind == threaded_code::KIND::INSTRUCTION)
+        {
+            w_d.clear();
+            r_d.clear();
+            w_c.clear();
+            r_c.clear();
+            ctx.ior().clear();
+
+            execution_status const  status = r.handler(*r.instruction,ctx);
+            if (!status.succeeded())
+                return msgstream() << "On edge {" << u << "," << r.successors.front() << " ; " << microcode::assembly_text(r.instruction->instruction())
+                                   << "} : " << status.message();
+
+            thd.stack().back() = r.successors.front();
+
+            node_counter_type const  old_counter = rprops.node_couter(eid,tid);
+            rprops.insert_node_to_history(eid,tid,r.successors.front());
+
+            detail::propagate_input_impacts(ctx,frontier,rprops,eid,tid,old_counter);
+        }
+        else
+        {
+            microcode::decoded_instruction const&  I = *r.instruction;
+            address const  adr = I.arg(1ULL);
+            byte const  num_bytes = (byte)I.arg(0ULL);
+
+            uint64_t const  value = memory_read<uint64_t>(thd.reg(),adr,num_bytes);
+            if ( (I.GIK() == microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO && value != 0ULL)       ||
+                 (I.GIK() == microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO && value == 0ULL)   )
+                k = 1ULL;
+            node_id const  v = r.successors.at(k);
+
+            thd.stack().back() = v;
+
+            for (byte  i = 0U; i < num_bytes; ++i)
+                if (taint_label const  label = frontier.reg_shadow().label(adr + i))
+                    rprops.add_input_impact_links(eid,tid,{detail::own_link(frontier,label,rprops,eid)});
+
+            rprops.insert_branching(eid,tid);
+            rprops.on_branching_visited({u,v});
+            rprops.insert_node_to_history(eid,tid,v);
+        }
+
+        index = code.successor_record(P,index,k);
+    }
+    return "";
+}
+
+
+std::string  execution_step(microcode::program&  P, std::vector<thread>&  in_thds, execution_properties&  eprops, recovery_properties&  rprops,
+                            std::vector<thread>&  out_thds, std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers,
+                            threaded_code* const  code)
+{
+    if (code != nullptr && in_thds.size() == 1ULL && out_thds.empty())
+    {
+        uint64_t  num_steps;
+        std::string const  error_message = execution_run(P,*code,in_thds.back(),eprops,rprops,threaded_code::max_num_steps_of_run,num_steps);
+        if (!error_message.empty() || num_steps != 0ULL)
+        {
+            out_thds.push_back(thread());
+            out_thds.back().swap(in_thds.back());
+            in_thds.pop_back();
+            return error_message;
+        }
+    }
+
+    rprops.on_concurrent_group_begin(eprops.get_execution_id());
+
+    bool const  is_sequential = in_thds.size() + out_thds.size() < 2ULL;
+
+    mem_access_set  W_d;
+    mem_access_set  R_d;
+    mem_access_set  W_c;
+    mem_access_set  R_c;
+    mem_access_set  w_d;
+    mem_access_set  r_d;
+    mem_access_set  w_c;
+    mem_access_set  r_c;
+    while (!in_thds.empty())
+    {
+        // The sets are reused by all threads, so their memory is allocated only once per step.
+        w_d.clear();
+        r_d.clear();
+        w_c.clear();
+        r_c.clear();
+
+        std::string  error_message = execution_step(P,in_thds.back(),eprops,rprops,out_thds,w_d,r_d,w_c,r_c,is_sequential,ranges_to_registers);
+        in_thds.pop_back();
+        if (!error_message.empty())
+            return error_message;
+
+        error_message = check_concurrent_accesses(W_d,R_d,W_c,R_c,w_d,r_d,w_c,r_c);
+        if (!error_message.empty())
+            return error_message;
+
+        W_d.insert(w_d);
+        R_d.insert(r_d);
+        W_c.insert(w_c);
+        R_c.insert(r_c);
+    }
+    return "";
+}
+
+
+
+}}
@@ -0,0 +1,232 @@
+#include <rebours/analysis/native_execution/mem_access_set.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace analysis { namespace natexe { namespace detail {
+
+
+uint64_t const  max_address = std::numeric_limits<uint64_t>::max();
+
+
+/**
+ * It returns a mask of bits 'first'..'last' of a 64-bit word.
+ */
+uint64_t  word_mask(uint64_t const  first, uint64_t const  last)
+{
+    ASSUMPTION(first <= last && last < 64ULL);
+    uint64_t const  high = last == 63ULL ? ~0ULL : (1ULL << (last + 1ULL)) - 1ULL;
+    return high & ~((1ULL << first) - 1ULL);
+}
+
+/**
+ * Both 'first' and 'last' are offsets of bits in the page.
+ */
+void  set_bits(mem_access_set::page_bitmap&  page, uint64_t const  first, uint64_t const  last)
+{
+    for (uint64_t  w = first / 64ULL; w <= last / 64ULL; ++w)
+        page.at(w) |= word_mask(w == first / 64ULL ? first % 64ULL : 0ULL,w == last / 64ULL ? last % 64ULL : 63ULL);
+}
+
+bool  test_bits(mem_access_set::page_bitmap const&  page, uint64_t const  first, uint64_t const  last)
+{
+    for (uint64_t  w = first / 64ULL; w <= last / 64ULL; ++w)
+        if ((page.at(w) & word_mask(w == first / 64ULL ? first % 64ULL : 0ULL,w == last / 64ULL ? last % 64ULL : 63ULL)) != 0ULL)
+            return true;
+    return false;
+}
+
+
+}}}
+
+namespace analysis { namespace natexe {
+
+
+uint64_t constexpr  mem_access_set::max_num_ranges;
+uint64_t constexpr  mem_access_set::page_size;
+
+
+mem_access_set::mem_access_set()
+    : m_ranges()
+    , m_pages()
+    , m_uses_bitmaps(false)
+{}
+
+void  mem_access_set::clear()
+{
+    m_ranges.clear();
+    m_pages.clear();
+    m_uses_bitmaps = false;
+}
+
+void  mem_access_set::insert(uint64_t const  adr, uint64_t const  num_bytes)
+{
+    if (num_bytes == 0ULL)
+        return;
+    uint64_t const  last = adr + (num_bytes - 1ULL);
+    if (last < adr)
+    {
+        // The access wraps around the end of the address space.
+        insert_range(adr,detail::max_address);
+        insert_range(0ULL,last);
+    }
+    else
+        insert_range(adr,last);
+}
+
+void  mem_access_set::insert(mem_access_set const&  other)
+{
+    if (!other.m_uses_bitmaps)
+    {
+        for (range const&  r : other.m_ranges)
+            insert_range(r.first,r.second);
+        return;
+    }
+    switch_to_bitmaps();
+    for (auto const&  key_page : other.m_pages)
+    {
+        page_bitmap&  page = m_pages.insert({key_page.first,page_bitmap{}}).first->second;
+        for (uint64_t  w = 0ULL; w < page.size(); ++w)
+            page.at(w) |= key_page.second.at(w);
+    }
+}
+
+bool  mem_access_set::contains(uint64_t const  adr) const
+{
+    if (m_uses_bitmaps)
+        return bitmaps_intersect_range(adr,adr);
+    auto const  it = std::upper_bound(m_ranges.cbegin(),m_ranges.cend(),adr,
+                                      [](uint64_t const  a, range const&  r) { return a < r.first; });
+    return it != m_ranges.cbegin() && std::prev(it)->second >= adr;
+}
+
+bool  mem_access_set::intersects(mem_access_set const&  other) const
+{
+    if (empty() || other.empty())
+        return false;
+    if (!m_uses_bitmaps && !other.m_uses_bitmaps)
+    {
+        auto  i = m_ranges.cbegin();
+        auto  j = other.m_ranges.cbegin();
+        while (i != m_ranges.cend() && j != other.m_ranges.cend())
+            if (i->second < j->first)
+                ++i;
+            else if (j->second < i->first)
+                ++j;
+            else
+                return true;
+        return false;
+    }
+    if (!m_uses_bitmaps)
+        return other.intersects(*this);
+    if (!other.m_uses_bitmaps)
+    {
+        for (range const&  r : other.m_ranges)
+            if (bitmaps_intersect_range(r.first,r.second))
+                return true;
+        return false;
+    }
+    mem_access_set const&  smaller = m_pages.size() <= other.m_pages.size() ? *this : other;
+    mem_access_set const&  bigger = m_pages.size() <= other.m_pages.size() ? other : *this;
+    for (auto const&  key_page : smaller.m_pages)
+    {
+        auto const  it = bigger.m_pages.find(key_page.first);
+        if (it != bigger.m_pages.cend())
+            for (uint64_t  w = 0ULL; w < key_page.second.size(); ++w)
+                if ((key_page.second.at(w) & it->second.at(w)) != 0ULL)
+                    return true;
+    }
+    return false;
+}
+
+void  mem_access_set::insert_range(uint64_t  first, uint64_t  last)
+{
+    ASSUMPTION(first <= last);
+    if (m_uses_bitmaps)
+    {
+        insert_range_to_bitmaps(first,last);
+        return;
+    }
+    // The fast path: addresses are mostly inserted in the increasing order.
+    if (m_ranges.empty() || (m_ranges.back().second != detail::max_address && m_ranges.back().second + 1ULL < first))
+    {
+        m_ranges.push_back({first,last});
+        if (m_ranges.size() > max_num_ranges)
+            switch_to_bitmaps();
+        return;
+    }
+    // We look for the first range, which is not before [first,last] (including adjacency).
+    auto const  begin = std::lower_bound(m_ranges.begin(),m_ranges.end(),first,
+                                         [](range const&  r, uint64_t const  a) { return r.second != detail::max_address && r.second + 1ULL < a; });
+    auto  end = begin;
+    for ( ; end != m_ranges.end() && (last == detail::max_address || end->first <= last + 1ULL); ++end)
+    {
+        first = std::min(first,end->first);
+        last = std::max(last,end->second);
+    }
+    if (begin == end)
+        m_ranges.insert(begin,{first,last});
+    else
+    {
+        *begin = {first,last};
+        m_ranges.erase(std::next(begin),end);
+    }
+    if (m_ranges.size() > max_num_ranges)
+        switch_to_bitmaps();
+}
+
+void  mem_access_set::insert_range_to_bitmaps(uint64_t  first, uint64_t const  last)
+{
+    ASSUMPTION(m_uses_bitmaps && first <= last);
+    uint64_t const  page_mask = page_size - 1ULL;
+    while (true)
+    {
+        uint64_t const  page_last = std::min(last,first | page_mask);
+        detail::set_bits(m_pages[first / page_size],first % page_size,page_last % page_size);
+        if (page_last == last)
+            break;
+        first = page_last + 1ULL;
+    }
+}
+
+bool  mem_access_set::bitmaps_intersect_range(uint64_t const  first, uint64_t const  last) const
+{
+    ASSUMPTION(m_uses_bitmaps && first <= last);
+    uint64_t const  first_key = first / page_size;
+    uint64_t const  last_key = last / page_size;
+    auto const  test_page = [first,last](uint64_t const  key, page_bitmap const&  page) {
+        uint64_t const  page_begin = key * page_size;
+        uint64_t const  page_last = page_begin + (page_size - 1ULL);
+        return detail::test_bits(page,std::max(first,page_begin) - page_begin,std::min(last,page_last) - page_begin);
+    };
+    if (last_key - first_key >= m_pages.size())
+    {
+        // The range spans more pages than there are in the set.
+        for (auto const&  key_page : m_pages)
+            if (key_page.first >= first_key && key_page.first <= last_key && test_page(key_page.first,key_page.second))
+                return true;
+        return false;
+    }
+    for (uint64_t  key = first_key; ; ++key)
+    {
+        auto const  it = m_pages.find(key);
+        if (it != m_pages.cend() && test_page(key,it->second))
+            return true;
+        if (key == last_key)
+            return false;
+    }
+}
+
+void  mem_access_set::switch_to_bitmaps()
+{
+    if (m_uses_bitmaps)
+        return;
+    m_uses_bitmaps = true;
+    for (range const&  r : m_ranges)
+        insert_range_to_bitmaps(r.first,r.second);
+    m_ranges.clear();
+}
+
+
+}}
@@ -13,13 +13,19 @@
 #include <iomanip>
 #include <fstream>
 #include <tuple>
+#include <mutex>
 
 namespace analysis { namespace natexe { namespace detail {
 
-static std::vector<std::string>  g_root_directory;
+/**
+ * Each thread has its own stack of dump directories, so executions performed in parallel do not interfere.
+ * The list of dump files is shared by all threads and it is guarded by the mutex below.
+ */
+static thread_local std::vector<std::string>  g_root_directory;
 static std::vector< std::pair<std::string,  //!< A brief description of the dump
                               std::string>  //!< A path-name of the root file of the dump
                     >  g_dump_files;
+static std::mutex  g_dump_files_mutex;
 
 
 static std::string  compute_relative_pathname(std::string const&  pathname, std::string const&  dir)
@@ -127,7 +133,10 @@ void  dump_add_file(std::string const&  description, std::string const&  pathnam
     if (!dump_enabled())
         return;
     if (!pathname.empty())
+    {
+        std::lock_guard<std::mutex> const  lock(detail::g_dump_files_mutex);
         detail::g_dump_files.push_back({description,pathname});
+    }
 }
 
 void  dump_create_root_file(std::string const&  error_message, std::string const&  dump_subdir)
@@ -138,6 +147,8 @@ void  dump_create_root_file(std::string const&  error_message, std::string const
     std::string const  root_dir = fileutl::concatenate_file_paths(dump_root_directory(),dump_subdir);
     std::string const  pathname = fileutl::concatenate_file_paths(root_dir,"start.html");
 
+    std::lock_guard<std::mutex> const  lock(detail::g_dump_files_mutex);
+
     std::fstream  ostr(pathname, std::ios_base::out);
     if (!ostr.is_open())
     {
@@ -245,19 +256,20 @@ std::string  dump_memory_content(memory_content const&  content, std::string con
     ostr << "<p>Only accessed memory pages are listed. All number are hexadecimal.</p>\n";
     if (!content.empty())
     {
+        std::vector< std::pair<address,memory_page const*> > const  pages = content.pages();
         ostr << "<table>\n";
         ostr << "  <caption>List of pages</caption>\n";
         ostr << "  <tr>\n";
         ostr << "    <th>Page</th>\n";
         ostr << "    <th>Content</th>\n";
         ostr << "  </tr>\n";
-        for (auto const&  adr_page : content)
+        for (auto const&  adr_page : pages)
         {
             ostr << "  <tr>\n";
             ostr << "    <td>["
                  << std::hex << std::setw(12) << std::setfill('0') << adr_page.first
                  << ","
-                 << std::hex << std::setw(12) << std::setfill('0') << adr_page.first + adr_page.second.size()
+                 << std::hex << std::setw(12) << std::setfill('0') << adr_page.first + adr_page.second->size()
                  << ")</td>\n";
             ostr << "    <td><a href=\"./" << filename << "#page_"
                  << std::hex << std::setw(12) << std::setfill('0') << adr_page.first
@@ -266,12 +278,12 @@ std::string  dump_memory_content(memory_content const&  content, std::string con
         }
         ostr << "</table>\n";
         ostr << "<pre>\n\n</pre>\n";
-        for (auto const&  adr_page : content)
+        for (auto const&  adr_page : pages)
         {
-            INVARIANT(adr_page.second.size() % 16ULL == 0ULL);
+            INVARIANT(adr_page.second->size() % 16ULL == 0ULL);
 
-            byte const*  ptr = adr_page.second.data();
-            byte const* const  end = ptr + adr_page.second.size();
+            byte const*  ptr = adr_page.second->data();
+            byte const* const  end = ptr + adr_page.second->size();
             address  adr = adr_page.first;
 
             ostr << "<h3 id=page_"
@@ -279,7 +291,7 @@ std::string  dump_memory_content(memory_content const&  content, std::string con
                  << ">Page ["
                  << std::hex << std::setw(12) << std::setfill('0') << adr
                  << ","
-                 << std::hex << std::setw(12) << std::setfill('0') << adr + adr_page.second.size()
+                 << std::hex << std::setw(12) << std::setfill('0') << adr + adr_page.second->size()
                  << ")</h3>\n";
 
             ostr << "<pre>\n";
@@ -765,7 +777,7 @@ std::string  dump_unexplored_exits(
 }
 
 std::string  dump_nodes_history_of_one_executed_thread(
-        std::vector<node_id> const&  nodes,
+        compact_trace const&  nodes,
         std::string const&  filename)
 {
     std::string const  pathname = fileutl::concatenate_file_paths(dump_directory(),filename);
@@ -859,7 +871,7 @@ std::string  dump_node_histories_of_executed_threads(
 
 std::string  dump_branchings_of_one_executed_thread(
         std::vector<node_counter_type> const&  counters,
-        std::vector<node_id> const&  nodes,
+        compact_trace const&  nodes,
         std::string const&  filename)
 {
     std::string const  pathname = fileutl::concatenate_file_paths(dump_directory(),filename);
@@ -1062,15 +1074,17 @@ std::string  dump_interleaving_of_threads_of_one_execution(
             "</p>\n"
             "<pre>\nCounter      Thread IDs\n\n"
             ;
-    std::vector<thread_id> const&  interleaving = rprops.interleaving_of_threads(eid);
-    for (index  i = 0ULL, j = 0ULL; i < interleaving.size(); ++i, ++j)
+    index  i = 0ULL, j = 0ULL;
+    for (thread_id const  tid : rprops.interleaving_of_threads(eid))
     {
         if (j % 10ULL == 0ULL)
         {
             ostr << (i != 0ULL ? "\n" : "") << std::setw(7) << std::setfill('0') << i << "      ";
             j = 0ULL;
         }
-        ostr << (rprops.is_begin_of_concurrent_group(eid,i) ? '*' : ' ') << interleaving.at(i) << ", ";
+        ostr << (rprops.is_begin_of_concurrent_group(eid,i) ? '*' : ' ') << tid << ", ";
+        ++j;
+        ++i;
     }
     ostr << "</pre>\n";
 
@@ -1130,7 +1144,7 @@ std::string  dump_interleaving_of_threads(
 
 std::string  dump_input_impacts_of_one_executed_thread(
         std::vector<std::vector<input_impact_value> > const&  impacts,
-        std::vector<node_id> const&  nodes_history,
+        compact_trace const&  nodes_history,
         std::string const&  filename)
 {
     std::string const  pathname = fileutl::concatenate_file_paths(dump_directory(),filename);
@@ -1271,7 +1285,7 @@ std::string  dump_input_impacts_of_executed_threads(
 
 std::string  dump_input_impact_links_of_one_executed_thread(
         std::vector<std::unordered_set<input_impact_link> > const&  links,
-        std::vector<node_id> const&  nodes_history,
+        compact_trace const&  nodes_history,
         std::string const&  filename)
 {
     std::string const  pathname = fileutl::concatenate_file_paths(dump_directory(),filename);
@@ -1497,7 +1511,7 @@ std::string  dump_recovery_properties(
 
 std::string  dump_input_frontier_of_thread(
         input_frontier_of_thread const&  frontier,
-        std::vector<node_id> const* const  nodes_history,
+        compact_trace const* const  nodes_history,
         std::string const&  filename)
 {
     std::string const  pathname = fileutl::concatenate_file_paths(dump_directory(),filename);
@@ -1515,7 +1529,8 @@ std::string  dump_input_frontier_of_thread(
 
     ostr << "<h2>Input frontier of an executed thread</h2>\n";
 
-    if (!frontier.reg_impacts().empty())
+    std::map<address,taint_label> const  reg_labels = frontier.reg_shadow().labels();
+    if (!reg_labels.empty())
     {
         ostr << "<h3>REG pool impacts</h3>\n";
         ostr << "<p>\n"
@@ -1529,26 +1544,30 @@ std::string  dump_input_frontier_of_thread(
         if (nodes_history != nullptr)
             ostr << "    <th>Node</th>\n";
         ostr << "  </tr>\n";
-        std::set<address>  sorted;
-        for (auto const& adr_link : frontier.reg_impacts())
-            sorted.insert(adr_link.first);
-        for (auto const& adr : sorted)
+        for (auto const& adr_label : reg_labels)
         {
             ostr << "  <tr>\n";
-            ostr << "    <td>" << std::setw(16) << std::setfill('0') << std::hex << adr << "</td>\n";
-            input_impact_link const&  link = frontier.reg_impacts().at(adr);
+            ostr << "    <td>" << std::setw(16) << std::setfill('0') << std::hex << adr_label.first << "</td>\n";
+            taint_label const  label = adr_label.second;
+            input_impact_link const&  link = frontier.link(label);
             ostr << "    <td>" << std::dec << link.first << "</td>\n";
             ostr << "    <td>" << std::dec << link.second << "</td>\n";
             if (nodes_history != nullptr)
             {
-                ASSUMPTION(nodes_history->size() > link.first);
-                ostr << "    <td>" << std::dec << nodes_history->at(link.first) << "</td>\n";
+                if (frontier.owner(label) != frontier.get_thread_id())
+                    ostr << "    <td>inherited from thread #" << std::dec << frontier.owner(label) << "</td>\n";
+                else
+                {
+                    ASSUMPTION(nodes_history->size() > link.first);
+                    ostr << "    <td>" << std::dec << nodes_history->at(link.first) << "</td>\n";
+                }
             }
         }
         ostr << "</table>\n";
     }
 
-    if (!frontier.mem_impacts().empty())
+    std::map<address,taint_label> const  mem_labels = frontier.mem_shadow().labels();
+    if (!mem_labels.empty())
     {
         ostr << "<h3>MEM pool impacts</h3>\n";
         ostr << "<p>\n"
@@ -1562,25 +1581,29 @@ std::string  dump_input_frontier_of_thread(
         if (nodes_history != nullptr)
             ostr << "    <th>Node</th>\n";
         ostr << "  </tr>\n";
-        std::set<address>  sorted;
-        for (auto const& adr_link : frontier.mem_impacts())
-            sorted.insert(adr_link.first);
-        for (auto const& adr : sorted)
+        for (auto const& adr_label : mem_labels)
         {
             ostr << "  <tr>\n";
-            ostr << "    <td>" << std::setw(16) << std::setfill('0') << std::hex << adr << "</td>\n";
-            input_impact_link const&  link = frontier.mem_impacts().at(adr);
+            ostr << "    <td>" << std::setw(16) << std::setfill('0') << std::hex << adr_label.first << "</td>\n";
+            taint_label const  label = adr_label.second;
+            input_impact_link const&  link = frontier.link(label);
             ostr << "    <td>" << std::dec << link.first << "</td>\n";
             ostr << "    <td>" << std::dec << link.second << "</td>\n";
             if (nodes_history != nullptr)
             {
-                ASSUMPTION(nodes_history->size() > link.first);
-                ostr << "    <td>" << std::dec << nodes_history->at(link.first) << "</td>\n";
+                if (frontier.owner(label) != frontier.get_thread_id())
+                    ostr << "    <td>inherited from thread #" << std::dec << frontier.owner(label) << "</td>\n";
+                else
+                {
+                    ASSUMPTION(nodes_history->size() > link.first);
+                    ostr << "    <td>" << std::dec << nodes_history->at(link.first) << "</td>\n";
+                }
             }
         }
         ostr << "</table>\n";
     }
-    if (!frontier.stream_impacts().empty())
+    std::map<std::pair<stream_id,address>,taint_label> const  stream_labels = frontier.stream_labels();
+    if (!stream_labels.empty())
     {
         ostr << "<h3>Stream impacts</h3>\n";
         ostr << "<p>\n"
@@ -1595,21 +1618,24 @@ std::string  dump_input_frontier_of_thread(
         if (nodes_history != nullptr)
             ostr << "    <th>Node</th>\n";
         ostr << "  </tr>\n";
-        std::set< std::pair<stream_id,address> >  sorted;
-        for (auto const& id_adr__link : frontier.stream_impacts())
-            sorted.insert(id_adr__link.first);
-        for (auto const& id_adr : sorted)
+        for (auto const& id_adr__label : stream_labels)
         {
             ostr << "  <tr>\n";
-            ostr << "    <td>" << id_adr.first << "</td>\n";
-            ostr << "    <td>" << std::setw(16) << std::setfill('0') << std::hex << id_adr.second << "</td>\n";
-            input_impact_link const&  link = frontier.stream_impacts().at(id_adr);
+            ostr << "    <td>" << id_adr__label.first.first << "</td>\n";
+            ostr << "    <td>" << std::setw(16) << std::setfill('0') << std::hex << id_adr__label.first.second << "</td>\n";
+            taint_label const  label = id_adr__label.second;
+            input_impact_link const&  link = frontier.link(label);
             ostr << "    <td>" << std::dec << link.first << "</td>\n";
             ostr << "    <td>" << std::dec << link.second << "</td>\n";
             if (nodes_history != nullptr)
             {
-                ASSUMPTION(nodes_history->size() > link.first);
-                ostr << "    <td>" << std::dec << nodes_history->at(link.first) << "</td>\n";
+                if (frontier.owner(label) != frontier.get_thread_id())
+                    ostr << "    <td>inherited from thread #" << std::dec << frontier.owner(label) << "</td>\n";
+                else
+                {
+                    ASSUMPTION(nodes_history->size() > link.first);
+                    ostr << "    <td>" << std::dec << nodes_history->at(link.first) << "</td>\n";
+                }
             }
         }
         ostr << "</table>\n";
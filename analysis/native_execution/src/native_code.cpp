@@ -0,0 +1,531 @@
+#include <rebours/analysis/native_execution/native_code.hpp>
+#include <rebours/analysis/native_execution/threaded_code.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+#include <initializer_list>
+#include <algorithm>
+#include <array>
+
+#if defined(__x86_64__) && defined(__linux__)
+#   include <sys/mman.h>
+#   define NATIVE_CODE_IS_SUPPORTED
+#endif
+
+namespace analysis { namespace natexe { namespace {
+
+
+address const  end_of_dense_pages = memory_content::num_dense_pages * memory_page_size;
+
+
+/**
+ * The machine code accesses only whole registers of 1, 2, 4, or 8 bytes lying in a single dense page.
+ */
+bool  is_native_access(address const  adr, uint64_t const  num_bytes)
+{
+    return (num_bytes == 1ULL || num_bytes == 2ULL || num_bytes == 4ULL || num_bytes == 8ULL) &&
+           adr < end_of_dense_pages && num_bytes <= end_of_dense_pages - adr &&
+           adr % memory_page_size + num_bytes <= memory_page_size;
+}
+
+
+/**
+ * A minimal emitter of x86-64 instructions used in regions. Values of registers of the REG pool are held in RAX and RCX,
+ * RDX holds the data of the accessed page, RDI the array of pages, RSI the maximal number of passes, and R8 the number
+ * of performed passes. All of them are scratch registers in the System V ABI, so the machine code needs no prologue.
+ * Registers of the REG pool are stored in the big endian, so each load and store swaps bytes.
+ */
+struct  emitter
+{
+    enum struct  OPERAND : uint8_t
+    {
+        RAX = 0U,
+        RCX = 1U,
+    };
+
+    emitter() : m_bytes() {}
+
+    std::vector<uint8_t> const&  bytes() const noexcept { return m_bytes; }
+    uint64_t  position() const noexcept { return m_bytes.size(); }
+
+    void  load(OPERAND const  operand, address const  adr, uint64_t const  num_bytes)
+    {
+        load_page(adr);
+        uint8_t const  reg = (uint8_t)operand;
+        uint8_t const  modrm = 0x82U | (uint8_t)(reg << 3U);   //!< [RDX + disp32]
+        switch (num_bytes)
+        {
+        case 1ULL: emit({ 0x0FU, 0xB6U, modrm }); emit32(adr % memory_page_size); break;                                     // movzx e?x, byte [rdx+d]
+        case 2ULL: emit({ 0x0FU, 0xB7U, modrm }); emit32(adr % memory_page_size); emit({ 0x66U, 0xC1U, (uint8_t)(0xC0U | reg), 0x08U }); break; // movzx e?x, word [rdx+d]; rol ?x, 8
+        case 4ULL: emit({ 0x8BU, modrm }); emit32(adr % memory_page_size); emit({ 0x0FU, (uint8_t)(0xC8U | reg) }); break;        // mov e?x, [rdx+d]; bswap e?x
+        case 8ULL: emit({ 0x48U, 0x8BU, modrm }); emit32(adr % memory_page_size); emit({ 0x48U, 0x0FU, (uint8_t)(0xC8U | reg) }); break; // mov r?x, [rdx+d]; bswap r?x
+        default: UNREACHABLE();
+        }
+    }
+
+    void  store_rax(address const  adr, uint64_t const  num_bytes)
+    {
+        load_page(adr);
+        switch (num_bytes)
+        {
+        case 1ULL: emit({ 0x88U, 0x82U }); break;                                           // mov [rdx+d], al
+        case 2ULL: emit({ 0x66U, 0xC1U, 0xC0U, 0x08U, 0x66U, 0x89U, 0x82U }); break;        // rol ax, 8; mov [rdx+d], ax
+        case 4ULL: emit({ 0x0FU, 0xC8U, 0x89U, 0x82U }); break;                             // bswap eax; mov [rdx+d], eax
+        case 8ULL: emit({ 0x48U, 0x0FU, 0xC8U, 0x48U, 0x89U, 0x82U }); break;               // bswap rax; mov [rdx+d], rax
+        default: UNREACHABLE();
+        }
+        emit32(adr % memory_page_size);
+    }
+
+    void  load_number_to_rcx(uint64_t const  value) { emit({ 0x48U, 0xB9U }); emit64(value); }    // mov rcx, imm64
+    void  copy_rcx_to_rax() { emit({ 0x48U, 0x89U, 0xC8U }); }          // mov rax, rcx
+    void  add_rcx_to_rax() { emit({ 0x48U, 0x01U, 0xC8U }); }           // add rax, rcx
+    void  multiply_rax_by_rcx() { emit({ 0x48U, 0x0FU, 0xAFU, 0xC1U }); }  // imul rax, rcx
+    void  and_rcx_to_rax() { emit({ 0x48U, 0x21U, 0xC8U }); }           // and rax, rcx
+    void  or_rcx_to_rax() { emit({ 0x48U, 0x09U, 0xC8U }); }            // or rax, rcx
+    void  xor_rcx_to_rax() { emit({ 0x48U, 0x31U, 0xC8U }); }           // xor rax, rcx
+    void  negate_rax() { emit({ 0x48U, 0xF7U, 0xD0U }); }               // not rax
+
+    void  clear_rcx() { emit({ 0x31U, 0xC9U }); }                       // xor ecx, ecx
+    void  clear_passes() { emit({ 0x45U, 0x31U, 0xC0U }); }             // xor r8d, r8d
+    void  increment_passes() { emit({ 0x49U, 0xFFU, 0xC0U }); }         // inc r8
+
+    /**
+     * The byte 'al' (when 'to_rax') or 'cl' is set to 1, if RAX is zero (when 'if_zero') or non-zero, and to 0 otherwise.
+     */
+    void  test_rax(bool const  if_zero, bool const  to_rax)
+    {
+        emit({ 0x48U, 0x85U, 0xC0U });                                                          // test rax, rax
+        emit({ 0x0FU, if_zero ? (uint8_t)0x94U : (uint8_t)0x95U, to_rax ? (uint8_t)0xC0U : (uint8_t)0xC1U });  // sete/setne al/cl
+    }
+
+    /**
+     * It returns the position of the displacement of the jump, which leaves the loop, when ECX differs from 'k'.
+     */
+    uint64_t  jump_out_of_loop_unless_ecx_is(uint8_t const  k)
+    {
+        emit({ 0x83U, 0xF9U, k });          // cmp ecx, k
+        emit({ 0x0FU, 0x85U });             // jne rel32
+        uint64_t const  result = position();
+        emit32(0U);
+        return result;
+    }
+
+    void  jump_to_loop_if_passes_below_limit(uint64_t const  loop_begin)
+    {
+        emit({ 0x49U, 0x39U, 0xF0U });      // cmp r8, rsi
+        emit({ 0x0FU, 0x82U });             // jb rel32
+        emit32((uint32_t)(int32_t)((int64_t)loop_begin - (int64_t)(position() + 4ULL)));
+    }
+
+    void  patch_jump(uint64_t const  displacement_position, uint64_t const  target)
+    {
+        uint32_t const  value = (uint32_t)(int32_t)((int64_t)target - (int64_t)(displacement_position + 4ULL));
+        for (uint64_t  i = 0ULL; i < 4ULL; ++i)
+            m_bytes.at(displacement_position + i) = (uint8_t)(value >> (8ULL * i));
+    }
+
+    /**
+     * RAX = (R8 << 1) | RCX
+     */
+    void  return_passes_and_rcx()
+    {
+        emit({ 0x4CU, 0x89U, 0xC0U });      // mov rax, r8
+        emit({ 0x48U, 0xD1U, 0xE0U });      // shl rax, 1
+        emit({ 0x48U, 0x09U, 0xC8U });      // or rax, rcx
+        emit({ 0xC3U });                    // ret
+    }
+
+private:
+    void  load_page(address const  adr)
+    {
+        emit({ 0x48U, 0x8BU, 0x97U });      // mov rdx, [rdi + disp32]
+        emit32((uint32_t)(8ULL * (adr / memory_page_size)));
+    }
+
+    void  emit(std::initializer_list<uint8_t> const  bytes) { m_bytes.insert(m_bytes.end(),bytes); }
+    void  emit32(uint64_t const  value) { for (uint64_t  i = 0ULL; i < 4ULL; ++i) m_bytes.push_back((uint8_t)(value >> (8ULL * i))); }
+    void  emit64(uint64_t const  value) { for (uint64_t  i = 0ULL; i < 8ULL; ++i) m_bytes.push_back((uint8_t)(value >> (8ULL * i))); }
+
+    std::vector<uint8_t>  m_bytes;
+};
+
+
+/**
+ * Ranges of registers read and written by a native instruction.
+ */
+void  collect_accesses(microcode::decoded_instruction const&  I, std::vector< std::pair<address,natexe::size> >&  reads,
+                       std::vector< std::pair<address,natexe::size> >&  writes)
+{
+    uint64_t const  n = I.arg(0ULL);
+    switch (I.GIK())
+    {
+    case microcode::GIK::SETANDCOPY__REG_ASGN_NUMBER:
+        writes.push_back({ I.arg(1ULL), n });
+        break;
+    case microcode::GIK::SETANDCOPY__REG_ASGN_REG:
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER:
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_NOT_REG:
+        reads.push_back({ I.arg(2ULL), n });
+        writes.push_back({ I.arg(1ULL), n });
+        break;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_REG:
+        reads.push_back({ I.arg(2ULL), n });
+        reads.push_back({ I.arg(3ULL), n });
+        writes.push_back({ I.arg(1ULL), n });
+        break;
+    case microcode::GIK::ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO:
+        reads.push_back({ I.arg(2ULL), n });
+        writes.push_back({ I.arg(1ULL), 1ULL });
+        break;
+    case microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO:
+    case microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO:
+        reads.push_back({ I.arg(1ULL), n });
+        break;
+    default:
+        UNREACHABLE();
+    }
+}
+
+/**
+ * It emits the machine code of a native instruction, except guards.
+ */
+void  emit_instruction(emitter&  E, microcode::decoded_instruction const&  I)
+{
+    using  OPERAND = emitter::OPERAND;
+
+    uint64_t const  n = I.arg(0ULL);
+    switch (I.GIK())
+    {
+    case microcode::GIK::SETANDCOPY__REG_ASGN_NUMBER:
+        E.load_number_to_rcx(I.arg(2ULL));
+        E.copy_rcx_to_rax();
+        E.store_rax(I.arg(1ULL),n);
+        break;
+    case microcode::GIK::SETANDCOPY__REG_ASGN_REG:
+        E.load(OPERAND::RAX,I.arg(2ULL),n);
+        E.store_rax(I.arg(1ULL),n);
+        break;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER:
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER:
+        E.load(OPERAND::RAX,I.arg(2ULL),n);
+        E.load_number_to_rcx(I.arg(3ULL));
+        break;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_REG:
+        E.load(OPERAND::RAX,I.arg(2ULL),n);
+        E.load(OPERAND::RCX,I.arg(3ULL),n);
+        break;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_NOT_REG:
+        E.load(OPERAND::RAX,I.arg(2ULL),n);
+        E.negate_rax();
+        E.store_rax(I.arg(1ULL),n);
+        break;
+    case microcode::GIK::ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO:
+        E.load(OPERAND::RAX,I.arg(2ULL),n);
+        E.test_rax(true,true);
+        E.store_rax(I.arg(1ULL),1ULL);
+        break;
+    default:
+        UNREACHABLE();
+    }
+
+    // Now the binary operations, whose operands were loaded above.
+    switch (I.GIK())
+    {
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER:
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG:
+        E.add_rcx_to_rax();
+        break;
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER:
+        E.multiply_rax_by_rcx();
+        break;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_REG:
+        E.and_rcx_to_rax();
+        break;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_REG:
+        E.or_rcx_to_rax();
+        break;
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_REG:
+        E.xor_rcx_to_rax();
+        break;
+    default:
+        return;
+    }
+    E.store_rax(I.arg(1ULL),n);
+}
+
+
+/**
+ * It copies the machine code into a new executable memory. It returns nullptr, if the memory cannot be allocated.
+ */
+void*  allocate_executable_memory(std::vector<uint8_t> const&  bytes, natexe::size&  num_bytes)
+{
+    num_bytes = align_to_memory_page_size(bytes.size());
+#   if defined(NATIVE_CODE_IS_SUPPORTED)
+    void* const  memory = mmap(nullptr,num_bytes,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+    if (memory == MAP_FAILED)
+        return nullptr;
+    std::copy(bytes.cbegin(),bytes.cend(),static_cast<uint8_t*>(memory));
+    if (mprotect(memory,num_bytes,PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(memory,num_bytes);
+        return nullptr;
+    }
+    return memory;
+#   else
+    (void)bytes;
+    return nullptr;
+#   endif
+}
+
+void  release_executable_memory(void* const  memory, natexe::size const  num_bytes)
+{
+#   if defined(NATIVE_CODE_IS_SUPPORTED)
+    munmap(memory,num_bytes);
+#   else
+    (void)memory;
+    (void)num_bytes;
+#   endif
+}
+
+
+}}}
+
+namespace analysis { namespace natexe {
+
+
+uint64_t constexpr  native_code::hot_threshold;
+uint64_t constexpr  native_code::max_num_records_of_region;
+uint64_t constexpr  native_code::no_loop;
+uint64_t constexpr  native_code::no_region;
+
+
+bool  native_code::is_supported() noexcept
+{
+#   if defined(NATIVE_CODE_IS_SUPPORTED)
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+native_code::native_code()
+    : m_heads()
+    , m_regions()
+    , m_blocks()
+    , m_uninitialised_page()
+    , m_is_enabled(is_supported())
+    , m_num_compilations(0ULL)
+    , m_num_refused_entries(0ULL)
+{}
+
+native_code::~native_code()
+{
+    for (auto const&  block : m_blocks)
+        release_executable_memory(block.first,block.second);
+}
+
+native_code::region const*  native_code::find_region(microcode::program const&  P, threaded_code&  code, uint64_t const  index)
+{
+    if (!m_is_enabled)
+        return nullptr;
+    if (index >= m_heads.size())
+        m_heads.resize(code.num_records(),{ 0ULL, no_region, nullptr, 0ULL });
+
+    if (m_heads.at(index).region != no_region)
+    {
+        region const&  R = *m_regions.at(m_heads.at(index).region);
+        if (R.component->version() == R.version)
+            return &R;
+        // The component was modified since the compilation, so records of the region might have changed.
+        m_heads.at(index).region = no_region;
+        m_heads.at(index).counter = 0ULL;
+    }
+
+    if (++m_heads.at(index).counter < hot_threshold)
+        return nullptr;
+    m_heads.at(index).counter = 0ULL;
+
+    threaded_code::record const&  r = code.at(index);
+    if (m_heads.at(index).refused_component == r.component && m_heads.at(index).refused_version == r.component->version())
+        return nullptr;
+    if (!compile(P,code,index))
+    {
+        m_heads.at(index).refused_component = code.at(index).component;
+        m_heads.at(index).refused_version = code.at(index).component->version();
+        return nullptr;
+    }
+    m_heads.at(index).region = m_regions.size() - 1ULL;
+    return m_regions.back().get();
+}
+
+bool  native_code::compile(microcode::program const&  P, threaded_code&  code, uint64_t const  index)
+{
+    ++m_num_compilations;
+
+    std::unique_ptr<region>  R(new region);
+    R->loop_successor = no_loop;
+    R->entry = nullptr;
+    R->component = code.at(index).component;
+    R->version = R->component->version();
+
+    // We follow the chain of records. Note that a resolution of a successor may lower new records, so we cannot keep
+    // references to records across it.
+    for (uint64_t  i = index; ; )
+    {
+        if (code.at(i).kind == threaded_code::KIND::WALKER || !is_native_instruction(*code.at(i).instruction))
+            break;
+        R->records.push_back(i);
+        if (code.at(i).kind == threaded_code::KIND::BRANCHING || R->records.size() == max_num_records_of_region)
+            break;
+        i = code.successor_record(P,i,0ULL);
+        if (std::find(R->records.cbegin(),R->records.cend(),i) != R->records.cend())
+            break;  // A cycle without any branching; the machine code performs it once per pass.
+    }
+    if (R->records.empty())
+        return false;
+
+    threaded_code::record const&  last = code.at(R->records.back());
+    bool const  ends_by_branching = last.kind == threaded_code::KIND::BRANCHING;
+    if (ends_by_branching)
+        for (uint64_t  k = 0ULL; k < 2ULL; ++k)
+            if (last.successors.at(k) == code.at(index).node)
+            {
+                R->loop_successor = k;
+                break;
+            }
+
+    std::vector< std::pair<address,natexe::size> >  reads;
+    std::vector< std::pair<address,natexe::size> >  writes;
+    for (uint64_t const  i : R->records)
+        collect_accesses(*code.at(i).instruction,reads,writes);
+    for (auto const&  range : writes)
+        if (std::find(R->written_pages.cbegin(),R->written_pages.cend(),range.first - range.first % memory_page_size) == R->written_pages.cend())
+            R->written_pages.push_back(range.first - range.first % memory_page_size);
+    for (auto const&  range : reads)
+        if (std::find(R->written_pages.cbegin(),R->written_pages.cend(),range.first - range.first % memory_page_size) == R->written_pages.cend() &&
+            std::find(R->read_pages.cbegin(),R->read_pages.cend(),range.first - range.first % memory_page_size) == R->read_pages.cend())
+            R->read_pages.push_back(range.first - range.first % memory_page_size);
+    R->accessed_ranges = reads;
+    R->accessed_ranges.insert(R->accessed_ranges.end(),writes.cbegin(),writes.cend());
+    std::sort(R->accessed_ranges.begin(),R->accessed_ranges.end());
+    R->accessed_ranges.erase(std::unique(R->accessed_ranges.begin(),R->accessed_ranges.end()),R->accessed_ranges.end());
+
+    emitter  E;
+    E.clear_passes();
+    uint64_t const  loop_begin = E.position();
+    for (uint64_t const  i : R->records)
+        if (code.at(i).kind == threaded_code::KIND::INSTRUCTION)
+            emit_instruction(E,*code.at(i).instruction);
+    E.increment_passes();
+    E.clear_rcx();
+    if (ends_by_branching)
+    {
+        microcode::decoded_instruction const&  I = *last.instruction;
+        E.load(emitter::OPERAND::RAX,I.arg(1ULL),I.arg(0ULL));
+        // The first successor is taken, when the first guard holds; otherwise RCX is set to 1.
+        E.test_rax(I.GIK() == microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO,false);
+        if (R->loop_successor != no_loop)
+        {
+            uint64_t const  exit_jump = E.jump_out_of_loop_unless_ecx_is((uint8_t)R->loop_successor);
+            E.jump_to_loop_if_passes_below_limit(loop_begin);
+            E.patch_jump(exit_jump,E.position());
+        }
+    }
+    E.return_passes_and_rcx();
+
+    natexe::size  num_bytes;
+    void* const  memory = allocate_executable_memory(E.bytes(),num_bytes);
+    if (memory == nullptr)
+    {
+        m_is_enabled = false;
+        return false;
+    }
+    m_blocks.push_back({memory,num_bytes});
+    R->entry = reinterpret_cast<entry_function>(memory);
+    m_regions.push_back(std::move(R));
+    return true;
+}
+
+uint64_t  native_code::run(region const&  R, memory_content&  reg, shadow_memory const&  reg_shadow, uint64_t const  max_num_passes, uint64_t&  k)
+{
+    ASSUMPTION(max_num_passes > 0ULL && R.entry != nullptr);
+
+    if (!reg_shadow.empty())
+        for (auto const&  range : R.accessed_ranges)
+            if (!reg_shadow.is_clean(range.first,range.second))
+            {
+                ++m_num_refused_entries;
+                return 0ULL;
+            }
+
+    std::array<byte*,memory_content::num_dense_pages>  pages;
+    pages.fill(nullptr);
+    for (address const  page_begin : R.written_pages)
+        pages.at(page_begin / memory_page_size) = reg.page(page_begin).data();
+    for (address const  page_begin : R.read_pages)
+    {
+        memory_page const* const  page = reg.find_page(page_begin);
+        // The machine code never writes into read pages, so we can pass the shared page of uninitialised bytes.
+        pages.at(page_begin / memory_page_size) = const_cast<byte*>(page == nullptr ? m_uninitialised_page.data() : page->data());
+    }
+
+    uint64_t const  result = R.entry(pages.data(),max_num_passes);
+    k = result & 1ULL;
+    return result >> 1ULL;
+}
+
+
+bool  is_native_instruction(microcode::decoded_instruction const&  I)
+{
+    std::vector< std::pair<address,natexe::size> >  reads;
+    std::vector< std::pair<address,natexe::size> >  writes;
+    switch (I.GIK())
+    {
+    case microcode::GIK::SETANDCOPY__REG_ASGN_NUMBER:
+    case microcode::GIK::SETANDCOPY__REG_ASGN_REG:
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER:
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG:
+    case microcode::GIK::INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER:
+    case microcode::GIK::ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_AND_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_OR_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_NOT_REG:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER:
+    case microcode::GIK::BITOPERATIONS__REG_ASGN_REG_XOR_REG:
+    case microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO:
+    case microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO:
+        collect_accesses(I,reads,writes);
+        break;
+    default:
+        return false;
+    }
+    for (auto const&  range : reads)
+        if (!is_native_access(range.first,range.second))
+            return false;
+    for (auto const&  range : writes)
+        // Writes into the first 8 bytes (i.e. into the program counter) are left to handlers, which check them.
+        if (!is_native_access(range.first,range.second) || range.first < 8ULL)
+            return false;
+    return true;
+}
+
+
+}}
@@ -0,0 +1,121 @@
+#include <rebours/analysis/native_execution/parallel_executions.hpp>
+#include <rebours/analysis/native_execution/execute_program.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+#include <rebours/analysis/native_execution/development.hpp>
+#include <memory>
+#include <mutex>
+
+namespace analysis { namespace natexe { namespace detail {
+
+
+/**
+ * Private copies of all shared data, which a single native execution performed by a worker thread may modify.
+ */
+struct  execution_sandbox
+{
+    execution_sandbox(execution_id const  eid, recovery_properties const&  rprops)
+        : rprops(rprops.fork_execution(eid))
+        , annotations()
+        , changes()
+        , error_message()
+    {}
+
+    recovery_properties  rprops;
+    microcode::annotations  annotations;    //!< Only annotations created during the execution.
+    program_changes  changes;
+    std::string  error_message;
+};
+
+void  merge_annotations(microcode::annotations const&  src, microcode::annotations&  dst)
+{
+    for (auto const&  node_annotations : src)
+        for (microcode::annotation const&  keyword_value : node_annotations.second)
+            if (microcode::find(dst,node_annotations.first,keyword_value.first) == nullptr)
+                microcode::append({ {node_annotations.first, { keyword_value } } },dst);
+}
+
+
+}}}
+
+namespace analysis { namespace natexe {
+
+
+std::vector<std::string>  perform_parallel_native_program_executions(
+        worker_pool&  pool,
+        recovery_properties&  rprops,
+        std::vector<execution_properties>&  eprops,
+        microcode::program&  prologue,
+        microcode::program&  program,
+        microcode::annotations&  annotations,
+        mal::recogniser::recognise_callback_fn const&  recognise,
+        std::vector<uint64_t>&  refused,
+        std::string const&  logging_root_dir,
+        bool const  log_also_prologue_program,
+        mal::recogniser::recognition_result_dump_fn const&  dump_recognition_results,
+        std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers,
+        prologue_snapshot_ptr const&  snapshot
+        )
+{
+    std::vector< std::unique_ptr<detail::execution_sandbox> >  sandboxes;
+    for (uint64_t  i = 0ULL; i < eprops.size(); ++i)
+    {
+        ASSUMPTION(eprops.at(i).get_execution_id() == rprops.num_executions_performed() + i);
+        sandboxes.push_back(std::unique_ptr<detail::execution_sandbox>(new detail::execution_sandbox(eprops.at(i).get_execution_id(),rprops)));
+    }
+
+    // The recogniser (and its cache) is shared by all executions, so we do not call it concurrently.
+    std::mutex  recognise_mutex;
+    mal::recogniser::recognise_callback_fn const  serialised_recognise =
+        [&recognise,&recognise_mutex](uint64_t const  start_address, mal::recogniser::reg_fn_type const&  reg_fn,
+                                      mal::recogniser::mem_fn_type const&  mem_fn) -> mal::recogniser::recognition_result {
+            std::lock_guard<std::mutex> const  lock(recognise_mutex);
+            return recognise(start_address,reg_fn,mem_fn);
+        };
+    mal::recogniser::recognition_result_dump_fn const  serialised_dump_recognition_results =
+        [&dump_recognition_results,&recognise_mutex](mal::recogniser::recognition_result const&  result, std::string const&  pathname) -> bool {
+            std::lock_guard<std::mutex> const  lock(recognise_mutex);
+            return dump_recognition_results(result,pathname);
+        };
+
+    // The shared program is only read while the executions run; each execution modifies its private copy.
+    for (uint64_t  i = 0ULL; i < eprops.size(); ++i)
+        pool.submit([&,i]() {
+            detail::execution_sandbox&  sandbox = *sandboxes.at(i);
+            std::unique_ptr<microcode::program> const  private_program = microcode::copy_program(program);
+            prologue_snapshot_ptr  forked_from = eprops.at(i).final_regs().empty() ? nullptr : snapshot;
+            sandbox.error_message = perform_single_native_program_execution(
+                                        sandbox.rprops,eprops.at(i),
+                                        prologue,*private_program,sandbox.annotations,
+                                        serialised_recognise,
+                                        logging_root_dir,
+                                        log_also_prologue_program,
+                                        serialised_dump_recognition_results,
+                                        ranges_to_registers,
+                                        forked_from ? &forked_from : nullptr
+                                        );
+            sandbox.changes = compute_program_changes(program,*private_program);
+        });
+    pool.wait();
+
+    std::vector<std::string>  error_messages;
+    std::unordered_set<node_id>  modified_nodes;
+    for (uint64_t  i = 0ULL; i < sandboxes.size(); ++i)
+    {
+        detail::execution_sandbox&  sandbox = *sandboxes.at(i);
+        error_messages.push_back(sandbox.error_message);
+        if (sandbox.rprops.num_executions_performed() <= eprops.at(i).get_execution_id())
+            continue;   //!< The execution has timeouted before it started.
+        if (!apply_program_changes(sandbox.changes,program,modified_nodes))
+        {
+            refused.push_back(i);
+            continue;
+        }
+        detail::merge_annotations(sandbox.annotations,annotations);
+        rprops.merge_execution(sandbox.rprops,eprops.at(i).get_execution_id());
+    }
+    return error_messages;
+}
+
+
+}}
@@ -0,0 +1,91 @@
+#include <rebours/analysis/native_execution/parallel_executions.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+#include <rebours/analysis/native_execution/development.hpp>
+
+namespace analysis { namespace natexe {
+
+
+program_changes  compute_program_changes(microcode::program const&  original, microcode::program&  modified)
+{
+    ASSUMPTION(original.num_components() <= modified.num_components());
+
+    program_changes  changes;
+    for (uint64_t  i = 0ULL; i < original.num_components(); ++i)
+    {
+        microcode::program_component const&  O = original.component(i);
+        microcode::program_component const&  M = modified.component(i);
+
+        component_changes  C{i,M.entry(),{},{},{},{}};
+        for (node_id const  n : M.nodes())
+            if (O.nodes().count(n) == 0ULL)
+                C.inserted_nodes.push_back(n);
+        for (node_id const  n : O.nodes())
+            if (M.nodes().count(n) == 0ULL)
+            {
+                C.erased_nodes.push_back(n);
+                changes.modified_nodes.insert(n);
+            }
+        for (auto const&  e_I : M.edges())
+            if (O.edges().count(e_I.first) == 0ULL)
+            {
+                C.inserted_edges.push_back({e_I.first,e_I.second.instruction()});
+                for (node_id const  n : { e_I.first.first, e_I.first.second })
+                    if (O.nodes().count(n) != 0ULL)
+                        changes.modified_nodes.insert(n);
+            }
+        for (auto const&  e_I : O.edges())
+            if (M.edges().count(e_I.first) == 0ULL)
+            {
+                C.erased_edges.push_back(e_I.first);
+                changes.modified_nodes.insert(e_I.first.first);
+                changes.modified_nodes.insert(e_I.first.second);
+            }
+        if (M.entry() != O.entry())
+            changes.modified_nodes.insert(O.entry());
+
+        if (M.entry() != O.entry() || !C.inserted_nodes.empty() || !C.erased_nodes.empty() || !C.inserted_edges.empty() || !C.erased_edges.empty())
+            changes.components.push_back(C);
+    }
+    for (uint64_t  i = original.num_components(); i < modified.num_components(); ++i)
+        changes.new_components.push_back(modified.share_component(i));
+    return changes;
+}
+
+bool  apply_program_changes(program_changes const&  changes, microcode::program&  program, std::unordered_set<node_id>&  modified_nodes)
+{
+    for (node_id const  n : changes.modified_nodes)
+        if (modified_nodes.count(n) != 0ULL)
+            return false;
+
+    // A new component, whose entry is already an entry of a component of the program, was merged before. If it is
+    // the same component (shared by copies of the program), then it is not inserted again. Otherwise, it conflicts.
+    std::vector<microcode::program_component_ptr>  new_components;
+    for (microcode::program_component_ptr const&  C : changes.new_components)
+    {
+        uint64_t const  index = program.find_component_with_entry_node(C->entry());
+        if (index == program.num_components())
+            new_components.push_back(C);
+        else if (&program.component(index) != C.get())
+            return false;
+    }
+
+    for (component_changes const&  C_changes : changes.components)
+    {
+        microcode::program_component&  C = program.component(C_changes.index);
+        C.insert_nodes(C_changes.inserted_nodes);
+        C.erase_edges(C_changes.erased_edges);
+        C.insert_edges(C_changes.inserted_edges);
+        if (C.entry() != C_changes.entry)
+            C.mark_entry(C_changes.entry);
+        C.erase_nodes(C_changes.erased_nodes);
+    }
+    for (microcode::program_component_ptr const&  C : new_components)
+        program.push_back(C);
+
+    modified_nodes.insert(changes.modified_nodes.cbegin(),changes.modified_nodes.cend());
+    return true;
+}
+
+
+}}
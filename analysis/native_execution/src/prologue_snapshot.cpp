@@ -0,0 +1,59 @@
+#include <rebours/analysis/native_execution/prologue_snapshot.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+#include <rebours/analysis/native_execution/development.hpp>
+
+namespace analysis { namespace natexe {
+
+
+prologue_snapshot::prologue_snapshot(execution_properties const&  eprops, recovery_properties const&  rprops)
+    : m_eprops(eprops,eprops.get_execution_id())
+    , m_records(rprops.records_of_execution(eprops.get_execution_id()))
+    , m_read_streams()
+{
+    ASSUMPTION(!m_eprops.final_regs().empty());
+    ASSUMPTION(!m_records.threads.empty());
+
+    for (auto const&  tid_values : m_records.input_impacts)
+        for (std::vector<input_impact_value> const&  values : tid_values.second)
+            for (input_impact_value const&  value : values)
+                if (value.is_in_stream())
+                    m_read_streams.insert(value.stream());
+    for (auto const&  sid_info : m_eprops.stream_allocations())
+        if (sid_info.second.cursor() != 0ULL)
+            m_read_streams.insert(sid_info.first);
+}
+
+bool  prologue_snapshot::can_fork(std::unordered_map<stream_id,std::vector<uint8_t> > const&  input_streams) const
+{
+    for (auto const&  sid_data : input_streams)
+        if (m_read_streams.count(sid_data.first) != 0ULL)
+            return false;
+    return true;
+}
+
+execution_properties  prologue_snapshot::fork(execution_id const  eid, std::unordered_map<stream_id,std::vector<uint8_t> > const&  input_streams) const
+{
+    ASSUMPTION(can_fork(input_streams));
+
+    execution_properties  eprops(m_eprops,eid);
+    for (auto const&  sid_data : input_streams)
+    {
+        stream_content&  content = eprops.contents_of_streams()[sid_data.first];
+        content.clear();
+        stream_write(content,0ULL,sid_data.second.data(),sid_data.second.size());
+
+        stream_open_info&  sinfo = eprops.stream_allocations()[sid_data.first];
+        sinfo.set_readable(true);
+        sinfo.set_size(sid_data.second.size());
+    }
+    return eprops;
+}
+
+void  prologue_snapshot::restore_records(recovery_properties&  rprops, execution_id const  eid) const
+{
+    rprops.set_records_of_execution(eid,m_records);
+}
+
+
+}}
@@ -21,6 +21,18 @@ switch_info::switch_info(node_id const  head_node)
     , m_havoc_instruction()
 {}
 
+switch_info::switch_info(
+        node_id const  head_node,
+        node_id const  default_node,
+        std::unordered_map<address,node_id> const&  cases,
+        microcode::instruction const  havoc_instruction
+        )
+    : m_head_node(head_node)
+    , m_default_node(default_node)
+    , m_cases(cases)
+    , m_havoc_instruction(havoc_instruction)
+{}
+
 void  switch_info::add_case(address const  adr, node_id const  case_node, node_id const  default_node)
 {
     ASSUMPTION(cases().count(adr) == 0ULL);
@@ -170,6 +182,8 @@ recovery_properties::recovery_properties(
     , m_visided_branchings()
     , m_input_impacts()
     , m_input_impact_links()
+    , m_is_fork(false)
+    , m_unexplored_journal()
 {
     ASSUMPTION(m_heap_begin <= m_heap_end);
     ASSUMPTION(m_temporaries_begin > 7ULL);
@@ -206,7 +220,12 @@ std::unordered_map<node_id,switch_info>::iterator  recovery_properties::add_swit
 
 void  recovery_properties::update_unexplored(node_id const  just_visited/*, std::vector<node_id> const&  successors_of_just_visited*/)
 {
-    m_unexplored.erase(just_visited);
+    auto const  it = m_unexplored.find(just_visited);
+    if (it == m_unexplored.end())
+        return;
+    if (m_is_fork)
+        m_unexplored_journal.push_back({false,it->second});
+    m_unexplored.erase(it);
 }
 
 void  recovery_properties::add_unexplored_exits(address const  IP, std::unordered_set<node_id> const&  exits)
@@ -215,6 +234,8 @@ void  recovery_properties::add_unexplored_exits(address const  IP, std::unordere
     {
         ASSUMPTION(m_unexplored.count(u) == 0ULL);
         m_unexplored.insert({u,{u,IP}});
+        if (m_is_fork)
+            m_unexplored_journal.push_back({true,{u,IP}});
     }
 }
 
@@ -266,7 +287,7 @@ void  recovery_properties::on_thread_step(execution_id const  eid, thread_id con
     m_interleaving_of_threads[eid].push_back(tid);
 }
 
-std::vector<thread_id> const&  recovery_properties::interleaving_of_threads(execution_id const  eid) const
+compact_trace const&  recovery_properties::interleaving_of_threads(execution_id const  eid) const
 {
     ASSUMPTION(m_interleaving_of_threads.size() > eid);
     return m_interleaving_of_threads.at(eid);
@@ -353,6 +374,119 @@ void  recovery_properties::add_input_impact_links(execution_id const  eid, threa
 }
 
 
+template<typename execution_data_type>
+static execution_data_type  copy_execution_data(std::vector<execution_data_type> const&  src, execution_id const  eid)
+{
+    return src.size() > eid ? src.at(eid) : execution_data_type{};
+}
+
+template<typename execution_data_type>
+static void  set_execution_data(std::vector<execution_data_type>&  dst, execution_id const  eid, execution_data_type const&  data)
+{
+    ASSUMPTION(dst.size() <= eid);
+    dst.resize(eid + 1ULL);
+    dst.back() = data;
+}
+
+execution_records  recovery_properties::records_of_execution(execution_id const  eid) const
+{
+    return {
+        copy_execution_data(m_node_histories,eid),
+        copy_execution_data(m_threads_of_executions,eid),
+        copy_execution_data(m_interleaving_of_threads,eid),
+        copy_execution_data(m_begins_of_concurrent_groups,eid),
+        copy_execution_data(m_branchings,eid),
+        copy_execution_data(m_input_impacts,eid),
+        copy_execution_data(m_input_impact_links,eid)
+        };
+}
+
+void  recovery_properties::set_records_of_execution(execution_id const  eid, execution_records const&  records)
+{
+    ASSUMPTION(eid == num_executions_performed());
+    ASSUMPTION(!records.threads.empty());
+    set_execution_data(m_node_histories,eid,records.node_histories);
+    set_execution_data(m_threads_of_executions,eid,records.threads);
+    set_execution_data(m_interleaving_of_threads,eid,records.interleaving_of_threads);
+    set_execution_data(m_begins_of_concurrent_groups,eid,records.begins_of_concurrent_groups);
+    set_execution_data(m_branchings,eid,records.branchings);
+    set_execution_data(m_input_impacts,eid,records.input_impacts);
+    set_execution_data(m_input_impact_links,eid,records.input_impact_links);
+}
+
+
+recovery_properties  recovery_properties::fork_execution(execution_id const  eid) const
+{
+    ASSUMPTION(eid >= num_executions_performed());
+    std::map<uint64_t,uint64_t>  important_code;
+    for (auto const  end_begin : m_important_code)
+        important_code.insert({end_begin.second,end_begin.first});
+    recovery_properties  result(m_heap_begin,m_heap_end,m_temporaries_begin,important_code,m_timeout_in_milliseconds);
+    result.m_start_time = m_start_time;
+    result.m_switches = m_switches;
+    result.m_unexplored = m_unexplored;
+    result.m_node_histories.resize(eid);
+    result.m_threads_of_executions.resize(eid);
+    result.m_interleaving_of_threads.resize(eid);
+    result.m_begins_of_concurrent_groups.resize(eid);
+    result.m_branchings.resize(eid);
+    result.m_visided_branchings = m_visided_branchings;
+    result.m_input_impacts.resize(eid);
+    result.m_input_impact_links.resize(eid);
+    result.m_is_fork = true;
+    return result;
+}
+
+template<typename execution_data_type>
+static void  move_execution_data(std::vector<execution_data_type>&  src, execution_id const  src_eid,
+                                 std::vector<execution_data_type>&  dst, execution_id const  dst_eid)
+{
+    ASSUMPTION(dst.size() <= dst_eid);
+    if (src.size() <= src_eid)
+        return;
+    dst.resize(dst_eid);
+    dst.push_back(std::move(src.at(src_eid)));
+}
+
+execution_id  recovery_properties::merge_execution(recovery_properties&  other, execution_id const  eid)
+{
+    ASSUMPTION(other.m_is_fork && !m_is_fork);
+    ASSUMPTION(other.num_executions_performed() > eid);
+
+    execution_id const  merged_eid = num_executions_performed();
+
+    move_execution_data(other.m_node_histories,eid,m_node_histories,merged_eid);
+    move_execution_data(other.m_threads_of_executions,eid,m_threads_of_executions,merged_eid);
+    move_execution_data(other.m_interleaving_of_threads,eid,m_interleaving_of_threads,merged_eid);
+    move_execution_data(other.m_begins_of_concurrent_groups,eid,m_begins_of_concurrent_groups,merged_eid);
+    move_execution_data(other.m_branchings,eid,m_branchings,merged_eid);
+    move_execution_data(other.m_input_impacts,eid,m_input_impacts,merged_eid);
+    move_execution_data(other.m_input_impact_links,eid,m_input_impact_links,merged_eid);
+
+    // Executions merged into this object must not modify the same switch (they would extend the same default node
+    // in the program). So, a switch with more cases than here can only come from the merged execution.
+    for (auto const&  head_info : other.m_switches)
+    {
+        auto const  it = m_switches.find(head_info.first);
+        if (it == m_switches.end())
+            m_switches.insert(head_info);
+        else if (it->second.cases().size() < head_info.second.cases().size())
+            it->second = head_info.second;
+    }
+
+    for (auto const&  insert_info : other.m_unexplored_journal)
+        if (insert_info.first)
+            m_unexplored.insert({insert_info.second.node(),insert_info.second});
+        else
+            m_unexplored.erase(insert_info.second.node());
+    other.m_unexplored_journal.clear();
+
+    m_visided_branchings.insert(other.m_visided_branchings.cbegin(),other.m_visided_branchings.cend());
+
+    return merged_eid;
+}
+
+
 bool is_inside_important_code(address const  adr, important_code_ranges const&  important_code)
 {
     auto const  it = important_code.lower_bound(adr);
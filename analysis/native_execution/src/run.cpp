@@ -1,10 +1,17 @@
 #include <rebours/analysis/native_execution/run.hpp>
 #include <rebours/analysis/native_execution/execute_program.hpp>
 #include <rebours/analysis/native_execution/exploration.hpp>
+#include <rebours/analysis/native_execution/parallel_executions.hpp>
+#include <rebours/analysis/native_execution/checkpoint.hpp>
+#include <rebours/analysis/native_execution/file_utils.hpp>
 #include <rebours/analysis/native_execution/dump.hpp>
 #include <rebours/analysis/native_execution/msgstream.hpp>
 #include <rebours/analysis/native_execution/assumptions.hpp>
 #include <rebours/analysis/native_execution/invariants.hpp>
+#include <unordered_set>
+#include <algorithm>
+#include <memory>
+#include <chrono>
 
 namespace analysis { namespace natexe {
 
@@ -23,13 +30,17 @@ std::string  run(microcode::program&  prologue,
                  std::string const&  logging_root_dir,
                  bool const  log_also_prologue_program,
                  mal::recogniser::recognition_result_dump_fn const&  dump_recognition_results,
-                 std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers
+                 std::map<std::pair<uint64_t,uint64_t>,std::string> const&  ranges_to_registers,
+                 uint32_t const  num_workers,
+                 std::string const&  checkpoint_pathname,
+                 uint32_t const  checkpoint_period_in_seconds
                  )
 {
     ASSUMPTION(heap_begin <= heap_end);
     ASSUMPTION(temporaries_begin > 7ULL);
     ASSUMPTION(!default_stack_init_data.empty());
     ASSUMPTION(timeout_in_seconds > 0U);
+    ASSUMPTION(num_workers > 0U);
 
     recovery_properties  rprops{heap_begin,heap_end,temporaries_begin,important_code,timeout_in_seconds * 1000ULL};
     {
@@ -37,44 +48,123 @@ std::string  run(microcode::program&  prologue,
             rprops.add_unexplored_exits(exit_ip.second,{exit_ip.first});
     }
 
-    execution_id  eid = 0ULL;
-
-    execution_properties  eprops{eid,heap_begin,heap_end,temporaries_begin};
+    std::vector<execution_properties>  executions;
+    executions.push_back(execution_properties{0ULL,heap_begin,heap_end,temporaries_begin});
     {
+        execution_properties&  eprops = executions.back();
         eprops.contents_of_streams().insert({{"#1",{}}});
         stream_open_info&  sinfo = eprops.stream_allocations()["#1"];
         sinfo.set_readable(true);
         sinfo.set_size(default_stack_init_data.size());
         stream_write(eprops.contents_of_streams().at("#1"),0ULL,default_stack_init_data.data(),default_stack_init_data.size());
     }
+    std::vector< std::unordered_map<stream_id,std::vector<uint8_t> > >  inputs_of_executions(1ULL);
+
+    std::unique_ptr<worker_pool> const  pool(num_workers > 1U ? new worker_pool(num_workers) : nullptr);
+
+    // The state after the prologue of the first execution. Later executions are forked from it, unless their input
+    // changes streams read by the prologue.
+    prologue_snapshot_ptr  snapshot;
 
     std::string  error_message;
 
+    // A checkpoint is saved after the first round of executions and then after each round (at most once per
+    // 'checkpoint_period_in_seconds'), so that the recovery can be resumed from the last saved round. A round
+    // interrupted by the timeout is not saved, so the checkpoint of a timed out analysis is the last one saved.
+    bool  resumed = false;
+    if (!checkpoint_pathname.empty() && fileutl::file_exists(checkpoint_pathname))
+    {
+        std::unique_ptr<microcode::program>  loaded_program;
+        error_message = load_checkpoint_file(checkpoint_pathname,prologue,loaded_program,annotations,rprops,inputs_of_executions);
+        if (!error_message.empty())
+        {
+            dump_create_root_file(error_message);
+            return error_message;
+        }
+        program.swap(*loaded_program);
+        executions.clear();
+        resumed = true;
+    }
+    std::chrono::system_clock::time_point  checkpoint_time = std::chrono::system_clock::now();
+    bool  checkpoint_saved = false;
+
     while (true)
     {
-        error_message = perform_single_native_program_execution(
-                            rprops,eprops,
-                            prologue,program,annotations,
-                            recognise,
-                            logging_root_dir,
-                            log_also_prologue_program,
-                            dump_recognition_results,
-                            ranges_to_registers
-                            );
-        if (error_message == "Timeout!")
-            break;
+        std::vector< std::unordered_map<stream_id,std::vector<uint8_t> > >  refused_inputs;
+        if (resumed)
+        {
+            // The round was performed before the checkpoint was saved; its refused inputs were stored in the checkpoint.
+            refused_inputs.swap(inputs_of_executions);
+            resumed = false;
+        }
+        else
+        {
+            if (executions.size() == 1ULL)
+            {
+                error_message = perform_single_native_program_execution(
+                                    rprops,executions.front(),
+                                    prologue,program,annotations,
+                                    recognise,
+                                    logging_root_dir,
+                                    log_also_prologue_program,
+                                    dump_recognition_results,
+                                    ranges_to_registers,
+                                    !executions.front().final_regs().empty() || !snapshot ? &snapshot : nullptr
+                                    );
+                if (error_message == "Timeout!")
+                    break;
+            }
+            else
+            {
+                std::vector<uint64_t>  refused;
+                std::vector<std::string> const  error_messages =
+                        perform_parallel_native_program_executions(
+                                    *pool,rprops,executions,
+                                    prologue,program,annotations,
+                                    recognise,
+                                    refused,
+                                    logging_root_dir,
+                                    log_also_prologue_program,
+                                    dump_recognition_results,
+                                    ranges_to_registers,
+                                    snapshot
+                                    );
+                if (std::find(error_messages.cbegin(),error_messages.cend(),"Timeout!") != error_messages.cend())
+                {
+                    error_message = "Timeout!";
+                    break;
+                }
+                for (uint64_t const  i : refused)
+                    refused_inputs.push_back(std::move(inputs_of_executions.at(i)));
+            }
+
+            executions.clear();
+
+            error_message = merge_recovered_traces(program,rprops);
+            if (!error_message.empty())
+                break;
+        }
 
-        eprops = execution_properties{++eid,heap_begin,heap_end,temporaries_begin};
+        // Executions refused by the merge are repeated first, so they get their chance before other exits.
+        inputs_of_executions.swap(refused_inputs);
 
-        error_message = merge_recovered_traces(program,rprops);
-        if (!error_message.empty())
-            break;
+        if (!checkpoint_pathname.empty() && (!checkpoint_saved ||
+                std::chrono::system_clock::now() - checkpoint_time >= std::chrono::seconds(checkpoint_period_in_seconds)))
+        {
+            error_message = save_checkpoint_file(checkpoint_pathname,prologue,program,annotations,rprops,inputs_of_executions);
+            if (!error_message.empty())
+                break;
+            checkpoint_time = std::chrono::system_clock::now();
+            checkpoint_saved = true;
+        }
 
-        std::unordered_map<stream_id,std::vector<uint8_t> > input_streams;
-        while (true)
+        std::unordered_set<node_id>  chosen_exits;
+        while (inputs_of_executions.size() < num_workers)
         {
+            std::unordered_map<stream_id,std::vector<uint8_t> > input_streams;
+
             node_id  next_exit = 0ULL;
-            error_message = choose_next_unexplored_exit(program,rprops,next_exit);
+            error_message = choose_next_unexplored_exit(program,rprops,next_exit,chosen_exits);
             if (!error_message.empty())
                 break;
 
@@ -89,19 +179,51 @@ std::string  run(microcode::program&  prologue,
                 break;
 
             error_message = compute_input_for_reaching_next_goal(prologue,program,rprops,next_goal,traces,input_streams);
-            if (!error_message.empty() || !input_streams.empty())
+            if (!error_message.empty())
                 break;
+            if (!input_streams.empty())
+            {
+                inputs_of_executions.push_back(std::move(input_streams));
+                chosen_exits.insert(next_exit);
+                continue;
+            }
 
             close_unexplored_exit(program,rprops,next_exit);
         }
         if (!error_message.empty())
-            break;
+        {
+            if (inputs_of_executions.empty())
+                break;
+            error_message.clear();  //!< We first perform the executions already prepared.
+        }
 
-        error_message = setup_next_execution_properties(eprops,input_streams,default_stack_init_data);
+        for (uint64_t  i = 0ULL; i < inputs_of_executions.size(); ++i)
+        {
+            execution_id const  eid = rprops.num_executions_performed() + i;
+            if (snapshot && snapshot->can_fork(inputs_of_executions.at(i)))
+            {
+                executions.push_back(snapshot->fork(eid,inputs_of_executions.at(i)));
+                continue;
+            }
+            executions.push_back(execution_properties{eid,heap_begin,heap_end,temporaries_begin});
+            error_message = setup_next_execution_properties(executions.back(),inputs_of_executions.at(i),default_stack_init_data);
+            if (!error_message.empty())
+                break;
+        }
         if (!error_message.empty())
             break;
     }
 
+    if (!checkpoint_pathname.empty() && error_message != "Timeout!")
+    {
+        // The state is consistent unless a round of executions was interrupted by the timeout. Then the checkpoint
+        // saved after the last completed round is kept.
+        std::string const  checkpoint_error_message =
+                save_checkpoint_file(checkpoint_pathname,prologue,program,annotations,rprops,inputs_of_executions);
+        if (error_message.empty())
+            error_message = checkpoint_error_message;
+    }
+
     dump_create_root_file(error_message);
 
     return error_message;
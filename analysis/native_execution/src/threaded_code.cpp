@@ -0,0 +1,93 @@
+#include <rebours/analysis/native_execution/threaded_code.hpp>
+#include <rebours/analysis/native_execution/recovery_properties.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+
+namespace analysis { namespace natexe {
+
+
+uint64_t constexpr  threaded_code::no_record;
+uint64_t constexpr  threaded_code::max_num_steps_of_run;
+
+
+threaded_code::threaded_code(bool const  use_native_code)
+    : m_records()
+    , m_indices()
+    , m_num_lowerings(0ULL)
+    , m_native(use_native_code && native_code::is_supported() ? new native_code : nullptr)
+{}
+
+uint64_t  threaded_code::find_record(microcode::program const&  P, node_id const  node)
+{
+    auto const  it = m_indices.find(node);
+    if (it != m_indices.cend())
+    {
+        if (!is_up_to_date(m_records.at(it->second)))
+            lower(P,it->second);
+        return it->second;
+    }
+    uint64_t const  index = m_records.size();
+    m_records.push_back(record());
+    m_records.back().node = node;
+    m_indices.insert({node,index});
+    lower(P,index);
+    return index;
+}
+
+uint64_t  threaded_code::successor_record(microcode::program const&  P, uint64_t const  index, uint64_t const  k)
+{
+    ASSUMPTION(m_records.at(index).kind != KIND::WALKER && k < (m_records.at(index).kind == KIND::BRANCHING ? 2ULL : 1ULL));
+    uint64_t const  next = m_records.at(index).next.at(k);
+    if (next == no_record)
+    {
+        uint64_t const  result = find_record(P,m_records.at(index).successors.at(k));
+        m_records.at(index).next.at(k) = result;
+        return result;
+    }
+    if (!is_up_to_date(m_records.at(next)))
+        lower(P,next);
+    return next;
+}
+
+void  threaded_code::lower(microcode::program const&  P, uint64_t const  index)
+{
+    ++m_num_lowerings;
+
+    record&  r = m_records.at(index);
+    uint64_t const  comp_index = microcode::find_component(P,r.node);
+    ASSUMPTION(comp_index < P.num_components());
+    microcode::program_component const&  C = P.component(comp_index);
+
+    r.kind = KIND::WALKER;
+    r.handler = nullptr;
+    r.instruction = nullptr;
+    r.successors = {{ 0ULL, 0ULL }};
+    r.next = {{ no_record, no_record }};
+    r.component = &C;
+    r.version = C.version();
+
+    std::vector<node_id> const&  successors = C.successors(r.node);
+    std::vector<microcode::decoded_instruction> const&  instructions = C.successor_instructions(r.node);
+    if (successors.size() == 1ULL)
+    {
+        microcode::decoded_instruction const&  I = instructions.front();
+        r.handler = find_instruction_handler(I.GIK());
+        if (r.handler != nullptr && !is_switch_instruction(I.instruction()))
+        {
+            r.kind = KIND::INSTRUCTION;
+            r.instruction = &I;
+            r.successors.front() = successors.front();
+        }
+    }
+    else if (successors.size() == 2ULL)
+    {
+        INVARIANT(instructions.front().GIK() == microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO ||
+                  instructions.front().GIK() == microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO);
+        r.kind = KIND::BRANCHING;
+        r.instruction = &instructions.front();
+        r.successors = {{ successors.front(), successors.back() }};
+    }
+}
+
+
+}}
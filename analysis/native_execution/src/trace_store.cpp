@@ -0,0 +1,353 @@
+#include <rebours/analysis/native_execution/trace_store.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <cstdio>
+#if !defined(WIN32)
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+namespace analysis { namespace natexe {
+
+
+struct  trace_chunk
+{
+    static uint64_t constexpr  num_checkpoints = compact_trace::chunk_size / compact_trace::checkpoint_stride;
+
+    using  checkpoint_values = std::array<uint64_t,num_checkpoints>;
+    using  checkpoint_offsets = std::array<uint16_t,num_checkpoints>;
+
+    /**
+     * The checkpoint 'k' is the value at the index 'k * checkpoint_stride' and the offset in 'bytes' of the
+     * encoded difference of the next value. Checkpoints are always kept in memory.
+     */
+    trace_chunk(checkpoint_values const&  values, checkpoint_offsets const&  offsets, std::vector<uint8_t>&&  bytes);
+    ~trace_chunk();
+
+    uint64_t  first_value() const noexcept { return m_checkpoint_values.front(); }
+    uint8_t const*  data() const noexcept { return m_data; }
+
+    /**
+     * It returns the value at the passed index into the chunk and it moves 'cursor' to the encoded difference
+     * of the next value.
+     */
+    uint64_t  seek(uint64_t const  index, uint8_t const*&  cursor) const;
+
+private:
+    checkpoint_values  m_checkpoint_values;
+    checkpoint_offsets  m_checkpoint_offsets;
+    std::vector<uint8_t>  m_bytes;  //!< Empty, when the chunk is spilled.
+    uint8_t const*  m_data;
+};
+
+
+}}
+
+namespace analysis { namespace natexe { namespace detail {
+
+
+std::atomic<uint64_t>  s_trace_memory_budget(256ULL << 20U);
+std::atomic<uint64_t>  s_num_bytes_in_memory(0ULL);
+std::atomic<uint64_t>  s_num_bytes_spilled(0ULL);
+
+
+/**
+ * An anonymous temporary file mapped into memory by segments. A segment is never unmapped (till the exit), so
+ * pointers to stored bytes stay valid.
+ */
+struct  trace_spill_file
+{
+    static uint64_t constexpr  segment_size = 64ULL << 20U;
+
+    trace_spill_file()
+        : m_mutex()
+        , m_file(nullptr)
+        , m_segments()
+        , m_used_in_last_segment(segment_size)
+        , m_is_broken(false)
+    {}
+
+    ~trace_spill_file()
+    {
+#if !defined(WIN32)
+        for (uint8_t* const  segment : m_segments)
+            munmap(segment,segment_size);
+#endif
+        if (m_file != nullptr)
+            std::fclose(m_file);
+    }
+
+    /**
+     * It returns nullptr, when the bytes could not be stored; the caller then keeps them in memory.
+     */
+    uint8_t const*  store(std::vector<uint8_t> const&  bytes)
+    {
+        ASSUMPTION(bytes.size() <= segment_size);
+#if defined(WIN32)
+        (void)bytes;
+        return nullptr;
+#else
+        std::lock_guard<std::mutex> const  lock(m_mutex);
+        if (m_is_broken)
+            return nullptr;
+        if (m_used_in_last_segment + bytes.size() > segment_size && !add_segment())
+        {
+            m_is_broken = true;
+            return nullptr;
+        }
+        uint8_t* const  result = m_segments.back() + m_used_in_last_segment;
+        std::memcpy(result,bytes.data(),bytes.size());
+        m_used_in_last_segment += bytes.size();
+        return result;
+#endif
+    }
+
+private:
+
+#if !defined(WIN32)
+    bool  add_segment()
+    {
+        if (m_file == nullptr)
+            m_file = std::tmpfile();
+        if (m_file == nullptr)
+            return false;
+        int const  fd = fileno(m_file);
+        off_t const  offset = (off_t)(m_segments.size() * segment_size);
+        if (ftruncate(fd,offset + (off_t)segment_size) != 0)
+            return false;
+        void* const  segment = mmap(nullptr,segment_size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,offset);
+        if (segment == MAP_FAILED)
+            return false;
+        m_segments.push_back((uint8_t*)segment);
+        m_used_in_last_segment = 0ULL;
+        return true;
+    }
+#endif
+
+    std::mutex  m_mutex;
+    std::FILE*  m_file;
+    std::vector<uint8_t*>  m_segments;
+    uint64_t  m_used_in_last_segment;
+    bool  m_is_broken;
+};
+
+
+trace_spill_file&  spill_file()
+{
+    static trace_spill_file  file;
+    return file;
+}
+
+
+void  write_varint(std::vector<uint8_t>&  bytes, uint64_t  value)
+{
+    for ( ; value >= 0x80ULL; value >>= 7U)
+        bytes.push_back((uint8_t)(value | 0x80ULL));
+    bytes.push_back((uint8_t)value);
+}
+
+uint64_t  read_varint(uint8_t const*&  cursor)
+{
+    uint64_t  value = 0ULL;
+    for (uint32_t  shift = 0U; ; shift += 7U)
+    {
+        uint8_t const  byte = *cursor++;
+        value |= (uint64_t)(byte & 0x7fU) << shift;
+        if ((byte & 0x80U) == 0U)
+            return value;
+    }
+}
+
+/**
+ * Differences are stored in the zig-zag form, so that small negative differences are small numbers as well.
+ */
+uint64_t  encode_difference(uint64_t const  previous, uint64_t const  value)
+{
+    uint64_t const  diff = value - previous;
+    return (diff << 1U) ^ (uint64_t)((int64_t)diff >> 63U);
+}
+
+uint64_t  decode_difference(uint64_t const  previous, uint64_t const  code)
+{
+    return previous + ((code >> 1U) ^ (~(code & 1ULL) + 1ULL));
+}
+
+
+}}}
+
+namespace analysis { namespace natexe {
+
+
+uint64_t constexpr  compact_trace::chunk_size;
+uint64_t constexpr  compact_trace::checkpoint_stride;
+uint64_t constexpr  trace_chunk::num_checkpoints;
+
+
+trace_chunk::trace_chunk(checkpoint_values const&  values, checkpoint_offsets const&  offsets, std::vector<uint8_t>&&  bytes)
+    : m_checkpoint_values(values)
+    , m_checkpoint_offsets(offsets)
+    , m_bytes()
+    , m_data(nullptr)
+{
+    uint64_t const  size = bytes.size();
+    if (detail::s_num_bytes_in_memory + size > detail::s_trace_memory_budget)
+        m_data = detail::spill_file().store(bytes);
+    if (m_data != nullptr)
+        detail::s_num_bytes_spilled += size;
+    else
+    {
+        m_bytes.swap(bytes);
+        m_bytes.shrink_to_fit();
+        m_data = m_bytes.data();
+        detail::s_num_bytes_in_memory += size;
+    }
+    detail::s_num_bytes_in_memory += sizeof(m_checkpoint_values) + sizeof(m_checkpoint_offsets);
+}
+
+trace_chunk::~trace_chunk()
+{
+    detail::s_num_bytes_in_memory -= m_bytes.size() + sizeof(m_checkpoint_values) + sizeof(m_checkpoint_offsets);
+}
+
+uint64_t  trace_chunk::seek(uint64_t const  index, uint8_t const*&  cursor) const
+{
+    ASSUMPTION(index < compact_trace::chunk_size);
+    uint64_t const  checkpoint = index / compact_trace::checkpoint_stride;
+    uint64_t  value = m_checkpoint_values.at(checkpoint);
+    cursor = m_data + m_checkpoint_offsets.at(checkpoint);
+    for (uint64_t  i = checkpoint * compact_trace::checkpoint_stride; i != index; ++i)
+        value = detail::decode_difference(value,detail::read_varint(cursor));
+    return value;
+}
+
+
+compact_trace::const_iterator::const_iterator(compact_trace const* const  trace, uint64_t const  index)
+    : m_trace(trace)
+    , m_index(index)
+    , m_cursor(nullptr)
+    , m_value(0ULL)
+{
+    ASSUMPTION(m_trace != nullptr && m_index <= m_trace->size());
+    if (m_index == m_trace->size())
+        return;
+    if (m_index % chunk_size == 0ULL)
+        load_value();
+    else if (m_index < m_trace->m_chunks.size() * chunk_size)
+        m_value = m_trace->m_chunks.at(m_index / chunk_size)->seek(m_index % chunk_size,m_cursor);
+    else
+        m_value = m_trace->m_tail.at(m_index % chunk_size);
+}
+
+compact_trace::const_iterator&  compact_trace::const_iterator::operator++()
+{
+    ASSUMPTION(m_index < m_trace->size());
+    ++m_index;
+    if (m_index == m_trace->size())
+        return *this;
+    if (m_index % chunk_size == 0ULL)
+        load_value();
+    else if (m_index < m_trace->m_chunks.size() * chunk_size)
+        m_value = detail::decode_difference(m_value,detail::read_varint(m_cursor));
+    else
+        m_value = m_trace->m_tail.at(m_index % chunk_size);
+    return *this;
+}
+
+void  compact_trace::const_iterator::load_value()
+{
+    ASSUMPTION(m_index % chunk_size == 0ULL);
+    uint64_t const  chunk = m_index / chunk_size;
+    if (chunk < m_trace->m_chunks.size())
+    {
+        m_value = m_trace->m_chunks.at(chunk)->first_value();
+        m_cursor = m_trace->m_chunks.at(chunk)->data();
+    }
+    else
+        m_value = m_trace->m_tail.front();
+}
+
+
+compact_trace::compact_trace()
+    : m_chunks()
+    , m_tail()
+{}
+
+compact_trace::compact_trace(std::initializer_list<uint64_t> const  values)
+    : compact_trace()
+{
+    for (uint64_t const  value : values)
+        push_back(value);
+}
+
+void  compact_trace::push_back(uint64_t const  value)
+{
+    m_tail.push_back(value);
+    if (m_tail.size() < chunk_size)
+        return;
+    std::vector<uint8_t>  bytes;
+    bytes.reserve(2ULL * chunk_size);
+    trace_chunk::checkpoint_values  values;
+    trace_chunk::checkpoint_offsets  offsets;
+    for (uint64_t  i = 0ULL; i < m_tail.size(); ++i)
+    {
+        if (i % checkpoint_stride == 0ULL)
+        {
+            values.at(i / checkpoint_stride) = m_tail.at(i);
+            offsets.at(i / checkpoint_stride) = (uint16_t)bytes.size();
+        }
+        if (i + 1ULL < m_tail.size())
+            detail::write_varint(bytes,detail::encode_difference(m_tail.at(i),m_tail.at(i + 1ULL)));
+    }
+    m_chunks.push_back(std::make_shared<trace_chunk const>(values,offsets,std::move(bytes)));
+    m_tail.clear();
+}
+
+uint64_t  compact_trace::at(uint64_t const  index) const
+{
+    ASSUMPTION(index < size());
+    uint64_t const  chunk = index / chunk_size;
+    if (chunk == m_chunks.size())
+        return m_tail.at(index % chunk_size);
+    uint8_t const*  cursor;
+    return m_chunks.at(chunk)->seek(index % chunk_size,cursor);
+}
+
+uint64_t  compact_trace::back() const
+{
+    ASSUMPTION(!empty());
+    return m_tail.empty() ? at(size() - 1ULL) : m_tail.back();
+}
+
+bool  compact_trace::operator==(compact_trace const&  other) const
+{
+    return size() == other.size() && std::equal(begin(),end(),other.begin());
+}
+
+
+void  set_trace_memory_budget(uint64_t const  num_bytes)
+{
+    detail::s_trace_memory_budget = num_bytes;
+}
+
+uint64_t  trace_memory_budget()
+{
+    return detail::s_trace_memory_budget;
+}
+
+uint64_t  num_bytes_of_traces_in_memory()
+{
+    return detail::s_num_bytes_in_memory;
+}
+
+uint64_t  num_bytes_of_traces_spilled()
+{
+    return detail::s_num_bytes_spilled;
+}
+
+
+}}
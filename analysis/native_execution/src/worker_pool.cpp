@@ -0,0 +1,93 @@
+#include <rebours/analysis/native_execution/worker_pool.hpp>
+#include <rebours/analysis/native_execution/assumptions.hpp>
+#include <rebours/analysis/native_execution/invariants.hpp>
+
+namespace analysis { namespace natexe {
+
+
+worker_pool::worker_pool(uint32_t const  num_workers)
+    : m_workers()
+    , m_tasks()
+    , m_num_running(0ULL)
+    , m_stop(false)
+    , m_exception()
+    , m_mutex()
+    , m_task_ready()
+    , m_all_done()
+{
+    ASSUMPTION(num_workers > 0U);
+    for (uint32_t  i = 0U; i < num_workers; ++i)
+        m_workers.push_back(std::thread(&worker_pool::worker_loop,this));
+}
+
+worker_pool::~worker_pool()
+{
+    {
+        std::lock_guard<std::mutex> const  lock(m_mutex);
+        m_stop = true;
+    }
+    m_task_ready.notify_all();
+    for (std::thread&  worker : m_workers)
+        worker.join();
+}
+
+void  worker_pool::submit(std::function<void()> const&  task)
+{
+    ASSUMPTION(task.operator bool());
+    {
+        std::lock_guard<std::mutex> const  lock(m_mutex);
+        ASSUMPTION(!m_stop);
+        m_tasks.push_back(task);
+    }
+    m_task_ready.notify_one();
+}
+
+void  worker_pool::wait()
+{
+    std::unique_lock<std::mutex>  lock(m_mutex);
+    m_all_done.wait(lock,[this]() { return m_tasks.empty() && m_num_running == 0ULL; });
+    if (m_exception)
+    {
+        std::exception_ptr const  exception = m_exception;
+        m_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void  worker_pool::worker_loop()
+{
+    while (true)
+    {
+        std::function<void()>  task;
+        {
+            std::unique_lock<std::mutex>  lock(m_mutex);
+            m_task_ready.wait(lock,[this]() { return m_stop || !m_tasks.empty(); });
+            if (m_tasks.empty())
+            {
+                INVARIANT(m_stop);
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_num_running;
+        }
+
+        std::exception_ptr  exception;
+        try { task(); }
+        catch (...) { exception = std::current_exception(); }
+
+        bool  all_done;
+        {
+            std::lock_guard<std::mutex> const  lock(m_mutex);
+            if (exception && !m_exception)
+                m_exception = exception;
+            --m_num_running;
+            all_done = m_tasks.empty() && m_num_running == 0ULL;
+        }
+        if (all_done)
+            m_all_done.notify_all();
+    }
+}
+
+
+}}
@@ -0,0 +1,255 @@
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/checkpoint.hpp>
+#include <rebours/analysis/native_execution/recovery_properties.hpp>
+#include <rebours/program/program.hpp>
+#include <rebours/program/assembly.hpp>
+#include <rebours/program/binary.hpp>
+#include <vector>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+
+using namespace analysis::natexe;
+
+
+/**
+ * It creates a program similar to recovered ones: a long sequence of basic blocks of small instructions, where
+ * each block ends with a branching, and a second component loading data of a section.
+ */
+static std::unique_ptr<microcode::program>  create_program(uint64_t const  num_blocks, microcode::annotations&  annotations)
+{
+    std::unique_ptr<microcode::program>  program = microcode::create_initial_program("test","MAIN");
+    microcode::program_component&  C = program->start_component();
+    node_id  node = C.entry();
+    for (uint64_t  i = 0ULL; i < num_blocks; ++i)
+    {
+        node = C.insert_sequence(node,{
+                    microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,0x100ULL,0x400000ULL + 0x10ULL * i),
+                    microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(8U,0x108ULL,0x100ULL,i % 16ULL),
+                    microcode::create_DATATRANSFER__REG_ASGN_DEREF_REG(4U,0x110ULL,0x108ULL),
+                    });
+        std::pair<node_id,node_id> const  branches = C.insert_branching(microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO,1U,0x110ULL,node);
+        annotations[branches.first].push_back({ "IP", std::to_string(0x400000ULL + 0x10ULL * i) });
+        node = branches.second;
+    }
+    program->push_back(std::make_shared<microcode::program_component>("test","DATA"));
+    program->component(1ULL).insert_sequence(program->component(1ULL).entry(),{
+                microcode::create_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA(0x600000ULL,std::vector<uint8_t>(4096ULL,0xccU)),
+                microcode::create_MISCELLANEOUS__STOP(),
+                });
+    return program;
+}
+
+static void test_binary_program()
+{
+    std::cout << "Starting: test_binary_program()\n";
+
+    microcode::annotations  annotations;
+    std::unique_ptr<microcode::program> const  program = create_program(1000ULL,annotations);
+
+    std::stringstream  binary;
+    microcode::save_program_as_binary(binary,*program,&annotations);
+    std::string  error_message;
+    std::pair<std::unique_ptr<microcode::program>,std::unique_ptr<microcode::annotations> > const  loaded =
+            microcode::create_program_from_binary(binary,error_message);
+    TEST_SUCCESS(error_message.empty() && loaded.first.operator bool() && loaded.second.operator bool());
+
+    TEST_SUCCESS(loaded.first->name() == program->name() && loaded.first->num_components() == program->num_components());
+    for (uint64_t  i = 0ULL; i < program->num_components(); ++i)
+    {
+        microcode::program_component const&  C = program->component(i);
+        microcode::program_component const&  D = loaded.first->component(i);
+        TEST_SUCCESS(C.name() == D.name() && C.entry() == D.entry() && C.exits() == D.exits());
+        TEST_SUCCESS(C.nodes().size() == D.nodes().size() && C.edges().size() == D.edges().size());
+        for (node_id const  n : C.nodes())
+        {
+            TEST_SUCCESS(D.nodes().count(n) == 1ULL && C.successors(n) == D.successors(n));
+            for (uint64_t  k = 0ULL; k < C.successors(n).size(); ++k)
+                TEST_SUCCESS(C.successor_instructions(n).at(k).instruction() == D.successor_instructions(n).at(k).instruction());
+        }
+    }
+    TEST_SUCCESS(*loaded.second == annotations);
+    TEST_SUCCESS(microcode::find_component(*loaded.first,program->component(1ULL).entry()) == 1ULL);
+
+    // IDs of loaded nodes are never generated again.
+    node_id  max_id = 0ULL;
+    for (node_id const  n : program->start_component().nodes())
+        max_id = std::max(max_id,n);
+    TEST_SUCCESS(microcode::generate_next_fresh_node_id() > max_id);
+
+    // A truncated input is refused.
+    std::string const  text = binary.str();
+    std::stringstream  truncated(text.substr(0ULL,text.size() / 2ULL));
+    error_message.clear();
+    TEST_SUCCESS(!microcode::create_program_from_binary(truncated,error_message).first.operator bool() && !error_message.empty());
+
+    // A program can be replaced by a loaded one.
+    std::unique_ptr<microcode::program> const  other = microcode::create_initial_program("other","MAIN");
+    node_id const  other_entry = other->start_component().entry();
+    other->swap(*loaded.first);
+    TEST_SUCCESS(other->name() == "test" && other->num_components() == 2ULL && loaded.first->name() == "other");
+    node_id const  extended = other->start_component().insert_sequence(*other->start_component().exits().begin(),
+                                                                        { microcode::create_MISCELLANEOUS__NOP() });
+    TEST_SUCCESS(microcode::find_component(*other,extended) == 0ULL);   //!< The swapped program is notified by components.
+    TEST_SUCCESS(microcode::find_component(*loaded.first,other_entry) == 0ULL);
+
+    std::stringstream  assembly;
+    microcode::save_program_as_assembly_text(assembly,*program,&annotations);
+    std::cout << "  nodes: " << program->start_component().nodes().size() + program->component(1ULL).nodes().size()
+              << ", size [bytes]:  assembly text " << assembly.str().size() << ", binary " << text.size()
+              << "\n";
+
+    std::cout << "SUCCESS\n";
+}
+
+static void  record_execution(recovery_properties&  rprops, execution_id const  eid, std::vector<node_id> const&  nodes)
+{
+    thread_id const  tid = 10ULL + eid;
+    rprops.on_new_thread(eid,tid);
+    rprops.on_concurrent_group_begin(eid);
+    for (node_id const  n : nodes)
+    {
+        rprops.insert_node_to_history(eid,tid,n);
+        rprops.on_thread_step(eid,tid);
+    }
+    rprops.insert_branching(eid,tid);
+    input_impact_link const  link = rprops.add_input_impact({ 0x41U, "#1", 3ULL, {} },eid,tid);
+    rprops.add_input_impact({ 0x42U, true, 0x100ULL, { link } },eid,tid);
+    rprops.add_input_impact_links(eid,tid,{ link });
+}
+
+static void test_checkpoint()
+{
+    std::cout << "Starting: test_checkpoint()\n";
+
+    std::unique_ptr<microcode::program> const  prologue = create_program(10ULL,*microcode::create_initial_annotations());
+    microcode::annotations  annotations;
+    std::unique_ptr<microcode::program> const  program = create_program(100ULL,annotations);
+
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { 0x400000ULL, 0x401000ULL }, { 0x500000ULL, 0x500100ULL } },1000000ULL);
+    rprops.add_unexplored_exits(0x400123ULL,{ *program->start_component().exits().begin() });
+    rprops.on_branching_visited({ 1ULL, 2ULL });
+    rprops.add_switch(7ULL)->second = switch_info(7ULL,9ULL,{ { 0x400010ULL, 8ULL } },microcode::create_HAVOC__REG_ASGN_HAVOC(0x100ULL,0x108ULL));
+    record_execution(rprops,0ULL,{ 1ULL, 2ULL, 3ULL });
+    record_execution(rprops,1ULL,{ 1ULL, 4ULL });
+    input_streams_of_executions const  pending_inputs{ { { "#1", { 1U, 2U, 3U } } }, {} };
+
+    std::string const  pathname = "checkpoint_TEST.bin";
+    TEST_SUCCESS(save_checkpoint_file(pathname,*prologue,*program,annotations,rprops,pending_inputs).empty());
+
+    std::unique_ptr<microcode::program>  loaded_program;
+    microcode::annotations  loaded_annotations;
+    recovery_properties  loaded_rprops(0x1ULL,0x1ULL,0x100ULL,{ { 0x1ULL, 0x2ULL } },5000ULL);
+    input_streams_of_executions  loaded_inputs;
+    TEST_SUCCESS(load_checkpoint_file(pathname,*prologue,loaded_program,loaded_annotations,loaded_rprops,loaded_inputs).empty());
+    std::remove(pathname.c_str());
+
+    TEST_SUCCESS(loaded_program->start_component().nodes().size() == program->start_component().nodes().size());
+    TEST_SUCCESS(loaded_annotations == annotations);
+    TEST_SUCCESS(loaded_inputs == pending_inputs);
+    TEST_SUCCESS(loaded_rprops.timeout_in_milliseconds() == 5000ULL);  //!< The timeout belongs to the resumed session.
+    TEST_SUCCESS(loaded_rprops.heap_begin() == 0x10000ULL && loaded_rprops.temporaries_begin() == 0x100ULL);
+    TEST_SUCCESS(loaded_rprops.important_code() == rprops.important_code());
+    TEST_SUCCESS(loaded_rprops.unexplored().size() == 1ULL && loaded_rprops.unexplored().begin()->second.IP() == 0x400123ULL);
+    TEST_SUCCESS(loaded_rprops.visited_branchings() == rprops.visited_branchings());
+    TEST_SUCCESS(loaded_rprops.has_switch(7ULL) && loaded_rprops.get_switch(7ULL).default_node() == 9ULL);
+    TEST_SUCCESS(loaded_rprops.get_switch(7ULL).cases() == rprops.get_switch(7ULL).cases());
+    TEST_SUCCESS(loaded_rprops.get_switch(7ULL).havoc_instruction() == rprops.get_switch(7ULL).havoc_instruction());
+    TEST_SUCCESS(loaded_rprops.num_executions_performed() == 2ULL);
+    for (execution_id  eid = 0ULL; eid < 2ULL; ++eid)
+    {
+        execution_records const  original = rprops.records_of_execution(eid);
+        execution_records const  records = loaded_rprops.records_of_execution(eid);
+        thread_id const  tid = original.threads.front();
+        TEST_SUCCESS(records.node_histories == original.node_histories && records.threads == original.threads);
+        TEST_SUCCESS(records.interleaving_of_threads == original.interleaving_of_threads);
+        TEST_SUCCESS(records.begins_of_concurrent_groups == original.begins_of_concurrent_groups);
+        TEST_SUCCESS(records.branchings == original.branchings && records.input_impact_links == original.input_impact_links);
+        TEST_SUCCESS(records.input_impacts.at(tid).size() == original.input_impacts.at(tid).size());
+        std::vector<input_impact_value> const&  values = records.input_impacts.at(tid).back();
+        TEST_SUCCESS(values.size() == 2ULL);
+        TEST_SUCCESS(values.front().is_in_stream() && values.front().stream() == "#1" && values.front().shift_from_begin() == 3ULL);
+        TEST_SUCCESS(values.back().is_in_reg_pool() && values.back().value() == 0x42U && values.back().links().size() == 1ULL);
+    }
+
+    // The checkpoint cannot be resumed with a different prologue.
+    std::stringstream  checkpoint;
+    TEST_SUCCESS(save_checkpoint(checkpoint,*prologue,*program,annotations,rprops,pending_inputs).empty());
+    std::unique_ptr<microcode::program> const  other_prologue = create_program(11ULL,*microcode::create_initial_annotations());
+    TEST_SUCCESS(!load_checkpoint(checkpoint,*other_prologue,loaded_program,loaded_annotations,loaded_rprops,loaded_inputs).empty());
+    TEST_SUCCESS(loaded_rprops.num_executions_performed() == 2ULL);    //!< Untouched by the failed load.
+
+    std::cout << "SUCCESS\n";
+}
+
+/**
+ * It measures saving and loading of a checkpoint of a larger recovery.
+ */
+static void test_checkpoint_performance()
+{
+    std::cout << "Starting: test_checkpoint_performance()\n";
+
+    std::unique_ptr<microcode::program> const  prologue = create_program(10ULL,*microcode::create_initial_annotations());
+    microcode::annotations  annotations;
+    std::unique_ptr<microcode::program> const  program = create_program(20000ULL,annotations);
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { 0x400000ULL, 0x401000ULL } },1000000ULL);
+    std::vector<node_id>  history;
+    for (node_id const  n : program->start_component().nodes())
+        history.push_back(n);
+    uint64_t const  num_executions = 20ULL;
+    for (execution_id  eid = 0ULL; eid < num_executions; ++eid)
+        record_execution(rprops,eid,history);
+
+    std::stringstream  checkpoint;
+    double const  save_time = measure_milliseconds([&]() {
+        TEST_SUCCESS(save_checkpoint(checkpoint,*prologue,*program,annotations,rprops,{}).empty());
+    });
+    std::unique_ptr<microcode::program>  loaded_program;
+    microcode::annotations  loaded_annotations;
+    recovery_properties  loaded_rprops(0x1ULL,0x1ULL,0x100ULL,{ { 0x1ULL, 0x2ULL } },5000ULL);
+    input_streams_of_executions  loaded_inputs;
+    double const  load_time = measure_milliseconds([&]() {
+        TEST_SUCCESS(load_checkpoint(checkpoint,*prologue,loaded_program,loaded_annotations,loaded_rprops,loaded_inputs).empty());
+    });
+    TEST_SUCCESS(loaded_rprops.node_histories().at(num_executions - 1ULL).at(10ULL + num_executions - 1ULL).size() == history.size());
+
+    std::cout << "  nodes: " << history.size() << ", executions: " << num_executions
+              << ", size [bytes]: " << checkpoint.str().size()
+              << ", time [ms]:  save " << save_time << ", load " << load_time
+              << "\n";
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("checkpoint_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_binary_program();
+        test_checkpoint();
+        test_checkpoint_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
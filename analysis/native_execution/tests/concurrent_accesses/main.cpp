@@ -0,0 +1,242 @@
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/execute_program.hpp>
+#include <rebours/analysis/native_execution/execute_instruction.hpp>
+#include <rebours/analysis/native_execution/execution_properties.hpp>
+#include <rebours/analysis/native_execution/recovery_properties.hpp>
+#include <rebours/program/program.hpp>
+#include <vector>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+static address const  data_begin = 0x600000ULL;
+static address const  data_size_per_thread = 0x100ULL;
+
+/**
+ * Each thread runs in a loop, where it reads 8 bytes from its part of the data and writes them to another place
+ * in the same part. So, threads never access the same bytes.
+ */
+static std::unique_ptr<microcode::program>  create_program()
+{
+    std::unique_ptr<microcode::program>  program = microcode::create_initial_program("test","MAIN");
+    microcode::program_component&  C = program->start_component();
+    C.insert_sequence(C.entry(),{
+                microcode::create_DATATRANSFER__REG_ASGN_DEREF_REG(8U,0x110ULL,0x100ULL),
+                microcode::create_DATATRANSFER__DEREF_REG_ASGN_REG(8U,0x108ULL,0x110ULL),
+                microcode::create_DATATRANSFER__REG_ASGN_DEREF_REG(4U,0x118ULL,0x108ULL),
+                microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,0x110ULL,0ULL),
+                },
+                C.entry());
+    return program;
+}
+
+static double  measure_step(uint64_t const  num_threads, uint64_t const  num_steps)
+{
+    std::unique_ptr<microcode::program> const  program = create_program();
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100000ULL,{ { 0x400000ULL, 0x401000ULL } },1000000ULL);
+    execution_properties  eprops(0ULL,0x10000ULL,0x20000ULL,0x100000ULL);
+    eprops.mem_allocations().insert({ data_begin, memory_allocation_info(num_threads * data_size_per_thread,true,true,false,false,false) });
+
+    std::vector<thread>  threads;
+    for (uint64_t  i = 0ULL; i < num_threads; ++i)
+    {
+        address const  part = data_begin + i * data_size_per_thread;
+        memory_write(eprops.mem_content(),part,i);
+        memory_write(eprops.mem_content(),part + 0x40ULL,(uint64_t)0ULL);
+        std::shared_ptr<memory_content> const  reg = std::make_shared<memory_content>();
+        memory_write(*reg,0x100ULL,part);
+        memory_write(*reg,0x108ULL,part + 0x40ULL);
+        threads.push_back(thread(program->start_component().entry(),reg));
+        rprops.on_new_thread(eprops.get_execution_id(),threads.back().id());
+        rprops.insert_node_to_history(eprops.get_execution_id(),threads.back().id(),threads.back().stack().back());
+    }
+
+    double const  time = measure_milliseconds([&]() {
+        for (uint64_t  i = 0ULL; i < num_steps; ++i)
+        {
+            std::vector<thread>  next;
+            TEST_SUCCESS(execution_step(*program,threads,eprops,rprops,next).empty());
+            threads.swap(next);
+        }
+    });
+    TEST_SUCCESS(threads.size() == num_threads);
+    for (uint64_t  i = 0ULL; i < num_threads; ++i)
+        TEST_SUCCESS(memory_read<uint64_t>(eprops.mem_content(),data_begin + i * data_size_per_thread + 0x40ULL) == i);
+    return 1000000.0 * time / (double)num_steps;
+}
+
+
+/**
+ * Sets of random accesses are compared with plain sets of addresses. Accesses are either clustered (so the
+ * sets stay ranges) or scattered (so the sets switch to bitmaps).
+ */
+static void test_mem_access_set()
+{
+    std::cout << "Starting: test_mem_access_set()\n";
+
+    uint64_t  seed = 12345ULL;
+    auto const  random = [&seed](uint64_t const  bound) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (seed >> 33U) % bound;
+    };
+    for (uint64_t const  spread : { 0x40ULL, 0x1000ULL, 0x100000ULL })
+        for (uint64_t  round = 0ULL; round < 50ULL; ++round)
+        {
+            mem_access_set  A, B;
+            std::set<uint64_t>  a, b;
+            for (uint64_t  i = 0ULL, n = random(100ULL); i < n; ++i)
+            {
+                uint64_t const  adr = 0x600000ULL + random(spread), num_bytes = 1ULL + random(8ULL);
+                A.insert(adr,num_bytes);
+                for (uint64_t  j = 0ULL; j < num_bytes; ++j)
+                    a.insert(adr + j);
+            }
+            for (uint64_t  i = 0ULL, n = random(100ULL); i < n; ++i)
+            {
+                uint64_t const  adr = 0x600000ULL + random(spread), num_bytes = 1ULL + random(8ULL);
+                B.insert(adr,num_bytes);
+                for (uint64_t  j = 0ULL; j < num_bytes; ++j)
+                    b.insert(adr + j);
+            }
+            for (uint64_t  adr = 0x600000ULL - 8ULL; adr < 0x600000ULL + std::min(spread + 8ULL,0x2000ULL); ++adr)
+                TEST_SUCCESS(A.contains(adr) == (a.count(adr) != 0ULL));
+            if (!A.uses_bitmaps())
+                for (uint64_t  i = 1ULL; i < A.ranges().size(); ++i)
+                    TEST_SUCCESS(A.ranges().at(i - 1ULL).second + 1ULL < A.ranges().at(i).first);
+            bool  intersect = false;
+            for (uint64_t const  adr : a)
+                intersect = intersect || b.count(adr) != 0ULL;
+            TEST_SUCCESS(A.intersects(B) == intersect && B.intersects(A) == intersect);
+
+            mem_access_set  C;
+            C.insert(0x600000ULL + spread / 2ULL);
+            C.insert(A);
+            C.insert(B);
+            for (uint64_t const  adr : a)
+                TEST_SUCCESS(C.contains(adr) && C.intersects(A));
+            for (uint64_t const  adr : b)
+                TEST_SUCCESS(C.contains(adr));
+        }
+
+    mem_access_set  S;
+    S.insert(~0ULL - 3ULL,8ULL);
+    TEST_SUCCESS(S.contains(~0ULL) && S.contains(0ULL) && S.contains(3ULL) && !S.contains(4ULL));
+    for (uint64_t  i = 0ULL; i <= mem_access_set::max_num_ranges; ++i)
+        S.insert(0x1000ULL + 2ULL * i);
+    TEST_SUCCESS(S.uses_bitmaps() && S.contains(~0ULL) && S.contains(0x1000ULL) && !S.contains(0x1001ULL));
+    S.clear();
+    TEST_SUCCESS(S.empty() && !S.uses_bitmaps() && !S.contains(0x1000ULL));
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_concurrent_accesses()
+{
+    std::cout << "Starting: test_concurrent_accesses()\n";
+
+    std::unique_ptr<microcode::program> const  program = create_program();
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100000ULL,{ { 0x400000ULL, 0x401000ULL } },1000000ULL);
+    execution_properties  eprops(0ULL,0x10000ULL,0x20000ULL,0x100000ULL);
+    eprops.mem_allocations().insert({ data_begin, memory_allocation_info(2ULL * data_size_per_thread,true,true,false,false,false) });
+    memory_write(eprops.mem_content(),data_begin,(uint64_t)1ULL);
+    memory_write(eprops.mem_content(),data_begin + 0x40ULL,(uint64_t)0ULL);
+
+    // Both threads read the same bytes in the first step, which is legal. But then they write to overlapping bytes.
+    std::vector<thread>  threads;
+    for (address const  dst : { data_begin + 0x40ULL, data_begin + 0x44ULL })
+    {
+        std::shared_ptr<memory_content> const  reg = std::make_shared<memory_content>();
+        memory_write(*reg,0x100ULL,data_begin);
+        memory_write(*reg,0x108ULL,dst);
+        threads.push_back(thread(program->start_component().entry(),reg));
+        rprops.on_new_thread(eprops.get_execution_id(),threads.back().id());
+        rprops.insert_node_to_history(eprops.get_execution_id(),threads.back().id(),threads.back().stack().back());
+    }
+    std::vector<thread>  next;
+    TEST_SUCCESS(execution_step(*program,threads,eprops,rprops,next).empty());
+    threads.swap(next);
+    next.clear();
+    std::string const  error_message = execution_step(*program,threads,eprops,rprops,next);
+    TEST_SUCCESS(error_message.find("intersection(W_d,") != std::string::npos);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_execution_status()
+{
+    std::cout << "Starting: test_execution_status()\n";
+
+    TEST_SUCCESS(execution_status().succeeded() && execution_status().message().empty());
+    TEST_SUCCESS(execution_status(EXECUTION_STATUS::DIVISION_BY_ZERO).message() == "Division by zero.");
+    TEST_SUCCESS(execution_status(EXECUTION_STATUS::STREAM_ALREADY_OPEN,3ULL).message() == "The stream '#3' is already open.");
+    TEST_SUCCESS(execution_status(EXECUTION_STATUS::NOT_IMPLEMENTED_INSTRUCTION,microcode::num(microcode::GIK::MODULARITY__CALL))
+                    .message().find("GIK=" + std::to_string(microcode::num(microcode::GIK::MODULARITY__CALL))) != std::string::npos);
+
+    // The thread reads from a not allocated memory. The text of the error is built only for the failed step.
+    std::unique_ptr<microcode::program> const  program = create_program();
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100000ULL,{ { 0x400000ULL, 0x401000ULL } },1000000ULL);
+    execution_properties  eprops(0ULL,0x10000ULL,0x20000ULL,0x100000ULL);
+    std::shared_ptr<memory_content> const  reg = std::make_shared<memory_content>();
+    memory_write(*reg,0x100ULL,data_begin);
+    std::vector<thread>  threads{ thread(program->start_component().entry(),reg) };
+    rprops.on_new_thread(eprops.get_execution_id(),threads.back().id());
+    rprops.insert_node_to_history(eprops.get_execution_id(),threads.back().id(),threads.back().stack().back());
+    std::vector<thread>  next;
+    std::string const  error_message = execution_step(*program,threads,eprops,rprops,next);
+    TEST_SUCCESS(error_message.find("On edge {") == 0ULL);
+    TEST_SUCCESS(error_message.find("} : Attempt to read from a not allocated memory.") != std::string::npos);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_step_performance()
+{
+    std::cout << "Starting: test_step_performance()\n";
+
+    for (uint64_t const  num_threads : { 1ULL, 4ULL, 16ULL })
+    {
+        uint64_t const  num_steps = 400000ULL / num_threads;
+        double const  step_time = measure_step(num_threads,num_steps);
+        std::cout << "  threads: " << num_threads << ", steps: " << num_steps
+                  << ", time per step [ns]: " << step_time << ", per thread " << step_time / (double)num_threads
+                  << "\n";
+    }
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("concurrent_accesses_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_mem_access_set();
+        test_concurrent_accesses();
+        test_execution_status();
+        test_step_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "./execution_fixture.hpp"
+#include <rebours/analysis/native_execution/test.hpp>
+#include <algorithm>
+
+using namespace analysis::natexe;
+
+
+address const  data_begin = 0x600000ULL;
+thread_id const  tid = generate_fresh_thread_id();
+
+
+std::unique_ptr<microcode::program>  create_program_with_store(uint64_t const  num_iterations)
+{
+    std::unique_ptr<microcode::program>  program = microcode::create_initial_program("test","MAIN");
+    microcode::program_component&  C = program->start_component();
+    node_id const  u = C.insert_sequence(C.entry(),{
+                microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(8U,0x100ULL,0x100ULL,(uint64_t)1ULL),
+                microcode::create_DATATRANSFER__DEREF_REG_ASGN_REG(8U,0x108ULL,0x100ULL),
+                microcode::create_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER(8U,0x110ULL,0x100ULL,num_iterations),
+                });
+    C.insert_branching(microcode::GIK::GUARDS__REG_NOT_EQUAL_TO_ZERO,8U,0x110ULL,u,{C.entry(),0ULL});
+    return program;
+}
+
+
+execution::execution(microcode::program const&  P)
+    : rprops(0x10000ULL,0x20000ULL,0x100000ULL,{ { 0x400000ULL, 0x401000ULL } },1000000ULL)
+    , eprops(0ULL,0x10000ULL,0x20000ULL,0x100000ULL)
+    , threads()
+{
+    eprops.mem_allocations().insert({ data_begin, memory_allocation_info(0x1000ULL,true,true,false,false,false) });
+    std::shared_ptr<memory_content> const  reg = std::make_shared<memory_content>();
+    memory_write(*reg,0x100ULL,(uint64_t)0ULL);
+    memory_write(*reg,0x108ULL,data_begin);
+    threads.push_back(thread(P.start_component().entry(),reg,tid));
+    rprops.on_new_thread(eprops.get_execution_id(),tid);
+    rprops.insert_node_to_history(eprops.get_execution_id(),tid,threads.back().stack().back());
+    rprops.add_input_impact_links(eprops.get_execution_id(),tid,{});
+}
+
+void  execution::taint_counter()
+{
+    for (address  adr = 0x100ULL; adr < 0x108ULL; ++adr)
+        eprops.input_frontier(tid).on_reg_impact(adr,rprops.add_input_impact({ 0U, true, adr, {} },eprops.get_execution_id(),tid));
+}
+
+std::string  execution::run(microcode::program&  P, threaded_code* const  code)
+{
+    do
+    {
+        std::vector<thread>  W(1ULL);
+        threads.back().swap(W.back());
+        threads.pop_back();
+        std::string const  error_message = execution_step(P,W,eprops,rprops,threads,{},code);
+        if (!error_message.empty())
+            return error_message;
+    }
+    while (!threads.empty());
+    return "";
+}
+
+double  execution::measure_run(microcode::program&  P, threaded_code* const  code)
+{
+    return measure_milliseconds([this,&P,code]() {
+        TEST_SUCCESS(run(P,code).empty());
+    });
+}
+
+
+bool  have_same_records(execution const&  E, execution const&  F)
+{
+    execution_records const  E_records = E.rprops.records_of_execution(0ULL);
+    execution_records const  F_records = F.rprops.records_of_execution(0ULL);
+    return E_records.node_histories == F_records.node_histories &&
+           E_records.interleaving_of_threads == F_records.interleaving_of_threads &&
+           E_records.begins_of_concurrent_groups == F_records.begins_of_concurrent_groups &&
+           E_records.branchings == F_records.branchings &&
+           E_records.input_impacts.count(tid) == F_records.input_impacts.count(tid) &&
+           (E_records.input_impacts.count(tid) == 0ULL || E_records.input_impacts.at(tid).size() == F_records.input_impacts.at(tid).size()) &&
+           E_records.input_impact_links == F_records.input_impact_links &&
+           E.rprops.visited_branchings() == F.rprops.visited_branchings() &&
+           E.eprops.input_frontier(tid).reg_impacts() == F.eprops.input_frontier(tid).reg_impacts();
+}
+
+bool  have_same_final_registers(execution const&  E, execution const&  F)
+{
+    if (E.eprops.final_regs().size() != 1ULL || F.eprops.final_regs().size() != 1ULL)
+        return false;
+    std::vector< std::pair<address,memory_page const*> > const  E_pages = E.eprops.final_regs().front().second->pages();
+    std::vector< std::pair<address,memory_page const*> > const  F_pages = F.eprops.final_regs().front().second->pages();
+    if (E_pages.size() != F_pages.size())
+        return false;
+    for (uint64_t  i = 0ULL; i < E_pages.size(); ++i)
+        if (E_pages.at(i).first != F_pages.at(i).first ||
+            !std::equal(E_pages.at(i).second->data(),E_pages.at(i).second->data() + memory_page_size,F_pages.at(i).second->data()))
+            return false;
+    return true;
+}
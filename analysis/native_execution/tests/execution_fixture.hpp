@@ -0,0 +1,60 @@
+#ifndef REBOURS_ANALYSIS_NATIVE_EXECUTION_TESTS_EXECUTION_FIXTURE_HPP_INCLUDED
+#   define REBOURS_ANALYSIS_NATIVE_EXECUTION_TESTS_EXECUTION_FIXTURE_HPP_INCLUDED
+
+#   include <rebours/analysis/native_execution/execute_program.hpp>
+#   include <rebours/analysis/native_execution/threaded_code.hpp>
+#   include <rebours/analysis/native_execution/execution_properties.hpp>
+#   include <rebours/analysis/native_execution/recovery_properties.hpp>
+#   include <rebours/program/program.hpp>
+#   include <vector>
+#   include <memory>
+#   include <string>
+#   include <cstdint>
+
+
+extern analysis::natexe::address const  data_begin;     //!< Start of a writable memory block of 0x1000 bytes.
+extern analysis::natexe::thread_id const  tid;          //!< Threads forked by executed programs get fresh ids as well.
+
+
+/**
+ * A loop counting REG[0x100] from 0 up to 'num_iterations'. Each iteration also stores the counter into the memory,
+ * so the loop consists of two regions separated by the store.
+ */
+std::unique_ptr<microcode::program>  create_program_with_store(uint64_t const  num_iterations);
+
+
+/**
+ * An execution of a single thread 'tid' from the entry of a program, where REG[0x100] holds 0 and REG[0x108] holds
+ * 'data_begin'.
+ */
+struct  execution
+{
+    explicit execution(microcode::program const&  P);
+
+    /**
+     * The bytes of the counter REG[0x100] become an input.
+     */
+    void  taint_counter();
+
+    /**
+     * The same loop as in 'execute_program', but without dumps, the recogniser, and checks of a timeout.
+     * The program is walked, when 'code' is nullptr.
+     */
+    std::string  run(microcode::program&  P, analysis::natexe::threaded_code* const  code);
+
+    /**
+     * It runs the program (see 'run'), which must terminate without an error, and returns the passed milliseconds.
+     */
+    double  measure_run(microcode::program&  P, analysis::natexe::threaded_code* const  code);
+
+    analysis::natexe::recovery_properties  rprops;
+    analysis::natexe::execution_properties  eprops;
+    std::vector<analysis::natexe::thread>  threads;
+};
+
+
+bool  have_same_records(execution const&  E, execution const&  F);
+bool  have_same_final_registers(execution const&  E, execution const&  F);
+
+
+#endif
@@ -0,0 +1,235 @@
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/execution_properties.hpp>
+#include <unordered_map>
+#include <vector>
+#include <map>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+static void test_shadow_memory()
+{
+    std::cout << "Starting: test_shadow_memory()\n";
+
+    shadow_memory  shadow;
+    TEST_SUCCESS(shadow.empty());
+    TEST_SUCCESS(shadow.label(0x1000ULL) == 0U);
+    TEST_SUCCESS(shadow.is_clean(0x1000ULL,0x100ULL));
+
+    shadow.set_label(0x1ffeULL,1U);
+    shadow.set_label(0x2001ULL,2U);
+    TEST_SUCCESS(!shadow.empty());
+    TEST_SUCCESS(shadow.label(0x1ffeULL) == 1U);
+    TEST_SUCCESS(shadow.label(0x2001ULL) == 2U);
+    TEST_SUCCESS(shadow.label(0x2000ULL) == 0U);
+    TEST_SUCCESS(shadow.is_clean(0x1000ULL,0xffeULL));
+    TEST_SUCCESS(!shadow.is_clean(0x1000ULL,0xfffULL));
+    TEST_SUCCESS(shadow.is_clean(0x1fffULL,2ULL));
+    TEST_SUCCESS(!shadow.is_clean(0x1fffULL,3ULL));                         //!< Crosses the page boundary.
+    TEST_SUCCESS((shadow.labels() == std::map<address,taint_label>{ { 0x1ffeULL, 1U }, { 0x2001ULL, 2U } }));
+
+    shadow_memory  copy = shadow;
+    shadow.clear(0x1ff0ULL,0x20ULL);
+    TEST_SUCCESS(shadow.empty());                                           //!< Pages without labels are released.
+    TEST_SUCCESS(copy.label(0x1ffeULL) == 1U && copy.label(0x2001ULL) == 2U);
+
+    copy.set_label(0x1ffeULL,3U);
+    copy.set_label(0x2001ULL,0U);
+    TEST_SUCCESS((copy.labels() == std::map<address,taint_label>{ { 0x1ffeULL, 3U } }));
+    copy.set_label(0x1ffeULL,0U);
+    TEST_SUCCESS(copy.empty());
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_input_frontier()
+{
+    std::cout << "Starting: test_input_frontier()\n";
+
+    stream_id const  sid = "#0";
+    input_frontier_of_thread  frontier(1ULL);
+    frontier.on_reg_impact(0x20ULL,{ 1ULL, 0ULL });
+    frontier.on_reg_impact(0x10ULL,{ 2ULL, 0ULL });
+    frontier.on_mem_impact(0x7fff0000ULL,{ 3ULL, 1ULL });
+    frontier.on_stream_impact(sid,5ULL,{ 4ULL, 0ULL });
+
+    TEST_SUCCESS(frontier.find_in_reg(0x20ULL) != nullptr && *frontier.find_in_reg(0x20ULL) == input_impact_link(1ULL,0ULL));
+    TEST_SUCCESS(frontier.find_in_reg(0x21ULL) == nullptr);
+    TEST_SUCCESS(frontier.find_in_mem(0x7fff0000ULL) != nullptr && *frontier.find_in_mem(0x7fff0000ULL) == input_impact_link(3ULL,1ULL));
+    TEST_SUCCESS(frontier.find_in_stream(sid,5ULL) != nullptr && *frontier.find_in_stream(sid,5ULL) == input_impact_link(4ULL,0ULL));
+    TEST_SUCCESS(frontier.find_in_stream("#1",5ULL) == nullptr);
+    TEST_SUCCESS(frontier.reg_impacts().size() == 2ULL && frontier.reg_impacts().begin()->first == 0x10ULL);
+    TEST_SUCCESS(frontier.stream_impacts().count({sid,5ULL}) == 1ULL);
+
+    frontier.on_reg_impact(0x20ULL,{ 5ULL, 2ULL });                         //!< Overwrites the old impact.
+    TEST_SUCCESS(*frontier.find_in_reg(0x20ULL) == input_impact_link(5ULL,2ULL));
+    frontier.delete_reg_impact(0x10ULL);
+    frontier.delete_stream_impact(sid,5ULL);
+    TEST_SUCCESS(frontier.reg_impacts().size() == 1ULL);
+    TEST_SUCCESS(frontier.stream_impacts().empty());
+    TEST_SUCCESS(frontier.reg_shadow().is_clean(0x0ULL,0x20ULL));
+
+    // A forked frontier shares labels with its parent until either side stores a label.
+    input_frontier_of_thread  forked(frontier,2ULL,7ULL);
+    TEST_SUCCESS(forked.get_thread_id() == 2ULL && forked.fork_counter() == 7ULL);
+    taint_label const  label = forked.reg_shadow().label(0x20ULL);
+    TEST_SUCCESS(label != 0U && forked.owner(label) == 1ULL);
+    forked.set_link(label,{ 7ULL, 0ULL });
+    TEST_SUCCESS(forked.owner(label) == 2ULL && *forked.find_in_reg(0x20ULL) == input_impact_link(7ULL,0ULL));
+    TEST_SUCCESS(frontier.owner(label) == 1ULL && *frontier.find_in_reg(0x20ULL) == input_impact_link(5ULL,2ULL));
+    forked.delete_reg_impact(0x20ULL);
+    forked.on_mem_impact(0x7fff0001ULL,{ 8ULL, 0ULL });
+    TEST_SUCCESS(forked.reg_impacts().empty() && frontier.reg_impacts().size() == 1ULL);
+    TEST_SUCCESS(forked.mem_impacts().size() == 2ULL && frontier.mem_impacts().size() == 1ULL);
+
+    io_range  range(true,0x100ULL,8ULL);
+    TEST_SUCCESS(range.location(0ULL) == 0x100ULL && range.location(7ULL) == 0x107ULL);
+    range.reverse();
+    TEST_SUCCESS(range.location(0ULL) == 0x107ULL && range.location(7ULL) == 0x100ULL);
+    io_range const  sub = io_range(false,0x100ULL,16ULL).sub_range(8ULL,16ULL);
+    TEST_SUCCESS(sub.is_in_mem_pool() && sub.begin() == 0x108ULL && sub.num_bytes() == 8ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_union_of_labels()
+{
+    std::cout << "Starting: test_union_of_labels()\n";
+
+    input_frontier_of_thread  frontier(1ULL);
+    for (address  adr = 0x100ULL; adr < 0x108ULL; ++adr)
+        frontier.on_reg_impact(adr,{ 1ULL, 0ULL });
+    frontier.on_mem_impact(0x7fff0000ULL,{ 1ULL, 0ULL });
+    TEST_SUCCESS(frontier.num_labels() == 1ULL && frontier.capacity_of_labels() == 1ULL);  //!< All bytes share one label.
+    TEST_SUCCESS(frontier.reg_shadow().label(0x100ULL) == frontier.mem_shadow().label(0x7fff0000ULL));
+
+    frontier.on_reg_impact(0x100ULL,{ 2ULL, 0ULL });
+    frontier.delete_reg_impacts(0x101ULL,7ULL);
+    TEST_SUCCESS(frontier.num_labels() == 2ULL && *frontier.find_in_mem(0x7fff0000ULL) == input_impact_link(1ULL,0ULL));
+    frontier.delete_mem_impact(0x7fff0000ULL);
+    TEST_SUCCESS(frontier.num_labels() == 1ULL);
+    frontier.on_reg_impact(0x101ULL,{ 3ULL, 0ULL });                        //!< Reuses the released label.
+    TEST_SUCCESS(frontier.num_labels() == 2ULL && frontier.capacity_of_labels() == 2ULL);
+    TEST_SUCCESS(*frontier.find_in_reg(0x100ULL) == input_impact_link(2ULL,0ULL));
+    TEST_SUCCESS(*frontier.find_in_reg(0x101ULL) == input_impact_link(3ULL,0ULL));
+
+    // Each write of an input impact value creates a new link, but the table of labels does not grow.
+    for (node_counter_type  counter = 4ULL; counter < 100000ULL; ++counter)
+        for (address  adr = 0x100ULL; adr < 0x108ULL; ++adr)
+            frontier.on_reg_impact(adr,{ counter, adr - 0x100ULL });
+    TEST_SUCCESS(frontier.num_labels() == 8ULL && frontier.capacity_of_labels() <= 9ULL);
+
+    // Labels released by a forked thread stay in use by its parent.
+    input_frontier_of_thread  forked(frontier,2ULL,7ULL);
+    forked.delete_reg_impacts(0x100ULL,8ULL);
+    TEST_SUCCESS(forked.num_labels() == 0ULL && frontier.num_labels() == 8ULL);
+    forked.on_reg_impact(0x100ULL,{ 1ULL, 0ULL });
+    TEST_SUCCESS(forked.owner(forked.reg_shadow().label(0x100ULL)) == 2ULL && frontier.find_in_reg(0x107ULL) != nullptr);
+    TEST_SUCCESS(frontier.owner(frontier.reg_shadow().label(0x100ULL)) == 1ULL);
+
+    // New labels of both threads are created in the chunk of labels they shared at the fork.
+    input_frontier_of_thread  parent(3ULL);
+    parent.on_reg_impact(0x100ULL,{ 1ULL, 0ULL });
+    input_frontier_of_thread  child(parent,4ULL,1ULL);
+    parent.on_reg_impact(0x101ULL,{ 2ULL, 0ULL });
+    child.on_reg_impact(0x102ULL,{ 3ULL, 0ULL });
+    TEST_SUCCESS(parent.capacity_of_labels() == 2ULL && child.capacity_of_labels() == 2ULL);
+    TEST_SUCCESS(*parent.find_in_reg(0x101ULL) == input_impact_link(2ULL,0ULL) && parent.find_in_reg(0x102ULL) == nullptr);
+    TEST_SUCCESS(*child.find_in_reg(0x102ULL) == input_impact_link(3ULL,0ULL) && child.find_in_reg(0x101ULL) == nullptr);
+
+    std::cout << "SUCCESS\n";
+}
+
+/**
+ * Most instructions of an executed program move data which do not depend on input. We compare the check of
+ * such a move (whether the read bytes are labelled, and erasure of labels of the written bytes) with the
+ * original per-byte lookups in a hash map.
+ */
+static void test_input_impacts_performance()
+{
+    std::cout << "Starting: test_input_impacts_performance()\n";
+
+    input_frontier_of_thread  frontier(1ULL);
+    std::unordered_map<address,input_impact_link>  reference;
+    for (address  adr = 0x1000ULL; adr < 0x1100ULL; adr += 0x10ULL)
+    {
+        frontier.on_reg_impact(adr,{ adr, 0ULL });
+        reference.insert({ adr, { adr, 0ULL } });
+    }
+
+    uint64_t const  num_rounds = 20000ULL;
+    uint64_t  num_moves = 0ULL, num_clean = 0ULL, num_reference_clean = 0ULL;
+    double const  shadow_time = measure_milliseconds([&]() {
+        for (uint64_t  r = 0ULL; r < num_rounds; ++r)
+            for (address  adr = 0x2000ULL; adr < 0x2100ULL; adr += 8ULL, ++num_moves)
+                if (frontier.reg_shadow().is_clean(adr,8ULL))
+                {
+                    frontier.delete_reg_impacts(adr + 0x100ULL,8ULL);
+                    ++num_clean;
+                }
+    });
+    double const  reference_time = measure_milliseconds([&]() {
+        for (uint64_t  r = 0ULL; r < num_rounds; ++r)
+            for (address  adr = 0x2000ULL; adr < 0x2100ULL; adr += 8ULL)
+            {
+                std::vector<input_impact_link>  links;
+                for (address  i = 0ULL; i < 8ULL; ++i)
+                {
+                    auto const  it = reference.find(adr + i);
+                    if (it != reference.cend())
+                        links.push_back(it->second);
+                }
+                if (links.empty())
+                {
+                    for (address  i = 0ULL; i < 8ULL; ++i)
+                        reference.erase(adr + 0x100ULL + i);
+                    ++num_reference_clean;
+                }
+            }
+    });
+    TEST_SUCCESS(num_clean == num_moves);
+    TEST_SUCCESS(num_reference_clean == num_moves);
+    TEST_SUCCESS(frontier.reg_impacts().size() == reference.size());
+
+    std::cout << "  8-byte moves: " << num_moves
+              << ", time [ms]:  per-byte map " << reference_time << ", shadow memory " << shadow_time
+              << ", throughput [moves/ms]:  per-byte map " << (double)num_moves / reference_time
+              << ", shadow memory " << (double)num_moves / shadow_time
+              << "\n";
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("input_impacts_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_shadow_memory();
+        test_input_frontier();
+        test_union_of_labels();
+        test_input_impacts_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
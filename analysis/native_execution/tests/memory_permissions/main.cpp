@@ -0,0 +1,221 @@
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/execution_properties.hpp>
+#include <vector>
+#include <map>
+#include <limits>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+static uint64_t  next_random(uint64_t&  seed)
+{
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return seed >> 33ULL;
+}
+
+static memory_allocation_info  create_allocation_info(size const  num_bytes, uint8_t const  rights)
+{
+    return { num_bytes, (rights & 1U) != 0U, (rights & 2U) != 0U, (rights & 4U) != 0U, (rights & 8U) != 0U, (rights & 16U) != 0U };
+}
+
+
+/**
+ * Computes the answer for the range [begin,begin+num_bytes) byte by byte. Flags are compared only when either
+ * all or none of the bytes are allocated.
+ */
+static bool  check_block_info(memory_allocations const&  alloc, address const  begin, size const  num_bytes)
+{
+    memory_block_info const  info = compute_memory_block_info(alloc,begin,num_bytes);
+    uint64_t  num_allocated = 0ULL;
+    memory_block_info  expected{ BOOL3::NO, BOOL3::NO, BOOL3::NO, BOOL3::NO, BOOL3::YES_AND_NO, BOOL3::YES_AND_NO };
+    for (address  adr = begin; adr != begin + num_bytes; ++adr)
+    {
+        memory_allocations::const_iterator  it = alloc.lower_bound(adr + 1ULL);
+        if (it == alloc.cbegin())
+            continue;
+        --it;
+        if (it->first + it->second.num_bytes() <= adr)
+            continue;
+        memory_block_info const  byte_info{it->second};
+        if (num_allocated++ == 0ULL)
+            expected = byte_info;
+        else
+        {
+            expected.readable = weaken(expected.readable,byte_info.readable);
+            expected.writable = weaken(expected.writable,byte_info.writable);
+            expected.executable = weaken(expected.executable,byte_info.executable);
+            expected.in_big_endian = weaken(expected.in_big_endian,byte_info.in_big_endian);
+            expected.has_mutable_endian = weaken(expected.has_mutable_endian,byte_info.has_mutable_endian);
+        }
+    }
+    if (num_allocated != 0ULL && num_allocated != num_bytes)
+        return info.allocated == BOOL3::YES_AND_NO;
+    return info.allocated == expected.allocated &&
+           info.readable == expected.readable &&
+           info.writable == expected.writable &&
+           info.executable == expected.executable &&
+           info.in_big_endian == expected.in_big_endian &&
+           info.has_mutable_endian == expected.has_mutable_endian;
+}
+
+
+/**
+ * The original query: a walk through all blocks intersecting the range. It is kept here only as a reference
+ * for the comparison of the query throughput.
+ */
+static BOOL3  reference_is_readable(memory_allocations::container_type const&  alloc, address  begin, size const  num_bytes)
+{
+    memory_allocations::container_type::const_iterator  block_begin = alloc.lower_bound(begin);
+    if (block_begin != alloc.cbegin() && std::prev(block_begin,1)->first + std::prev(block_begin,1)->second.num_bytes() > begin)
+        --block_begin;
+    if (block_begin == alloc.cend() || block_begin->first >= begin + num_bytes)
+        return BOOL3::NO;
+    address const end = begin + num_bytes;
+    memory_allocations::container_type::const_iterator const  block_end = alloc.lower_bound(end);
+    BOOL3  readable = bool3(block_begin->second.readable());
+    for ( ; block_begin != block_end && begin < end; ++block_begin)
+    {
+        if (block_begin->first > begin)
+            return weaken_YES(readable);
+        readable = weaken(readable,block_begin->second.readable());
+        begin = block_begin->first + block_begin->second.num_bytes();
+    }
+    return readable;
+}
+
+
+static void test_memory_permissions()
+{
+    std::cout << "Starting: test_memory_permissions()\n";
+
+    memory_allocations  alloc;
+    TEST_SUCCESS(check_block_info(alloc,0x400000ULL,8ULL));
+
+    alloc.insert({ 0x400000ULL, create_allocation_info(0x3000ULL,5U) });
+    alloc.insert({ 0x403000ULL, create_allocation_info(0x1000ULL,3U) });
+    alloc.insert({ 0x404000ULL, create_allocation_info(0x800ULL,3U) });        //!< The rest of the page is not allocated.
+    alloc.insert({ 0x405000ULL, create_allocation_info(0x400ULL,3U) });
+    alloc.insert({ 0x405400ULL, create_allocation_info(0xc00ULL,3U) });        //!< Two blocks covering a page with the same rights.
+    alloc.insert({ 0x406000ULL, create_allocation_info(0x10ULL,1U) });
+    alloc.insert({ 0x406010ULL, create_allocation_info(0xff0ULL,3U) });        //!< Two blocks covering a page with different rights.
+
+    TEST_SUCCESS(alloc.find_uniform_page_info(0x401000ULL) != nullptr);
+    TEST_SUCCESS(alloc.find_uniform_page_info(0x404000ULL) == nullptr);
+    TEST_SUCCESS(alloc.find_uniform_page_info(0x405000ULL) != nullptr);
+    TEST_SUCCESS(alloc.find_uniform_page_info(0x406000ULL) == nullptr);
+    TEST_SUCCESS(alloc.find_uniform_page_info(0x500000ULL) != nullptr);
+    TEST_SUCCESS(alloc.find_uniform_page_info(0x500000ULL)->allocated == BOOL3::NO);
+
+    for (address  adr = 0x3ff000ULL; adr < 0x408000ULL; adr += 0xfcULL)
+        for (size  n : { 1ULL, 2ULL, 8ULL, 16ULL, 0x20ULL })
+            TEST_SUCCESS(check_block_info(alloc,adr,n));
+    TEST_SUCCESS(check_block_info(alloc,0x403ff8ULL,0x810ULL));                //!< Crosses into the partially allocated page.
+
+    // The index must follow insertions and erasures.
+    TEST_SUCCESS(compute_memory_block_info(alloc,0x404900ULL,8ULL).allocated == BOOL3::NO);
+    alloc.insert({ 0x404800ULL, create_allocation_info(0x800ULL,3U) });
+    TEST_SUCCESS(compute_memory_block_info(alloc,0x404900ULL,8ULL).allocated == BOOL3::YES);
+    TEST_SUCCESS(alloc.find_uniform_page_info(0x404000ULL) != nullptr);
+    TEST_SUCCESS(compute_memory_block_info(alloc,0x401000ULL,1ULL).executable == BOOL3::YES);
+    alloc.erase(alloc.find(0x400000ULL));
+    TEST_SUCCESS(compute_memory_block_info(alloc,0x401000ULL,1ULL).allocated == BOOL3::NO);
+    TEST_SUCCESS(check_block_info(alloc,0x402ff0ULL,0x20ULL));
+
+    // Random layouts mixing page-granular and byte-granular blocks.
+    uint64_t  seed = 12345ULL;
+    for (uint64_t  round = 0ULL; round < 20ULL; ++round)
+    {
+        memory_allocations  random_alloc;
+        address  adr = 0x10000ULL;
+        for (uint64_t  i = 0ULL; i < 40ULL; ++i)
+        {
+            size const  num_bytes = (next_random(seed) % 2ULL == 0ULL) ? memory_page_size * (1ULL + next_random(seed) % 3ULL) :
+                                                                          1ULL + next_random(seed) % 0x300ULL;
+            random_alloc.insert({ adr, create_allocation_info(num_bytes,(uint8_t)(next_random(seed) % 32ULL)) });
+            adr += num_bytes + ((next_random(seed) % 3ULL == 0ULL) ? next_random(seed) % 0x800ULL : 0ULL);
+        }
+        for (uint64_t  i = 0ULL; i < 2000ULL; ++i)
+        {
+            address const  begin = 0x10000ULL + next_random(seed) % (adr - 0x10000ULL + 0x1000ULL);
+            TEST_SUCCESS(check_block_info(random_alloc,begin,1ULL + next_random(seed) % 16ULL));
+            if (i % 500ULL == 499ULL)
+                random_alloc.erase(std::next(random_alloc.cbegin(),next_random(seed) % random_alloc.size()));
+        }
+    }
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_memory_permissions_performance()
+{
+    std::cout << "Starting: test_memory_permissions_performance()\n";
+
+    // A layout of a loaded program: code and data sections, heap, libraries, and stack.
+    memory_allocations  alloc;
+    alloc.insert({ 0x400000ULL, create_allocation_info(0x2000ULL,5U) });
+    alloc.insert({ 0x601000ULL, create_allocation_info(0x1000ULL,3U) });
+    alloc.insert({ 0x602000ULL, create_allocation_info(0x21000ULL,3U) });
+    for (uint64_t  i = 0ULL; i < 100ULL; ++i)
+        alloc.insert({ 0x7f4000000000ULL + i * 0x10000ULL, create_allocation_info(0x8000ULL,(i % 3ULL == 0ULL) ? 5U : 3U) });
+    alloc.insert({ 0x7ffffffde000ULL, create_allocation_info(0x21000ULL,3U) });
+
+    memory_allocations::container_type  reference(alloc.cbegin(),alloc.cend());
+
+    // Instruction bytes are fetched one by one, like the recogniser does via 'nu_mem'.
+    uint64_t const  num_rounds = 200ULL;
+    uint64_t  num_queries = 0ULL, num_readable = 0ULL, num_reference_readable = 0ULL;
+    double const  indexed_time = measure_milliseconds([&]() {
+        for (uint64_t  r = 0ULL; r < num_rounds; ++r)
+            for (address  adr = 0x400000ULL; adr < 0x402000ULL; ++adr, ++num_queries)
+                if (compute_memory_block_info(alloc,adr,1ULL).readable == BOOL3::YES)
+                    ++num_readable;
+    });
+    double const  reference_time = measure_milliseconds([&]() {
+        for (uint64_t  r = 0ULL; r < num_rounds; ++r)
+            for (address  adr = 0x400000ULL; adr < 0x402000ULL; ++adr)
+                if (reference_is_readable(reference,adr,1ULL) == BOOL3::YES)
+                    ++num_reference_readable;
+    });
+    TEST_SUCCESS(num_readable == num_queries);
+    TEST_SUCCESS(num_reference_readable == num_queries);
+
+    std::cout << "  byte fetches: " << num_queries
+              << ", time [ms]:  block walk " << reference_time << ", permission index " << indexed_time
+              << ", throughput [queries/ms]:  block walk " << (double)num_queries / reference_time
+              << ", permission index " << (double)num_queries / indexed_time
+              << "\n";
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("memory_permissions_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_memory_permissions();
+        test_memory_permissions_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
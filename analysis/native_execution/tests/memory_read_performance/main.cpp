@@ -0,0 +1,234 @@
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/execution_properties.hpp>
+#include <vector>
+#include <map>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+/**
+ * The original backend of the memory content: an ordered map of pages, where even a read creates a missing page.
+ * It is kept here only as a reference for the comparison of read throughput.
+ */
+using  reference_memory_content = std::map<address,memory_page>;
+
+static uint64_t  reference_memory_read(reference_memory_content&  content, address const  begin)
+{
+    uint64_t  value = 0ULL;
+    byte* const  data_begin = reinterpret_cast<byte*>(&value);
+    index  num_output_bytes = 0ULL;
+    address  page_begin = begin & ~(memory_page_size - 1ULL);
+    index  page_offset = begin - page_begin;
+    while (num_output_bytes < sizeof(value))
+    {
+        size const  num_bytes_to_copy = std::min(memory_page_size - page_offset,sizeof(value) - num_output_bytes);
+        memory_page&  page = content[page_begin];
+        std::copy(page.data() + page_offset,page.data() + page_offset + num_bytes_to_copy,data_begin + num_output_bytes);
+        page_begin += memory_page_size;
+        page_offset = 0ULL;
+        num_output_bytes += num_bytes_to_copy;
+    }
+    return value;
+}
+
+
+/**
+ * Returns addresses of reads resembling the interpreter: registers and temporaries in the low part of the REG pool,
+ * or a stack and a few heap/data pages in the MEM pool. Some reads cross a page boundary.
+ */
+static std::vector<address>  create_read_addresses(bool const  for_reg_pool, uint64_t const  num_reads)
+{
+    std::vector<address>  result;
+    result.reserve(num_reads);
+    uint64_t  seed = 0x9e3779b97f4a7c15ULL;
+    for (uint64_t  i = 0ULL; i < num_reads; ++i)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t const  r = seed >> 33ULL;
+        if (for_reg_pool)
+            result.push_back((r % 8ULL == 0ULL) ? 0x1000ULL + (r % 0x8000ULL) : 8ULL * (r % 0x40ULL));
+        else
+        {
+            static address const  bases[] = { 0x7ffffffde000ULL, 0x601000ULL, 0x602000ULL, 0x7f4000000000ULL, 0x7f4000a00000ULL };
+            address const  base = bases[r % (sizeof(bases) / sizeof(bases[0]))];
+            result.push_back(base + (r >> 8ULL) % (4ULL * memory_page_size));
+        }
+    }
+    return result;
+}
+
+
+static void test_memory_content()
+{
+    std::cout << "Starting: test_memory_content()\n";
+
+    memory_content  content;
+    TEST_SUCCESS(content.empty());
+
+    // Unmapped reads return the uninitialised value and do not create pages.
+    TEST_SUCCESS(memory_read<uint8_t>(content,0x10ULL) == default_uninitialised_value());
+    TEST_SUCCESS(memory_read<uint64_t>(content,0x7ffffffdeffcULL) == 0xcdcdcdcdcdcdcdcdULL);
+    TEST_SUCCESS(content.empty());
+
+    memory_write(content,0x8ULL,0x0123456789abcdefULL);
+    memory_write(content,0x7ffffffdeffcULL,0x1122334455667788ULL);
+    memory_write(content,0xfffcULL,0xa1a2a3a4a5a6a7a8ULL);   //!< Crosses from the dense array into the page table.
+    TEST_SUCCESS(content.size() == 5ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(content,0x8ULL) == 0x0123456789abcdefULL);
+    TEST_SUCCESS(memory_read<uint64_t>(content,0x7ffffffdeffcULL) == 0x1122334455667788ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(content,0xfffcULL) == 0xa1a2a3a4a5a6a7a8ULL);
+    TEST_SUCCESS(memory_read<uint32_t>(content,0x7ffffffdf000ULL) == 0x55667788U);
+
+    std::vector< std::pair<address,memory_page const*> > const  pages = content.pages();
+    TEST_SUCCESS(pages.size() == 5ULL);
+    for (uint64_t  i = 1ULL; i < pages.size(); ++i)
+        TEST_SUCCESS(pages.at(i - 1ULL).first < pages.at(i).first);
+
+    memory_content  copy = content;
+    memory_write(copy,0x7ffffffdeffcULL,0ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(content,0x7ffffffdeffcULL) == 0x1122334455667788ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(copy,0x7ffffffdeffcULL) == 0ULL);
+
+    // A copy shares all pages until either side writes into them. Pages cached in the TLB of the original must not
+    // be written through after the copy.
+    memory_content  fork = content;
+    TEST_SUCCESS(fork.find_page(0x7ffffffdf000ULL) == content.find_page(0x7ffffffdf000ULL));
+    TEST_SUCCESS(fork.find_page(0x0ULL) == content.find_page(0x0ULL));
+    memory_write(content,0x7ffffffdf000ULL,(uint8_t)0x99U);
+    memory_write(content,0xcULL,(uint8_t)0x99U);
+    TEST_SUCCESS(fork.find_page(0x7ffffffdf000ULL) != content.find_page(0x7ffffffdf000ULL));
+    TEST_SUCCESS(fork.find_page(0xf000ULL) == content.find_page(0xf000ULL));
+    TEST_SUCCESS(memory_read<uint8_t>(fork,0x7ffffffdf000ULL) == 0x55U && memory_read<uint8_t>(content,0x7ffffffdf000ULL) == 0x99U);
+    TEST_SUCCESS(memory_read<uint8_t>(fork,0xcULL) == 0x89U && memory_read<uint8_t>(content,0xcULL) == 0x99U);
+    memory_write(fork,0xfff8ULL,(uint8_t)0x77U);
+    TEST_SUCCESS(memory_read<uint8_t>(content,0xfff8ULL) == 0xcdU);
+
+    content.erase_pages(0x7ffffffde000ULL,0x7ffffffe0000ULL);
+    TEST_SUCCESS(content.size() == 3ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(content,0x7ffffffdeffcULL) == 0xcdcdcdcdcdcdcdcdULL);
+    TEST_SUCCESS(memory_read<uint64_t>(content,0xfffcULL) == 0xa1a2a3a4a5a6a7a8ULL);
+    TEST_SUCCESS(content.size() == 3ULL);
+    TEST_SUCCESS(fork.size() == 5ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(fork,0x7ffffffdeff8ULL) == 0xcdcdcdcd11223344ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_memory_read_performance()
+{
+    std::cout << "Starting: test_memory_read_performance()\n";
+
+    uint64_t const  num_reads = 4000000ULL;
+
+    for (bool  for_reg_pool : { true, false })
+    {
+        std::vector<address> const  addresses = create_read_addresses(for_reg_pool,num_reads);
+
+        memory_content  content;
+        reference_memory_content  reference;
+        for (uint64_t  i = 0ULL; i < addresses.size(); i += 7ULL)
+        {
+            memory_write(content,addresses.at(i),i);
+            uint64_t const  value = memory_read<uint64_t>(content,addresses.at(i),false);
+            byte const* const  b = reinterpret_cast<byte const*>(&value);
+            for (uint64_t  j = 0ULL; j < sizeof(value); ++j)
+            {
+                address const  adr = addresses.at(i) + j;
+                reference[adr & ~(memory_page_size - 1ULL)].at(adr % memory_page_size) = b[j];
+            }
+        }
+
+        uint64_t  new_sum = 0ULL, reference_sum = 0ULL;
+        double const  new_time = measure_milliseconds([&]() {
+            for (address const  adr : addresses)
+                new_sum += memory_read<uint64_t>(content,adr,false);
+        });
+        double const  reference_time = measure_milliseconds([&]() {
+            for (address const  adr : addresses)
+                reference_sum += reference_memory_read(reference,adr);
+        });
+
+        TEST_SUCCESS(new_sum == reference_sum);
+
+        std::cout << "  pool: " << (for_reg_pool ? "REG" : "MEM")
+                  << ", reads: " << num_reads
+                  << ", pages: " << content.size()
+                  << ", time [ms]:  std::map " << reference_time << ", memory_content " << new_time
+                  << ", throughput [reads/ms]:  std::map " << (double)num_reads / reference_time
+                  << ", memory_content " << (double)num_reads / new_time
+                  << "\n";
+    }
+
+    {
+        // A fork of a thread copies its REG pool and then both threads write into a few registers.
+        memory_content  content;
+        for (address  adr = 0ULL; adr < 0x20000ULL; adr += 8ULL)
+            memory_write(content,adr,adr);
+        uint64_t const  num_forks = 10000ULL;
+        uint64_t  sum = 0ULL;
+        double const  time = measure_milliseconds([&]() {
+            for (uint64_t  i = 0ULL; i < num_forks; ++i)
+            {
+                memory_content  fork = content;
+                memory_write(fork,0x8ULL,i);
+                sum += memory_read<uint64_t>(fork,0x8ULL);
+            }
+        });
+        TEST_SUCCESS(sum == num_forks * (num_forks - 1ULL) / 2ULL);
+        TEST_SUCCESS(memory_read<uint64_t>(content,0x8ULL) == 0x8ULL);
+        std::cout << "  pool: REG (fork), pages: " << content.size() << ", forks: " << num_forks
+                  << ", time [ms]: " << time
+                  << ", throughput [forks/ms]: " << (double)num_forks / time
+                  << "\n";
+    }
+
+    {
+        memory_content  content;
+        std::vector<address> const  addresses = create_read_addresses(false,num_reads);
+        uint64_t  sum = 0ULL;
+        double const  time = measure_milliseconds([&]() {
+            for (address const  adr : addresses)
+                sum += memory_read<uint64_t>(content,adr);
+        });
+        TEST_SUCCESS(sum == num_reads * 0xcdcdcdcdcdcdcdcdULL);
+        TEST_SUCCESS(content.empty());
+        std::cout << "  pool: MEM (unmapped), reads: " << num_reads
+                  << ", time [ms]: " << time
+                  << ", throughput [reads/ms]: " << (double)num_reads / time
+                  << "\n";
+    }
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("memory_read_performance_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_memory_content();
+        test_memory_read_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "../execution_fixture.hpp"
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/native_code.hpp>
+#include <iterator>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+/**
+ * A loop over registers only, which uses all instructions supported by the native code with all sizes of registers.
+ * It also accesses registers in several dense pages, one of them never written.
+ */
+static std::unique_ptr<microcode::program>  create_register_program(uint64_t const  num_iterations)
+{
+    std::unique_ptr<microcode::program>  program = microcode::create_initial_program("test","MAIN");
+    microcode::program_component&  C = program->start_component();
+    node_id const  u = C.insert_sequence(C.entry(),{
+                microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(8U,0x100ULL,0x100ULL,(uint64_t)1ULL),
+                microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_TIMES_NUMBER(4U,0x110ULL,0x104ULL,(uint64_t)0x9e3779b9ULL),
+                microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(2U,0x118ULL,0x118ULL,0x106ULL),
+                microcode::create_BITOPERATIONS__REG_ASGN_REG_AND_NUMBER(8U,0x120ULL,0x100ULL,0xffULL),
+                microcode::create_BITOPERATIONS__REG_ASGN_REG_AND_REG(4U,0x124ULL,0x110ULL,0x104ULL),
+                microcode::create_BITOPERATIONS__REG_ASGN_REG_OR_REG(1U,0x128ULL,0x128ULL,0x107ULL),
+                microcode::create_BITOPERATIONS__REG_ASGN_REG_OR_NUMBER(4U,0x12cULL,0x12cULL,0x10ULL),
+                microcode::create_BITOPERATIONS__REG_ASGN_REG_XOR_REG(8U,0x130ULL,0x130ULL,0x100ULL),
+                microcode::create_BITOPERATIONS__REG_ASGN_NOT_REG(4U,0x138ULL,0x110ULL),
+                microcode::create_ZEROTEST__REG_ASGN_REG_EQUAL_TO_ZERO(8U,0x140ULL,0x120ULL),
+                microcode::create_SETANDCOPY__REG_ASGN_REG(2U,0x148ULL,0x118ULL),
+                microcode::create_SETANDCOPY__REG_ASGN_NUMBER(1U,0x150ULL,0x7fULL),
+                microcode::create_SETANDCOPY__REG_ASGN_REG(8U,0x1008ULL,0x130ULL),
+                microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_REG(8U,0x158ULL,0x1008ULL,0x2000ULL),
+                microcode::create_BITOPERATIONS__REG_ASGN_REG_XOR_NUMBER(8U,0x160ULL,0x100ULL,num_iterations),
+                });
+    C.insert_branching(microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO,8U,0x160ULL,u,{0ULL,C.entry()});
+    return program;
+}
+
+
+static void test_same_records()
+{
+    std::cout << "Starting: test_same_records()\n";
+
+    uint64_t const  num_iterations = 1000ULL;
+    for (auto const  create_program : { &create_program_with_store, &create_register_program })
+    {
+        std::unique_ptr<microcode::program> const  program = create_program(num_iterations);
+
+        execution  walked(*program);
+        TEST_SUCCESS(walked.run(*program,nullptr).empty());
+
+        threaded_code  code(true);
+        execution  compiled(*program);
+        TEST_SUCCESS(compiled.run(*program,&code).empty());
+
+        TEST_SUCCESS(have_same_records(compiled,walked));
+        TEST_SUCCESS(have_same_final_registers(compiled,walked));
+        TEST_SUCCESS(memory_read<uint64_t>(*compiled.eprops.final_regs().front().second,0x100ULL) == num_iterations);
+
+        if (native_code::is_supported())
+        {
+            TEST_SUCCESS(code.native() != nullptr);
+            TEST_SUCCESS(code.native()->num_regions() > 0ULL);
+            TEST_SUCCESS(code.native()->num_refused_entries() == 0ULL);
+        }
+    }
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_input_impacts()
+{
+    std::cout << "Starting: test_input_impacts()\n";
+
+    std::unique_ptr<microcode::program> const  program = create_register_program(1000ULL);
+
+    execution  walked(*program);
+    walked.taint_counter();
+    TEST_SUCCESS(walked.run(*program,nullptr).empty());
+
+    threaded_code  code(true);
+    execution  compiled(*program);
+    compiled.taint_counter();
+    TEST_SUCCESS(compiled.run(*program,&code).empty());
+
+    // Input impacts are propagated by the threaded code, since the loop accesses the counter.
+    TEST_SUCCESS(have_same_records(compiled,walked));
+    TEST_SUCCESS(have_same_final_registers(compiled,walked));
+    TEST_SUCCESS(!walked.eprops.input_frontier(tid).reg_impacts().empty());
+    if (native_code::is_supported())
+        TEST_SUCCESS(code.native()->num_refused_entries() > 0ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+/**
+ * The thread forks and both threads copy the tainted REG[0x100] to REG[0x300]. The tainted REG[0x200] is never read.
+ */
+static void test_input_impacts_of_forked_thread()
+{
+    std::cout << "Starting: test_input_impacts_of_forked_thread()\n";
+
+    std::unique_ptr<microcode::program>  program = microcode::create_initial_program("test","MAIN");
+    microcode::program_component&  C = program->start_component();
+    C.insert_sequence(C.entry(),{
+                microcode::create_CONCURRENCY__REG_ASGN_THREAD(0x180ULL),
+                microcode::create_SETANDCOPY__REG_ASGN_REG(8U,0x300ULL,0x100ULL),
+                });
+
+    execution  E(*program);
+    E.taint_counter();
+    for (address  adr = 0x200ULL; adr < 0x208ULL; ++adr)
+        E.eprops.input_frontier(tid).on_reg_impact(adr,E.rprops.add_input_impact({ 0U, true, adr, {} },E.eprops.get_execution_id(),tid));
+    TEST_SUCCESS(E.run(*program,nullptr).empty());
+
+    input_impacts_of_threads const&  impacts = E.rprops.input_impacts().at(E.eprops.get_execution_id());
+    TEST_SUCCESS(impacts.size() == 2ULL);
+    thread_id const  child = impacts.cbegin()->first != tid ? impacts.cbegin()->first : std::next(impacts.cbegin())->first;
+    input_frontier_of_thread const&  frontier = E.eprops.input_frontier(child);
+
+    // Only values of bytes read by the forked thread are copied to it. The copies are recorded under the node
+    // counter of the fork in the order of the reads. An eager copy at the fork would copy also REG[0x200].
+    std::vector<input_impact_value> const&  copies = impacts.at(child).at(frontier.fork_counter());
+    TEST_SUCCESS(copies.size() == 8ULL);
+    for (index  i = 0ULL; i < copies.size(); ++i)
+        TEST_SUCCESS(copies.at(i).is_in_reg_pool() && copies.at(i).shift_from_begin() == 0x100ULL + i && copies.at(i).links().empty());
+    for (address  adr = 0x300ULL; adr < 0x308ULL; ++adr)
+    {
+        input_impact_link const* const  link = frontier.find_in_reg(adr);
+        TEST_SUCCESS(link != nullptr && frontier.owner(frontier.reg_shadow().label(adr)) == child);
+        input_impact_value const* const  value = E.rprops.find_input_impact_value(E.eprops.get_execution_id(),child,*link);
+        TEST_SUCCESS(value != nullptr && value->links().size() == 1ULL);
+        TEST_SUCCESS(value->links().front() == input_impact_link(frontier.fork_counter(),adr - 0x300ULL));
+    }
+    TEST_SUCCESS(frontier.owner(frontier.reg_shadow().label(0x200ULL)) == tid);
+    TEST_SUCCESS(frontier.reg_impacts().size() == 24ULL && E.eprops.input_frontier(tid).reg_impacts().size() == 24ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_modified_program()
+{
+    std::cout << "Starting: test_modified_program()\n";
+
+    uint64_t const  num_iterations = 1000ULL;
+    std::unique_ptr<microcode::program> const  program = create_register_program(num_iterations);
+    microcode::program_component&  C = program->start_component();
+
+    threaded_code  code(true);
+    execution  E(*program);
+    TEST_SUCCESS(E.run(*program,&code).empty());
+    uint64_t const  num_compilations = code.native() == nullptr ? 0ULL : code.native()->num_compilations();
+
+    // Like the recogniser, we append code to the exit, where the thread stopped. The code restarts the loop.
+    TEST_SUCCESS(C.exits().size() == 1ULL);
+    C.insert_sequence(*C.exits().cbegin(),{ microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,0x100ULL,0ULL) });
+
+    execution  walked(*program);
+    TEST_SUCCESS(walked.run(*program,nullptr).empty());
+    execution  compiled(*program);
+    TEST_SUCCESS(compiled.run(*program,&code).empty());
+    TEST_SUCCESS(have_same_records(compiled,walked));
+    TEST_SUCCESS(have_same_final_registers(compiled,walked));
+    if (native_code::is_supported())
+        TEST_SUCCESS(code.native()->num_compilations() > num_compilations);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_run_performance()
+{
+    std::cout << "Starting: test_run_performance()\n";
+
+    uint64_t const  num_iterations = 100000ULL;
+    std::unique_ptr<microcode::program> const  program = create_register_program(num_iterations);
+    uint64_t const  num_steps = 16ULL * num_iterations;
+
+    threaded_code  code;
+    execution  threaded(*program);
+    double const  threaded_time = threaded.measure_run(*program,&code);
+
+    threaded_code  native(true);
+    execution  compiled(*program);
+    double const  native_time = compiled.measure_run(*program,&native);
+    TEST_SUCCESS(compiled.rprops.records_of_execution(0ULL).node_histories == threaded.rprops.records_of_execution(0ULL).node_histories);
+    TEST_SUCCESS(have_same_final_registers(compiled,threaded));
+
+    std::cout << "  native code supported: " << std::boolalpha << native_code::is_supported() << "\n"
+              << "  steps: " << num_steps << "\n"
+              << "  time per step [ns]: threaded code " << 1000000.0 * threaded_time / (double)num_steps
+              << ", native code " << 1000000.0 * native_time / (double)num_steps << "\n"
+              << "  steps per second [millions]: threaded code " << (double)num_steps / (1000.0 * threaded_time)
+              << ", native code " << (double)num_steps / (1000.0 * native_time) << "\n"
+              ;
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("native_code_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_same_records();
+        test_input_impacts();
+        test_input_impacts_of_forked_thread();
+        test_modified_program();
+        test_run_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
@@ -0,0 +1,485 @@
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/parallel_executions.hpp>
+#include <rebours/analysis/native_execution/worker_pool.hpp>
+#include <rebours/analysis/native_execution/recovery_properties.hpp>
+#include <rebours/analysis/native_execution/prologue_snapshot.hpp>
+#include <rebours/analysis/native_execution/execute_program.hpp>
+#include <rebours/analysis/native_execution/msgstream.hpp>
+#include <rebours/MAL/recogniser/detail/recognition_data.hpp>
+#include <rebours/program/program.hpp>
+#include <rebours/program/assembly.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+static uint64_t  busy_work(uint64_t  seed)
+{
+    for (uint64_t  i = 0ULL; i < 200000ULL; ++i)
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return seed;
+}
+
+static void test_worker_pool()
+{
+    std::cout << "Starting: test_worker_pool()\n";
+
+    uint64_t const  num_tasks = 64ULL;
+    std::vector<uint64_t>  expected(num_tasks);
+    double const  sequential_time = measure_milliseconds([&]() {
+        for (uint64_t  i = 0ULL; i < num_tasks; ++i)
+            expected.at(i) = busy_work(i);
+    });
+
+    worker_pool  pool(4U);
+    TEST_SUCCESS(pool.num_workers() == 4U);
+    std::vector<uint64_t>  results(num_tasks,0ULL);
+    double const  parallel_time = measure_milliseconds([&]() {
+        for (uint64_t  i = 0ULL; i < num_tasks; ++i)
+            pool.submit([&results,i]() { results.at(i) = busy_work(i); });
+        pool.wait();
+    });
+    TEST_SUCCESS(results == expected);
+
+    // The pool can be reused, and an exception thrown from a task is re-thrown from 'wait()'.
+    std::atomic<uint64_t>  num_finished(0ULL);
+    for (uint64_t  i = 0ULL; i < num_tasks; ++i)
+        pool.submit([&num_finished,i]() {
+            if (i == 7ULL)
+                throw std::runtime_error("task failed");
+            ++num_finished;
+        });
+    bool  thrown = false;
+    try { pool.wait(); }
+    catch (std::runtime_error const&) { thrown = true; }
+    TEST_SUCCESS(thrown);
+    TEST_SUCCESS(num_finished == num_tasks - 1ULL);
+    pool.wait();
+
+    std::cout << "  tasks: " << num_tasks << ", time [ms]:  sequential " << sequential_time << ", pool of 4 workers " << parallel_time << "\n";
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_merge_of_recovery_properties()
+{
+    std::cout << "Starting: test_merge_of_recovery_properties()\n";
+
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { 0x400000ULL, 0x401000ULL } },1000000ULL);
+    rprops.add_unexplored_exits(0x400000ULL,{ 10ULL, 20ULL });
+
+    recovery_properties  first = rprops.fork_execution(0ULL);
+    recovery_properties  second = rprops.fork_execution(1ULL);
+    TEST_SUCCESS(first.unexplored().size() == 2ULL && first.num_executions_performed() == 0ULL);
+
+    first.on_new_thread(0ULL,1ULL);
+    first.insert_node_to_history(0ULL,1ULL,10ULL);
+    first.update_unexplored(10ULL);
+    first.add_unexplored_exits(0x400010ULL,{ 11ULL });
+
+    second.on_new_thread(1ULL,2ULL);
+    second.insert_node_to_history(1ULL,2ULL,20ULL);
+    second.insert_node_to_history(1ULL,2ULL,21ULL);
+    second.on_branching_visited({ 20ULL, 21ULL });
+    second.add_unexplored_exits(0x400020ULL,{ 22ULL });
+    second.update_unexplored(22ULL);  //!< Inserted and erased by the same execution.
+
+    TEST_SUCCESS(rprops.merge_execution(first,0ULL) == 0ULL);
+    TEST_SUCCESS(rprops.merge_execution(second,1ULL) == 1ULL);
+    TEST_SUCCESS(rprops.num_executions_performed() == 2ULL);
+    TEST_SUCCESS(rprops.threads_of_execution(0ULL) == std::vector<thread_id>{ 1ULL });
+    TEST_SUCCESS(rprops.threads_of_execution(1ULL) == std::vector<thread_id>{ 2ULL });
+    TEST_SUCCESS(rprops.node_histories().at(1ULL).at(2ULL) == (compact_trace{ 20ULL, 21ULL }));
+    TEST_SUCCESS(rprops.unexplored().size() == 2ULL && rprops.unexplored().count(20ULL) == 1ULL && rprops.unexplored().count(11ULL) == 1ULL);
+    TEST_SUCCESS(rprops.unexplored().at(11ULL).IP() == 0x400010ULL);
+    TEST_SUCCESS(rprops.visited_branchings().count({ 20ULL, 21ULL }) == 1ULL);
+
+    // When a preceding execution is not merged, the next one takes its ID.
+    recovery_properties  third = rprops.fork_execution(2ULL);
+    recovery_properties  fourth = rprops.fork_execution(3ULL);
+    third.on_new_thread(2ULL,3ULL);
+    fourth.on_new_thread(3ULL,4ULL);
+    fourth.insert_node_to_history(3ULL,4ULL,11ULL);
+    TEST_SUCCESS(rprops.merge_execution(fourth,3ULL) == 2ULL);
+    TEST_SUCCESS(rprops.num_executions_performed() == 3ULL);
+    TEST_SUCCESS(rprops.threads_of_execution(2ULL) == std::vector<thread_id>{ 4ULL });
+    TEST_SUCCESS(rprops.node_couter(2ULL,4ULL) == 0ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_merge_of_recovered_code()
+{
+    std::cout << "Starting: test_merge_of_recovered_code()\n";
+
+    std::unique_ptr<microcode::program> const  program = microcode::create_initial_program("test","MAIN");
+    microcode::program_component&  C = program->start_component();
+    node_id const  head = C.insert_sequence(C.entry(),{ microcode::create_MISCELLANEOUS__NOP() });
+    std::pair<node_id,node_id> const  xy = C.insert_branching(microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO,1U,0ULL,head);
+    node_id const  x = xy.first;
+    node_id const  y = xy.second;
+    TEST_SUCCESS(C.exits().size() == 2ULL);
+
+    std::unique_ptr<microcode::program> const  first = microcode::copy_program(*program);
+    std::unique_ptr<microcode::program> const  second = microcode::copy_program(*program);
+    std::unique_ptr<microcode::program> const  third = microcode::copy_program(*program);
+    TEST_SUCCESS(first->start_component().entry() == C.entry() && first->start_component().nodes().count(x) == 1ULL);
+    TEST_SUCCESS(first->start_component().edges().size() == C.edges().size());
+
+    node_id const  x1 = first->start_component().insert_sequence(x,{ microcode::create_MISCELLANEOUS__STOP() });
+    node_id const  y1 = second->start_component().insert_sequence(y,{ microcode::create_MISCELLANEOUS__STOP() });
+    second->push_back(std::make_shared<microcode::program_component>("test","FUNC"));
+    third->start_component().insert_sequence(x,{ microcode::create_MISCELLANEOUS__NOP() });
+    TEST_SUCCESS(C.exits().count(x) == 1ULL && C.nodes().count(x1) == 0ULL);  //!< Copies are independent on the original.
+
+    program_changes const  first_changes = compute_program_changes(*program,*first);
+    program_changes const  second_changes = compute_program_changes(*program,*second);
+    program_changes const  third_changes = compute_program_changes(*program,*third);
+    TEST_SUCCESS(first_changes.components.size() == 1ULL && first_changes.new_components.empty());
+    TEST_SUCCESS(first_changes.components.front().inserted_nodes == std::vector<node_id>{ x1 });
+    TEST_SUCCESS(first_changes.modified_nodes == std::unordered_set<node_id>{ x });
+    TEST_SUCCESS(second_changes.new_components.size() == 1ULL);
+
+    std::unordered_set<node_id>  modified_nodes;
+    TEST_SUCCESS(apply_program_changes(first_changes,*program,modified_nodes));
+    TEST_SUCCESS(apply_program_changes(second_changes,*program,modified_nodes));
+    TEST_SUCCESS(!apply_program_changes(third_changes,*program,modified_nodes));  //!< It extends the same exit as the first one.
+
+    TEST_SUCCESS(C.exits() == (std::unordered_set<node_id>{ x1, y1 }));
+    TEST_SUCCESS(C.instruction({ x, x1 }).GIK() == microcode::GIK::MISCELLANEOUS__STOP);
+    TEST_SUCCESS(program->num_components() == 2ULL);
+    TEST_SUCCESS(microcode::find_component(*program,x1) == 0ULL);
+    TEST_SUCCESS(microcode::find_component(*program,program->component(1ULL).entry()) == 1ULL);
+
+    // A component shared by copies of the program is merged only once. A different component with the entry
+    // of a merged one conflicts.
+    microcode::program_component_ptr const  shared = std::make_shared<microcode::program_component>("test","SHARED");
+    std::unique_ptr<microcode::program> const  fourth = microcode::copy_program(*program);
+    std::unique_ptr<microcode::program> const  fifth = microcode::copy_program(*program);
+    fourth->push_back(shared);
+    fifth->push_back(shared);
+    program_changes const  fourth_changes = compute_program_changes(*program,*fourth);
+    program_changes const  fifth_changes = compute_program_changes(*program,*fifth);
+    TEST_SUCCESS(fourth_changes.components.empty() && fourth_changes.new_components.size() == 1ULL);
+    TEST_SUCCESS(apply_program_changes(fourth_changes,*program,modified_nodes));
+    TEST_SUCCESS(apply_program_changes(fifth_changes,*program,modified_nodes));
+    TEST_SUCCESS(program->num_components() == 3ULL && &program->component(2ULL) == shared.get());
+
+    std::unique_ptr<microcode::program> const  sixth = microcode::copy_program(*program);
+    TEST_SUCCESS(sixth->component(2ULL).entry() == shared->entry() && &sixth->component(2ULL) != shared.get());
+    program_changes  conflicting_changes = fifth_changes;
+    conflicting_changes.new_components = { sixth->share_component(2ULL) };
+    TEST_SUCCESS(!apply_program_changes(conflicting_changes,*program,modified_nodes));
+    TEST_SUCCESS(program->num_components() == 3ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+namespace {
+
+
+/**
+ * A recogniser of a tiny instruction set, which (unlike the one in MAL/recogniser/tests/fake_recogniser.cpp) updates
+ * the instruction pointer at the address 0 of REG pool, so that native executions can run the recognised code:
+ *      90h                 NOP             IP := IP + 1
+ *      74h rr xx           JZ [rr],xx      IP := IP + 3 + xx, if the byte at the address rr of REG pool is 0;
+ *                                          IP := IP + 3, otherwise
+ *      F4h                 HLT             STOP
+ */
+struct fake_recognition_data : public mal::recogniser::detail::recognition_data
+{
+    fake_recognition_data(uint64_t const  start_address, mal::recogniser::reg_fn_type const&  reg_fn,
+                          mal::recogniser::mem_fn_type const&  mem_fn)
+        : mal::recogniser::detail::recognition_data(start_address,reg_fn,mem_fn)
+    {}
+
+    void  recognise(mal::descriptor::storage const&) { recognise(); }
+    bool  dump(std::string const&) const { return false; }
+
+    void  recognise();
+
+private:
+    bool  read_byte(uint64_t const  address);
+};
+
+
+bool  fake_recognition_data::read_byte(uint64_t const  address)
+{
+    int16_t const  value = mem_fn()(address,2U);
+    if (value < 0)
+    {
+        set_error_result(value == -1 ? 2U : 4U);
+        set_error_address(address);
+        if (value == -2)
+            set_error_rights(2U);
+        return false;
+    }
+    buffer().push_back((uint8_t)value);
+    return true;
+}
+
+void  fake_recognition_data::recognise()
+{
+    if (!read_byte(start_address()))
+        return;
+
+    microcode::program_component&  C = program()->start_component();
+    switch (buffer().front())
+    {
+    case 0x90U:
+        set_asm_text("NOP");
+        C.insert_sequence(C.entry(),{ microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,0ULL,start_address() + 1ULL) });
+        break;
+    case 0x74U:
+        {
+            if (!read_byte(start_address() + 1ULL) || !read_byte(start_address() + 2ULL))
+                return;
+            set_asm_text("JZ");
+            std::pair<node_id,node_id> const  targets =
+                    C.insert_branching(microcode::GIK::GUARDS__REG_EQUAL_TO_ZERO,1U,buffer().at(1ULL),C.entry());
+            C.insert_sequence(targets.first,{ microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,0ULL,start_address() + 3ULL + buffer().at(2ULL)) });
+            C.insert_sequence(targets.second,{ microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,0ULL,start_address() + 3ULL) });
+        }
+        break;
+    case 0xF4U:
+        set_asm_text("HLT");
+        C.insert_sequence(C.entry(),{ microcode::create_MISCELLANEOUS__STOP() });
+        break;
+    default:
+        set_error_result(254U);
+        set_error_address(start_address());
+        return;
+    }
+
+    std::ostringstream  ostr;
+    for (uint64_t  i = 0ULL; i < buffer().size(); ++i)
+        ostr << std::hex << (uint32_t)buffer().at(i) << "h" << (i + 1ULL != buffer().size() ? "," : "");
+    set_asm_bytes(ostr.str());
+    instructions().push_back({ C.entry(), start_address(), asm_text(), asm_bytes() });
+    set_ends_basic_block(true);
+}
+
+
+}
+
+static mal::recogniser::recognition_result  recognise_fake_instruction(uint64_t const  start_address,
+                                                                        mal::recogniser::reg_fn_type const&  reg_fn,
+                                                                        mal::recogniser::mem_fn_type const&  mem_fn)
+{
+    std::shared_ptr<fake_recognition_data> const  data = std::make_shared<fake_recognition_data>(start_address,reg_fn,mem_fn);
+    data->recognise();
+    return mal::recogniser::recognition_result(data);
+}
+
+
+static address const  code_begin = 0x400000ULL;
+static std::vector<uint8_t> const  code{
+    0x74U, 0x10U, 0x05U,    //!< 0: JZ [10h],5
+    0x74U, 0x11U, 0x01U,    //!< 3: JZ [11h],1
+    0xF4U,                  //!< 6: HLT
+    0xF4U,                  //!< 7: HLT
+    0x90U,                  //!< 8: NOP
+    0xF4U,                  //!< 9: HLT
+    };
+
+/**
+ * It mimics the work of a prologue program: it loads the code into the memory and sets the instruction pointer.
+ */
+static prologue_snapshot_ptr  create_snapshot(thread_id const  tid)
+{
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { code_begin, code_begin + code.size() } },1000000ULL);
+    execution_properties  eprops(0ULL,0x10000ULL,0x20000ULL,0x100ULL);
+    eprops.mem_allocations().insert({ code_begin, memory_allocation_info(code.size(),true,false,true,true,false) });
+    memory_write(eprops.mem_content(),code_begin,code.data(),code.size());
+
+    std::shared_ptr<memory_content> const  reg = std::make_shared<memory_content>();
+    memory_write(*reg,0ULL,code_begin);
+    eprops.add_final_reg(tid,reg);
+
+    rprops.on_new_thread(eprops.get_execution_id(),tid);
+    rprops.on_concurrent_group_begin(eprops.get_execution_id());
+    rprops.on_thread_step(eprops.get_execution_id(),tid);
+    rprops.insert_node_to_history(eprops.get_execution_id(),tid,1ULL);
+    return std::make_shared<prologue_snapshot const>(eprops,rprops);
+}
+
+/**
+ * The fork behaves as if the program read the values of both flags from its input.
+ */
+static execution_properties  fork_with_flags(prologue_snapshot const&  snapshot, execution_id const  eid, uint8_t const  flag10, uint8_t const  flag11)
+{
+    execution_properties  fork = snapshot.fork(eid,{});
+    memory_write(*fork.final_regs().front().second,0x10ULL,flag10);
+    memory_write(*fork.final_regs().front().second,0x11ULL,flag11);
+    return fork;
+}
+
+/**
+ * Fresh IDs of nodes differ between runs, so we rename each node to its index in the depth-first search from the entry
+ * (successors are visited in the order of assembly texts of edges) before we compare recovered data.
+ */
+static std::string  canonical_text(microcode::program const&  P, microcode::annotations const&  A, recovery_properties const&  rprops)
+{
+    TEST_SUCCESS(P.num_components() == 1ULL);
+    microcode::program_component const&  C = P.start_component();
+
+    std::unordered_map<node_id,uint64_t>  index;
+    std::vector<node_id>  stack{ C.entry() };
+    std::ostringstream  ostr;
+    while (!stack.empty())
+    {
+        node_id const  u = stack.back();
+        stack.pop_back();
+        if (index.count(u) != 0ULL)
+            continue;
+        index.insert({u,index.size()});
+        std::map<std::string,node_id>  successors;
+        for (node_id const  v : C.successors(u))
+            successors.insert({ microcode::assembly_text(C.instruction({u,v})), v });
+        for (auto it = successors.crbegin(); it != successors.crend(); ++it)
+            stack.push_back(it->second);
+    }
+    TEST_SUCCESS(index.size() == C.nodes().size());
+
+    std::set<std::string>  lines;
+    for (auto const&  e_I : C.edges())
+        lines.insert(msgstream() << "E " << index.at(e_I.first.first) << " " << index.at(e_I.first.second) << " "
+                                 << microcode::assembly_text(e_I.second.instruction()) << msgstream::end());
+    for (auto const&  node_annotations : A)
+        for (microcode::annotation const&  keyword_value : node_annotations.second)
+            lines.insert(msgstream() << "A " << index.at(node_annotations.first) << " " << keyword_value.first << " " << keyword_value.second << msgstream::end());
+    for (auto const&  node_info : rprops.unexplored())
+        lines.insert(msgstream() << "U " << index.at(node_info.first) << " " << node_info.second.IP() << msgstream::end());
+    for (edge_id const&  e : rprops.visited_branchings())
+        lines.insert(msgstream() << "B " << index.at(e.first) << " " << index.at(e.second) << msgstream::end());
+    for (execution_id  eid = 0ULL; eid < rprops.num_executions_performed(); ++eid)
+        for (thread_id const  tid : rprops.threads_of_execution(eid))
+        {
+            msgstream  mstr;
+            mstr << "H " << eid << " " << tid << " :";
+            for (node_id const  u : rprops.node_histories().at(eid).at(tid))
+                mstr << " " << (index.count(u) == 0ULL ? "?" : std::to_string(index.at(u)));
+            lines.insert(mstr.str());
+        }
+
+    for (std::string const&  line : lines)
+        ostr << line << "\n";
+    return ostr.str();
+}
+
+/**
+ * Error messages name the edge of the 'STOP' instruction, which differs between runs.
+ */
+static bool  was_stopped(std::string const&  error_message)
+{
+    std::string const  suffix = "The execution was terminated by the 'STOP' instruction.";
+    return error_message.size() >= suffix.size() && error_message.compare(error_message.size() - suffix.size(),suffix.size(),suffix) == 0;
+}
+
+/**
+ * Executions forked from a snapshot are performed by a worker pool and their results are merged. The merged data must
+ * be the same as if the merged executions were performed one by one. The last execution takes the same path as
+ * the first one, so their recovered code conflicts and the last execution must be refused.
+ */
+static void test_parallel_executions_of_forks()
+{
+    std::cout << "Starting: test_parallel_executions_of_forks()\n";
+
+    thread_id const  tid = generate_fresh_thread_id();
+    prologue_snapshot_ptr const  snapshot = create_snapshot(tid);
+    std::vector< std::pair<uint8_t,uint8_t> > const  flags{ { 1U, 1U }, { 0U, 1U }, { 1U, 0U }, { 0U, 0U } };
+
+    recovery_properties  serial_rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { code_begin, code_begin + code.size() } },1000000ULL);
+    std::unique_ptr<microcode::program> const  serial_program = microcode::create_initial_program("program","MAIN");
+    std::unique_ptr<microcode::program> const  prologue = microcode::create_initial_program("prologue","MAIN");
+    microcode::annotations  serial_annotations;
+    snapshot->restore_records(serial_rprops,0ULL);
+    std::vector<std::string>  serial_errors;
+    for (uint64_t  i = 0ULL; i + 1ULL < flags.size(); ++i)
+    {
+        prologue_snapshot_ptr  forked_from = snapshot;
+        execution_properties  eprops = fork_with_flags(*snapshot,i + 1ULL,flags.at(i).first,flags.at(i).second);
+        serial_errors.push_back(perform_single_native_program_execution(serial_rprops,eprops,*prologue,*serial_program,serial_annotations,
+                                                                        &recognise_fake_instruction,"",false,
+                                                                        mal::recogniser::recognition_result_dump_fn(),{},
+                                                                        &forked_from));
+    }
+    TEST_SUCCESS(std::all_of(serial_errors.cbegin(),serial_errors.cend(),&was_stopped));
+    TEST_SUCCESS(serial_rprops.num_executions_performed() == flags.size());
+    TEST_SUCCESS(serial_rprops.unexplored().empty());
+
+    // The first execution is performed alone, so that the next ones diverge at branchings it has recovered.
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { code_begin, code_begin + code.size() } },1000000ULL);
+    std::unique_ptr<microcode::program> const  program = microcode::create_initial_program("program","MAIN");
+    microcode::annotations  annotations;
+    snapshot->restore_records(rprops,0ULL);
+    {
+        prologue_snapshot_ptr  forked_from = snapshot;
+        execution_properties  eprops = fork_with_flags(*snapshot,1ULL,flags.front().first,flags.front().second);
+        TEST_SUCCESS(was_stopped(perform_single_native_program_execution(rprops,eprops,*prologue,*program,annotations,
+                                                                         &recognise_fake_instruction,"",false,
+                                                                         mal::recogniser::recognition_result_dump_fn(),{},
+                                                                         &forked_from)));
+    }
+    TEST_SUCCESS(rprops.unexplored().size() == 2ULL);
+
+    std::vector<execution_properties>  eprops;
+    for (uint64_t  i = 1ULL; i < flags.size(); ++i)
+        eprops.push_back(fork_with_flags(*snapshot,i + 1ULL,flags.at(i).first,flags.at(i).second));
+    worker_pool  pool(2U);
+    std::vector<uint64_t>  refused;
+    std::vector<std::string> const  errors =
+            perform_parallel_native_program_executions(pool,rprops,eprops,*prologue,*program,annotations,&recognise_fake_instruction,
+                                                       refused,"",false,
+                                                       [](mal::recogniser::recognition_result const& , std::string const&) -> bool { return false; },
+                                                       {},snapshot);
+    TEST_SUCCESS(errors.size() == eprops.size());
+    TEST_SUCCESS(std::all_of(errors.cbegin(),errors.cend(),&was_stopped));
+    TEST_SUCCESS(refused == std::vector<uint64_t>{ 2ULL });
+
+    TEST_SUCCESS(rprops.num_executions_performed() == serial_rprops.num_executions_performed());
+    TEST_SUCCESS(canonical_text(*program,annotations,rprops) == canonical_text(*serial_program,serial_annotations,serial_rprops));
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("parallel_executions_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_worker_pool();
+        test_merge_of_recovery_properties();
+        test_merge_of_recovered_code();
+        test_parallel_executions_of_forks();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
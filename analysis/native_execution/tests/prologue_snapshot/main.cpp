@@ -0,0 +1,189 @@
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/prologue_snapshot.hpp>
+#include <rebours/analysis/native_execution/execution_properties.hpp>
+#include <rebours/analysis/native_execution/recovery_properties.hpp>
+#include <rebours/analysis/native_execution/execute_program.hpp>
+#include <rebours/program/program.hpp>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+static address const  image_begin = 0x400000ULL;
+static address const  image_end = 0x800000ULL;
+
+/**
+ * It mimics the work of a prologue program: it loads an image of the executable into the memory, opens
+ * the standard streams, and reads the first bytes of the stream #0.
+ */
+static void  execute_prologue(execution_properties&  eprops, recovery_properties&  rprops, thread_id const  tid)
+{
+    eprops.mem_allocations().insert({ image_begin, memory_allocation_info(image_end - image_begin,true,false,true,true,false) });
+    for (address  adr = image_begin; adr < image_end; adr += 8ULL)
+        memory_write(eprops.mem_content(),adr,adr);
+
+    eprops.stream_allocations().insert({ "#0", stream_open_info(true,true,false,false,4ULL,2ULL) });
+    eprops.stream_allocations().insert({ "#1", stream_open_info(true,false,true,false,0ULL,0ULL) });
+    stream_write(eprops.contents_of_streams()["#0"],0ULL,(uint32_t)0x01020304U);
+
+    std::shared_ptr<memory_content> const  reg = std::make_shared<memory_content>();
+    memory_write(*reg,0x10ULL,image_begin);
+    eprops.add_final_reg(tid,reg);
+
+    rprops.on_new_thread(eprops.get_execution_id(),tid);
+    rprops.insert_node_to_history(eprops.get_execution_id(),tid,1ULL);
+    rprops.insert_node_to_history(eprops.get_execution_id(),tid,2ULL);
+    rprops.add_input_impact({ 0x01U, "#0", 0ULL, {} },eprops.get_execution_id(),tid);
+}
+
+static void test_fork_of_snapshot()
+{
+    std::cout << "Starting: test_fork_of_snapshot()\n";
+
+    thread_id const  tid = 1ULL;
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { image_begin, image_begin + 0x1000ULL } },1000000ULL);
+    execution_properties  eprops(0ULL,0x10000ULL,0x20000ULL,0x100ULL);
+    execute_prologue(eprops,rprops,tid);
+
+    prologue_snapshot const  snapshot(eprops,rprops);
+    TEST_SUCCESS(snapshot.read_streams() == std::unordered_set<stream_id>{ "#0" });
+    TEST_SUCCESS(snapshot.can_fork({ { "#2", { 0x61U } } }));
+    TEST_SUCCESS(!snapshot.can_fork({ { "#0", { 0x61U } } }));
+
+    execution_properties  fork = snapshot.fork(1ULL,{ { "#2", { 0x61U, 0x62U } } });
+    TEST_SUCCESS(fork.get_execution_id() == 1ULL);
+    TEST_SUCCESS(fork.final_regs().size() == 1ULL && fork.final_regs().front().first == tid);
+    TEST_SUCCESS(memory_read<uint64_t>(fork.mem_content(),image_end - 8ULL) == image_end - 8ULL);
+    TEST_SUCCESS(fork.stream_allocations().at("#2").readable() && fork.stream_allocations().at("#2").size() == 2ULL);
+    TEST_SUCCESS(stream_read<uint8_t>(fork.contents_of_streams().at("#2"),1ULL) == 0x62U);
+    TEST_SUCCESS(stream_read<uint32_t>(fork.contents_of_streams().at("#0"),0ULL) == 0x01020304U);
+
+    // Writes to the fork are not visible in the snapshot (and so in other forks).
+    memory_write(fork.mem_content(),image_begin,(uint64_t)0ULL);
+    memory_write(*fork.final_regs().front().second,0x10ULL,(uint64_t)0ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(fork.mem_content(),image_begin) == 0ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(snapshot.eprops().mem_content(),image_begin) == image_begin);
+    TEST_SUCCESS(memory_read<uint64_t>(*snapshot.eprops().final_regs().front().second,0x10ULL) == image_begin);
+    TEST_SUCCESS(memory_read<uint64_t>(*eprops.final_regs().front().second,0x10ULL) == image_begin);
+
+    snapshot.restore_records(rprops,1ULL);
+    TEST_SUCCESS(rprops.num_executions_performed() == 2ULL);
+    TEST_SUCCESS(rprops.threads_of_execution(1ULL) == std::vector<thread_id>{ tid });
+    TEST_SUCCESS(rprops.node_couter(1ULL,tid) == rprops.node_couter(0ULL,tid));
+    TEST_SUCCESS(rprops.input_impacts().at(1ULL).at(tid).size() == rprops.input_impacts().at(0ULL).at(tid).size());
+
+    std::cout << "SUCCESS\n";
+}
+
+/**
+ * A fork, which times out before the program runs, is not an execution performed. So, no records of the prologue
+ * are restored for it.
+ */
+static void test_timeout_of_fork()
+{
+    std::cout << "Starting: test_timeout_of_fork()\n";
+
+    thread_id const  tid = 1ULL;
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { image_begin, image_begin + 0x1000ULL } },0ULL);
+    execution_properties  eprops(0ULL,0x10000ULL,0x20000ULL,0x100ULL);
+    execute_prologue(eprops,rprops,tid);
+    prologue_snapshot_ptr  snapshot = std::make_shared<prologue_snapshot const>(eprops,rprops);
+
+    std::unique_ptr<microcode::program> const  prologue = microcode::create_initial_program("prologue","MAIN");
+    std::unique_ptr<microcode::program> const  program = microcode::create_initial_program("program","MAIN");
+    microcode::annotations  annotations;
+    execution_properties  fork = snapshot->fork(1ULL,{});
+    std::string const  error_message = perform_single_native_program_execution(rprops,fork,*prologue,*program,annotations,
+                                                                               mal::recogniser::recognise_callback_fn(),"",false,
+                                                                               mal::recogniser::recognition_result_dump_fn(),{},
+                                                                               &snapshot);
+    TEST_SUCCESS(error_message == "Timeout!");
+    TEST_SUCCESS(rprops.num_executions_performed() == 1ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+/**
+ * We compare repeated executions of the prologue with forks of its snapshot, where each execution then
+ * writes into a few pages of the loaded image.
+ */
+static void test_fork_performance()
+{
+    std::cout << "Starting: test_fork_performance()\n";
+
+    uint64_t const  num_executions = 50ULL;
+    thread_id const  tid = 1ULL;
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100ULL,{ { image_begin, image_begin + 0x1000ULL } },1000000ULL);
+
+    uint64_t  replay_sum = 0ULL;
+    double const  replay_time = measure_milliseconds([&]() {
+        for (uint64_t  i = 0ULL; i < num_executions; ++i)
+        {
+            execution_properties  eprops(i,0x10000ULL,0x20000ULL,0x100ULL);
+            execute_prologue(eprops,rprops,tid);
+            memory_write(eprops.mem_content(),image_begin + 0x1000ULL * i,i);
+            replay_sum += memory_read<uint64_t>(eprops.mem_content(),image_begin + 0x1000ULL * i);
+        }
+    });
+
+    execution_properties  eprops(num_executions,0x10000ULL,0x20000ULL,0x100ULL);
+    execute_prologue(eprops,rprops,tid);
+    prologue_snapshot const  snapshot(eprops,rprops);
+
+    uint64_t  fork_sum = 0ULL;
+    double const  fork_time = measure_milliseconds([&]() {
+        for (uint64_t  i = 0ULL; i < num_executions; ++i)
+        {
+            execution_properties  fork = snapshot.fork(num_executions + 1ULL + i,{ { "#2", { (uint8_t)i } } });
+            snapshot.restore_records(rprops,num_executions + 1ULL + i);
+            memory_write(fork.mem_content(),image_begin + 0x1000ULL * i,i);
+            fork_sum += memory_read<uint64_t>(fork.mem_content(),image_begin + 0x1000ULL * i);
+        }
+    });
+
+    TEST_SUCCESS(replay_sum == fork_sum);
+    TEST_SUCCESS(rprops.num_executions_performed() == 2ULL * num_executions + 1ULL);
+    TEST_SUCCESS(memory_read<uint64_t>(snapshot.eprops().mem_content(),image_begin + 0x1000ULL) == image_begin + 0x1000ULL);
+
+    std::cout << "  executions: " << num_executions
+              << ", image pages: " << snapshot.eprops().mem_content().size()
+              << ", time [ms]:  prologue " << replay_time << ", snapshot fork " << fork_time
+              << "\n";
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("prologue_snapshot_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_fork_of_snapshot();
+        test_timeout_of_fork();
+        test_fork_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
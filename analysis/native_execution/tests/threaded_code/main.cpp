@@ -0,0 +1,143 @@
+#include "../execution_fixture.hpp"
+#include <rebours/analysis/native_execution/test.hpp>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+static void test_same_records()
+{
+    std::cout << "Starting: test_same_records()\n";
+
+    uint64_t const  num_iterations = 1000ULL;
+    std::unique_ptr<microcode::program> const  program = create_program_with_store(num_iterations);
+
+    execution  walked(*program);
+    walked.taint_counter();
+    TEST_SUCCESS(walked.run(*program,nullptr).empty());
+
+    threaded_code  code;
+    execution  compiled(*program);
+    compiled.taint_counter();
+    TEST_SUCCESS(compiled.run(*program,&code).empty());
+
+    TEST_SUCCESS(code.num_records() == 5ULL);
+    TEST_SUCCESS(code.num_lowerings() == code.num_records());
+
+    TEST_SUCCESS(walked.rprops.records_of_execution(0ULL).node_histories.at(tid).size() == 4ULL * num_iterations + 2ULL);  // The termination inserts the entry again.
+    TEST_SUCCESS(have_same_records(compiled,walked));
+    TEST_SUCCESS(have_same_final_registers(compiled,walked));
+    TEST_SUCCESS(memory_read<uint64_t>(*compiled.eprops.final_regs().front().second,0x100ULL) == num_iterations);
+    TEST_SUCCESS(memory_read<uint64_t>(compiled.eprops.mem_content(),data_begin) == num_iterations);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_errors()
+{
+    std::cout << "Starting: test_errors()\n";
+
+    std::unique_ptr<microcode::program> const  program = create_program_with_store(100ULL);
+
+    execution  walked(*program);
+    memory_write(walked.threads.back().reg(),0x108ULL,data_begin + 0x100000ULL);
+    std::string const  walked_error = walked.run(*program,nullptr);
+
+    threaded_code  code;
+    execution  compiled(*program);
+    memory_write(compiled.threads.back().reg(),0x108ULL,data_begin + 0x100000ULL);
+    std::string const  compiled_error = compiled.run(*program,&code);
+
+    TEST_SUCCESS(walked_error.find("Attempt to write into a not allocated memory.") != std::string::npos);
+    TEST_SUCCESS(compiled_error == walked_error);
+    TEST_SUCCESS(compiled.threads.size() == 1ULL && compiled.threads.back().stack() == walked.threads.back().stack());
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_modified_program()
+{
+    std::cout << "Starting: test_modified_program()\n";
+
+    std::unique_ptr<microcode::program> const  program = microcode::create_initial_program("test","MAIN");
+    microcode::program_component&  C = program->start_component();
+    node_id const  u = C.insert_sequence(C.entry(),{ microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,0x100ULL,1ULL) });
+
+    threaded_code  code;
+    execution  E(*program);
+    uint64_t  num_steps;
+    TEST_SUCCESS(execution_run(*program,code,E.threads.back(),E.eprops,E.rprops,100ULL,num_steps).empty());
+    TEST_SUCCESS(num_steps == 1ULL && E.threads.back().stack().back() == u);
+    TEST_SUCCESS(code.at(code.find_record(*program,u)).kind == threaded_code::KIND::WALKER);
+
+    // Like the recogniser, we append code to the exit, where the thread stopped.
+    node_id const  v = C.insert_sequence(u,{ microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,0x100ULL,2ULL) });
+    uint64_t const  num_lowerings = code.num_lowerings();
+    TEST_SUCCESS(execution_run(*program,code,E.threads.back(),E.eprops,E.rprops,100ULL,num_steps).empty());
+    TEST_SUCCESS(num_steps == 1ULL && E.threads.back().stack().back() == v);
+    TEST_SUCCESS(code.num_lowerings() > num_lowerings);
+    TEST_SUCCESS(memory_read<uint64_t>(E.threads.back().reg(),0x100ULL) == 2ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_run_performance()
+{
+    std::cout << "Starting: test_run_performance()\n";
+
+    uint64_t const  num_iterations = 250000ULL;
+    std::unique_ptr<microcode::program> const  program = create_program_with_store(num_iterations);
+    uint64_t const  num_steps = 4ULL * num_iterations;
+
+    execution  walked(*program);
+    double const  walker_time = walked.measure_run(*program,nullptr);
+
+    threaded_code  code;
+    execution  compiled(*program);
+    double const  threaded_time = compiled.measure_run(*program,&code);
+    TEST_SUCCESS(compiled.rprops.records_of_execution(0ULL).node_histories == walked.rprops.records_of_execution(0ULL).node_histories);
+
+    std::cout << "  steps: " << num_steps << "\n"
+              << "  time per step [ns]: walker " << 1000000.0 * walker_time / (double)num_steps
+              << ", threaded code " << 1000000.0 * threaded_time / (double)num_steps << "\n"
+              << "  steps per second [millions]: walker " << (double)num_steps / (1000.0 * walker_time)
+              << ", threaded code " << (double)num_steps / (1000.0 * threaded_time) << "\n"
+              ;
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("threaded_code_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_same_records();
+        test_errors();
+        test_modified_program();
+        test_run_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
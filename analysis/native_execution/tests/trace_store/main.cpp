@@ -0,0 +1,211 @@
+#include <rebours/analysis/native_execution/test.hpp>
+#include <rebours/analysis/native_execution/trace_store.hpp>
+#include <rebours/analysis/native_execution/recovery_properties.hpp>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+using namespace analysis::natexe;
+
+
+/**
+ * It produces a sequence resembling visited nodes: runs of successive IDs (basic blocks) interrupted by jumps
+ * forward and backward, and occasionally a huge ID.
+ */
+static std::vector<uint64_t>  create_history(uint64_t const  size)
+{
+    std::vector<uint64_t>  history;
+    uint64_t  node = 1000ULL;
+    uint64_t  seed = 12345ULL;
+    for (uint64_t  i = 0ULL; i < size; ++i)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t const  r = seed >> 33U;
+        if (r % 1000ULL == 0ULL)
+            node = 0xfffffffffffff000ULL + r % 0x1000ULL;
+        else if (r % 8ULL == 0ULL)
+            node = 1000ULL + r % 50000ULL;
+        else
+            ++node;
+        history.push_back(node);
+    }
+    return history;
+}
+
+static void  check_trace(compact_trace const&  trace, std::vector<uint64_t> const&  values)
+{
+    TEST_SUCCESS(trace.size() == values.size());
+    TEST_SUCCESS(trace.empty() == values.empty());
+    uint64_t  i = 0ULL;
+    for (uint64_t const  value : trace)
+    {
+        TEST_SUCCESS(value == values.at(i));
+        ++i;
+    }
+    TEST_SUCCESS(i == values.size());
+    for (uint64_t  j = 0ULL; j < values.size(); j += 37ULL)
+    {
+        TEST_SUCCESS(trace.at(j) == values.at(j));
+        TEST_SUCCESS(*compact_trace::const_iterator(&trace,j) == values.at(j));
+    }
+    if (!values.empty())
+        TEST_SUCCESS(trace.back() == values.back());
+}
+
+
+static void test_compact_trace()
+{
+    std::cout << "Starting: test_compact_trace()\n";
+
+    compact_trace  trace;
+    check_trace(trace,{});
+    TEST_SUCCESS(trace.begin() == trace.end());
+
+    std::vector<uint64_t> const  history = create_history(10ULL * compact_trace::chunk_size + 17ULL);
+    std::vector<uint64_t>  prefix;
+    for (uint64_t const  node : history)
+    {
+        trace.push_back(node);
+        prefix.push_back(node);
+        if (prefix.size() % 61ULL == 0ULL || prefix.size() % compact_trace::chunk_size <= 1ULL)
+            check_trace(trace,prefix);
+    }
+    check_trace(trace,history);
+
+    compact_trace  copy = trace;
+    TEST_SUCCESS(copy == trace);
+    copy.push_back(0ULL);
+    TEST_SUCCESS(copy != trace);
+    check_trace(trace,history);
+
+    TEST_SUCCESS((compact_trace{ 1ULL, 0ULL, ~0ULL, 0ULL }) == (compact_trace{ 1ULL, 0ULL, ~0ULL, 0ULL }));
+    TEST_SUCCESS((compact_trace{ 1ULL, 0ULL }) != (compact_trace{ 1ULL, 2ULL }));
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_spilling()
+{
+    std::cout << "Starting: test_spilling()\n";
+
+    uint64_t const  budget = trace_memory_budget();
+    uint64_t const  spilled = num_bytes_of_traces_spilled();
+    set_trace_memory_budget(num_bytes_of_traces_in_memory());
+
+    std::vector<uint64_t> const  history = create_history(1000ULL * compact_trace::chunk_size);
+    compact_trace  trace;
+    for (uint64_t const  node : history)
+        trace.push_back(node);
+    TEST_SUCCESS(num_bytes_of_traces_spilled() > spilled);
+    check_trace(trace,history);
+
+    set_trace_memory_budget(budget);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_recovery_properties()
+{
+    std::cout << "Starting: test_recovery_properties()\n";
+
+    recovery_properties  rprops(0x10000ULL,0x20000ULL,0x100000ULL,{ { 0x400000ULL, 0x401000ULL } },1000000ULL);
+    std::vector<uint64_t> const  history = create_history(3ULL * compact_trace::chunk_size);
+    rprops.on_new_thread(0ULL,1ULL);
+    for (uint64_t const  node : history)
+    {
+        rprops.insert_node_to_history(0ULL,1ULL,node);
+        rprops.on_thread_step(0ULL,1ULL);
+    }
+    TEST_SUCCESS(rprops.node_couter(0ULL,1ULL) == history.size() - 1ULL);
+    check_trace(rprops.node_histories().at(0ULL).at(1ULL),history);
+    check_trace(rprops.interleaving_of_threads(0ULL),std::vector<uint64_t>(history.size(),1ULL));
+
+    execution_records const  records = rprops.records_of_execution(0ULL);
+    TEST_SUCCESS(records.node_histories.at(1ULL) == rprops.node_histories().at(0ULL).at(1ULL));
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_trace_performance()
+{
+    std::cout << "Starting: test_trace_performance()\n";
+
+    uint64_t const  num_steps = 20000000ULL;
+    std::vector<uint64_t> const  history = create_history(num_steps);
+
+    uint64_t const  old_bytes = num_bytes_of_traces_in_memory() + num_bytes_of_traces_spilled();
+    std::vector<uint64_t>  vector;
+    compact_trace  trace;
+    double const  vector_push_time = measure_milliseconds([&history,&vector]() {
+        for (uint64_t const  node : history)
+            vector.push_back(node);
+    });
+    double const  trace_push_time = measure_milliseconds([&history,&trace]() {
+        for (uint64_t const  node : history)
+            trace.push_back(node);
+    });
+    uint64_t const  trace_bytes = num_bytes_of_traces_in_memory() + num_bytes_of_traces_spilled() - old_bytes;
+
+    uint64_t  vector_sum = 0ULL, trace_sum = 0ULL;
+    double const  vector_scan_time = measure_milliseconds([&vector,&vector_sum]() {
+        for (uint64_t const  node : vector)
+            vector_sum += node;
+    });
+    double const  trace_scan_time = measure_milliseconds([&trace,&trace_sum]() {
+        for (uint64_t const  node : trace)
+            trace_sum += node;
+    });
+    TEST_SUCCESS(vector_sum == trace_sum);
+
+    uint64_t const  num_lookups = 1000000ULL;
+    double const  vector_lookup_time = measure_milliseconds([&vector,&vector_sum,num_lookups]() {
+        for (uint64_t  i = 0ULL; i < num_lookups; ++i)
+            vector_sum += vector.at((i * 7919ULL * 7919ULL) % vector.size());
+    });
+    double const  trace_lookup_time = measure_milliseconds([&trace,&trace_sum,num_lookups]() {
+        for (uint64_t  i = 0ULL; i < num_lookups; ++i)
+            trace_sum += trace.at((i * 7919ULL * 7919ULL) % trace.size());
+    });
+    TEST_SUCCESS(vector_sum == trace_sum);
+
+    std::cout << "  steps: " << num_steps << "\n"
+              << "  size [bytes]: vector " << vector.size() * sizeof(uint64_t) << ", trace " << trace_bytes << "\n"
+              << "  push time [ms]: vector " << vector_push_time << ", trace " << trace_push_time << "\n"
+              << "  scan time [ms]: vector " << vector_scan_time << ", trace " << trace_scan_time << "\n"
+              << "  " << num_lookups << " lookups time [ms]: vector " << vector_lookup_time << ", trace " << trace_lookup_time << "\n"
+              ;
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("trace_store_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_compact_trace();
+        test_spilling();
+        test_recovery_properties();
+        test_trace_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
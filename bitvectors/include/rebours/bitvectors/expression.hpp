@@ -26,6 +26,8 @@ std::size_t  expression_impl_hash(expression_impl const&  e);
 
 /**
  * We consider an expression as a thin wrapper over a shared pointer to its implementation 'expression_impl'.
+ * Expressions are hash-consed, i.e. structurally identical expressions share the same implementation. The hash
+ * of an expression is computed only once, when its implementation is created.
  */
 struct expression
 {
@@ -44,11 +46,12 @@ private:
 
 
 /**
- * It checks whether two expressions are structuraly identical, i.e. they have exactly the same AST.
+ * It checks whether two expressions are structuraly identical, i.e. they have exactly the same AST. Thanks to
+ * the hash-consing it is a comparison of pointers to implementations.
  */
 inline bool  operator ==(expression const  e0, expression const  e1)
 {
-    return e0.operator ->() == e1.operator ->() || expression_impl_equal(*e0.operator ->(),*e1.operator ->());
+    return e0.operator ->() == e1.operator ->();
 }
 inline bool  operator !=(expression const  e0, expression const  e1) { return !(e0 == e1); }
 
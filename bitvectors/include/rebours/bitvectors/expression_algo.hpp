@@ -4,7 +4,9 @@
 #   include <rebours/bitvectors/expression.hpp>
 #   include <functional>
 #   include <unordered_set>
+#   include <unordered_map>
 #   include <vector>
+#   include <cstdint>
 
 namespace bv {
 
@@ -18,6 +20,24 @@ bool  find_unintepreted_symbols(expression const  e, std::unordered_set<symbol,s
 expression  to_conjunction(std::vector<expression> const&  conjuncts);
 
 
+/**
+ * It partitions the conjuncts into slices, so that conjuncts of different slices have no uninterpreted symbol in common
+ * (the conjunction is satisfiable iff each slice is). Conjuncts without uninterpreted symbols form slices of their own.
+ * Slices are ordered by their first conjuncts and each slice keeps the order of the conjuncts in the input.
+ */
+void  split_to_independent_conjuncts(std::vector<expression> const&  conjuncts,
+                                     std::vector< std::vector<expression> >&  slices);
+
+
+/**
+ * It computes the value of the passed expression for the passed values of uninterpreted symbols without parameters.
+ * Only constants, integer operations and comparisons on at most 64 bits, integer casts, concatenation, and logical
+ * connectives are supported. For other expressions, for a missing value of a symbol, and for a division by zero the
+ * function returns false. The value of a formula is 0 or 1.
+ */
+bool  evaluate(expression const  e, std::unordered_map<symbol,uint64_t,symbol::hash> const&  values, uint64_t&  result);
+
+
 }
 
 #endif
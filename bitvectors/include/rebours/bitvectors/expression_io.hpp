@@ -38,6 +38,15 @@ std::unordered_map<std::string,std::string> const&  operators_outside_QF_UFBV();
 std::unordered_map<std::string,std::string> const&  operators_to_QF_UFBV_names();
 
 
+/**
+ * Pieces of 'save_in_smtlib2_format' for sending commands to a solver one by one. The first function produces the
+ * 'declare-fun' commands of all uninterpreted symbols and of all operators outside QF_UFBV in the expression. The second
+ * one writes the passed formula (without 'assert'). All is written on single lines.
+ */
+void  save_declarations_in_smtlib2_format(expression const  e, std::vector<std::string>&  output);
+void  save_formula_in_smtlib2_format(std::ostream&  ostr, expression const  e);
+
+
 struct QF_UFBV_operator_props
 {
     QF_UFBV_operator_props(std::string const&  name,
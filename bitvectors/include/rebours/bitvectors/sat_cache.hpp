@@ -0,0 +1,144 @@
+#ifndef REBOURS_BITVECTORS_SAT_CACHE_HPP_INCLUDED
+#   define REBOURS_BITVECTORS_SAT_CACHE_HPP_INCLUDED
+
+#   include <rebours/bitvectors/sat_checking.hpp>
+#   include <rebours/bitvectors/expression.hpp>
+#   include <functional>
+#   include <unordered_map>
+#   include <vector>
+#   include <string>
+#   include <memory>
+#   include <utility>
+#   include <iosfwd>
+#   include <cstdint>
+
+namespace bv {
+
+
+/**
+ * It remembers results (and models) of satisfiability queries. A query is a set of conjuncts, i.e. the top level
+ * conjuncts of a formula. Since expressions are hash-consed, conjuncts are compared by identity and the order of
+ * conjuncts in the formula does not matter. Besides exact hits, the cache answers a query without a solver, when:
+ *      - the query contains all conjuncts of a cached unsatisfiable query; then it is unsatisfiable,
+ *      - all conjuncts of the query are in a cached satisfiable query; then the cached model is a model of the query,
+ *      - a cached model of a query sharing a conjunct with the query satisfies the query (see the function 'evaluate');
+ *        symbols missing in the model are assumed zero.
+ *
+ * When a path name of a file is passed to the constructor, the cache loads its content from the file (if it exists)
+ * and 'save' writes the content back. Only models consisting of values of symbols without parameters are stored in the
+ * file; other satisfiable queries are stored without models. A file with a damaged record is ignored as a whole and
+ * the reason is written to 'std::cerr'.
+ *
+ * The cache is not thread-safe.
+ */
+struct  sat_query_cache
+{
+    using  solver_function = std::function<std::pair<sat_result,sat_model>(expression const)>;
+
+    static uint64_t constexpr  max_num_models_to_evaluate = 32ULL;  //!< Per query.
+
+    explicit sat_query_cache(std::string const&  persistent_file_pathname = "");
+    ~sat_query_cache();
+
+    sat_query_cache(sat_query_cache const&) = delete;
+    sat_query_cache&  operator=(sat_query_cache const&) = delete;
+
+    /**
+     * They answer the query from the cache, or they call the solver and they insert its answer into the cache. Failed
+     * queries are not inserted. The first two functions use the portfolio of engines.
+     */
+    sat_result  is_satisfiable(expression const  e, uint32_t const  timeout_milliseconds);
+    std::pair<sat_result,sat_model>  get_model_if_satisfiable(expression const  e, uint32_t const  timeout_milliseconds);
+    sat_result  is_satisfiable(expression const  e, std::function<sat_result(expression const)> const&  solver);
+    std::pair<sat_result,sat_model>  get_model_if_satisfiable(expression const  e, solver_function const&  solver);
+
+    /**
+     * They split the conjuncts of the query into independent slices (see 'split_to_independent_conjuncts'), they answer
+     * each slice as the functions above, and they put the models of the slices together. So, when a conjunct is added to
+     * an already answered query, only the slice of the conjunct is passed to the solver. When 'in_parallel' is true,
+     * slices missing in the cache are solved in separate threads (the solver must be thread-safe then); otherwise the
+     * solver is not called for the remaining slices after an unsatisfiable one.
+     */
+    sat_result  is_satisfiable_by_slices(expression const  e, uint32_t const  timeout_milliseconds,
+                                         bool const  in_parallel = false);
+    std::pair<sat_result,sat_model>  get_model_if_satisfiable_by_slices(expression const  e, uint32_t const  timeout_milliseconds,
+                                                                        bool const  in_parallel = false);
+    sat_result  is_satisfiable_by_slices(expression const  e, std::function<sat_result(expression const)> const&  solver,
+                                         bool const  in_parallel = false);
+    std::pair<sat_result,sat_model>  get_model_if_satisfiable_by_slices(expression const  e, solver_function const&  solver,
+                                                                        bool const  in_parallel = false);
+
+    /**
+     * It returns true, if the cache knows the answer to the query. A satisfiable answer is accepted only with a model,
+     * when 'need_model' is true. The model is stored into 'model', if it is not nullptr.
+     */
+    bool  find(std::vector<expression> const&  conjuncts, bool const  need_model, sat_result&  result, sat_model* const  model);
+
+    /**
+     * The model is ignored for an unsatisfiable query; nullptr means that the model of a satisfiable query is unknown.
+     */
+    void  insert(std::vector<expression> const&  conjuncts, sat_result const  result, sat_model const* const  model);
+
+    bool  save() const;
+
+    /**
+     * Each query passed to the querying functions above is appended to the log (see 'load_query_log').
+     */
+    void  record_queries(std::string const&  log_pathname);
+
+    uint64_t  num_entries() const noexcept { return m_entries.size(); }
+    uint64_t  num_hits() const noexcept { return m_num_exact_hits + m_num_unsat_subset_hits + m_num_sat_superset_hits + m_num_model_hits; }
+    uint64_t  num_exact_hits() const noexcept { return m_num_exact_hits; }
+    uint64_t  num_unsat_subset_hits() const noexcept { return m_num_unsat_subset_hits; }
+    uint64_t  num_sat_superset_hits() const noexcept { return m_num_sat_superset_hits; }
+    uint64_t  num_model_hits() const noexcept { return m_num_model_hits; }
+    uint64_t  num_misses() const noexcept { return m_num_misses; }
+    uint64_t  num_sliced_queries() const noexcept { return m_num_sliced_queries; }
+    uint64_t  num_slices() const noexcept { return m_num_slices; }
+
+private:
+    struct  entry
+    {
+        std::vector<expression>  conjuncts;     //!< Sorted by addresses of implementations.
+        sat_result  result;
+        bool  has_model;
+        sat_model  model;
+        std::unordered_map<symbol,uint64_t,symbol::hash>  values;  //!< Values of symbols in the model, when they all fit 64 bits.
+    };
+
+    struct  conjuncts_hash { std::size_t  operator()(std::vector<expression> const&  conjuncts) const; };
+
+    using  index = std::unordered_map<expression,std::vector<uint64_t>,expression::hash>;  //!< Conjuncts to entries.
+
+    void  log_query(expression const  e);
+    std::pair<sat_result,sat_model>  solve_by_slices(expression const  e, solver_function const&  solver, bool const  need_model,
+                                                     bool const  in_parallel);
+
+    std::string  m_persistent_file_pathname;
+    std::unique_ptr<std::ostream>  m_query_log;
+    std::vector<entry>  m_entries;
+    std::unordered_map<std::vector<expression>,uint64_t,conjuncts_hash>  m_exact;
+    index  m_unsat_index;
+    index  m_sat_index;
+    uint64_t  m_num_exact_hits;
+    uint64_t  m_num_unsat_subset_hits;
+    uint64_t  m_num_sat_superset_hits;
+    uint64_t  m_num_model_hits;
+    uint64_t  m_num_misses;
+    uint64_t  m_num_sliced_queries;
+    uint64_t  m_num_slices;
+};
+
+
+/**
+ * Top level conjuncts of the formula, without 'tt' and duplicates, sorted by addresses of implementations.
+ */
+std::vector<expression>  to_sorted_conjuncts(expression const  e);
+
+
+bool  load_query_log(std::string const&  log_pathname, std::vector<expression>&  queries);
+
+
+}
+
+#endif
@@ -6,6 +6,9 @@
 #   include <string>
 #   include <memory>
 #   include <unordered_map>
+#   include <unordered_set>
+#   include <vector>
+#   include <functional>
 #   include <utility>
 #   include <cstdint>
 
@@ -26,6 +29,11 @@ enum struct sat_engine : uint8_t {
 };
 
 
+/**
+ * The engines are launched in parallel and the first answer is returned. The remaining engines are interrupted then,
+ * but the function does not wait for them. When engines are not specified, only those likely to win for the shape of
+ * the formula are launched (see 'select_sat_engines').
+ */
 sat_result  is_satisfiable(expression const  e, uint32_t const  timeout_milliseconds, sat_engine* const  fastest_respondent_ptr = nullptr);
 sat_result  is_satisfiable(expression const  e, uint32_t const  timeout_milliseconds, std::set<sat_engine> const&  engines,
                            sat_engine* const  fastest_respondent_ptr = nullptr);
@@ -65,6 +73,129 @@ std::pair<sat_result,sat_model>  get_model_if_satisfiable(expression const  e, u
                                                           sat_engine* const  fastest_respondent_ptr = nullptr);
 
 
+std::set<sat_engine> const&  all_sat_engines();
+
+
+/**
+ * Formulae are classified by their shape, i.e. by presence of non-linear operations, of operations outside QF_UFBV
+ * (e.g. floating point ones), of uninterpreted functions with parameters, and of many uninterpreted symbols. For each
+ * shape the portfolio records how many times an engine was launched and how many times it was the fastest.
+ */
+uint8_t constexpr  formula_shape_nonlinear = 0x01U;
+uint8_t constexpr  formula_shape_outside_QF_UFBV = 0x02U;
+uint8_t constexpr  formula_shape_functions = 0x04U;
+uint8_t constexpr  formula_shape_many_symbols = 0x08U;
+
+uint8_t  formula_shape(expression const  e);
+
+struct sat_engine_statistics
+{
+    uint64_t  num_launches;
+    uint64_t  num_wins;
+};
+
+sat_engine_statistics  get_sat_engine_statistics(sat_engine const  engine, uint8_t const  shape);
+void  clear_sat_engine_statistics();
+
+/**
+ * It returns those of the passed engines, which won at least a quarter of wins of the best engine for the shape of the
+ * passed formula. All passed engines are returned till each of them was launched few times for the shape, and also
+ * periodically, so that the statistics can follow changes of the winner.
+ */
+std::set<sat_engine>  select_sat_engines(expression const  e, std::set<sat_engine> const&  engines);
+
+
+/**
+ * A long-lived process of a solver, which receives incremental SMT-LIB2 commands through a pipe connected to its standard
+ * input and answers through another pipe connected to its standard output. So, there is neither a temporary file nor
+ * a new process per query.
+ *
+ * Uninterpreted symbols (and operators outside QF_UFBV) are declared only once, when they first appear in an asserted
+ * or assumed formula. An assumed formula is represented in the solver by a Boolean literal implying the formula, and
+ * the literal is also introduced only once. So, related queries sharing conjuncts send only the literals of those
+ * conjuncts to the 'check-sat-assuming' command. Declarations, literals, and assertions introduced after a 'push' are
+ * forgotten on the corresponding 'pop'.
+ *
+ * When a query is interrupted (e.g. because of a timeout), the solver process is killed. Then a new process is started
+ * at the beginning of the next query and all commands, which are still in effect, are sent to it again. The result of
+ * an interrupted query is 'sat_result::FAIL'.
+ *
+ * An instance must not be used from several threads at the same time. It is available only on Linux and Mac; elsewhere
+ * each query fails.
+ */
+struct  solver_session
+{
+    explicit solver_session(sat_engine const  engine);
+    explicit solver_session(std::string const&  shell_command); //!< The command must start a solver reading SMT-LIB2 from the standard input.
+    ~solver_session();
+
+    solver_session(solver_session const&) = delete;
+    solver_session&  operator=(solver_session const&) = delete;
+
+    std::string const&  shell_command() const noexcept { return m_shell_command; }
+
+    void  push();
+    void  pop();
+    uint64_t  num_scopes() const noexcept { return m_scopes.size(); }
+
+    void  assert_formula(expression const  e);
+
+    sat_result  check_sat_assuming(std::vector<expression> const&  assumptions, uint32_t const  timeout_milliseconds);
+    sat_result  check_sat_assuming(std::vector<expression> const&  assumptions, std::function<bool()> const&  interrupt);
+
+    /**
+     * The model contains values of all uninterpreted symbols without parameters appearing in the passed assumptions.
+     */
+    std::pair<sat_result,sat_model>  get_model_if_satisfiable(std::vector<expression> const&  assumptions,
+                                                              uint32_t const  timeout_milliseconds);
+
+    /**
+     * Top level conjuncts of the passed formula are assumed separately. So, the same conjuncts of different formulae are
+     * not sent to the solver again.
+     */
+    sat_result  is_satisfiable(expression const  e, uint32_t const  timeout_milliseconds);
+    std::pair<sat_result,sat_model>  get_model_if_satisfiable(expression const  e, uint32_t const  timeout_milliseconds);
+
+    uint64_t  num_started_processes() const noexcept { return m_num_started_processes; }
+    uint64_t  num_declarations() const noexcept { return m_num_declarations; }
+    uint64_t  num_literals() const noexcept { return m_num_literals; }
+    uint64_t  num_queries() const noexcept { return m_num_queries; }
+
+private:
+    struct  scope
+    {
+        uint64_t  script_size;      //!< The size of 'm_script' at the time of 'push'.
+        std::vector<std::string>  declarations;
+        std::vector<expression>  literals;
+    };
+
+    bool  start();
+    void  stop();
+    bool  send(std::vector<std::string> const&  commands, std::function<bool()> const&  interrupt);
+    bool  receive(std::string&  response, std::function<bool()> const&  interrupt);
+    void  enqueue(std::string const&  command);
+    void  declare(expression const  e);
+    std::string const&  literal(expression const  e);
+    sat_result  check(std::vector<expression> const&  assumptions, std::string const&  extra_command,
+                      std::function<bool()> const&  interrupt, std::string&  extra_response);
+
+    std::string  m_shell_command;
+    int64_t  m_process_id;
+    int  m_input_fd;    //!< The standard input of the solver.
+    int  m_output_fd;   //!< The standard output of the solver.
+    std::string  m_buffer;  //!< Received characters which are not part of a response yet.
+    std::vector<std::string>  m_script;  //!< All commands in effect; they are sent again to a restarted solver.
+    std::vector<std::string>  m_pending; //!< Commands of the script which were not sent to the solver yet.
+    std::unordered_set<std::string>  m_declarations;
+    std::unordered_map<expression,std::string,expression::hash>  m_literals;
+    std::vector<scope>  m_scopes;
+    uint64_t  m_num_started_processes;
+    uint64_t  m_num_declarations;
+    uint64_t  m_num_literals;
+    uint64_t  m_num_queries;
+};
+
+
 std::string  to_string(sat_result const  value);
 std::string  to_string(sat_engine const  value);
 
@@ -1,10 +1,22 @@
 #ifndef TEST_HPP_INCLUDED
-#   define TETS_HPP_INCLUDED
+#   define TEST_HPP_INCLUDED
 
+#   include <chrono>
 #   include <cassert>
 #   include <stdexcept>
 
 #   define TEST_SUCCESS(C) do { if (!(C)) { assert(C); throw std::logic_error("TEST_SUCCESS has failed."); } } while (false)
 #   define TEST_FAILURE(C) do { if (C) { assert(!(C)); throw std::logic_error("TEST_FAILURE has failed."); } } while (false)
 
+/**
+ * Returns the wall-clock time in milliseconds spent by calling 'func'.
+ */
+template<typename function_type>
+inline double  measure_milliseconds(function_type const&  func)
+{
+    std::chrono::high_resolution_clock::time_point const  start = std::chrono::high_resolution_clock::now();
+    func();
+    return std::chrono::duration<double,std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
 #endif
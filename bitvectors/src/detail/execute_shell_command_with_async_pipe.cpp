@@ -7,6 +7,7 @@
 #       include <cstdio>
 #       include <signal.h>
 #       include <fcntl.h>
+#       include <poll.h>
 #       include <cstdlib>
 #       include <cctype>
 #       include <unistd.h>
@@ -177,7 +178,9 @@ bool  execute_shell_command_with_async_pipe(std::string const& shell_command, st
 {
     std::stringstream  process_id_ostr;
     ::pid_t  process_id = -1;
-    std::FILE* const  pipe = ::popen((std::string("echo PID $$ && ") + shell_command).c_str(), "r");
+    // The shell replaces itself by the command, so the printed process id is the one of the command. Otherwise, a kill
+    // of an interrupted command would terminate only the shell and the command would keep running.
+    std::FILE* const  pipe = ::popen((std::string("echo PID $$ && exec ") + shell_command).c_str(), "r");
     if (pipe == nullptr)
         return false;
     int const  fno = ::fileno(pipe);
@@ -185,11 +188,13 @@ bool  execute_shell_command_with_async_pipe(std::string const& shell_command, st
     ::fcntl(fno,F_SETFL,flags | O_NONBLOCK);
     while (true)
     {
-        static char  buff[512];
+        char  buff[512];
         ssize_t num_read = read(fno,buff,sizeof(buff));
         if (num_read == -1 && errno == EAGAIN)
         {
-            // no data yet => do nothing
+            // no data yet => wait for them a while, but not longer than a millisecond to react quickly to an interrupt.
+            ::pollfd  fds = { fno, POLLIN, 0 };
+            ::poll(&fds,1,1);
         }
         else if (num_read > 0)
         {
@@ -213,13 +218,11 @@ bool  execute_shell_command_with_async_pipe(std::string const& shell_command, st
             return true;
         }
 
-        if (interrupt())
+        // We cannot kill the command before we know its id, which comes first.
+        if (process_id > 0 && interrupt())
         {
-            if (process_id > 0)
-            {
-                ::kill(process_id,SIGKILL);
-                ::pclose(pipe);
-            }
+            ::kill(process_id,SIGKILL);
+            ::pclose(pipe);
             return false;
         }
     }
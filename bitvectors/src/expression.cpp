@@ -1,42 +1,143 @@
 #include <rebours/bitvectors/expression.hpp>
+#include <unordered_map>
+#include <mutex>
+#include <new>
 
 namespace bv {
 
 
+/**
+ * Expressions are hash-consed: there is at most one instance of 'expression_impl' for each pair of a symbol and
+ * a sequence of (instances of) arguments. So, structurally identical expressions share the instance, their equality
+ * is the identity of pointers, and the hash of an instance is computed only once (from cached hashes of arguments)
+ * when the instance is created.
+ *
+ * Instances are held in a unique table (like symbols). Unlike symbols, an instance is released when the last
+ * expression referencing it is destroyed. The table thus holds only weak pointers to instances; the instance
+ * removes itself from the table in its deleter. Arguments of an instance are stored right behind the instance in
+ * the same block of memory, so an instance costs a single allocation (besides the control block of the shared
+ * pointer).
+ */
 struct expression_impl
 {
     static expression  create(symbol const  s, std::vector<expression> const&  arguments);
 
     symbol  get_symbol() const noexcept { return m_symbol; }
-    uint64_t  num_arguments() const noexcept { return m_arguments.size(); }
-    expression  argument(uint64_t const  index) const { return m_arguments.at(index); }
+    uint64_t  num_arguments() const noexcept { return m_num_arguments; }
+    expression  argument(uint64_t const  index) const { ASSUMPTION(index < m_num_arguments); return arguments_begin()[index]; }
+    std::size_t  hash() const noexcept { return m_hash; }
 
 private:
-    expression_impl(symbol const  s, std::vector<expression> const&  arguments);
+    struct unique_table_entry
+    {
+        expression_impl const*  instance;
+        std::weak_ptr<expression_impl>  reference;
+    };
+
+    using unique_table = std::unordered_multimap<std::size_t,unique_table_entry>;  //!< Keys are hashes of instances.
+
+    static unique_table&  table();
+    static std::mutex&  table_mutex();
+
+    expression_impl(symbol const  s, uint64_t const  num_arguments, std::size_t const  hash);
+
+    static void  destroy(expression_impl* const  e);   //!< The deleter of shared pointers to instances.
+
+    expression const*  arguments_begin() const noexcept { return reinterpret_cast<expression const*>(this + 1); }
+    expression*  arguments_begin() noexcept { return reinterpret_cast<expression*>(this + 1); }
 
     symbol  m_symbol;
-    std::vector<expression>  m_arguments;
+    uint64_t  m_num_arguments;
+    std::size_t  m_hash;
 };
 
+static_assert(sizeof(expression_impl) % alignof(expression) == 0ULL,"Arguments stored behind an instance must be aligned.");
 
-expression  expression_impl::create(symbol const  s, std::vector<expression> const&  arguments)
+
+/**
+ * Both the table and the mutex are never destroyed, because expressions stored in static variables (e.g. 'tt()')
+ * may be destroyed after any static object of this file.
+ */
+expression_impl::unique_table&  expression_impl::table()
 {
-    return expression{ std::shared_ptr<expression_impl>{new expression_impl(s,arguments) }};
+    static unique_table* const  instances = new unique_table;
+    return *instances;
 }
 
-expression_impl::expression_impl(symbol const  s, std::vector<expression> const&  arguments)
-    : m_symbol(s)
-    , m_arguments(arguments)
+std::mutex&  expression_impl::table_mutex()
+{
+    static std::mutex* const  mutex = new std::mutex;
+    return *mutex;
+}
+
+expression  expression_impl::create(symbol const  s, std::vector<expression> const&  arguments)
 {
-    ASSUMPTION(symbol_num_parameters(m_symbol) == m_arguments.size());
+    ASSUMPTION(symbol_num_parameters(s) == arguments.size());
     ASSUMPTION(
             [](symbol const  s, std::vector<expression> const&  arguments) {
                 for (uint64_t i = 0ULL; i < arguments.size(); ++i)
                     if (symbol_num_bits_of_parameter(s,i) != num_bits_of_return_value(arguments.at(i)))
                         return false;
                 return true;
-            }(m_symbol,m_arguments)
+            }(s,arguments)
             );
+
+    std::size_t  hash = symbol::hash()(s);
+    for (uint64_t i = 0ULL; i < arguments.size(); ++i)
+        hash += (i + 1ULL) * 12101ULL * arguments.at(i)->hash();
+
+    std::lock_guard<std::mutex> const  lock(table_mutex());
+
+    auto const  range = table().equal_range(hash);
+    for (auto  it = range.first; it != range.second; ++it)
+    {
+        // The instance is not freed yet, even if it is expired, because its deleter waits for the lock.
+        expression_impl const&  e = *it->second.instance;
+        if (e.m_symbol != s)
+            continue;
+        uint64_t  i = 0ULL;
+        for ( ; i < arguments.size(); ++i)
+            if (e.arguments_begin()[i].operator ->() != arguments.at(i).operator ->())
+                break;
+        if (i != arguments.size())
+            continue;
+        std::shared_ptr<expression_impl> const  existing = it->second.reference.lock();
+        if (existing.operator bool())
+            return expression{ existing };
+    }
+
+    void* const  memory = ::operator new(sizeof(expression_impl) + arguments.size() * sizeof(expression));
+    expression_impl* const  e = new(memory) expression_impl(s,arguments.size(),hash);
+    for (uint64_t i = 0ULL; i < arguments.size(); ++i)
+        new(e->arguments_begin() + i) expression(arguments.at(i));
+    std::shared_ptr<expression_impl> const  result{ e, &expression_impl::destroy };
+    table().insert({ hash, { e, result } });
+    return expression{ result };
+}
+
+expression_impl::expression_impl(symbol const  s, uint64_t const  num_arguments, std::size_t const  hash)
+    : m_symbol(s)
+    , m_num_arguments(num_arguments)
+    , m_hash(hash)
+{}
+
+void  expression_impl::destroy(expression_impl* const  e)
+{
+    {
+        std::lock_guard<std::mutex> const  lock(table_mutex());
+        auto const  range = table().equal_range(e->m_hash);
+        for (auto  it = range.first; it != range.second; ++it)
+            if (it->second.instance == e)
+            {
+                table().erase(it);
+                break;
+            }
+    }
+    // Arguments are released outside the lock, since their deleters need it.
+    for (uint64_t i = 0ULL; i < e->m_num_arguments; ++i)
+        e->arguments_begin()[i].~expression();
+    e->~expression_impl();
+    ::operator delete(e);
 }
 
 
@@ -47,20 +148,12 @@ expression::expression(symbol const  s, std::vector<expression> const&  args)
 
 bool  expression_impl_equal(expression_impl const&  e0, expression_impl const&  e1)
 {
-    if (e0.get_symbol() != e1.get_symbol())
-        return false;
-    for (uint64_t i = 0ULL; i < e0.num_arguments(); ++i)
-        if (e0.argument(i) != e1.argument(i))
-            return false;
-    return true;
+    return &e0 == &e1;
 }
 
 std::size_t  expression_impl_hash(expression_impl const&  e)
 {
-    std::size_t  result = symbol::hash()(e.get_symbol());
-    for (uint64_t i = 0ULL; i < e.num_arguments(); ++i)
-        result += (i + 1ULL) * 12101ULL * expression::hash()(e.argument(i));
-    return result;
+    return e.hash();
 }
 
 
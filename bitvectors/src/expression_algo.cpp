@@ -1,4 +1,150 @@
 #include <rebours/bitvectors/expression_algo.hpp>
+#include <algorithm>
+#include <string>
+#include <cctype>
+
+namespace bv { namespace {
+
+
+uint64_t  mask(uint64_t const  num_bits)
+{
+    return num_bits >= 64ULL ? ~0ULL : (1ULL << num_bits) - 1ULL;
+}
+
+int64_t  to_signed(uint64_t const  value, uint64_t const  num_bits)
+{
+    return num_bits >= 64ULL || (value & (1ULL << (num_bits - 1ULL))) == 0ULL ? (int64_t)value :
+                                                                              (int64_t)(value | ~mask(num_bits));
+}
+
+/**
+ * The name of an operation without the number of bits at its end, e.g. '+i' for '+i32'.
+ */
+std::string  operation_kind(symbol const  s)
+{
+    std::string  name = symbol_name(s);
+    while (!name.empty() && std::isdigit(name.back()))
+        name.pop_back();
+    return name;
+}
+
+bool  evaluate_operation(symbol const  s, std::vector<uint64_t> const&  args, uint64_t&  result)
+{
+    uint64_t const  num_bits = symbol_num_parameters(s) == 0ULL ? 0ULL : symbol_num_bits_of_parameter(s,0ULL);
+    std::string const  kind = operation_kind(s);
+    if (args.size() == 1ULL)
+    {
+        if (kind == "!")
+            result = args.at(0ULL) == 0ULL ? 1ULL : 0ULL;
+        else if (kind.size() > 1ULL && kind.front() == '#' && kind.find('f') == std::string::npos)
+        {
+            uint64_t const  num_dst_bits = symbol_num_bits_of_return_value(s);
+            if (kind.at(1ULL) == 's')
+                result = (uint64_t)to_signed(args.at(0ULL),num_bits) & mask(num_dst_bits);
+            else if (kind.at(1ULL) == 'u' || kind.at(1ULL) == 'i')
+                result = args.at(0ULL) & mask(num_dst_bits);
+            else
+                return false;
+        }
+        else
+            return false;
+        return true;
+    }
+    if (args.size() != 2ULL)
+        return false;
+
+    uint64_t const  a = args.at(0ULL), b = args.at(1ULL);
+    if (kind == "&&")
+        result = a != 0ULL && b != 0ULL ? 1ULL : 0ULL;
+    else if (kind == "+++")
+    {
+        if (symbol_num_bits_of_return_value(s) > 64ULL)
+            return false;
+        result = (a << symbol_num_bits_of_parameter(s,1ULL)) | b;
+    }
+    else if (kind == "+i") result = (a + b) & mask(num_bits);
+    else if (kind == "-i") result = (a - b) & mask(num_bits);
+    else if (kind == "*i") result = (a * b) & mask(num_bits);
+    else if (kind == "&i") result = a & b;
+    else if (kind == "|i") result = a | b;
+    else if (kind == "^i") result = a ^ b;
+    else if (kind == "<<i") result = b >= num_bits ? 0ULL : (a << b) & mask(num_bits);
+    else if (kind == ">>u") result = b >= num_bits ? 0ULL : a >> b;
+    else if (kind == ">>s") result = (uint64_t)(to_signed(a,num_bits) >> (b >= num_bits ? num_bits - 1ULL : b)) & mask(num_bits);
+    else if (kind == "<u") result = a < b ? 1ULL : 0ULL;
+    else if (kind == "<s") result = to_signed(a,num_bits) < to_signed(b,num_bits) ? 1ULL : 0ULL;
+    else if (kind == "=i") result = a == b ? 1ULL : 0ULL;
+    else if (b == 0ULL)
+        return false;
+    else if (kind == "/u") result = a / b;
+    else if (kind == "%u") result = a % b;
+    else if ((kind == "/s" || kind == "%s") && !(to_signed(a,num_bits) == to_signed(1ULL << (num_bits - 1ULL),num_bits) &&
+                                                 to_signed(b,num_bits) == -1LL))
+        result = (uint64_t)(kind == "/s" ? to_signed(a,num_bits) / to_signed(b,num_bits) :
+                                           to_signed(a,num_bits) % to_signed(b,num_bits)) & mask(num_bits);
+    else
+        return false;
+    return true;
+}
+
+bool  evaluate(expression const  e, std::unordered_map<symbol,uint64_t,symbol::hash> const&  values,
+               std::unordered_map<expression,uint64_t,expression::hash>&  visited, uint64_t&  result)
+{
+    auto const  vit = visited.find(e);
+    if (vit != visited.cend())
+    {
+        result = vit->second;
+        return true;
+    }
+
+    symbol const  s = get_symbol(e);
+    if (symbol_num_bits_of_return_value(s) > 64ULL)
+        return false;
+    if (!symbol_is_interpreted(s))
+    {
+        if (symbol_num_parameters(s) != 0ULL)
+            return false;
+        auto const  it = values.find(s);
+        if (it == values.cend())
+            return false;
+        result = it->second & mask(symbol_num_bits_of_return_value(s));
+    }
+    else if (symbol_is_interpreted_constant(s))
+        result = std::stoull(symbol_name(s).substr(2ULL),nullptr,16);
+    else if (is_tt(e))
+        result = 1ULL;
+    else if (is_ff(e))
+        result = 0ULL;
+    else
+    {
+        std::vector<uint64_t>  args;
+        for (uint64_t  i = 0ULL; i < num_arguments(e); ++i)
+        {
+            if (symbol_num_bits_of_parameter(s,i) > 64ULL)
+                return false;
+            args.push_back(0ULL);
+            if (!evaluate(argument(e,i),values,visited,args.back()))
+                return false;
+        }
+        if (!evaluate_operation(s,args,result))
+            return false;
+    }
+    visited.insert({e,result});
+    return true;
+}
+
+uint64_t  find_root(std::vector<uint64_t>&  parents, uint64_t  i)
+{
+    while (parents.at(i) != i)
+    {
+        parents.at(i) = parents.at(parents.at(i));
+        i = parents.at(i);
+    }
+    return i;
+}
+
+
+}}
 
 namespace bv {
 
@@ -28,5 +174,44 @@ expression  to_conjunction(std::vector<expression> const&  conjuncts)
     return result;
 }
 
+void  split_to_independent_conjuncts(std::vector<expression> const&  conjuncts,
+                                     std::vector< std::vector<expression> >&  slices)
+{
+    std::vector<uint64_t>  parents(conjuncts.size());
+    std::unordered_map<symbol,uint64_t,symbol::hash>  owners;   // The first conjunct containing the symbol.
+    for (uint64_t  i = 0ULL; i < conjuncts.size(); ++i)
+    {
+        parents.at(i) = i;
+        std::unordered_set<symbol,symbol::hash>  symbols;
+        find_unintepreted_symbols(conjuncts.at(i),symbols);
+        for (symbol const  s : symbols)
+        {
+            auto const  it = owners.insert({s,i});
+            if (!it.second)
+            {
+                uint64_t const  root0 = find_root(parents,it.first->second);
+                uint64_t const  root1 = find_root(parents,i);
+                parents.at(std::max(root0,root1)) = std::min(root0,root1);
+            }
+        }
+    }
+
+    std::unordered_map<uint64_t,uint64_t>  slice_of_root;
+    for (uint64_t  i = 0ULL; i < conjuncts.size(); ++i)
+    {
+        auto const  it = slice_of_root.insert({find_root(parents,i),slices.size()});
+        if (it.second)
+            slices.push_back({});
+        slices.at(it.first->second).push_back(conjuncts.at(i));
+    }
+}
+
+
+bool  evaluate(expression const  e, std::unordered_map<symbol,uint64_t,symbol::hash> const&  values, uint64_t&  result)
+{
+    std::unordered_map<expression,uint64_t,expression::hash>  visited;
+    return evaluate(e,values,visited,result);
+}
+
 
 }
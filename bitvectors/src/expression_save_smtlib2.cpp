@@ -162,10 +162,10 @@ std::unordered_map<std::string,std::string> const&  operators_to_QF_UFBV_names()
             { "<s32", "bvslt" },
             { "<s64", "bvslt" },
 
-            { "us8", "bvult" },
-            { "us16", "bvult" },
-            { "us32", "bvult" },
-            { "us64", "bvult" },
+            { "<u8", "bvult" },
+            { "<u16", "bvult" },
+            { "<u32", "bvult" },
+            { "<u64", "bvult" },
 
             { "=i8", "=" },
             { "=i16", "=" },
@@ -262,6 +262,23 @@ void  save_in_smtlib2_format(std::ostream&  ostr, expression const  e, std::stri
     }
 }
 
+void  save_in_smtlib2_format_on_single_line(std::ostream&  ostr, expression const  e)
+{
+    if (num_arguments(e) == 0ULL)
+        save_symbol_in_smtlib2_format(ostr,get_symbol(e));
+    else
+    {
+        ostr << "(";
+        save_symbol_in_smtlib2_format(ostr,get_symbol(e));
+        for (uint64_t  i = 0ULL; i < num_arguments(e); ++i)
+        {
+            ostr << " ";
+            save_in_smtlib2_format_on_single_line(ostr,argument(e,i));
+        }
+        ostr << ")";
+    }
+}
+
 
 }}
 
@@ -300,3 +317,36 @@ void  save_in_smtlib2_format(std::ostream&  ostr, expression const  e)
 
 
 }
+
+namespace bv { namespace detail {
+
+
+void  save_declarations_in_smtlib2_format(expression const  e, std::vector<std::string>&  output)
+{
+    std::unordered_set<symbol,symbol::hash> uninterpreted;
+    find_unintepreted_symbols(e,uninterpreted);
+    for (symbol s : uninterpreted)
+    {
+        std::stringstream  sstr;
+        save_uninterpreted_symbol_decl_in_smtlib2_format(sstr,s);
+        output.push_back(sstr.str().substr(0ULL,sstr.str().size() - 1ULL));
+    }
+
+    std::unordered_set<symbol,symbol::hash>  unsupported;
+    find_symbols(e,&is_unsupported_operator,unsupported);
+    for (symbol s : unsupported)
+    {
+        std::stringstream  sstr;
+        save_unsupported_symbol_decl_in_smtlib2_format(sstr,s);
+        output.push_back(sstr.str().substr(0ULL,sstr.str().size() - 1ULL));
+    }
+}
+
+void  save_formula_in_smtlib2_format(std::ostream&  ostr, expression const  e)
+{
+    ASSUMPTION(is_formula(e));
+    save_in_smtlib2_format_on_single_line(ostr,e);
+}
+
+
+}}
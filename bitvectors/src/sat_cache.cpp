@@ -0,0 +1,546 @@
+#include <rebours/bitvectors/sat_cache.hpp>
+#include <rebours/bitvectors/expression_algo.hpp>
+#include <rebours/bitvectors/expression_io.hpp>
+#include <rebours/bitvectors/assumptions.hpp>
+#include <rebours/bitvectors/invariants.hpp>
+#include <unordered_set>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <cstdio>
+
+namespace bv { namespace {
+
+
+void  collect_conjuncts(expression const  e, std::vector<expression>&  output)
+{
+    if (get_symbol(e) == make_symbol_of_logical_conjunction())
+    {
+        collect_conjuncts(argument(e,0ULL),output);
+        collect_conjuncts(argument(e,1ULL),output);
+    }
+    else if (!is_tt(e))
+        output.push_back(e);
+}
+
+bool  less_by_address(expression const  e0, expression const  e1)
+{
+    return e0.operator ->().get() < e1.operator ->().get();
+}
+
+/**
+ * It returns false, if some value in the model is not a constant of at most 64 bits of a symbol without parameters.
+ */
+bool  model_to_values(sat_model const&  model, std::unordered_map<symbol,uint64_t,symbol::hash>&  values)
+{
+    for (auto const&  symbol_and_values : model)
+    {
+        symbol const  s = symbol_and_values.first;
+        values_of_expression_in_model const&  cases = symbol_and_values.second;
+        if (symbol_num_parameters(s) != 0ULL || symbol_num_bits_of_return_value(s) > 64ULL || cases.num_cases() != 1ULL ||
+            !is_interpreted_constant(cases.value_of_case(0ULL)))
+            return false;
+        uint64_t  value;
+        if (!evaluate(cases.value_of_case(0ULL),{},value))
+            return false;
+        values.insert({s,value});
+    }
+    return true;
+}
+
+/**
+ * It returns false, if a value cannot be represented by a constant (the number of bits of the symbol is not a multiple
+ * of 8).
+ */
+bool  values_to_model(std::unordered_map<symbol,uint64_t,symbol::hash> const&  values, sat_model&  model)
+{
+    for (auto const&  symbol_and_value : values)
+    {
+        uint64_t const  num_bits = symbol_num_bits_of_return_value(symbol_and_value.first);
+        if (num_bits % 8ULL != 0ULL)
+            return false;
+        std::stringstream  sstr;
+        sstr << std::hex;
+        for (uint64_t  i = num_bits / 8ULL; i != 0ULL; --i)
+        {
+            uint64_t const  byte = (symbol_and_value.second >> (8ULL * (i - 1ULL))) & 0xffULL;
+            sstr << (byte < 0x10ULL ? "0" : "") << byte;
+        }
+        expression const  value{make_symbol_of_interpreted_constant(sstr.str()),{}};
+        model.insert({symbol_and_value.first,sat_model_cases_ptr(new values_of_expression_in_model::sat_model_cases({{{},value}}))});
+    }
+    return true;
+}
+
+void  write_record(std::ostream&  ostr, std::string const&  text)
+{
+    ostr << text.size() << "\n" << text << "\n";
+}
+
+bool  read_record(std::istream&  istr, std::string&  text)
+{
+    uint64_t  size;
+    if (!(istr >> size) || istr.get() != '\n')
+        return false;
+    text.resize(size);
+    return size == 0ULL || (istr.read(&text.at(0ULL),size) && istr.get() == '\n');
+}
+
+std::string  to_smtlib2(std::vector<expression> const&  conjuncts)
+{
+    std::stringstream  sstr;
+    sstr << to_conjunction(conjuncts);
+    return sstr.str();
+}
+
+bool  from_smtlib2(std::string const&  text, expression&  e)
+{
+    std::stringstream  sstr(text);
+    std::string  error;
+    e = load_in_smtlib2_format(sstr,error);
+    if (!error.empty())
+    {
+        std::cerr << error;
+        return false;
+    }
+    return true;
+}
+
+
+}}
+
+namespace bv {
+
+
+uint64_t constexpr  sat_query_cache::max_num_models_to_evaluate;
+
+
+std::size_t  sat_query_cache::conjuncts_hash::operator()(std::vector<expression> const&  conjuncts) const
+{
+    std::size_t  result = conjuncts.size();
+    for (auto const&  e : conjuncts)
+        result = result * 31ULL + expression::hash()(e);
+    return result;
+}
+
+
+sat_query_cache::sat_query_cache(std::string const&  persistent_file_pathname)
+    : m_persistent_file_pathname(persistent_file_pathname)
+    , m_query_log()
+    , m_entries()
+    , m_exact()
+    , m_unsat_index()
+    , m_sat_index()
+    , m_num_exact_hits(0ULL)
+    , m_num_unsat_subset_hits(0ULL)
+    , m_num_sat_superset_hits(0ULL)
+    , m_num_model_hits(0ULL)
+    , m_num_misses(0ULL)
+    , m_num_sliced_queries(0ULL)
+    , m_num_slices(0ULL)
+{
+    if (m_persistent_file_pathname.empty())
+        return;
+
+    std::ifstream  istr(m_persistent_file_pathname,std::ifstream::binary);
+    if (!istr.is_open())
+        return;
+
+    // The whole file is rejected, when any of its records is damaged: the records are length-prefixed,
+    // so the rest of the file cannot be trusted after a malformed one.
+    struct  loaded_entry
+    {
+        loaded_entry() : conjuncts(), result(sat_result::FAIL), has_model(false), model() {}
+
+        std::vector<expression>  conjuncts;
+        sat_result  result;
+        bool  has_model;
+        sat_model  model;
+    };
+    std::vector<loaded_entry>  loaded;
+    std::string  error;
+    std::string  result_name;
+    uint32_t  has_model;
+    uint64_t  num_values;
+    while (error.empty() && !(istr >> std::ws).eof())
+    {
+        loaded.push_back(loaded_entry());
+        loaded_entry&  E = loaded.back();
+
+        if (!(istr >> result_name >> has_model >> num_values))
+        {
+            error = "the header is malformed";
+            break;
+        }
+        if (result_name == to_string(sat_result::YES))
+            E.result = sat_result::YES;
+        else if (result_name == to_string(sat_result::NO))
+            E.result = sat_result::NO;
+        else
+        {
+            error = "the result '" + result_name + "' is neither YES nor NO";
+            break;
+        }
+
+        std::string  text;
+        expression  e;
+        if (!read_record(istr,text) || !from_smtlib2(text,e))
+        {
+            error = "the query is malformed";
+            break;
+        }
+        E.conjuncts = to_sorted_conjuncts(e);
+
+        std::unordered_map<symbol,uint64_t,symbol::hash>  values;
+        for (uint64_t  i = 0ULL; error.empty() && i < num_values; ++i)
+        {
+            std::string  name;
+            uint64_t  num_bits, value;
+            if (istr >> name >> num_bits >> value)
+                values.insert({make_symbol_of_unintepreted_function(name,num_bits),value});
+            else
+                error = "a value of the model is malformed";
+        }
+        E.has_model = has_model != 0U && values_to_model(values,E.model);
+    }
+    if (!error.empty())
+    {
+        std::cerr << "The SAT query cache file '" << m_persistent_file_pathname << "' is ignored, because in the record "
+                  << loaded.size() << " " << error << ".\n";
+        return;
+    }
+
+    for (loaded_entry const&  E : loaded)
+        insert(E.conjuncts,E.result,E.has_model ? &E.model : nullptr);
+}
+
+sat_query_cache::~sat_query_cache()
+{}
+
+sat_result  sat_query_cache::is_satisfiable(expression const  e, uint32_t const  timeout_milliseconds)
+{
+    return is_satisfiable(e,[timeout_milliseconds](expression const  query) { return bv::is_satisfiable(query,timeout_milliseconds); });
+}
+
+std::pair<sat_result,sat_model>  sat_query_cache::get_model_if_satisfiable(expression const  e, uint32_t const  timeout_milliseconds)
+{
+    return get_model_if_satisfiable(e,[timeout_milliseconds](expression const  query) { return bv::get_model_if_satisfiable(query,timeout_milliseconds); });
+}
+
+sat_result  sat_query_cache::is_satisfiable(expression const  e, std::function<sat_result(expression const)> const&  solver)
+{
+    log_query(e);
+    std::vector<expression> const  conjuncts = to_sorted_conjuncts(e);
+    sat_result  result;
+    if (find(conjuncts,false,result,nullptr))
+        return result;
+    result = solver(e);
+    if (result != sat_result::FAIL)
+        insert(conjuncts,result,nullptr);
+    return result;
+}
+
+std::pair<sat_result,sat_model>  sat_query_cache::get_model_if_satisfiable(expression const  e, solver_function const&  solver)
+{
+    log_query(e);
+    std::vector<expression> const  conjuncts = to_sorted_conjuncts(e);
+    std::pair<sat_result,sat_model>  result;
+    if (find(conjuncts,true,result.first,&result.second))
+        return result;
+    result = solver(e);
+    if (result.first != sat_result::FAIL)
+        insert(conjuncts,result.first,&result.second);
+    return result;
+}
+
+sat_result  sat_query_cache::is_satisfiable_by_slices(expression const  e, uint32_t const  timeout_milliseconds,
+                                                  bool const  in_parallel)
+{
+    return is_satisfiable_by_slices(e,[timeout_milliseconds](expression const  query) { return bv::is_satisfiable(query,timeout_milliseconds); },
+                                    in_parallel);
+}
+
+std::pair<sat_result,sat_model>  sat_query_cache::get_model_if_satisfiable_by_slices(expression const  e, uint32_t const  timeout_milliseconds,
+                                                                                     bool const  in_parallel)
+{
+    return get_model_if_satisfiable_by_slices(e,[timeout_milliseconds](expression const  query) { return bv::get_model_if_satisfiable(query,timeout_milliseconds); },
+                                              in_parallel);
+}
+
+sat_result  sat_query_cache::is_satisfiable_by_slices(expression const  e, std::function<sat_result(expression const)> const&  solver,
+                                                  bool const  in_parallel)
+{
+    return solve_by_slices(e,[&solver](expression const  query) { return std::pair<sat_result,sat_model>{solver(query),{}}; },
+                           false,in_parallel).first;
+}
+
+std::pair<sat_result,sat_model>  sat_query_cache::get_model_if_satisfiable_by_slices(expression const  e, solver_function const&  solver,
+                                                                                     bool const  in_parallel)
+{
+    return solve_by_slices(e,solver,true,in_parallel);
+}
+
+std::pair<sat_result,sat_model>  sat_query_cache::solve_by_slices(expression const  e, solver_function const&  solver,
+                                                                  bool const  need_model, bool const  in_parallel)
+{
+    log_query(e);
+    std::vector< std::vector<expression> >  slices;
+    split_to_independent_conjuncts(to_sorted_conjuncts(e),slices);
+    ++m_num_sliced_queries;
+    m_num_slices += slices.size();
+
+    std::vector< std::pair<sat_result,sat_model> >  results(slices.size(),{sat_result::FAIL,{}});
+    std::vector<uint64_t>  missing;
+    for (uint64_t  i = 0ULL; i < slices.size(); ++i)
+        if (!find(slices.at(i),need_model,results.at(i).first,need_model ? &results.at(i).second : nullptr))
+            missing.push_back(i);
+        else if (results.at(i).first == sat_result::NO)
+            return {sat_result::NO,{}};
+
+    if (in_parallel && missing.size() > 1ULL)
+    {
+        std::vector<std::thread>  threads;
+        for (uint64_t const  i : missing)
+            threads.push_back(std::thread([&solver,&slices,&results,i]() { results.at(i) = solver(to_conjunction(slices.at(i))); }));
+        for (auto&  thread : threads)
+            thread.join();
+    }
+    else
+        for (uint64_t const  i : missing)
+        {
+            results.at(i) = solver(to_conjunction(slices.at(i)));
+            if (results.at(i).first == sat_result::NO)
+                break;
+        }
+    for (uint64_t const  i : missing)
+        if (results.at(i).first != sat_result::FAIL)
+            insert(slices.at(i),results.at(i).first,need_model ? &results.at(i).second : nullptr);
+
+    // Models of slices are put together. A cached model may contain values of symbols outside its slice; they are dropped.
+    std::pair<sat_result,sat_model>  result{sat_result::YES,{}};
+    for (uint64_t  i = 0ULL; i < slices.size(); ++i)
+        if (results.at(i).first == sat_result::NO)
+            return {sat_result::NO,{}};
+        else if (results.at(i).first == sat_result::FAIL)
+            result.first = sat_result::FAIL;
+        else if (need_model)
+        {
+            std::unordered_set<symbol,symbol::hash>  symbols;
+            for (auto const&  conjunct : slices.at(i))
+                find_unintepreted_symbols(conjunct,symbols);
+            for (auto const&  symbol_and_values : results.at(i).second)
+                if (symbols.count(symbol_and_values.first) != 0ULL)
+                    result.second.insert(symbol_and_values);
+        }
+    if (result.first == sat_result::FAIL)
+        result.second.clear();
+    return result;
+}
+
+bool  sat_query_cache::find(std::vector<expression> const&  conjuncts, bool const  need_model, sat_result&  result,
+                            sat_model* const  model)
+{
+    ASSUMPTION(std::is_sorted(conjuncts.cbegin(),conjuncts.cend(),&less_by_address));
+
+    if (conjuncts.empty())
+    {
+        ++m_num_exact_hits;
+        result = sat_result::YES;
+        if (model != nullptr)
+            model->clear();
+        return true;
+    }
+
+    auto const  it = m_exact.find(conjuncts);
+    if (it != m_exact.cend())
+    {
+        entry const&  E = m_entries.at(it->second);
+        if (E.result == sat_result::NO || !need_model || E.has_model)
+        {
+            ++m_num_exact_hits;
+            result = E.result;
+            if (model != nullptr && E.result == sat_result::YES)
+                *model = E.model;
+            return true;
+        }
+    }
+
+    // An unsatisfiable subset of conjuncts.
+    std::unordered_map<uint64_t,uint64_t>  counts;
+    for (auto const&  e : conjuncts)
+    {
+        auto const  iit = m_unsat_index.find(e);
+        if (iit != m_unsat_index.cend())
+            for (uint64_t const  idx : iit->second)
+                if (++counts[idx] == m_entries.at(idx).conjuncts.size())
+                {
+                    ++m_num_unsat_subset_hits;
+                    result = sat_result::NO;
+                    return true;
+                }
+    }
+
+    // A satisfiable superset of conjuncts. We also collect candidates for evaluation of models.
+    counts.clear();
+    for (auto const&  e : conjuncts)
+    {
+        auto const  iit = m_sat_index.find(e);
+        if (iit != m_sat_index.cend())
+            for (uint64_t const  idx : iit->second)
+                ++counts[idx];
+    }
+    std::vector<std::pair<uint64_t,uint64_t> >  candidates;
+    for (auto const&  idx_and_count : counts)
+    {
+        entry const&  E = m_entries.at(idx_and_count.first);
+        if (idx_and_count.second == conjuncts.size() && (!need_model || E.has_model))
+        {
+            ++m_num_sat_superset_hits;
+            result = sat_result::YES;
+            if (model != nullptr)
+                *model = E.model;
+            return true;
+        }
+        if (E.has_model && !E.values.empty())
+            candidates.push_back({idx_and_count.second,idx_and_count.first});
+    }
+
+    // A cached model satisfying the conjuncts. Entries sharing more conjuncts (and then younger ones) are tried first.
+    std::sort(candidates.begin(),candidates.end(),std::greater<std::pair<uint64_t,uint64_t> >());
+    if (candidates.size() > max_num_models_to_evaluate)
+        candidates.resize(max_num_models_to_evaluate);
+    std::unordered_set<symbol,symbol::hash>  symbols;
+    if (!candidates.empty())
+        for (auto const&  e : conjuncts)
+            find_unintepreted_symbols(e,symbols);
+    for (auto const&  count_and_idx : candidates)
+    {
+        std::unordered_map<symbol,uint64_t,symbol::hash>  values = m_entries.at(count_and_idx.second).values;
+        for (symbol const  s : symbols)
+            if (symbol_num_parameters(s) == 0ULL)
+                values.insert({s,0ULL});
+        bool  satisfied = true;
+        for (auto const&  e : conjuncts)
+        {
+            uint64_t  value;
+            if (!evaluate(e,values,value) || value == 0ULL)
+            {
+                satisfied = false;
+                break;
+            }
+        }
+        sat_model  values_model;
+        if (satisfied && values_to_model(values,values_model))
+        {
+            ++m_num_model_hits;
+            result = sat_result::YES;
+            if (model != nullptr)
+                model->swap(values_model);
+            return true;
+        }
+    }
+
+    ++m_num_misses;
+    return false;
+}
+
+void  sat_query_cache::insert(std::vector<expression> const&  conjuncts, sat_result const  result, sat_model const* const  model)
+{
+    ASSUMPTION(result != sat_result::FAIL);
+    ASSUMPTION(std::is_sorted(conjuncts.cbegin(),conjuncts.cend(),&less_by_address));
+
+    auto const  it = m_exact.find(conjuncts);
+    if (it != m_exact.cend())
+    {
+        entry&  E = m_entries.at(it->second);
+        INVARIANT(E.result == result);
+        if (result == sat_result::NO || E.has_model || model == nullptr)
+            return;
+        E.has_model = true;
+        E.model = *model;
+        if (!model_to_values(E.model,E.values))
+            E.values.clear();
+        return;
+    }
+
+    uint64_t const  idx = m_entries.size();
+    m_entries.push_back({conjuncts,result,result == sat_result::YES && model != nullptr,{},{}});
+    entry&  E = m_entries.back();
+    if (E.has_model)
+    {
+        E.model = *model;
+        if (!model_to_values(E.model,E.values))
+            E.values.clear();
+    }
+    m_exact.insert({conjuncts,idx});
+    for (auto const&  e : conjuncts)
+        (result == sat_result::NO ? m_unsat_index : m_sat_index)[e].push_back(idx);
+}
+
+bool  sat_query_cache::save() const
+{
+    if (m_persistent_file_pathname.empty())
+        return false;
+
+    std::string const  temp_pathname = m_persistent_file_pathname + ".tmp";
+    {
+        std::ofstream  ostr(temp_pathname,std::ofstream::binary);
+        for (entry const&  E : m_entries)
+        {
+            bool const  has_values = E.has_model && (E.model.empty() || !E.values.empty());
+            ostr << to_string(E.result) << " " << (has_values ? 1U : 0U) << " " << (has_values ? E.values.size() : 0ULL) << "\n";
+            write_record(ostr,to_smtlib2(E.conjuncts));
+            if (has_values)
+                for (auto const&  symbol_and_value : E.values)
+                    ostr << symbol_name(symbol_and_value.first) << " "
+                         << symbol_num_bits_of_return_value(symbol_and_value.first) << " "
+                         << symbol_and_value.second << "\n";
+        }
+        if (!ostr.good())
+            return false;
+    }
+    return std::rename(temp_pathname.c_str(),m_persistent_file_pathname.c_str()) == 0;
+}
+
+void  sat_query_cache::record_queries(std::string const&  log_pathname)
+{
+    m_query_log.reset(new std::ofstream(log_pathname,std::ofstream::binary | std::ofstream::app));
+}
+
+void  sat_query_cache::log_query(expression const  e)
+{
+    if (m_query_log != nullptr)
+        write_record(*m_query_log,to_smtlib2(to_sorted_conjuncts(e)));
+}
+
+
+std::vector<expression>  to_sorted_conjuncts(expression const  e)
+{
+    std::vector<expression>  conjuncts;
+    collect_conjuncts(e,conjuncts);
+    std::sort(conjuncts.begin(),conjuncts.end(),&less_by_address);
+    conjuncts.erase(std::unique(conjuncts.begin(),conjuncts.end()),conjuncts.end());
+    return conjuncts;
+}
+
+
+bool  load_query_log(std::string const&  log_pathname, std::vector<expression>&  queries)
+{
+    std::ifstream  istr(log_pathname,std::ifstream::binary);
+    if (!istr.is_open())
+        return false;
+    std::string  text;
+    while (read_record(istr,text))
+    {
+        expression  e;
+        if (!from_smtlib2(text,e))
+            return false;
+        queries.push_back(e);
+    }
+    return istr.eof();
+}
+
+
+}
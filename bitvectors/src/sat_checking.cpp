@@ -1,8 +1,14 @@
 #include <rebours/bitvectors/sat_checking.hpp>
+#include <rebours/bitvectors/expression_algo.hpp>
+#include <rebours/bitvectors/expression_io.hpp>
 #include <vector>
 #include <map>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
+#include <functional>
+#include <unordered_set>
+#include <algorithm>
 
 namespace bv { namespace detail {
 
@@ -28,6 +34,101 @@ extern void  get_model_if_satisfiable_mathsat5(expression const  e, uint32_t con
                                                sat_result&  output_state, sat_model&  output_model,
                                                sat_engine* const  fastest_respondent_ptr, std::mutex&  output_mutex);
 
+}}
+
+namespace bv { namespace {
+
+
+uint64_t constexpr  many_uninterpreted_symbols = 16ULL;
+uint64_t constexpr  min_num_launches_to_select = 8ULL;     //!< Before that, all engines are launched for a shape.
+uint64_t constexpr  min_share_of_wins_to_select = 4ULL;    //!< An engine is launched, if it has at least 1/4 of wins of the best one.
+uint64_t constexpr  exploration_period = 16ULL;            //!< Each 16th formula of a shape is given to all engines.
+
+
+/**
+ * It is shared by the caller of a portfolio and by threads of engines. The caller does not wait for losing engines,
+ * so this object may outlive the call.
+ */
+struct portfolio_state
+{
+    std::mutex  mutex;
+    std::condition_variable  engine_finished;
+    sat_result  result = sat_result::FAIL;
+    sat_model  model;
+    sat_engine  winner = sat_engine::Z3;
+    uint64_t  num_running_engines = 0ULL;
+};
+
+
+std::mutex&  statistics_mutex()
+{
+    static std::mutex  mutex;
+    return mutex;
+}
+
+std::map<std::pair<uint8_t,sat_engine>,sat_engine_statistics>&  statistics()
+{
+    static std::map<std::pair<uint8_t,sat_engine>,sat_engine_statistics>  table;
+    return table;
+}
+
+std::map<uint8_t,uint64_t>&  num_selections_of_shapes()
+{
+    static std::map<uint8_t,uint64_t>  table;
+    return table;
+}
+
+
+bool  is_special_symbol(symbol const  s)
+{
+    if (!symbol_is_interpreted(s))
+        return false;
+    if (detail::operators_outside_QF_UFBV().count(symbol_name(s)) != 0ULL)
+        return true;
+    auto const  it = detail::operators_to_QF_UFBV_names().find(symbol_name(s));
+    return it != detail::operators_to_QF_UFBV_names().cend() &&
+           (it->second == "bvmul" || it->second == "bvsdiv" || it->second == "bvudiv" ||
+            it->second == "bvsrem" || it->second == "bvurem");
+}
+
+
+/**
+ * It launches all engines in separate threads and it returns as soon as one of them answers (or when all of them fail).
+ * Engines are interrupted by the answer (see 'get_sat_checking_interruption_function'); they kill their solvers and
+ * their threads terminate on their own.
+ */
+std::shared_ptr<portfolio_state>  run_portfolio(uint8_t const  shape, std::set<sat_engine> const&  engines,
+                                                std::vector< std::function<void(portfolio_state&)> > const&  launchers)
+{
+    std::shared_ptr<portfolio_state> const  state = std::make_shared<portfolio_state>();
+    state->num_running_engines = launchers.size();
+    for (auto const&  launcher : launchers)
+        std::thread([state,launcher]() {
+            launcher(*state);
+            {
+                std::lock_guard<std::mutex> const  lock(state->mutex);
+                --state->num_running_engines;
+            }
+            state->engine_finished.notify_all();
+        }).detach();
+
+    {
+        std::unique_lock<std::mutex>  lock(state->mutex);
+        state->engine_finished.wait(lock,[&state]() {
+            return state->result != sat_result::FAIL || state->num_running_engines == 0ULL;
+        });
+    }
+
+    std::lock_guard<std::mutex> const  lock(statistics_mutex());
+    for (auto engine : engines)
+        ++statistics()[{shape,engine}].num_launches;
+    if (state->result != sat_result::FAIL)
+        ++statistics()[{shape,state->winner}].num_wins;
+
+    return state;
+}
+
+
 }}
 
 namespace bv {
@@ -35,7 +136,7 @@ namespace bv {
 
 sat_result  is_satisfiable(expression const  e, uint32_t const  timeout_milliseconds, sat_engine* const  fastest_respondent_ptr)
 {
-    return is_satisfiable(e,timeout_milliseconds,{sat_engine::Z3,sat_engine::BOOLECTOR,sat_engine::MATHSAT5},fastest_respondent_ptr);
+    return is_satisfiable(e,timeout_milliseconds,select_sat_engines(e,all_sat_engines()),fastest_respondent_ptr);
 }
 
 sat_result  is_satisfiable(expression const  e, uint32_t const  timeout_milliseconds, std::set<sat_engine> const&  engines,
@@ -50,25 +151,22 @@ sat_result  is_satisfiable(expression const  e, uint32_t const  timeout_millisec
     ASSUMPTION(e.operator bool());
     ASSUMPTION(!engines.empty());
 
-    sat_result  result = sat_result::FAIL;
-    std::mutex  result_mutex;
-
-    uint32_t  thread_counter = 1U;
-    std::vector<std::thread>  threads;
+    std::vector< std::function<void(portfolio_state&)> >  launchers;
     for (auto engine : engines)
     {
         auto const  it = engines_map.find(engine);
         ASSUMPTION(it != engines_map.cend());
-        ASSUMPTION(thread_counter <= engines.size());
-        if (thread_counter < engines.size())
-            threads.push_back(std::thread(it->second,e,timeout_milliseconds,std::ref(result),fastest_respondent_ptr,std::ref(result_mutex)));
-        else
-            it->second(e,timeout_milliseconds,result,fastest_respondent_ptr,result_mutex);
+        auto const  engine_function = it->second;
+        launchers.push_back([engine_function,e,timeout_milliseconds](portfolio_state&  state) {
+            engine_function(e,timeout_milliseconds,state.result,&state.winner,state.mutex);
+        });
     }
-    for (std::thread& thread : threads)
-        thread.join();
 
-    return result;
+    std::shared_ptr<portfolio_state> const  state = run_portfolio(formula_shape(e),engines,launchers);
+    std::lock_guard<std::mutex> const  lock(state->mutex);
+    if (state->result != sat_result::FAIL && fastest_respondent_ptr != nullptr)
+        *fastest_respondent_ptr = state->winner;
+    return state->result;
 }
 
 
@@ -102,7 +200,7 @@ expression  values_of_expression_in_model::value_of_case(uint64_t const  case_in
 std::pair<sat_result,sat_model>  get_model_if_satisfiable(expression const  e, uint32_t const  timeout_milliseconds,
                                                           sat_engine* const  fastest_respondent_ptr)
 {
-    return get_model_if_satisfiable(e,timeout_milliseconds,{sat_engine::Z3,sat_engine::BOOLECTOR,sat_engine::MATHSAT5},fastest_respondent_ptr);
+    return get_model_if_satisfiable(e,timeout_milliseconds,select_sat_engines(e,all_sat_engines()),fastest_respondent_ptr);
 }
 
 std::pair<sat_result,sat_model>  get_model_if_satisfiable(expression const  e, uint32_t const  timeout_milliseconds,
@@ -117,28 +215,93 @@ std::pair<sat_result,sat_model>  get_model_if_satisfiable(expression const  e, u
     ASSUMPTION(e.operator bool());
     ASSUMPTION(!engines.empty());
 
-    sat_result  state = sat_result::FAIL;
-    sat_model   model;
-    std::mutex  result_mutex;
-
-    uint32_t  thread_counter = 1U;
-    std::vector<std::thread>  threads;
+    std::vector< std::function<void(portfolio_state&)> >  launchers;
     for (auto engine : engines)
     {
         auto const  it = engines_map.find(engine);
         ASSUMPTION(it != engines_map.cend());
-        ASSUMPTION(thread_counter <= engines.size());
-        if (thread_counter < engines.size())
-            threads.push_back(std::thread(it->second,e,timeout_milliseconds,std::ref(state),std::ref(model),fastest_respondent_ptr,std::ref(result_mutex)));
-        else
-            it->second(e,timeout_milliseconds,state,model,fastest_respondent_ptr,result_mutex);
+        auto const  engine_function = it->second;
+        launchers.push_back([engine_function,e,timeout_milliseconds](portfolio_state&  state) {
+            engine_function(e,timeout_milliseconds,state.result,state.model,&state.winner,state.mutex);
+        });
     }
-    for (std::thread& thread : threads)
-        thread.join();
 
-    return {state,model};
+    std::shared_ptr<portfolio_state> const  state = run_portfolio(formula_shape(e),engines,launchers);
+    std::lock_guard<std::mutex> const  lock(state->mutex);
+    if (state->result != sat_result::FAIL && fastest_respondent_ptr != nullptr)
+        *fastest_respondent_ptr = state->winner;
+    return {state->result,state->model};
 }
 
+
+std::set<sat_engine> const&  all_sat_engines()
+{
+    static std::set<sat_engine> const  engines{ sat_engine::Z3, sat_engine::BOOLECTOR, sat_engine::MATHSAT5 };
+    return engines;
+}
+
+
+uint8_t  formula_shape(expression const  e)
+{
+    std::unordered_set<symbol,symbol::hash>  uninterpreted;
+    find_unintepreted_symbols(e,uninterpreted);
+    std::unordered_set<symbol,symbol::hash>  special;
+    find_symbols(e,&is_special_symbol,special);
+
+    uint8_t  shape = uninterpreted.size() > many_uninterpreted_symbols ? formula_shape_many_symbols : 0U;
+    for (symbol const  s : uninterpreted)
+        if (symbol_num_parameters(s) != 0ULL)
+            shape |= formula_shape_functions;
+    for (symbol const  s : special)
+        shape |= detail::operators_outside_QF_UFBV().count(symbol_name(s)) != 0ULL ? formula_shape_outside_QF_UFBV :
+                                                                                     formula_shape_nonlinear;
+    return shape;
+}
+
+sat_engine_statistics  get_sat_engine_statistics(sat_engine const  engine, uint8_t const  shape)
+{
+    std::lock_guard<std::mutex> const  lock(statistics_mutex());
+    auto const  it = statistics().find({shape,engine});
+    return it == statistics().cend() ? sat_engine_statistics{0ULL,0ULL} : it->second;
+}
+
+void  clear_sat_engine_statistics()
+{
+    std::lock_guard<std::mutex> const  lock(statistics_mutex());
+    statistics().clear();
+    num_selections_of_shapes().clear();
+}
+
+std::set<sat_engine>  select_sat_engines(expression const  e, std::set<sat_engine> const&  engines)
+{
+    ASSUMPTION(!engines.empty());
+
+    uint8_t const  shape = formula_shape(e);
+
+    std::lock_guard<std::mutex> const  lock(statistics_mutex());
+
+    if (num_selections_of_shapes()[shape]++ % exploration_period == exploration_period - 1ULL)
+        return engines;
+
+    uint64_t  max_num_wins = 0ULL;
+    for (auto engine : engines)
+    {
+        auto const  it = statistics().find({shape,engine});
+        if (it == statistics().cend() || it->second.num_launches < min_num_launches_to_select)
+            return engines;
+        max_num_wins = std::max(max_num_wins,it->second.num_wins);
+    }
+    if (max_num_wins == 0ULL)
+        return engines;
+
+    std::set<sat_engine>  selected;
+    for (auto engine : engines)
+        if (min_share_of_wins_to_select * statistics().at({shape,engine}).num_wins >= max_num_wins)
+            selected.insert(engine);
+    return selected;
+}
+
+
 std::string  to_string(sat_result const  value)
 {
     switch (value)
@@ -0,0 +1,563 @@
+#include <rebours/bitvectors/sat_checking.hpp>
+#include <rebours/bitvectors/expression_io.hpp>
+#include <rebours/bitvectors/expression_algo.hpp>
+#include <rebours/bitvectors/assumptions.hpp>
+#include <rebours/bitvectors/invariants.hpp>
+#include <chrono>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <cctype>
+#   if defined(WIN32)
+#       error "NOT IMPLEMENTED YET!"
+#   elif defined(__linux__) || defined(__APPLE__)
+#       include <signal.h>
+#       include <fcntl.h>
+#       include <poll.h>
+#       include <unistd.h>
+#       include <sys/types.h>
+#       include <sys/wait.h>
+#       include <cerrno>
+#   else
+#       error "Unsuported platform."
+#   endif
+
+#define XSTR(s) STR(s)
+#define STR(s) #s
+
+namespace bv { namespace {
+
+
+std::string  get_session_command(sat_engine const  engine)
+{
+    switch (engine)
+    {
+    case sat_engine::Z3: return std::string(XSTR(Z3_ROOT)) + "/bin/z3 -smt2 -in";
+    case sat_engine::BOOLECTOR: return std::string(XSTR(BOOLECTOR_ROOT)) + "/boolector --smt2 --incremental --hex";
+    case sat_engine::MATHSAT5: return std::string(XSTR(MATHSAT5_ROOT)) + "/bin/mathsat -input=smt2";
+    default: UNREACHABLE();
+    }
+}
+
+std::function<bool()>  get_timeout_function(uint32_t const  timeout_milliseconds)
+{
+    std::chrono::high_resolution_clock::time_point const  start_time = std::chrono::high_resolution_clock::now();
+    return [start_time,timeout_milliseconds]() {
+        std::chrono::high_resolution_clock::time_point const  current_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double,std::milli>(current_time - start_time).count() >= double(timeout_milliseconds);
+    };
+}
+
+void  collect_conjuncts(expression const  e, std::vector<expression>&  output)
+{
+    if (get_symbol(e) == make_symbol_of_logical_conjunction())
+    {
+        collect_conjuncts(argument(e,0ULL),output);
+        collect_conjuncts(argument(e,1ULL),output);
+    }
+    else if (!is_tt(e))
+        output.push_back(e);
+}
+
+/**
+ * It moves the first complete response in the buffer to the output. A response is either a balanced parenthesised
+ * expression or a single line.
+ */
+bool  extract_response(std::string&  buffer, std::string&  output)
+{
+    uint64_t  begin = 0ULL;
+    while (begin < buffer.size() && std::isspace(buffer.at(begin)))
+        ++begin;
+    if (begin == buffer.size())
+        return false;
+
+    uint64_t  end = begin;
+    if (buffer.at(begin) == '(')
+    {
+        int64_t  depth = 0LL;
+        char  quote = 0;
+        for ( ; end < buffer.size(); ++end)
+        {
+            char const  c = buffer.at(end);
+            if (quote != 0)
+            {
+                if (c == quote)
+                    quote = 0;
+            }
+            else if (c == '"' || c == '|')
+                quote = c;
+            else if (c == '(')
+                ++depth;
+            else if (c == ')' && --depth == 0LL)
+                break;
+        }
+        if (end == buffer.size())
+            return false;
+        ++end;
+    }
+    else
+    {
+        end = buffer.find('\n',begin);
+        if (end == std::string::npos)
+            return false;
+    }
+
+    output = buffer.substr(begin,end - begin);
+    while (!output.empty() && std::isspace(output.back()))
+        output.pop_back();
+    buffer.erase(0ULL,end);
+    return true;
+}
+
+expression  parse_value(detail::smtlib2_ast_node const&  ast, uint64_t const  num_bits)
+{
+    if (ast.children().size() == 3ULL &&
+        ast.children().at(0ULL).token().name() == "_" &&
+        ast.children().at(1ULL).token().name().size() > 2ULL &&
+        ast.children().at(1ULL).token().name().substr(0ULL,2ULL) == "bv")
+    {
+        uint64_t const  value = std::stoull(ast.children().at(1ULL).token().name().substr(2ULL));
+        switch (num_bits)
+        {
+        case 8ULL: return num<uint8_t>(value);
+        case 16ULL: return num<uint16_t>(value);
+        case 32ULL: return num<uint32_t>(value);
+        case 64ULL: return num<uint64_t>(value);
+        default: return {};
+        }
+    }
+    std::string  error;
+    expression const  value = detail::build_expression_from_smtlib2_ast(ast,{},error);
+    if (!error.empty())
+    {
+        std::cerr << error;
+        return {};
+    }
+    return value;
+}
+
+bool  parse_values(std::string const&  response, std::unordered_map<std::string,symbol> const&  symbols, sat_model&  output)
+{
+    std::stringstream  sstr(response);
+    std::vector<detail::smtlib2_token>  tokens;
+    detail::tokenise_smtlib2_stream(sstr,tokens);
+    std::vector<detail::smtlib2_ast_node>  asts;
+    if (!detail::tokenised_smtlib2_stream_to_ast(tokens,asts).empty())
+        return false;
+
+    if (asts.size() != 1ULL || !asts.at(0ULL).token().name().empty())
+    {
+        std::cerr << "ERROR: The values do not have the format '( (...) (...) ...)'.";
+        return false;
+    }
+
+    for (auto const&  pair : asts.at(0ULL).children())
+    {
+        if (pair.children().size() != 2ULL || symbols.count(pair.children().at(0ULL).token().name()) == 0ULL)
+        {
+            std::cerr << "ERROR[" << pair.token().line() << ":" << pair.token().column() << "]: "
+                         "Expected a pair (<symbol> <value>).";
+            return false;
+        }
+        symbol const  s = symbols.at(pair.children().at(0ULL).token().name());
+        expression const  value = parse_value(pair.children().at(1ULL),symbol_num_bits_of_return_value(s));
+        if (!value.operator bool())
+            return false;
+        output.insert({s,sat_model_cases_ptr(new values_of_expression_in_model::sat_model_cases({{{},value}}))});
+    }
+
+    return true;
+}
+
+
+}}
+
+namespace bv {
+
+
+solver_session::solver_session(sat_engine const  engine)
+    : solver_session(get_session_command(engine))
+{}
+
+solver_session::solver_session(std::string const&  shell_command)
+    : m_shell_command(shell_command)
+    , m_process_id(-1LL)
+    , m_input_fd(-1)
+    , m_output_fd(-1)
+    , m_buffer()
+    , m_script()
+    , m_pending()
+    , m_declarations()
+    , m_literals()
+    , m_scopes()
+    , m_num_started_processes(0ULL)
+    , m_num_declarations(0ULL)
+    , m_num_literals(0ULL)
+    , m_num_queries(0ULL)
+{}
+
+solver_session::~solver_session()
+{
+    if (m_process_id > 0LL)
+        send({"(exit)"},get_timeout_function(100U));
+    stop();
+}
+
+void  solver_session::push()
+{
+    m_scopes.push_back({m_script.size(),{},{}});
+    enqueue("(push 1)");
+}
+
+void  solver_session::pop()
+{
+    ASSUMPTION(!m_scopes.empty());
+    scope const&  S = m_scopes.back();
+    for (auto const&  decl : S.declarations)
+        m_declarations.erase(decl);
+    for (auto const&  e : S.literals)
+        m_literals.erase(e);
+    m_script.resize(S.script_size);
+    if (m_process_id > 0LL)
+        m_pending.push_back("(pop 1)");
+    m_scopes.pop_back();
+}
+
+void  solver_session::assert_formula(expression const  e)
+{
+    ASSUMPTION(is_formula(e));
+    declare(e);
+    std::stringstream  sstr;
+    sstr << "(assert ";
+    detail::save_formula_in_smtlib2_format(sstr,e);
+    sstr << ")";
+    enqueue(sstr.str());
+}
+
+sat_result  solver_session::check_sat_assuming(std::vector<expression> const&  assumptions, uint32_t const  timeout_milliseconds)
+{
+    return check_sat_assuming(assumptions,get_timeout_function(timeout_milliseconds));
+}
+
+sat_result  solver_session::check_sat_assuming(std::vector<expression> const&  assumptions, std::function<bool()> const&  interrupt)
+{
+    std::string  unused;
+    return check(assumptions,"",interrupt,unused);
+}
+
+std::pair<sat_result,sat_model>  solver_session::get_model_if_satisfiable(std::vector<expression> const&  assumptions,
+                                                                          uint32_t const  timeout_milliseconds)
+{
+    std::unordered_map<std::string,symbol>  symbols;
+    std::stringstream  sstr;
+    for (auto const&  e : assumptions)
+    {
+        std::unordered_set<symbol,symbol::hash>  uninterpreted;
+        find_unintepreted_symbols(e,uninterpreted);
+        for (symbol const  s : uninterpreted)
+            if (symbol_num_parameters(s) == 0ULL && symbols.insert({symbol_name(s),s}).second)
+                sstr << (symbols.size() == 1ULL ? "" : " ") << symbol_name(s);
+    }
+
+    std::string  values;
+    sat_result const  result = check(assumptions,symbols.empty() ? "" : "(get-value (" + sstr.str() + "))",
+                                     get_timeout_function(timeout_milliseconds),values);
+    sat_model  model;
+    if (result == sat_result::YES && !symbols.empty() && !parse_values(values,symbols,model))
+        return {sat_result::FAIL,{}};
+    return {result,model};
+}
+
+sat_result  solver_session::is_satisfiable(expression const  e, uint32_t const  timeout_milliseconds)
+{
+    std::vector<expression>  conjuncts;
+    collect_conjuncts(e,conjuncts);
+    return check_sat_assuming(conjuncts,timeout_milliseconds);
+}
+
+std::pair<sat_result,sat_model>  solver_session::get_model_if_satisfiable(expression const  e, uint32_t const  timeout_milliseconds)
+{
+    std::vector<expression>  conjuncts;
+    collect_conjuncts(e,conjuncts);
+    return get_model_if_satisfiable(conjuncts,timeout_milliseconds);
+}
+
+void  solver_session::enqueue(std::string const&  command)
+{
+    m_script.push_back(command);
+    if (m_process_id > 0LL)
+        m_pending.push_back(command);
+}
+
+void  solver_session::declare(expression const  e)
+{
+    std::vector<std::string>  declarations;
+    detail::save_declarations_in_smtlib2_format(e,declarations);
+    for (auto const&  decl : declarations)
+        if (m_declarations.insert(decl).second)
+        {
+            if (!m_scopes.empty())
+                m_scopes.back().declarations.push_back(decl);
+            enqueue(decl);
+            ++m_num_declarations;
+        }
+}
+
+std::string const&  solver_session::literal(expression const  e)
+{
+    auto const  it = m_literals.find(e);
+    if (it != m_literals.cend())
+        return it->second;
+
+    declare(e);
+
+    std::stringstream  name;
+    name << "bv_session_literal_" << m_num_literals;
+    ++m_num_literals;
+    enqueue("(declare-fun " + name.str() + " () Bool)");
+
+    std::stringstream  sstr;
+    sstr << "(assert (=> " << name.str() << " ";
+    detail::save_formula_in_smtlib2_format(sstr,e);
+    sstr << "))";
+    enqueue(sstr.str());
+
+    if (!m_scopes.empty())
+        m_scopes.back().literals.push_back(e);
+    return m_literals.insert({e,name.str()}).first->second;
+}
+
+sat_result  solver_session::check(std::vector<expression> const&  assumptions, std::string const&  extra_command,
+                                  std::function<bool()> const&  interrupt, std::string&  extra_response)
+{
+    ++m_num_queries;
+
+    std::stringstream  sstr;
+    for (uint64_t  i = 0ULL; i < assumptions.size(); ++i)
+    {
+        ASSUMPTION(is_formula(assumptions.at(i)));
+        sstr << (i == 0ULL ? "" : " ") << literal(assumptions.at(i));
+    }
+
+    std::vector<std::string>  commands;
+    if (m_process_id <= 0LL)
+    {
+        if (!start())
+            return sat_result::FAIL;
+        commands = {"(set-option :print-success true)", "(set-option :produce-models true)", "(set-logic QF_UFBV)"};
+        commands.insert(commands.end(),m_script.cbegin(),m_script.cend());
+    }
+    else
+        commands.swap(m_pending);
+    m_pending.clear();
+    uint64_t const  num_acknowledgements = commands.size();
+    commands.push_back(assumptions.empty() ? std::string("(check-sat)") : "(check-sat-assuming (" + sstr.str() + "))");
+    if (!extra_command.empty())
+        commands.push_back(extra_command);
+
+    if (!send(commands,interrupt))
+    {
+        stop();
+        return sat_result::FAIL;
+    }
+
+    bool  acknowledged = true;
+    std::string  response;
+    for (uint64_t  i = 0ULL; i < num_acknowledgements; ++i)
+    {
+        if (!receive(response,interrupt))
+        {
+            stop();
+            return sat_result::FAIL;
+        }
+        if (response != "success")
+        {
+            std::cerr << "ERROR: The solver '" << m_shell_command << "' rejected the command '" << commands.at(i) << "': " << response << "\n";
+            acknowledged = false;
+        }
+    }
+
+    if (!receive(response,interrupt) || (!extra_command.empty() && !receive(extra_response,interrupt)))
+    {
+        stop();
+        return sat_result::FAIL;
+    }
+    if (!acknowledged)
+        return sat_result::FAIL;
+    if (response == "sat")
+        return sat_result::YES;
+    if (response == "unsat")
+        return sat_result::NO;
+    return sat_result::FAIL;
+}
+
+
+#   if defined(WIN32)
+#       error "NOT IMPLEMENTED YET!"
+#   elif defined(__linux__) || defined(__APPLE__)
+
+namespace {
+
+
+/**
+ * Both ends of the pipe are created closed on exec, so that no process started concurrently by another thread
+ * inherits them. In the child 'dup2' clears the flag on its copies of the ends.
+ */
+bool  create_pipe(int  fds[2])
+{
+#       if defined(__linux__)
+    return ::pipe2(fds,O_CLOEXEC) == 0;
+#       else
+    if (::pipe(fds) != 0)
+        return false;
+    for (int  i = 0; i != 2; ++i)
+        ::fcntl(fds[i],F_SETFD,::fcntl(fds[i],F_GETFD) | FD_CLOEXEC);
+    return true;
+#       endif
+}
+
+
+}
+
+bool  solver_session::start()
+{
+    INVARIANT(m_process_id <= 0LL);
+
+    int  input_pipe[2], output_pipe[2];
+    if (!create_pipe(input_pipe))
+        return false;
+    if (!create_pipe(output_pipe))
+    {
+        ::close(input_pipe[0]);
+        ::close(input_pipe[1]);
+        return false;
+    }
+
+    std::string const  command = "exec " + m_shell_command;
+    ::pid_t const  pid = ::fork();
+    if (pid == 0)
+    {
+        ::dup2(input_pipe[0],STDIN_FILENO);
+        ::dup2(output_pipe[1],STDOUT_FILENO);
+        ::close(input_pipe[0]);
+        ::close(input_pipe[1]);
+        ::close(output_pipe[0]);
+        ::close(output_pipe[1]);
+        ::execl("/bin/sh","sh","-c",command.c_str(),(char*)nullptr);
+        ::_exit(127);
+    }
+
+    ::close(input_pipe[0]);
+    ::close(output_pipe[1]);
+    if (pid < 0)
+    {
+        ::close(input_pipe[1]);
+        ::close(output_pipe[0]);
+        return false;
+    }
+
+    m_process_id = pid;
+    m_input_fd = input_pipe[1];
+    m_output_fd = output_pipe[0];
+    for (int const  fd : { m_input_fd, m_output_fd })
+        ::fcntl(fd,F_SETFL,::fcntl(fd,F_GETFL) | O_NONBLOCK);
+    m_buffer.clear();
+    ++m_num_started_processes;
+    return true;
+}
+
+void  solver_session::stop()
+{
+    if (m_process_id <= 0LL)
+        return;
+    ::close(m_input_fd);
+    ::close(m_output_fd);
+    ::kill((::pid_t)m_process_id,SIGKILL);
+    ::waitpid((::pid_t)m_process_id,nullptr,0);
+    m_process_id = -1LL;
+    m_input_fd = -1;
+    m_output_fd = -1;
+    m_buffer.clear();
+    m_pending.clear();
+}
+
+bool  solver_session::send(std::vector<std::string> const&  commands, std::function<bool()> const&  interrupt)
+{
+    std::string  text;
+    for (auto const&  command : commands)
+        text.append(command).push_back('\n');
+
+    // A write into the pipe of a terminated solver would raise SIGPIPE. So, we block the signal in this thread and
+    // we discard it, if it was raised.
+    ::sigset_t  pipe_signal, old_mask;
+    sigemptyset(&pipe_signal);
+    sigaddset(&pipe_signal,SIGPIPE);
+    ::pthread_sigmask(SIG_BLOCK,&pipe_signal,&old_mask);
+
+    bool  result = true;
+    uint64_t  num_written = 0ULL;
+    while (result && num_written < text.size())
+    {
+        // The solver answers while it is reading, so we must also read its answers, otherwise both pipes may get full.
+        ::pollfd  fds[2] = { { m_input_fd, POLLOUT, 0 }, { m_output_fd, POLLIN, 0 } };
+        if (::poll(fds,2,10) < 0 && errno != EINTR)
+            result = false;
+        else if ((fds[1].revents & POLLIN) != 0)
+        {
+            char  buff[4096];
+            ssize_t const  num_read = ::read(m_output_fd,buff,sizeof(buff));
+            if (num_read > 0)
+                m_buffer.append(buff,num_read);
+        }
+        if (result && (fds[0].revents & (POLLOUT | POLLERR | POLLHUP)) != 0)
+        {
+            ssize_t const  n = ::write(m_input_fd,text.data() + num_written,text.size() - num_written);
+            if (n > 0)
+                num_written += n;
+            else if (n < 0 && errno != EAGAIN && errno != EINTR)
+                result = false;
+        }
+        if (result && num_written < text.size() && interrupt())
+            result = false;
+    }
+
+    ::sigset_t  pending;
+    sigpending(&pending);
+    if (sigismember(&pending,SIGPIPE))
+    {
+        int  signal_number;
+        sigwait(&pipe_signal,&signal_number);
+    }
+    ::pthread_sigmask(SIG_SETMASK,&old_mask,nullptr);
+
+    return result;
+}
+
+bool  solver_session::receive(std::string&  response, std::function<bool()> const&  interrupt)
+{
+    while (!extract_response(m_buffer,response))
+    {
+        ::pollfd  fds = { m_output_fd, POLLIN, 0 };
+        if (::poll(&fds,1,10) < 0 && errno != EINTR)
+            return false;
+        if ((fds.revents & (POLLIN | POLLHUP)) != 0)
+        {
+            char  buff[4096];
+            ssize_t const  num_read = ::read(m_output_fd,buff,sizeof(buff));
+            if (num_read == 0 || (num_read < 0 && errno != EAGAIN && errno != EINTR))
+                return false;   // The solver has terminated.
+            if (num_read > 0)
+                m_buffer.append(buff,num_read);
+        }
+        if (interrupt())
+            return false;
+    }
+    return true;
+}
+
+#   else
+#       error "Unsuported platform."
+#   endif
+
+
+}
@@ -0,0 +1,384 @@
+#include <rebours/bitvectors/test.hpp>
+#include <rebours/bitvectors/expression.hpp>
+#include <rebours/bitvectors/expression_algo.hpp>
+#include <rebours/bitvectors/sat_checking.hpp>
+#include <rebours/bitvectors/sat_cache.hpp>
+#include <unordered_set>
+#include <unordered_map>
+#include <vector>
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+
+
+static std::atomic<uint64_t>  num_solver_calls(0ULL);
+
+/**
+ * A stand-in for a real solver. It tries all values of (at most two) 8-bit symbols of the formula, but only in the range
+ * 0,...,63 (to keep the test fast). So, it decides satisfiability of formulae with symbols restricted to the range.
+ */
+static std::pair<bv::sat_result,bv::sat_model>  brute_force_solver(bv::expression const  e)
+{
+    ++num_solver_calls;
+    std::unordered_set<bv::symbol,bv::symbol::hash>  symbols;
+    bv::find_unintepreted_symbols(e,symbols);
+    std::vector<bv::symbol> const  vars(symbols.cbegin(),symbols.cend());
+    if (vars.size() > 2ULL)
+        return {bv::sat_result::FAIL,{}};
+    for (auto const  s : vars)
+        if (bv::symbol_num_parameters(s) != 0ULL || bv::symbol_num_bits_of_return_value(s) != 8ULL)
+            return {bv::sat_result::FAIL,{}};
+    for (uint64_t  i = 0ULL; i < (1ULL << (6ULL * vars.size())); ++i)
+    {
+        std::unordered_map<bv::symbol,uint64_t,bv::symbol::hash>  values;
+        for (uint64_t  j = 0ULL; j < vars.size(); ++j)
+            values.insert({vars.at(j),(i >> (6ULL * j)) & 0x3fULL});
+        uint64_t  value;
+        if (bv::evaluate(e,values,value) && value != 0ULL)
+        {
+            bv::sat_model  model;
+            for (auto const&  symbol_and_value : values)
+            {
+                bv::expression const  constant = bv::num((uint8_t)symbol_and_value.second);
+                model.insert({symbol_and_value.first,bv::sat_model_cases_ptr(new bv::values_of_expression_in_model::sat_model_cases({{{},constant}}))});
+            }
+            return {bv::sat_result::YES,model};
+        }
+    }
+    return {bv::sat_result::NO,{}};
+}
+
+static bv::sat_result  brute_force_satisfiability_solver(bv::expression const  e)
+{
+    return brute_force_solver(e).first;
+}
+
+static bv::sat_result  unreachable_solver(bv::expression const)
+{
+    TEST_SUCCESS(false);
+    return bv::sat_result::FAIL;
+}
+
+static bool  is_model_of(bv::sat_model const&  model, bv::expression const  e)
+{
+    std::unordered_map<bv::symbol,uint64_t,bv::symbol::hash>  values;
+    for (auto const&  symbol_and_values : model)
+    {
+        uint64_t  value;
+        if (!bv::evaluate(symbol_and_values.second.value_of_case(0ULL),{},value))
+            return false;
+        values.insert({symbol_and_values.first,value});
+    }
+    uint64_t  value;
+    return bv::evaluate(e,values,value) && value != 0ULL;
+}
+
+
+static void test_evaluate()
+{
+    std::cout << "Starting: test_evaluate()\n";
+
+    bv::typed_expression<uint8_t> const  a = bv::var<uint8_t>("a");
+    bv::typed_expression<uint8_t> const  b = bv::var<uint8_t>("b");
+    bv::typed_expression<int32_t> const  c = bv::var<int32_t>("c");
+
+    std::unordered_map<bv::symbol,uint64_t,bv::symbol::hash> const  values{
+            {bv::get_symbol(a),250ULL}, {bv::get_symbol(b),10ULL}, {bv::get_symbol(c),0xfffffffeULL} // c == -2
+            };
+    uint64_t  value;
+
+    TEST_SUCCESS(bv::evaluate(a + b,values,value) && value == 4ULL);
+    TEST_SUCCESS(bv::evaluate(a - b,values,value) && value == 240ULL);
+    TEST_SUCCESS(bv::evaluate(a / b,values,value) && value == 25ULL);
+    TEST_SUCCESS(bv::evaluate((a ^ b) & bv::num((uint8_t)0x0f),values,value) && value == 0x00ULL);
+    TEST_SUCCESS(bv::evaluate(b < a,values,value) && value == 1ULL);
+    TEST_SUCCESS(bv::evaluate(c < bv::num((int32_t)0),values,value) && value == 1ULL);
+    TEST_SUCCESS(bv::evaluate(c * c == bv::num((int32_t)4) && !(a == b),values,value) && value == 1ULL);
+    TEST_SUCCESS(bv::evaluate(bv::cast<int32_t>(a) + c,values,value) && value == 248ULL);
+
+    TEST_SUCCESS(!bv::evaluate(a / (b - b),values,value));
+    TEST_SUCCESS(!bv::evaluate(a + bv::var<uint8_t>("unknown"),values,value));
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_subsumption()
+{
+    std::cout << "Starting: test_subsumption()\n";
+
+    bv::typed_expression<uint8_t> const  a = bv::var<uint8_t>("a");
+    bv::typed_expression<uint8_t> const  b = bv::var<uint8_t>("b");
+    bv::typed_expression<uint8_t> const  i10 = bv::num((uint8_t)10);
+    bv::typed_expression<uint8_t> const  i20 = bv::num((uint8_t)20);
+
+    bv::sat_query_cache  cache;
+    num_solver_calls = 0ULL;
+
+    std::pair<bv::sat_result,bv::sat_model>  result = cache.get_model_if_satisfiable(a < i10 && b == a + i10,&brute_force_solver);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 1ULL && cache.num_misses() == 1ULL);
+
+    // Exact hit; the order of conjuncts does not matter.
+    result = cache.get_model_if_satisfiable(b == a + i10 && a < i10,&brute_force_solver);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 1ULL && cache.num_exact_hits() == 1ULL);
+
+    // A subset of a satisfiable query.
+    result = cache.get_model_if_satisfiable(a < i10,&brute_force_solver);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 1ULL && cache.num_sat_superset_hits() == 1ULL);
+    TEST_SUCCESS(is_model_of(result.second,a < i10));
+
+    // A superset of an unsatisfiable query.
+    TEST_SUCCESS(cache.is_satisfiable(a < i10 && i20 < a,&brute_force_satisfiability_solver) == bv::sat_result::NO);
+    TEST_SUCCESS(num_solver_calls == 2ULL);
+    TEST_SUCCESS(cache.get_model_if_satisfiable(b == i20 && i20 < a && a < i10,&brute_force_solver).first == bv::sat_result::NO);
+    TEST_SUCCESS(num_solver_calls == 2ULL && cache.num_unsat_subset_hits() == 1ULL);
+
+    // A cached model satisfies the new query.
+    result = cache.get_model_if_satisfiable(a < i10 && b == a + i10 && b < i20,&brute_force_solver);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 2ULL && cache.num_model_hits() == 1ULL);
+    TEST_SUCCESS(is_model_of(result.second,a < i10 && b == a + i10 && b < i20));
+
+    // No cached model satisfies the query.
+    result = cache.get_model_if_satisfiable(a < i10 && b == a + i10 && i10 < a + b,&brute_force_solver);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 3ULL && cache.num_misses() == 3ULL);
+    TEST_SUCCESS(is_model_of(result.second,a < i10 && b == a + i10 && i10 < a + b));
+
+    // A query without a model is not a hit for a query asking for a model.
+    TEST_SUCCESS(cache.is_satisfiable(i20 < b,&brute_force_satisfiability_solver) == bv::sat_result::YES);
+    TEST_SUCCESS(num_solver_calls == 4ULL);
+    TEST_SUCCESS(cache.is_satisfiable(i20 < b,&unreachable_solver) == bv::sat_result::YES);
+    result = cache.get_model_if_satisfiable(i20 < b,&brute_force_solver);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 5ULL && is_model_of(result.second,i20 < b));
+
+    TEST_SUCCESS(cache.num_entries() == 4ULL);
+    TEST_SUCCESS(cache.num_hits() == 5ULL && cache.num_misses() == 5ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_persistent_cache()
+{
+    std::cout << "Starting: test_persistent_cache()\n";
+
+    std::string const  pathname = "./caching_of_queries_cache.txt";
+    std::remove(pathname.c_str());
+
+    bv::typed_expression<uint8_t> const  a = bv::var<uint8_t>("a");
+    bv::typed_expression<uint8_t> const  b = bv::var<uint8_t>("b");
+    bv::typed_expression<uint8_t> const  i10 = bv::num((uint8_t)10);
+    bv::typed_expression<uint8_t> const  i20 = bv::num((uint8_t)20);
+
+    num_solver_calls = 0ULL;
+    {
+        bv::sat_query_cache  cache(pathname);
+        TEST_SUCCESS(cache.num_entries() == 0ULL);
+        TEST_SUCCESS(cache.get_model_if_satisfiable(a < i10 && b == a + i20,&brute_force_solver).first == bv::sat_result::YES);
+        TEST_SUCCESS(cache.get_model_if_satisfiable(a < i10 && i20 < a,&brute_force_solver).first == bv::sat_result::NO);
+        TEST_SUCCESS(cache.save());
+    }
+    TEST_SUCCESS(num_solver_calls == 2ULL);
+    {
+        bv::sat_query_cache  cache(pathname);
+        TEST_SUCCESS(cache.num_entries() == 2ULL);
+
+        std::pair<bv::sat_result,bv::sat_model> const  result =
+                cache.get_model_if_satisfiable(b == a + i20 && a < i10,&brute_force_solver);
+        TEST_SUCCESS(result.first == bv::sat_result::YES && is_model_of(result.second,a < i10 && b == a + i20));
+        TEST_SUCCESS(cache.is_satisfiable(i20 < a && a < i10 && b == i10,&unreachable_solver) == bv::sat_result::NO);
+        TEST_SUCCESS(cache.num_exact_hits() == 1ULL && cache.num_unsat_subset_hits() == 1ULL);
+    }
+    TEST_SUCCESS(num_solver_calls == 2ULL);
+
+    // A damaged file is ignored as a whole.
+    std::string  content;
+    {
+        std::ifstream  istr(pathname,std::ifstream::binary);
+        content.assign(std::istreambuf_iterator<char>(istr),std::istreambuf_iterator<char>());
+    }
+    TEST_SUCCESS(content.find("\nNO 0 0\n") != std::string::npos);
+    std::string  unknown_result = content;
+    unknown_result.replace(unknown_result.find("\nNO 0 0\n"),4ULL,"\nMAYBE ");
+    std::string  bad_value = content;
+    bad_value.replace(bad_value.find("\nNO 0 0\n") - 2ULL,1ULL,"x");
+    std::string const  bad_header = content + "YES 1\n";
+    for (std::string const&  damaged : { unknown_result, bad_value, bad_header, content.substr(0ULL,content.size() - 8ULL) })
+    {
+        {
+            std::ofstream  ostr(pathname,std::ofstream::binary);
+            ostr << damaged;
+        }
+        bv::sat_query_cache  cache(pathname);
+        TEST_SUCCESS(cache.num_entries() == 0ULL);
+    }
+
+    std::remove(pathname.c_str());
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_slicing()
+{
+    std::cout << "Starting: test_slicing()\n";
+
+    bv::typed_expression<uint8_t> const  a = bv::var<uint8_t>("a");
+    bv::typed_expression<uint8_t> const  b = bv::var<uint8_t>("b");
+    bv::typed_expression<uint8_t> const  c = bv::var<uint8_t>("c");
+    bv::typed_expression<uint8_t> const  d = bv::var<uint8_t>("d");
+    bv::typed_expression<uint8_t> const  i5 = bv::num((uint8_t)5);
+    bv::typed_expression<uint8_t> const  i10 = bv::num((uint8_t)10);
+    bv::typed_expression<uint8_t> const  i20 = bv::num((uint8_t)20);
+
+    {
+        std::vector< std::vector<bv::expression> >  slices;
+        bv::split_to_independent_conjuncts({a < i10, c < i10, i10 < i20, b == a + i10, d == c},slices);
+        TEST_SUCCESS(slices.size() == 3ULL);
+        TEST_SUCCESS(slices.at(0ULL) == std::vector<bv::expression>({a < i10, b == a + i10}));
+        TEST_SUCCESS(slices.at(1ULL) == std::vector<bv::expression>({c < i10, d == c}));
+        TEST_SUCCESS(slices.at(2ULL) == std::vector<bv::expression>({i10 < i20}));
+
+        slices.clear();
+        bv::split_to_independent_conjuncts({a < b, c < d, b < c},slices);
+        TEST_SUCCESS(slices.size() == 1ULL && slices.front().size() == 3ULL);
+    }
+
+    bv::expression const  ab = a < i10 && b == a + i10;
+    bv::expression const  cd = c < i10 && d == c;
+
+    bv::sat_query_cache  cache;
+    num_solver_calls = 0ULL;
+
+    std::pair<bv::sat_result,bv::sat_model>  result = cache.get_model_if_satisfiable_by_slices(ab && cd,&brute_force_solver);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 2ULL);
+    TEST_SUCCESS(result.second.size() == 4ULL && is_model_of(result.second,ab && cd));
+
+    // Only the slice of the new conjunct is solved.
+    result = cache.get_model_if_satisfiable_by_slices(ab && cd && i5 < d,&brute_force_solver);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 3ULL);
+    TEST_SUCCESS(result.second.size() == 4ULL && is_model_of(result.second,ab && cd && i5 < d));
+
+    TEST_SUCCESS(cache.is_satisfiable_by_slices(ab && cd && i5 < d && a == i20,&brute_force_satisfiability_solver) == bv::sat_result::NO);
+    TEST_SUCCESS(num_solver_calls == 4ULL);
+    TEST_SUCCESS(cache.is_satisfiable_by_slices(cd && a == i20 && ab,&unreachable_solver) == bv::sat_result::NO);
+
+    TEST_SUCCESS(cache.num_sliced_queries() == 4ULL && cache.num_slices() == 8ULL);
+    TEST_SUCCESS(cache.num_misses() == 4ULL);
+
+    // Missing slices solved in parallel.
+    bv::sat_query_cache  parallel_cache;
+    num_solver_calls = 0ULL;
+    result = parallel_cache.get_model_if_satisfiable_by_slices(ab && cd && i5 < d,&brute_force_solver,true);
+    TEST_SUCCESS(result.first == bv::sat_result::YES && num_solver_calls == 2ULL);
+    TEST_SUCCESS(result.second.size() == 4ULL && is_model_of(result.second,ab && cd && i5 < d));
+
+    std::cout << "SUCCESS\n";
+}
+
+/**
+ * It records queries of a symbolic execution of a loop with branchings 'a + d < b' and 'b < d + d'
+ * (for d = 0,1,...) into a log. Then it replays the log with and without the cache.
+ */
+static void test_query_log_benchmark()
+{
+    std::cout << "Starting: test_query_log_benchmark()\n";
+
+    std::string const  log_pathname = "./caching_of_queries_log.txt";
+    std::remove(log_pathname.c_str());
+
+    bv::typed_expression<uint8_t> const  a = bv::var<uint8_t>("a");
+    bv::typed_expression<uint8_t> const  b = bv::var<uint8_t>("b");
+
+    uint64_t const  depth = 6ULL;
+    {
+        bv::sat_query_cache  recorder;
+        recorder.record_queries(log_pathname);
+        std::vector< std::vector<bv::expression> >  paths{ {} };
+        for (uint64_t  d = 0ULL; d < depth; ++d)
+        {
+            bv::typed_expression<uint8_t> const  n = bv::num((uint8_t)(10ULL * d));
+            bv::expression const  condition = d % 2ULL == 0ULL ? a + n < b : b < n + n;
+            std::vector< std::vector<bv::expression> >  next_paths;
+            for (auto const&  path : paths)
+                for (bv::expression const&  branch : { condition, !condition })
+                {
+                    std::vector<bv::expression>  next_path = path;
+                    next_path.push_back(branch);
+                    if (recorder.is_satisfiable(bv::to_conjunction(next_path),&brute_force_satisfiability_solver) == bv::sat_result::YES)
+                        next_paths.push_back(next_path);
+                }
+            paths.swap(next_paths);
+        }
+    }
+
+    std::vector<bv::expression>  queries;
+    TEST_SUCCESS(bv::load_query_log(log_pathname,queries));
+    TEST_SUCCESS(queries.size() > 2ULL * depth);
+
+    std::vector<bv::sat_result>  results;
+    num_solver_calls = 0ULL;
+    double const  time_without_cache = measure_milliseconds([&queries,&results]() {
+        for (auto const&  e : queries)
+            results.push_back(brute_force_solver(e).first);
+    });
+    uint64_t const  num_calls_without_cache = num_solver_calls;
+
+    bv::sat_query_cache  cache;
+    num_solver_calls = 0ULL;
+    double const  time_with_cache = measure_milliseconds([&queries,&results,&cache]() {
+        for (uint64_t  i = 0ULL; i < queries.size(); ++i)
+            TEST_SUCCESS(cache.get_model_if_satisfiable(queries.at(i),&brute_force_solver).first == results.at(i));
+    });
+    uint64_t const  num_calls_with_cache = num_solver_calls;
+
+    TEST_SUCCESS(num_calls_with_cache == cache.num_misses());
+    TEST_SUCCESS(num_calls_with_cache < num_calls_without_cache);
+
+    std::cout << "  queries: " << queries.size() << "\n"
+              << "  solver calls without cache: " << num_calls_without_cache << "\n"
+              << "  solver calls with cache: " << num_calls_with_cache << "\n"
+              << "  hits (exact/unsat subset/sat superset/model): " << cache.num_hits() << " ("
+                    << cache.num_exact_hits() << "/" << cache.num_unsat_subset_hits() << "/"
+                    << cache.num_sat_superset_hits() << "/" << cache.num_model_hits() << ")\n"
+              << "  time without cache [ms]: " << time_without_cache << "\n"
+              << "  time with cache [ms]: " << time_with_cache << "\n"
+              ;
+
+    std::remove(log_pathname.c_str());
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("caching_of_queries_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_evaluate();
+        test_subsumption();
+        test_persistent_cache();
+        test_slicing();
+        test_query_log_benchmark();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
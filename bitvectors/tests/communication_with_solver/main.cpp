@@ -164,6 +164,50 @@ static void test_nonlinear_terms()
     std::cout << "SUCCESS\n";
 }
 
+static void test_engine_statistics()
+{
+    std::cout << "Starting: test_engine_statistics()\n";
+
+    bv::typed_expression<int> const  v0 = bv::var<int>("v0");
+    bv::typed_expression<int> const  v1 = bv::var<int>("v1");
+    bv::typed_expression<float> const  f0 = bv::var<float>("f0");
+    bv::typed_expression<int> const  i10 = bv::num(10);
+    bv::typed_expression<float> const  pi = bv::num(3.1415f);
+
+    TEST_SUCCESS(bv::formula_shape(v0 == i10 && v1 < v0 + i10) == 0U);
+    TEST_SUCCESS(bv::formula_shape(v0 * v1 == i10) == bv::formula_shape_nonlinear);
+    TEST_SUCCESS(bv::formula_shape(f0 + pi == pi) == bv::formula_shape_outside_QF_UFBV);
+    TEST_SUCCESS(bv::formula_shape(bv::ufun<int>("g",{v0}) == i10) == bv::formula_shape_functions);
+
+    bv::clear_sat_engine_statistics();
+    uint64_t const  num_queries = 10ULL;
+    uint64_t  num_answers = 0ULL;
+    for (uint64_t  i = 0ULL; i < num_queries; ++i)
+        if (bv::is_satisfiable(v0 == i10,500U,bv::all_sat_engines()) != bv::sat_result::FAIL)
+            ++num_answers;
+
+    uint64_t  num_wins = 0ULL;
+    bv::sat_engine  best = bv::sat_engine::Z3;
+    for (auto engine : bv::all_sat_engines())
+    {
+        bv::sat_engine_statistics const  stats = bv::get_sat_engine_statistics(engine,0U);
+        TEST_SUCCESS(stats.num_launches == num_queries);
+        num_wins += stats.num_wins;
+        if (stats.num_wins > bv::get_sat_engine_statistics(best,0U).num_wins)
+            best = engine;
+        std::cout << "  " << bv::to_string(engine) << ": launches " << stats.num_launches << ", wins " << stats.num_wins << "\n";
+    }
+    TEST_SUCCESS(num_wins == num_answers);
+    TEST_SUCCESS(bv::get_sat_engine_statistics(bv::sat_engine::Z3,bv::formula_shape_nonlinear).num_launches == 0ULL);
+
+    std::set<bv::sat_engine> const  selected = bv::select_sat_engines(v1 == i10,bv::all_sat_engines());
+    TEST_SUCCESS(selected.count(best) != 0ULL);
+    TEST_SUCCESS(num_wins != 0ULL || selected == bv::all_sat_engines());
+    TEST_SUCCESS(bv::select_sat_engines(v0 * v1 == i10,bv::all_sat_engines()) == bv::all_sat_engines());
+
+    std::cout << "SUCCESS\n";
+}
+
 static void save_crash_report(std::string const& crash_message)
 {
     std::cout << "ERROR: " << crash_message << "\n";
@@ -177,6 +221,7 @@ int main(int argc, char* argv[])
     (void)argv;
     try
     {
+        test_engine_statistics();
         test_is_satisfiable();
         test_get_model_if_satisfiable();
         test_nonlinear_terms();
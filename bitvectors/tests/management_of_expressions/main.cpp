@@ -209,6 +209,72 @@ static void test_expression_construction()
     std::cout << "SUCCESS\n";
 }
 
+static void test_hash_consing()
+{
+    std::cout << "Starting: test_hash_consing()\n";
+
+    bv::expression const  e0 = bv::num<uint8_t>(10) + bv::var<uint8_t>("x");
+    bv::expression const  e1 = bv::num<uint8_t>(10) + bv::var<uint8_t>("x");
+    TEST_SUCCESS(e0.operator ->() == e1.operator ->());
+    TEST_SUCCESS(e0 == e1);
+    TEST_SUCCESS(bv::expression::hash()(e0) == bv::expression::hash()(e1));
+
+    bv::expression const  e2 = bv::var<uint8_t>("x") + bv::num<uint8_t>(10);
+    TEST_SUCCESS(e2 != e0);
+    TEST_SUCCESS(bv::argument(e2,0ULL) == bv::argument(e0,1ULL));
+    TEST_SUCCESS(bv::argument(e2,1ULL).operator ->() == bv::argument(e0,0ULL).operator ->());
+
+    // A released expression can be created again.
+    std::size_t  hash;
+    {
+        bv::expression const  e3 = bv::var<uint16_t>("only_here") * bv::num<uint16_t>(3);
+        hash = bv::expression::hash()(e3);
+    }
+    bv::expression const  e4 = bv::var<uint16_t>("only_here") * bv::num<uint16_t>(3);
+    TEST_SUCCESS(bv::symbol_name(e4) == "*i16");
+    TEST_SUCCESS(bv::expression::hash()(e4) == hash);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_hash_consing_performance()
+{
+    std::cout << "Starting: test_hash_consing_performance()\n";
+
+    // The tree of each expression has 2^num_levels leaves, but the DAG has only num_levels + 1 nodes.
+    uint64_t const  num_levels = 64ULL;
+    auto const  build = [num_levels]() {
+        bv::typed_expression<uint8_t>  e = bv::var<uint8_t>("byte_of_input");
+        for (uint64_t  i = 0ULL; i < num_levels; ++i)
+            e = e + e;
+        return bv::expression(e);
+    };
+
+    bv::expression  e0;
+    bv::expression  e1;
+    double const  build_time = measure_milliseconds([&e0,&e1,&build]() { e0 = build(); e1 = build(); });
+
+    bool  are_equal = false;
+    std::size_t  hash0 = 0ULL;
+    std::size_t  hash1 = 1ULL;
+    double const  compare_time = measure_milliseconds([&]() {
+        for (uint64_t  i = 0ULL; i < 1000000ULL; ++i)
+        {
+            are_equal = e0 == e1;
+            hash0 = bv::expression::hash()(e0);
+            hash1 = bv::expression::hash()(e1);
+        }
+    });
+    TEST_SUCCESS(are_equal && hash0 == hash1);
+
+    std::cout << "  levels of sharing: " << num_levels << "\n"
+              << "  time of two constructions [ms]: " << build_time << "\n"
+              << "  time of 10^6 comparisons and hashings [ms]: " << compare_time << "\n"
+              ;
+
+    std::cout << "SUCCESS\n";
+}
+
 static void save_crash_report(std::string const& crash_message)
 {
     std::cout << "ERROR: " << crash_message << "\n";
@@ -223,6 +289,8 @@ int main(int argc, char* argv[])
     try
     {
         test_expression_construction();
+        test_hash_consing();
+        test_hash_consing_performance();
     }
     catch(std::exception const& e)
     {
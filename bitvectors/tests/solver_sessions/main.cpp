@@ -0,0 +1,206 @@
+#include <rebours/bitvectors/test.hpp>
+#include <rebours/bitvectors/expression.hpp>
+#include <rebours/bitvectors/sat_checking.hpp>
+#include <string>
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+#define XSTR(s) STR(s)
+#define STR(s) #s
+
+
+static std::string const  log_file = "./solver_sessions_log.txt";
+
+/**
+ * It starts a session with the stand-in solver and it clears the log of commands received by the solver.
+ */
+static std::string  stand_in_solver_command()
+{
+    std::remove(log_file.c_str());
+    return std::string("sh ") + XSTR(STAND_IN_SOLVER_PATH) + " " + log_file;
+}
+
+static uint64_t  count_in_log(std::string const&  text)
+{
+    std::ifstream  istr(log_file);
+    uint64_t  count = 0ULL;
+    std::string  line;
+    while (std::getline(istr,line))
+        for (std::string::size_type  pos = line.find(text); pos != std::string::npos; pos = line.find(text,pos + 1ULL))
+            ++count;
+    return count;
+}
+
+
+static void test_shared_declarations()
+{
+    std::cout << "Starting: test_shared_declarations()\n";
+
+    bv::typed_expression<int> const  v0 = bv::var<int>("v0");
+    bv::typed_expression<int> const  v1 = bv::var<int>("v1");
+    bv::typed_expression<int> const  i10 = bv::num(10);
+    bv::typed_expression<int> const  i5 = bv::num(5);
+
+    bv::solver_session  session(stand_in_solver_command());
+
+    TEST_SUCCESS(session.is_satisfiable(v0 == i10 && v1 == v0 + i5,500U) == bv::sat_result::YES);
+    TEST_SUCCESS(session.num_declarations() == 2ULL && session.num_literals() == 2ULL);
+
+    TEST_SUCCESS(session.is_satisfiable(v0 == i10 && v1 == v0 + i10,500U) == bv::sat_result::YES);
+    TEST_SUCCESS(session.num_declarations() == 2ULL && session.num_literals() == 3ULL);
+
+    TEST_SUCCESS(session.is_satisfiable(v1 == v0 + i10 && v0 == i10,500U) == bv::sat_result::YES);
+    TEST_SUCCESS(session.num_declarations() == 2ULL && session.num_literals() == 3ULL);
+
+    TEST_SUCCESS(session.num_queries() == 3ULL && session.num_started_processes() == 1ULL);
+    TEST_SUCCESS(count_in_log("(declare-fun v0 ") == 1ULL && count_in_log("(declare-fun v1 ") == 1ULL);
+    TEST_SUCCESS(count_in_log("(check-sat-assuming ") == 3ULL);
+    TEST_SUCCESS(count_in_log("(set-logic ") == 1ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_scopes()
+{
+    std::cout << "Starting: test_scopes()\n";
+
+    bv::typed_expression<int> const  v0 = bv::var<int>("v0");
+    bv::typed_expression<int> const  v2 = bv::var<int>("v2");
+    bv::typed_expression<int> const  i10 = bv::num(10);
+
+    bv::solver_session  session(stand_in_solver_command());
+
+    session.assert_formula(v0 == i10);
+    TEST_SUCCESS(session.check_sat_assuming({},500U) == bv::sat_result::YES);
+
+    session.push();
+    session.assert_formula(bv::ff());
+    TEST_SUCCESS(session.check_sat_assuming({v0 == i10},500U) == bv::sat_result::NO);
+    session.pop();
+    TEST_SUCCESS(session.check_sat_assuming({v0 == i10},500U) == bv::sat_result::YES);
+    TEST_SUCCESS(session.num_literals() == 2ULL);
+
+    session.push();
+    TEST_SUCCESS(session.check_sat_assuming({v2 == i10, bv::ff()},500U) == bv::sat_result::NO);
+    TEST_SUCCESS(session.num_declarations() == 2ULL && session.num_literals() == 4ULL);
+    session.pop();
+    TEST_SUCCESS(session.num_scopes() == 0ULL);
+
+    // The declaration of 'v2' and the literals were forgotten by the 'pop'.
+    TEST_SUCCESS(session.check_sat_assuming({v2 == i10},500U) == bv::sat_result::YES);
+    TEST_SUCCESS(session.num_declarations() == 3ULL && session.num_literals() == 5ULL);
+    TEST_SUCCESS(count_in_log("(declare-fun v2 ") == 2ULL);
+    TEST_SUCCESS(count_in_log("(pop 1)") == 2ULL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_get_model_if_satisfiable()
+{
+    std::cout << "Starting: test_get_model_if_satisfiable()\n";
+
+    bv::typed_expression<uint32_t> const  v0 = bv::var<uint32_t>("v0");
+    bv::typed_expression<uint32_t> const  v1 = bv::var<uint32_t>("v1");
+
+    bv::solver_session  session(stand_in_solver_command());
+
+    std::pair<bv::sat_result,bv::sat_model> const  result = session.get_model_if_satisfiable(v0 == v1 && v1 == bv::num(42U),500U);
+    TEST_SUCCESS(result.first == bv::sat_result::YES);
+    TEST_SUCCESS(result.second.size() == 2ULL);
+    TEST_SUCCESS(result.second.at(bv::get_symbol(v0)).num_cases() == 1ULL);
+    TEST_SUCCESS(result.second.at(bv::get_symbol(v0)).args_of_case(0ULL).empty());
+    TEST_SUCCESS(result.second.at(bv::get_symbol(v0)).value_of_case(0ULL) == bv::num(42U));
+    TEST_SUCCESS(result.second.at(bv::get_symbol(v1)).value_of_case(0ULL) == bv::num(42U));
+
+    TEST_SUCCESS(session.get_model_if_satisfiable(v0 == v1 && bv::ff(),500U).first == bv::sat_result::NO);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_interruption()
+{
+    std::cout << "Starting: test_interruption()\n";
+
+    bv::typed_expression<int> const  v0 = bv::var<int>("v0");
+    bv::typed_expression<int> const  sleepy = bv::var<int>("sleepy");
+    bv::typed_expression<int> const  i10 = bv::num(10);
+
+    bv::solver_session  session(stand_in_solver_command());
+
+    session.push();
+    session.assert_formula(v0 == i10);
+    double const  time = measure_milliseconds([&session,&sleepy,&i10]() {
+        TEST_SUCCESS(session.check_sat_assuming({sleepy == i10},200U) == bv::sat_result::FAIL);
+    });
+    TEST_SUCCESS(time < 2000.0);
+
+    // A new solver process receives all commands in effect.
+    TEST_SUCCESS(session.check_sat_assuming({v0 == i10},500U) == bv::sat_result::YES);
+    TEST_SUCCESS(session.num_started_processes() == 2ULL);
+    TEST_SUCCESS(count_in_log("(declare-fun v0 ") == 2ULL && count_in_log("(push 1)") == 2ULL);
+    session.pop();
+    TEST_SUCCESS(session.check_sat_assuming({v0 == i10},500U) == bv::sat_result::YES);
+    TEST_SUCCESS(session.num_started_processes() == 2ULL);
+
+    bv::solver_session  missing("./bitvectors_missing_solver");
+    TEST_SUCCESS(missing.check_sat_assuming({v0 == i10},500U) == bv::sat_result::FAIL);
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_session_performance()
+{
+    std::cout << "Starting: test_session_performance()\n";
+
+    uint64_t const  num_queries = 200ULL;
+    bv::typed_expression<int> const  v0 = bv::var<int>("v0");
+    bv::typed_expression<int> const  v1 = bv::var<int>("v1");
+
+    bv::solver_session  session(stand_in_solver_command());
+    double const  time = measure_milliseconds([&session,&v0,&v1,num_queries]() {
+        for (uint64_t  i = 0ULL; i < num_queries; ++i)
+            TEST_SUCCESS(session.is_satisfiable(v0 < v1 && v1 == bv::num((int)(i % 10ULL)),500U) == bv::sat_result::YES);
+    });
+    TEST_SUCCESS(session.num_started_processes() == 1ULL && session.num_literals() == 11ULL);
+
+    std::cout << "  queries: " << num_queries << "\n"
+              << "  time per query [ms]: " << time / (double)num_queries << "\n"
+              ;
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("solver_sessions_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_shared_declarations();
+        test_scopes();
+        test_get_model_if_satisfiable();
+        test_interruption();
+        test_session_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#!/bin/sh
+#
+# A stand-in for an SMT solver reading incremental SMT-LIB2 commands (one per line) from the standard input. All
+# received commands are appended to the file passed as the first argument. The answers are:
+#   - 'unsat' when an asserted formula, or a formula implied by an assumed literal, contains '(= #b0 #b1)' (i.e. 'ff'),
+#   - 'sat' otherwise, but only after 5 seconds, when an assumed formula contains the symbol 'sleepy',
+#   - 42 as the value of each symbol in 'get-value',
+#   - 'success' for all other commands.
+#
+
+log_file="$1"
+depth=0
+false_at_0=""
+slow_literals=""
+
+while IFS= read -r line
+do
+    echo "$line" >> "$log_file"
+    case "$line" in
+        "(push 1)")
+            depth=$((depth + 1))
+            eval "false_at_$depth=\"\""
+            echo success
+            ;;
+        "(pop 1)")
+            eval "false_at_$depth=\"\""
+            depth=$((depth - 1))
+            echo success
+            ;;
+        "(assert (=> "*)
+            set -- $line
+            case "$line" in *"(= #b0 #b1)"*) eval "false_at_$depth=\"\$false_at_$depth $3 \"" ;; esac
+            case "$line" in *sleepy*) slow_literals="$slow_literals $3 " ;; esac
+            echo success
+            ;;
+        "(assert "*)
+            case "$line" in *"(= #b0 #b1)"*) eval "false_at_$depth=\"\$false_at_$depth * \"" ;; esac
+            echo success
+            ;;
+        "(check-sat"*)
+            set -- $(echo "$line" | tr -d '()')
+            shift
+            answer=sat
+            for literal in '*' "$@"
+            do
+                d=0
+                while [ $d -le $depth ]
+                do
+                    eval "false_literals=\"\$false_at_$d\""
+                    case "$false_literals" in *" $literal "*) answer=unsat ;; esac
+                    d=$((d + 1))
+                done
+                case "$slow_literals" in *" $literal "*) sleep 5 ;; esac
+            done
+            echo $answer
+            ;;
+        "(get-value"*)
+            set -- $(echo "$line" | tr -d '()')
+            shift
+            values=""
+            for name in "$@"
+            do
+                values="$values ($name #x0000002a)"
+            done
+            echo "($values)"
+            ;;
+        "(exit)")
+            echo success
+            exit 0
+            ;;
+        *)
+            echo success
+            ;;
+    esac
+done
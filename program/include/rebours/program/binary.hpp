@@ -0,0 +1,47 @@
+#ifndef REBOURS_PROGRAM_MICROCODE_BINARY_HPP_INCLUDED
+#   define REBOURS_PROGRAM_MICROCODE_BINARY_HPP_INCLUDED
+
+#   include <rebours/program/program.hpp>
+#   include <rebours/program/assembly.hpp>
+#   include <vector>
+#   include <string>
+#   include <utility>
+#   include <memory>
+#   include <iosfwd>
+#   include <cstdint>
+
+namespace microcode {
+
+
+/**
+ * Primitives of binary files. Numbers are stored as ULEB128 (so small numbers and IDs take only a byte or two),
+ * byte vectors and strings are prefixed by their size. All read functions return false when the input ends
+ * prematurely or it is malformed.
+ */
+void  write_varint(std::ostream&  ostr, uint64_t  value);
+bool  read_varint(std::istream&  istr, uint64_t&  value);
+
+void  write_bytes(std::ostream&  ostr, std::vector<uint8_t> const&  bytes);
+bool  read_bytes(std::istream&  istr, std::vector<uint8_t>&  bytes);
+
+void  write_string(std::ostream&  ostr, std::string const&  text);
+bool  read_string(std::istream&  istr, std::string&  text);
+
+
+/**
+ * It stores the program (and its annotations, if passed) into a compact binary format. Each distinct instruction of
+ * the program is stored only once, in a dictionary at the beginning, and edges refer to its entries. The loaded
+ * program has the same IDs of nodes and the same order of successors of each node as the saved one.
+ */
+std::ostream&  save_program_as_binary(std::ostream&  output_stream, program const&  P, annotations const* const A);
+
+/**
+ * It loads a program saved by 'save_program_as_binary'. IDs of nodes of the loaded program are never generated
+ * again by 'generate_next_fresh_node_id'. On failure it returns null pointers and sets 'error_message'.
+ */
+std::pair<std::unique_ptr<program>,std::unique_ptr<annotations> >  create_program_from_binary(std::istream&  input_stream, std::string&  error_message);
+
+
+}
+
+#endif
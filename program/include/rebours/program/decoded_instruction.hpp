@@ -0,0 +1,53 @@
+#ifndef REBOURS_PROGRAM_MICROCODE_DECODED_INSTRUCTION_HPP_INCLUDED
+#   define REBOURS_PROGRAM_MICROCODE_DECODED_INSTRUCTION_HPP_INCLUDED
+
+#   include <rebours/program/instruction.hpp>
+#   include <rebours/program/large_types.hpp>
+#   include <rebours/program/assumptions.hpp>
+#   include <array>
+#   include <cstdint>
+
+namespace microcode {
+
+
+/**
+ * A Microcode instruction together with its arguments already decoded into a fixed structure. An instruction is
+ * decoded only once, when it is inserted to an edge of a program component, and the decoded form is kept on the edge.
+ * So, an interpreter does not have to parse separators of arguments and copy their bytes whenever it executes the edge.
+ *
+ * Arguments of at most 8 bytes are stored (zero-extended) in the array 'args'. A 16 bytes argument is stored
+ * in 'wide_arg' (and its item in 'args' is 0). The data block of 'DATATRANSFER__DEREF_*_ASGN_DATA' instructions
+ * is not copied; it is referenced by 'data_begin' and 'data_size' (instructions are never destroyed).
+ */
+struct decoded_instruction
+{
+    static uint64_t const  max_num_args = 4ULL;
+
+    decoded_instruction();
+    decoded_instruction(microcode::instruction const  I);
+
+    microcode::instruction const&  instruction() const noexcept { return m_instruction; }
+
+    microcode::GIK  GIK() const noexcept { return m_GIK; }
+    uint64_t  num_arguments() const noexcept { return m_num_arguments; }
+
+    uint64_t  arg(uint64_t const  argument_index) const { ASSUMPTION(argument_index < max_num_args); return m_args[argument_index]; }
+    uint128_t const&  wide_arg() const noexcept { return m_wide_arg; }
+
+    uint8_t const*  data_begin() const noexcept { return m_data_begin; }
+    uint64_t  data_size() const noexcept { return m_data_size; }
+
+private:
+    std::array<uint64_t,max_num_args>  m_args;
+    microcode::GIK  m_GIK;
+    uint64_t  m_num_arguments;
+    uint8_t const*  m_data_begin;
+    uint64_t  m_data_size;
+    uint128_t  m_wide_arg;
+    microcode::instruction  m_instruction;
+};
+
+
+}
+
+#endif
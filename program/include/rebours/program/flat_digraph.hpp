@@ -0,0 +1,443 @@
+#ifndef FLAT_DIGRAPH_HPP_INCLUDED
+#   define FLAT_DIGRAPH_HPP_INCLUDED
+
+#   include <rebours/program/digraph.hpp>
+#   include <rebours/program/assumptions.hpp>
+#   include <rebours/program/invariants.hpp>
+#   include <vector>
+#   include <memory>
+#   include <algorithm>
+#   include <iterator>
+#   include <utility>
+#   include <cstddef>
+#   include <cstdint>
+
+
+namespace detail {
+
+
+/**
+ * An open-addressing hash table (linear probing, power-of-two capacity) mapping node IDs to indices of slots.
+ * A lookup is typically a single probe into a contiguous array. The key 0 marks an empty cell.
+ */
+struct  flat_digraph_index
+{
+    flat_digraph_index() : m_cells(16ULL,cell{0ULL,0ULL}), m_size(0ULL) {}
+
+    uint64_t  size() const noexcept { return m_size; }
+
+    uint64_t const*  find(uint64_t const  key) const
+    {
+        uint64_t const  mask = m_cells.size() - 1ULL;
+        for (uint64_t  i = hash(key) & mask; ; i = (i + 1ULL) & mask)
+        {
+            cell const&  c = m_cells[i];
+            if (c.key == key)
+                return &c.value;
+            if (c.key == 0ULL)
+                return nullptr;
+        }
+    }
+
+    bool  insert(uint64_t const  key, uint64_t const  value)
+    {
+        ASSUMPTION(key != 0ULL);
+        if (2ULL * (m_size + 1ULL) > m_cells.size())
+            rehash(2ULL * m_cells.size());
+        uint64_t const  mask = m_cells.size() - 1ULL;
+        for (uint64_t  i = hash(key) & mask; ; i = (i + 1ULL) & mask)
+        {
+            cell&  c = m_cells[i];
+            if (c.key == key)
+                return false;
+            if (c.key == 0ULL)
+            {
+                c = cell{key,value};
+                ++m_size;
+                return true;
+            }
+        }
+    }
+
+    void  erase(uint64_t const  key)
+    {
+        uint64_t const  mask = m_cells.size() - 1ULL;
+        uint64_t  i = hash(key) & mask;
+        while (m_cells[i].key != key)
+        {
+            if (m_cells[i].key == 0ULL)
+                return;
+            i = (i + 1ULL) & mask;
+        }
+        // Backward shift deletion: cells following the erased one, which would become unreachable, are moved back.
+        for (uint64_t  j = (i + 1ULL) & mask; m_cells[j].key != 0ULL; j = (j + 1ULL) & mask)
+        {
+            uint64_t const  k = hash(m_cells[j].key) & mask;
+            if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+                continue;
+            m_cells[i] = m_cells[j];
+            i = j;
+        }
+        m_cells[i] = cell{0ULL,0ULL};
+        --m_size;
+    }
+
+private:
+    struct  cell
+    {
+        uint64_t  key;
+        uint64_t  value;
+    };
+
+    static uint64_t  hash(uint64_t const  key) noexcept
+    {
+        uint64_t const  h = key * 0x9e3779b97f4a7c15ULL;
+        return h ^ (h >> 32U);
+    }
+
+    void  rehash(uint64_t const  capacity)
+    {
+        std::vector<cell>  old(capacity,cell{0ULL,0ULL});
+        old.swap(m_cells);
+        m_size = 0ULL;
+        for (cell const&  c : old)
+            if (c.key != 0ULL)
+                insert(c.key,c.value);
+    }
+
+    std::vector<cell>  m_cells;
+    uint64_t  m_size;
+};
+
+
+}
+
+
+/**
+ * A directed graph with data on edges. It provides the same interface as 'digraph<void,edge_data_type__>',
+ * but nodes are stored in a dense array of slots (allocated in chunks). Each slot holds the successors of the node together with
+ * the data of the corresponding out-going edges (stored inline, at the same indices), and the predecessors.
+ * So, once the slot of a node is found, all its out-going edges are accessible without any further lookup.
+ *
+ * A slot never moves in memory, even when new nodes are inserted. Slots of erased nodes are reused.
+ * References to successors, predecessors, and edge data of a node therefore stay valid until the node (or the edge)
+ * is erased, or a new out-going (for successors and data) or in-going (for predecessors) edge of the node is inserted.
+ *
+ * The ID 0 is reserved (it marks an unused slot) and so it cannot be used for a node.
+ */
+template<typename edge_data_type__>
+struct flat_digraph
+{
+    using  node_id = uint64_t;
+    using  node_index = uint64_t;
+    using  node_id_hasher_type = detail::digraph_hash_func<node_id>;
+    using  nodes_container_value_type = node_id;
+
+    using  edge_id = std::pair<node_id,node_id>;
+    using  edge_data_type = edge_data_type__;
+    using  edge_id_hasher_type = detail::digraph_hash_func<edge_id>;
+    using  edges_container_value_type = std::pair<edge_id,edge_data_type>;
+
+    /**
+     * A light-weight read-only view of the set of nodes.
+     */
+    struct  nodes_container_type
+    {
+        struct  const_iterator
+        {
+            using  iterator_category = std::forward_iterator_tag;
+            using  value_type = node_id;
+            using  difference_type = std::ptrdiff_t;
+            using  pointer = node_id const*;
+            using  reference = node_id const&;
+
+            const_iterator(flat_digraph const* const  graph, node_index const  index) : m_graph(graph), m_index(index) { skip_free_slots(); }
+
+            reference  operator*() const { return m_graph->slot(m_index).id; }
+            pointer  operator->() const { return &m_graph->slot(m_index).id; }
+            const_iterator&  operator++() { ++m_index; skip_free_slots(); return *this; }
+            const_iterator  operator++(int) { const_iterator const  old = *this; ++*this; return old; }
+            bool  operator==(const_iterator const&  other) const { return m_index == other.m_index; }
+            bool  operator!=(const_iterator const&  other) const { return m_index != other.m_index; }
+
+        private:
+            void  skip_free_slots() { while (m_index < m_graph->m_num_slots && m_graph->slot(m_index).id == 0ULL) ++m_index; }
+
+            flat_digraph const*  m_graph;
+            node_index  m_index;
+        };
+        using  iterator = const_iterator;
+
+        explicit nodes_container_type(flat_digraph const* const  graph) : m_graph(graph) {}
+
+        const_iterator  begin() const { return const_iterator(m_graph,0ULL); }
+        const_iterator  end() const { return const_iterator(m_graph,m_graph->m_num_slots); }
+        const_iterator  cbegin() const { return begin(); }
+        const_iterator  cend() const { return end(); }
+
+        uint64_t  size() const noexcept { return m_graph->m_index.size(); }
+        bool  empty() const noexcept { return size() == 0ULL; }
+        uint64_t  count(node_id const  n) const { return m_graph->m_index.find(n) == nullptr ? 0ULL : 1ULL; }
+
+    private:
+        flat_digraph const*  m_graph;
+    };
+
+    /**
+     * A light-weight read-only view of the set of edges. Its iterators produce pairs (edge_id,edge_data) by value.
+     */
+    struct  edges_container_type
+    {
+        struct  const_iterator
+        {
+            using  iterator_category = std::forward_iterator_tag;
+            using  value_type = edges_container_value_type;
+            using  difference_type = std::ptrdiff_t;
+            using  pointer = void;
+            using  reference = value_type;
+
+            const_iterator(flat_digraph const* const  graph, node_index const  index) : m_graph(graph), m_index(index), m_succ(0ULL) { skip_empty(); }
+
+            value_type  operator*() const
+            {
+                auto const&  slot = m_graph->slot(m_index);
+                return { {slot.id,slot.successors[m_succ]}, slot.successors_data[m_succ] };
+            }
+            const_iterator&  operator++() { ++m_succ; skip_empty(); return *this; }
+            const_iterator  operator++(int) { const_iterator const  old = *this; ++*this; return old; }
+            bool  operator==(const_iterator const&  other) const { return m_index == other.m_index && m_succ == other.m_succ; }
+            bool  operator!=(const_iterator const&  other) const { return !(*this == other); }
+
+        private:
+            void  skip_empty()
+            {
+                while (m_index < m_graph->m_num_slots && m_succ >= m_graph->slot(m_index).successors.size())
+                {
+                    ++m_index;
+                    m_succ = 0ULL;
+                }
+            }
+
+            flat_digraph const*  m_graph;
+            node_index  m_index;
+            uint64_t  m_succ;
+        };
+        using  iterator = const_iterator;
+
+        explicit edges_container_type(flat_digraph const* const  graph) : m_graph(graph) {}
+
+        const_iterator  begin() const { return const_iterator(m_graph,0ULL); }
+        const_iterator  end() const { return const_iterator(m_graph,m_graph->m_num_slots); }
+        const_iterator  cbegin() const { return begin(); }
+        const_iterator  cend() const { return end(); }
+
+        uint64_t  size() const noexcept { return m_graph->m_num_edges; }
+        bool  empty() const noexcept { return size() == 0ULL; }
+        uint64_t  count(edge_id const&  e) const { return m_graph->find_successor(e) < 0 ? 0ULL : 1ULL; }
+
+    private:
+        flat_digraph const*  m_graph;
+    };
+
+    flat_digraph() : m_chunks(), m_num_slots(0ULL), m_free_slots(), m_index(), m_num_edges(0ULL) {}
+    flat_digraph(flat_digraph&&) = default;
+
+    nodes_container_type  nodes() const noexcept { return nodes_container_type(this); }
+    edges_container_type  edges() const noexcept { return edges_container_type(this); }
+
+    node_index  index_of(node_id const  n) const;
+
+    std::vector<node_id> const&  successors(node_id const  n) const { return slot(index_of(n)).successors; }
+    std::vector<node_id> const&  predecessors(node_id const  n) const { return slot(index_of(n)).predecessors; }
+
+    /**
+     * Returns data of edges going out of the node 'n'. The k-th element belongs to the edge (n,successors(n).at(k)).
+     */
+    std::vector<edge_data_type> const&  successors_data(node_id const  n) const { return slot(index_of(n)).successors_data; }
+
+    edge_data_type const&  data(edge_id const  e) const;
+    edge_data_type&  data(edge_id const  e);
+
+    void  insert_nodes(std::vector<nodes_container_value_type> const&  nodes) { insert_nodes(nodes.cbegin(),nodes.cend()); }
+    template<typename iterator_type__>
+    void  insert_nodes(iterator_type__  begin, iterator_type__ const  end);
+    void  erase_nodes(std::vector<node_id> const&  nodes);
+
+    void  insert_edges(std::vector<edges_container_value_type> const&  edges) { insert_edges(edges.cbegin(),edges.cend()); }
+    template<typename iterator_type__>
+    void  insert_edges(iterator_type__  begin, iterator_type__ const  end);
+    void  erase_edges(std::vector<edge_id> const&  edges);
+
+private:
+    flat_digraph(flat_digraph const& ) = delete;
+    flat_digraph& operator=(flat_digraph const& ) = delete;
+
+    struct  node_slot
+    {
+        node_slot() : id(0ULL), successors(), successors_data(), predecessors() {}
+
+        node_id  id;    //!< The value 0 marks an unused slot.
+        std::vector<node_id>  successors;
+        std::vector<edge_data_type>  successors_data;
+        std::vector<node_id>  predecessors;
+    };
+
+    static uint64_t const  chunk_size = 64ULL;
+
+    node_slot const&  slot(node_index const  index) const { return m_chunks[index / chunk_size][index % chunk_size]; }
+    node_slot&  slot(node_index const  index) { return m_chunks[index / chunk_size][index % chunk_size]; }
+
+    int64_t  find_successor(edge_id const&  e) const;
+
+    std::vector< std::unique_ptr<node_slot[]> >  m_chunks;
+    uint64_t  m_num_slots;
+    std::vector<node_index>  m_free_slots;
+    detail::flat_digraph_index  m_index;
+    uint64_t  m_num_edges;
+};
+
+
+template<typename edge_data_type__>
+typename flat_digraph<edge_data_type__>::node_index  flat_digraph<edge_data_type__>::index_of(node_id const  n) const
+{
+    node_index const* const  index = m_index.find(n);
+    ASSUMPTION(index != nullptr);
+    return *index;
+}
+
+template<typename edge_data_type__>
+int64_t  flat_digraph<edge_data_type__>::find_successor(edge_id const&  e) const
+{
+    node_index const* const  index = m_index.find(e.first);
+    if (index == nullptr)
+        return -1LL;
+    std::vector<node_id> const&  succ = slot(*index).successors;
+    auto const  sit = std::find(succ.cbegin(),succ.cend(),e.second);
+    return sit == succ.cend() ? -1LL : (int64_t)(sit - succ.cbegin());
+}
+
+template<typename edge_data_type__>
+typename flat_digraph<edge_data_type__>::edge_data_type const&  flat_digraph<edge_data_type__>::data(edge_id const  e) const
+{
+    node_slot const&  slot = this->slot(index_of(e.first));
+    auto const  it = std::find(slot.successors.cbegin(),slot.successors.cend(),e.second);
+    ASSUMPTION(it != slot.successors.cend());
+    return slot.successors_data[it - slot.successors.cbegin()];
+}
+
+template<typename edge_data_type__>
+typename flat_digraph<edge_data_type__>::edge_data_type&  flat_digraph<edge_data_type__>::data(edge_id const  e)
+{
+    node_slot&  slot = this->slot(index_of(e.first));
+    auto const  it = std::find(slot.successors.cbegin(),slot.successors.cend(),e.second);
+    ASSUMPTION(it != slot.successors.cend());
+    return slot.successors_data[it - slot.successors.cbegin()];
+}
+
+template<typename edge_data_type__>
+template<typename iterator_type__>
+void  flat_digraph<edge_data_type__>::insert_nodes(iterator_type__  begin, iterator_type__ const  end)
+{
+    for ( ; begin != end; ++begin)
+    {
+        node_id const  id = *begin;
+        ASSUMPTION(id != 0ULL);
+
+        node_index  index;
+        if (m_free_slots.empty())
+        {
+            if (m_num_slots % chunk_size == 0ULL)
+                m_chunks.push_back(std::unique_ptr<node_slot[]>(new node_slot[chunk_size]));
+            index = m_num_slots;
+            ++m_num_slots;
+        }
+        else
+        {
+            index = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+        INVARIANT(slot(index).id == 0ULL);
+        slot(index).id = id;
+
+        bool const  inserted = m_index.insert(id,index);
+        ASSUMPTION(inserted);
+        (void)inserted;
+    }
+}
+
+template<typename edge_data_type__>
+void  flat_digraph<edge_data_type__>::erase_nodes(std::vector<node_id> const&  nodes)
+{
+    for (auto const n : nodes)
+    {
+        node_index const  index = index_of(n);
+
+        std::vector<edge_id>  edges;
+        for (node_id const  m : slot(index).successors)
+            edges.push_back({n,m});
+        erase_edges(edges);
+
+        edges.clear();
+        for (node_id const  m : slot(index).predecessors)
+            edges.push_back({m,n});
+        erase_edges(edges);
+
+        node_slot&  s = slot(index);
+        s.id = 0ULL;
+        std::vector<node_id>().swap(s.successors);
+        std::vector<edge_data_type>().swap(s.successors_data);
+        std::vector<node_id>().swap(s.predecessors);
+        m_free_slots.push_back(index);
+        m_index.erase(n);
+    }
+}
+
+template<typename edge_data_type__>
+template<typename iterator_type__>
+void  flat_digraph<edge_data_type__>::insert_edges(iterator_type__  begin, iterator_type__ const  end)
+{
+    for ( ; begin != end; ++begin)
+    {
+        edges_container_value_type const  e = *begin;
+        edge_id const&  id = e.first;
+
+        {
+            node_slot&  slot = this->slot(index_of(id.first));
+            ASSUMPTION(std::find(slot.successors.cbegin(),slot.successors.cend(),id.second) == slot.successors.cend());
+            slot.successors.push_back(id.second);
+            slot.successors_data.push_back(e.second);
+        }
+        {
+            node_slot&  slot = this->slot(index_of(id.second));
+            ASSUMPTION(std::find(slot.predecessors.cbegin(),slot.predecessors.cend(),id.first) == slot.predecessors.cend());
+            slot.predecessors.push_back(id.first);
+        }
+        ++m_num_edges;
+    }
+}
+
+template<typename edge_data_type__>
+void  flat_digraph<edge_data_type__>::erase_edges(std::vector<edge_id> const&  edges)
+{
+    for (auto const& e : edges)
+    {
+        {
+            node_slot&  slot = this->slot(index_of(e.first));
+            auto const  it = std::find(slot.successors.begin(),slot.successors.end(),e.second);
+            ASSUMPTION(it != slot.successors.end());
+            slot.successors_data.erase(slot.successors_data.begin() + (it - slot.successors.begin()));
+            slot.successors.erase(it);
+        }
+        {
+            node_slot&  slot = this->slot(index_of(e.second));
+            auto const  it = std::find(slot.predecessors.begin(),slot.predecessors.end(),e.first);
+            ASSUMPTION(it != slot.predecessors.end());
+            slot.predecessors.erase(it);
+        }
+        INVARIANT(m_num_edges > 0ULL);
+        --m_num_edges;
+    }
+}
+
+
+#endif
@@ -269,6 +269,20 @@ inline bool  operator ==(instruction const  I0, instruction const  I1) noexcept
 inline bool  operator !=(instruction const  I0, instruction const  I1) noexcept { return !(I0 == I1); }
 
 
+/**
+ * Both functions give access to the representation of an interned instruction: 'separators' are offsets of arguments
+ * in 'data', and the first byte of 'data' is the GIK. They are meant for storing instructions into binary files.
+ */
+std::vector<uint8_t>  instruction_separators(instruction const  I);
+std::vector<uint8_t>  instruction_data(instruction const  I);
+
+/**
+ * It returns the instruction of the passed representation (see 'instruction_separators' and 'instruction_data'),
+ * or an empty instruction if the representation is not valid (e.g. it was read from a corrupted file).
+ */
+instruction  create_instruction_from_representation(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data);
+
+
 template<typename return_type>
 return_type  instruction::get_argument(uint64_t const  index, return_type const* const) const
 {
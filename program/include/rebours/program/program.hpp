@@ -1,8 +1,9 @@
 #ifndef REBOURS_PROGRAM_MICROCODE_PROGRAM_HPP_INCLUDED
 #   define REBOURS_PROGRAM_MICROCODE_PROGRAM_HPP_INCLUDED
 
-#   include <rebours/program/digraph.hpp>
+#   include <rebours/program/flat_digraph.hpp>
 #   include <rebours/program/instruction.hpp>
+#   include <rebours/program/decoded_instruction.hpp>
 #   include <memory>
 #   include <vector>
 #   include <cstdint>
@@ -10,25 +11,36 @@
 namespace microcode {
 
 
+struct program;
+
+
 struct program_component
 {
-    using  graph_type = digraph<void,microcode::instruction>;
+    using  graph_type = flat_digraph<microcode::decoded_instruction>;
     using  node_id = program_component::graph_type::node_id;
     using  edge_id = program_component::graph_type::edge_id;
     using  edge_id_hasher_type = program_component::graph_type::edge_id_hasher_type;
 
     program_component(std::string const&  program_name = "", std::string const&  component_name = "");
+    program_component(program_component const& ) = delete;
+    program_component& operator=(program_component const& ) = delete;
 
     node_id  entry() const noexcept { return m_entry; }
     std::unordered_set<node_id> const&  exits() const noexcept { return m_exits; }
 
-    graph_type::nodes_container_type const&  nodes() const noexcept { return graph().nodes(); }
-    graph_type::edges_container_type const&  edges() const noexcept { return graph().edges(); }
+    graph_type::nodes_container_type  nodes() const noexcept { return graph().nodes(); }
+    graph_type::edges_container_type  edges() const noexcept { return graph().edges(); }
 
     std::vector<node_id> const&  successors(node_id const  n) const { return graph().successors(n); }
     std::vector<node_id> const&  predecessors(node_id const  n) const { return graph().predecessors(n); }
 
-    microcode::instruction const&  instruction(edge_id const  e) const { return graph().data(e); }
+    microcode::instruction const&  instruction(edge_id const  e) const { return graph().data(e).instruction(); }
+    microcode::decoded_instruction const&  decoded_instruction(edge_id const  e) const { return graph().data(e); }
+
+    /**
+     * Returns decoded instructions of edges going out of the node 'n'. The k-th instruction is on the edge (n,successors(n).at(k)).
+     */
+    std::vector<microcode::decoded_instruction> const&  successor_instructions(node_id const  n) const { return graph().successors_data(n); }
 
     void  mark_entry(node_id const  node);
 
@@ -47,14 +59,32 @@ struct program_component
     std::string const&  name() const noexcept { return m_name; }
     std::string&  name() noexcept { return m_name; }
 
+    /**
+     * The number is increased by each modification of nodes or edges of the component. So, a data derived from
+     * the component (e.g. a compiled code) can detect it is outdated.
+     */
+    uint64_t  version() const noexcept { return m_version; }
+
+    /**
+     * Returns a deep copy of the component with the same IDs of nodes. The copy does not belong to any program.
+     */
+    std::shared_ptr<program_component>  copy() const;
+
 private:
+    friend struct program;
+
     graph_type const&  graph() const noexcept { return m_graph; }
     graph_type&  graph() noexcept { return m_graph; }
 
+    void  notify_owners_about_inserted_nodes(std::vector<node_id> const&  nodes) const;
+    void  notify_owners_about_erased_nodes(std::vector<node_id> const&  nodes) const;
+
     graph_type  m_graph;
     node_id  m_entry;
     std::unordered_set<node_id>  m_exits;
     std::string  m_name;
+    std::vector< std::pair<program*,uint64_t> >  m_owners;  //!< Programs containing this component, each with the index of the component in it.
+    uint64_t  m_version;
 };
 
 
@@ -62,13 +92,29 @@ using  program_component_ptr = std::shared_ptr<program_component>;
 using  program_component_const_ptr = std::shared_ptr<program_component const>;
 
 
+/**
+ * A program is a sequence of components. The program maintains an index from nodes to components containing them
+ * and an index from entry nodes to components. Components notify their programs about inserted and erased nodes
+ * and about a change of the entry, so the indices stay valid even when a component is modified directly.
+ * A component may be shared by several programs.
+ */
 struct program
 {
+    using  node_id = program_component::node_id;
+
     program(std::string const&  program_name = "", std::string const&  start_component_name = "MAIN");
     program(std::vector<program_component_ptr> const&  components, std::string const&  program_name = "");
+    ~program();
+    program(program const& ) = delete;
+    program& operator=(program const& ) = delete;
 
     void  push_back(program_component_ptr const  C);
 
+    /**
+     * It exchanges components and names of the programs (e.g. to replace a program by a program loaded from a file).
+     */
+    void  swap(program&  other);
+
     uint64_t  num_components() const { return m_components.size(); }
     program_component const&  component(uint64_t const  index) const;
     program_component&  component(uint64_t const  index);
@@ -82,17 +128,43 @@ struct program
     std::string const&  name() const noexcept { return m_name; }
     std::string&  name() noexcept { return m_name; }
 
+    /**
+     * Both functions return the index of the found component, or 'num_components()' if there is no such component.
+     */
+    uint64_t  find_component(node_id const  node) const;
+    uint64_t  find_component_with_entry_node(node_id const  entry) const;
+
 private:
+    friend struct program_component;
+
+    void  index_component(uint64_t const  index);
+    void  on_nodes_inserted(uint64_t const  index, std::vector<node_id> const&  nodes);
+    void  on_nodes_erased(std::vector<node_id> const&  nodes);
+    void  on_entry_changed(uint64_t const  index, node_id const  old_entry, node_id const  new_entry);
+
     std::vector<program_component_ptr>  m_components;
     std::string  m_name;
+    ::detail::flat_digraph_index  m_component_of_node;
+    ::detail::flat_digraph_index  m_component_of_entry;
 };
 
 
 program_component::node_id  generate_next_fresh_node_id();
 
+/**
+ * It ensures that no ID up to 'last_used_id' is generated again, e.g. after nodes with those IDs were loaded from a file.
+ */
+void  reserve_fresh_node_ids(program_component::node_id const  last_used_id);
+
 
 std::unique_ptr<microcode::program>  create_initial_program(std::string const&  program_name = "", std::string const&  start_component_name = "MAIN");
 
+/**
+ * Returns a program consisting of deep copies of components of the passed program. So, the copy can be modified
+ * independently on the original (e.g. in a different thread), while IDs of all nodes are preserved.
+ */
+std::unique_ptr<microcode::program>  copy_program(program const&  P);
+
 uint64_t  find_component_with_entry_node(program const&  P, program_component::node_id const  entry);
 uint64_t  find_component(program const&  P, program_component::node_id const  node_id);
 
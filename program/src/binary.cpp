@@ -0,0 +1,311 @@
+#include <rebours/program/binary.hpp>
+#include <rebours/program/assumptions.hpp>
+#include <rebours/program/invariants.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+
+namespace microcode { namespace detail {
+
+
+using  node_id = program_component::node_id;
+
+
+std::string const  binary_program_magic = "REBOURS.MICROCODE.BINARY";
+uint64_t const  binary_program_version = 1ULL;
+
+
+std::vector<node_id>  sorted_nodes(program_component const&  C)
+{
+    std::vector<node_id>  nodes(C.nodes().cbegin(),C.nodes().cend());
+    std::sort(nodes.begin(),nodes.end());
+    return nodes;
+}
+
+struct  loaded_component
+{
+    std::string  name;
+    node_id  entry;
+    std::vector<node_id>  nodes;
+    std::vector< std::pair<program_component::edge_id,microcode::instruction> >  edges;
+};
+
+
+std::string  load_component(std::istream&  istr, std::vector<microcode::instruction> const&  instructions, loaded_component&  C)
+{
+    uint64_t  num_nodes;
+    if (!read_string(istr,C.name) || !read_varint(istr,C.entry) || !read_varint(istr,num_nodes))
+        return "Wrong header of a component.";
+    node_id  last = 0ULL;
+    for (uint64_t  i = 0ULL; i < num_nodes; ++i)
+    {
+        uint64_t  delta;
+        if (!read_varint(istr,delta) || delta == 0ULL || last + delta < last)
+            return "Wrong ID of a node.";
+        last += delta;
+        C.nodes.push_back(last);
+    }
+    if (!std::binary_search(C.nodes.cbegin(),C.nodes.cend(),C.entry))
+        return "The entry node is not a node of the component.";
+    for (node_id const  n : C.nodes)
+    {
+        uint64_t  num_successors;
+        if (!read_varint(istr,num_successors))
+            return "Wrong number of successors.";
+        for (uint64_t  k = 0ULL; k < num_successors; ++k)
+        {
+            node_id  m;
+            uint64_t  index;
+            if (!read_varint(istr,m) || !std::binary_search(C.nodes.cbegin(),C.nodes.cend(),m))
+                return "Wrong successor of a node.";
+            if (!read_varint(istr,index) || index >= instructions.size())
+                return "Wrong index into the dictionary of instructions.";
+            C.edges.push_back({ {n,m}, instructions.at(index) });
+        }
+    }
+    return "";
+}
+
+
+}}
+
+namespace microcode {
+
+
+void  write_varint(std::ostream&  ostr, uint64_t  value)
+{
+    do
+    {
+        uint8_t  byte = value & 0x7fULL;
+        value >>= 7U;
+        if (value != 0ULL)
+            byte |= 0x80U;
+        ostr.put((char)byte);
+    }
+    while (value != 0ULL);
+}
+
+bool  read_varint(std::istream&  istr, uint64_t&  value)
+{
+    value = 0ULL;
+    for (uint32_t  shift = 0U; shift < 64U; shift += 7U)
+    {
+        std::istream::int_type const  c = istr.get();
+        if (c == std::istream::traits_type::eof())
+            return false;
+        value |= (uint64_t)(c & 0x7f) << shift;
+        if ((c & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+void  write_bytes(std::ostream&  ostr, std::vector<uint8_t> const&  bytes)
+{
+    write_varint(ostr,bytes.size());
+    ostr.write((char const*)bytes.data(),bytes.size());
+}
+
+bool  read_bytes(std::istream&  istr, std::vector<uint8_t>&  bytes)
+{
+    uint64_t  size;
+    if (!read_varint(istr,size))
+        return false;
+    // The size is not trusted; the bytes are read in chunks, so a corrupted size only leads to the end of the input.
+    uint64_t const  chunk_size = 1ULL << 20U;
+    bytes.clear();
+    while (bytes.size() < size)
+    {
+        uint64_t const  old_size = bytes.size();
+        bytes.resize(old_size + std::min(chunk_size,size - old_size));
+        if (!istr.read((char*)bytes.data() + old_size,bytes.size() - old_size))
+            return false;
+    }
+    return true;
+}
+
+void  write_string(std::ostream&  ostr, std::string const&  text)
+{
+    write_varint(ostr,text.size());
+    ostr.write(text.data(),text.size());
+}
+
+bool  read_string(std::istream&  istr, std::string&  text)
+{
+    std::vector<uint8_t>  bytes;
+    if (!read_bytes(istr,bytes))
+        return false;
+    text.assign(bytes.cbegin(),bytes.cend());
+    return true;
+}
+
+
+std::ostream&  save_program_as_binary(std::ostream&  output_stream, program const&  P, annotations const* const A)
+{
+    write_string(output_stream,detail::binary_program_magic);
+    write_varint(output_stream,detail::binary_program_version);
+    write_string(output_stream,P.name());
+
+    std::unordered_map<instruction,uint64_t,instruction::hash>  dictionary;
+    std::vector<instruction>  instructions;
+    for (uint64_t  i = 0ULL; i < P.num_components(); ++i)
+        for (auto const&  edge_data : P.component(i).edges())
+            if (dictionary.insert({edge_data.second.instruction(),instructions.size()}).second)
+                instructions.push_back(edge_data.second.instruction());
+    write_varint(output_stream,instructions.size());
+    for (instruction const  I : instructions)
+    {
+        write_bytes(output_stream,instruction_separators(I));
+        write_bytes(output_stream,instruction_data(I));
+    }
+
+    write_varint(output_stream,P.num_components());
+    for (uint64_t  i = 0ULL; i < P.num_components(); ++i)
+    {
+        program_component const&  C = P.component(i);
+        write_string(output_stream,C.name());
+        write_varint(output_stream,C.entry());
+        std::vector<detail::node_id> const  nodes = detail::sorted_nodes(C);
+        write_varint(output_stream,nodes.size());
+        detail::node_id  last = 0ULL;
+        for (detail::node_id const  n : nodes)
+        {
+            write_varint(output_stream,n - last);
+            last = n;
+        }
+        for (detail::node_id const  n : nodes)
+        {
+            write_varint(output_stream,C.successors(n).size());
+            for (uint64_t  k = 0ULL; k < C.successors(n).size(); ++k)
+            {
+                write_varint(output_stream,C.successors(n).at(k));
+                write_varint(output_stream,dictionary.at(C.successor_instructions(n).at(k).instruction()));
+            }
+        }
+    }
+
+    std::vector<detail::node_id>  annotated;
+    if (A != nullptr)
+        for (auto const&  node_annotations : *A)
+            annotated.push_back(node_annotations.first);
+    std::sort(annotated.begin(),annotated.end());
+    write_varint(output_stream,annotated.size());
+    for (detail::node_id const  n : annotated)
+    {
+        write_varint(output_stream,n);
+        write_varint(output_stream,A->at(n).size());
+        for (annotation const&  keyword_value : A->at(n))
+        {
+            write_string(output_stream,keyword_value.first);
+            write_string(output_stream,keyword_value.second);
+        }
+    }
+
+    return output_stream;
+}
+
+std::pair<std::unique_ptr<program>,std::unique_ptr<annotations> >  create_program_from_binary(std::istream&  input_stream, std::string&  error_message)
+{
+    std::pair<std::unique_ptr<program>,std::unique_ptr<annotations> >  result;
+
+    std::string  magic, name;
+    uint64_t  version;
+    if (!read_string(input_stream,magic) || magic != detail::binary_program_magic ||
+            !read_varint(input_stream,version) || version != detail::binary_program_version ||
+            !read_string(input_stream,name))
+    {
+        error_message = "The input is not a binary Microcode program of a supported version.";
+        return result;
+    }
+
+    uint64_t  num_instructions;
+    if (!read_varint(input_stream,num_instructions))
+    {
+        error_message = "Wrong size of the dictionary of instructions.";
+        return result;
+    }
+    std::vector<instruction>  instructions;
+    for (uint64_t  i = 0ULL; i < num_instructions; ++i)
+    {
+        std::vector<uint8_t>  separators, data;
+        if (!read_bytes(input_stream,separators) || !read_bytes(input_stream,data))
+        {
+            error_message = "Wrong entry in the dictionary of instructions.";
+            return result;
+        }
+        instructions.push_back(create_instruction_from_representation(separators,data));
+        if (!instructions.back().operator bool())
+        {
+            error_message = "Wrong entry in the dictionary of instructions.";
+            return result;
+        }
+    }
+
+    uint64_t  num_components;
+    if (!read_varint(input_stream,num_components) || num_components == 0ULL)
+    {
+        error_message = "Wrong number of components.";
+        return result;
+    }
+    std::vector<detail::loaded_component>  loaded;
+    detail::node_id  max_id = 0ULL;
+    for (uint64_t  i = 0ULL; i < num_components; ++i)
+    {
+        loaded.push_back({});
+        error_message = detail::load_component(input_stream,instructions,loaded.back());
+        if (!error_message.empty())
+            return result;
+        max_id = std::max(max_id,loaded.back().nodes.back());
+    }
+
+    std::unique_ptr<annotations>  A = create_initial_annotations();
+    uint64_t  num_annotated;
+    if (!read_varint(input_stream,num_annotated))
+    {
+        error_message = "Wrong number of annotated nodes.";
+        return result;
+    }
+    for (uint64_t  i = 0ULL; i < num_annotated; ++i)
+    {
+        detail::node_id  n;
+        uint64_t  num_annotations;
+        if (!read_varint(input_stream,n) || !read_varint(input_stream,num_annotations))
+        {
+            error_message = "Wrong annotations of a node.";
+            return result;
+        }
+        node_annotations&  node_As = (*A)[n];
+        for (uint64_t  j = 0ULL; j < num_annotations; ++j)
+        {
+            annotation  keyword_value;
+            if (!read_string(input_stream,keyword_value.first) || !read_string(input_stream,keyword_value.second))
+            {
+                error_message = "Wrong annotations of a node.";
+                return result;
+            }
+            node_As.push_back(keyword_value);
+        }
+    }
+
+    // Components are created only now, because their (temporary) entry nodes get fresh IDs, which must differ
+    // from all loaded IDs.
+    reserve_fresh_node_ids(max_id);
+    std::vector<program_component_ptr>  components;
+    for (detail::loaded_component const&  C : loaded)
+    {
+        program_component_ptr const  component = std::make_shared<program_component>();
+        detail::node_id const  temporary_entry = component->entry();
+        component->insert_nodes(C.nodes);
+        component->insert_edges(C.edges);
+        component->mark_entry(C.entry);
+        component->erase_nodes({ temporary_entry });
+        component->name() = C.name;
+        components.push_back(component);
+    }
+    result.first = std::unique_ptr<program>(new program(components,name));
+    result.second = std::move(A);
+    return result;
+}
+
+
+}
@@ -0,0 +1,57 @@
+#include <rebours/program/decoded_instruction.hpp>
+#include <rebours/program/invariants.hpp>
+#include <algorithm>
+
+namespace microcode {
+
+
+uint64_t const  decoded_instruction::max_num_args;
+
+
+decoded_instruction::decoded_instruction()
+    : m_args{{0ULL,0ULL,0ULL,0ULL}}
+    , m_GIK(microcode::GIK::NUM_GIKs)
+    , m_num_arguments(0ULL)
+    , m_data_begin(nullptr)
+    , m_data_size(0ULL)
+    , m_wide_arg()
+    , m_instruction()
+{}
+
+decoded_instruction::decoded_instruction(microcode::instruction const  I)
+    : m_args{{0ULL,0ULL,0ULL,0ULL}}
+    , m_GIK(microcode::GIK::NUM_GIKs)
+    , m_num_arguments(0ULL)
+    , m_data_begin(nullptr)
+    , m_data_size(0ULL)
+    , m_wide_arg()
+    , m_instruction(I)
+{
+    if (!I)
+        return;
+
+    m_GIK = I.GIK();
+    m_num_arguments = I.num_arguments();
+
+    uint64_t  num_decoded_arguments = std::min(m_num_arguments,max_num_args);
+    if (m_GIK == microcode::GIK::DATATRANSFER__DEREF_ADDRESS_ASGN_DATA || m_GIK == microcode::GIK::DATATRANSFER__DEREF_REG_ASGN_DATA)
+    {
+        INVARIANT(m_num_arguments > 1ULL);
+        num_decoded_arguments = 1ULL;
+        m_data_begin = I.argument_begin(1ULL);
+        m_data_size = m_num_arguments - 1ULL;
+    }
+
+    for (uint64_t  i = 0ULL; i < num_decoded_arguments; ++i)
+    {
+        uint8_t const  size = I.argument_size(i);
+        if (size <= sizeof(uint64_t))
+            m_args[i] = I.argument<uint64_t>(i);
+        else if (size == sizeof(uint128_t))
+            m_wide_arg = I.argument<uint128_t>(i);
+        // Other arguments (i.e. float80_t) are not decoded; the interpreter does not support instructions using them.
+    }
+}
+
+
+}
@@ -1,9 +1,12 @@
 #include <rebours/program/instruction.hpp>
 #include <rebours/program/assumptions.hpp>
-#include <unordered_set>
+#include <algorithm>
 #include <array>
+#include <memory>
+#include <new>
 #include <limits>
 #include <mutex>
+#include <cstring>
 #ifdef DEBUG
 #   include <rebours/program/assembly.hpp>
 #endif
@@ -36,57 +39,213 @@ bool  is_instruction_with_data(microcode::GIK const  GIK);
 
 void  test_cache();
 
+/**
+ * An interned instruction is a single contiguous record allocated in an arena: this header is directly
+ * followed by separators and then by data. The first data byte is the GIK.
+ */
 struct instruction
 {
     static instruction const*  create(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data);
 
-    microcode::GIK  GIK() const noexcept { return static_cast<microcode::GIK>(m_data.at(0ULL)); }
+    microcode::GIK  GIK() const noexcept { return static_cast<microcode::GIK>(*data()); }
 
-    uint64_t  num_arguments() const noexcept { return m_separators.size() + (has_data_block() ? m_data.size() - m_separators.back() - 1ULL : 0ULL); }
+    uint64_t  num_arguments() const noexcept { return m_num_separators + (has_data_block() ? m_data_size - separators()[m_num_separators - 1U] - 1ULL : 0ULL); }
     uint8_t  argument_size(uint64_t const  argument_index) const;
     uint8_t const*  argument_begin(uint64_t const  argument_index) const;
 
-    std::vector<uint8_t> const&  separators() const noexcept { return m_separators; }
-    std::vector<uint8_t> const&  data() const noexcept { return m_data; }
+    uint8_t  num_separators() const noexcept { return m_num_separators; }
+    uint8_t const*  separators() const noexcept { return reinterpret_cast<uint8_t const*>(this + 1); }
+
+    uint64_t  data_size() const noexcept { return m_data_size; }
+    uint8_t const*  data() const noexcept { return separators() + m_num_separators; }
+
+    std::size_t  hash() const noexcept { return m_hash; }
+
+    bool  has_content(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data) const;
 
 private:
-    instruction(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data);
+    instruction(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data, std::size_t const  hash);
 
+    instruction(instruction const&  other) = delete;
     instruction& operator=(instruction const&  other) = delete;
 
     bool  has_data_block() const noexcept { return is_instruction_with_data(GIK()); }
 
-    using instructions_dictionary = std::unordered_set<instruction,decltype(&instruction_hash),decltype(&instruction_equal)>;
-    static instructions_dictionary  s_instructions;
-    static std::mutex  s_construction_mutex;
+    static std::size_t  compute_hash(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data);
+
 friend void  test_cache();
+friend struct instructions_dictionary;
 
-    std::vector<uint8_t>  m_separators;
-    std::vector<uint8_t>  m_data;
+    std::size_t  m_hash;
+    uint32_t  m_data_size;
+    uint8_t  m_num_separators;
 };
 
-instruction::instructions_dictionary  instruction::s_instructions(
-        0,
-        &instruction_hash,
-        &instruction_equal
-        );
 
-std::mutex  instruction::s_construction_mutex;
+/**
+ * A bump allocator of memory which is never released. Small requests are served from large chunks;
+ * a request bigger than a quarter of a chunk (e.g. a data instruction holding a whole section) gets its own block.
+ */
+struct  instructions_arena
+{
+    static uint64_t const  chunk_size = 64ULL * 1024ULL;
+
+    instructions_arena() : m_blocks(), m_cursor(nullptr), m_end(nullptr), m_num_bytes(0ULL) {}
+
+    void*  allocate(uint64_t  num_bytes)
+    {
+        num_bytes = (num_bytes + alignof(instruction) - 1ULL) & ~(alignof(instruction) - 1ULL);
+        m_num_bytes += num_bytes;
+        if (num_bytes > chunk_size / 4ULL)
+        {
+            m_blocks.push_back(std::unique_ptr<uint64_t[]>(new uint64_t[num_bytes / sizeof(uint64_t) + 1ULL]));
+            return m_blocks.back().get();
+        }
+        if ((uint64_t)(m_end - m_cursor) < num_bytes)
+        {
+            m_blocks.push_back(std::unique_ptr<uint64_t[]>(new uint64_t[chunk_size / sizeof(uint64_t)]));
+            m_cursor = reinterpret_cast<uint8_t*>(m_blocks.back().get());
+            m_end = m_cursor + chunk_size;
+        }
+        void* const  result = m_cursor;
+        m_cursor += num_bytes;
+        return result;
+    }
+
+    uint64_t  num_bytes() const noexcept { return m_num_bytes; }
+
+private:
+    std::vector< std::unique_ptr<uint64_t[]> >  m_blocks;
+    uint8_t*  m_cursor;
+    uint8_t*  m_end;
+    uint64_t  m_num_bytes;
+};
+
+
+/**
+ * The set of all created instructions (each instruction exists only once, so instructions can be compared by pointers).
+ * The set is split into independent shards, each guarded by its own mutex. A shard is selected by the hash of the
+ * content of the instruction, so threads creating different instructions usually lock different mutexes. Each shard
+ * keeps its instructions in its own arena and indexes them by an open-addressing table of pointers (the hash is
+ * stored in the instruction, so a probe usually touches only one record). Instructions are never destroyed
+ * and they never move in memory.
+ */
+struct  instructions_dictionary
+{
+    static uint64_t const  num_shards = 64ULL;
+
+    struct  shard
+    {
+        shard() : mutex(), arena(), table(16ULL,nullptr), size(0ULL) {}
+
+        instruction const*  find_or_insert(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data, std::size_t const  hash);
+
+        std::mutex  mutex;
+        instructions_arena  arena;
+        std::vector<instruction const*>  table;
+        uint64_t  size;
+    };
+
+    static instructions_dictionary&  instance()
+    {
+        static instructions_dictionary  dictionary;
+        return dictionary;
+    }
+
+    shard&  shard_of(std::size_t const  hash) { return m_shards[(hash >> 32U) % num_shards]; }
+
+private:
+    std::array<shard,num_shards>  m_shards;
+};
+
+
+instruction const*  instructions_dictionary::shard::find_or_insert(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data,
+                                                                   std::size_t const  hash)
+{
+    uint64_t  mask = table.size() - 1ULL;
+    uint64_t  i = hash & mask;
+    for ( ; table.at(i) != nullptr; i = (i + 1ULL) & mask)
+        if (table.at(i)->hash() == hash && table.at(i)->has_content(separators,data))
+            return table.at(i);
+
+    void* const  record = arena.allocate(sizeof(instruction) + separators.size() + data.size());
+    instruction const* const  I = new(record) instruction(separators,data,hash);
+
+    ++size;
+    if (2ULL * size > table.size())
+    {
+        std::vector<instruction const*>  old(2ULL * table.size(),nullptr);
+        old.swap(table);
+        mask = table.size() - 1ULL;
+        for (instruction const* const  J : old)
+            if (J != nullptr)
+            {
+                uint64_t  j = J->hash() & mask;
+                while (table.at(j) != nullptr)
+                    j = (j + 1ULL) & mask;
+                table.at(j) = J;
+            }
+        for (i = hash & mask; table.at(i) != nullptr; i = (i + 1ULL) & mask)
+            ;
+    }
+    table.at(i) = I;
+
+    return I;
+}
+
 
 instruction const*  instruction::create(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data)
 {
-    std::lock_guard<std::mutex> const  lock(s_construction_mutex);
-    return &*s_instructions.insert({separators,data}).first;
+    std::size_t const  hash = compute_hash(separators,data);
+    instructions_dictionary::shard&  shard = instructions_dictionary::instance().shard_of(hash);
+    std::lock_guard<std::mutex> const  lock(shard.mutex);
+    return shard.find_or_insert(separators,data,hash);
 }
 
-instruction::instruction(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data)
-    : m_separators(separators)
-    , m_data(data)
+std::size_t  instruction::compute_hash(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data)
 {
-    ASSUMPTION(!m_data.empty());
-    ASSUMPTION(m_separators.size() <= 0xffULL);
-    ASSUMPTION((m_data.size() == 1ULL && m_separators.empty()) ||
-               (m_separators.front() == 1U && m_separators.back() < m_data.size() &&
+    // It is MurmurHash64A applied to all bytes of the data and then of the separators.
+    uint64_t const  m = 0xc6a4a7935bd1e995ULL;
+    auto const  mix_bytes =
+            [m](uint8_t const* const  begin, uint64_t const  size, uint64_t  h) -> uint64_t {
+                h ^= size * m;
+                uint64_t  i = 0ULL;
+                for ( ; i + 8ULL <= size; i += 8ULL)
+                {
+                    uint64_t  k;
+                    std::memcpy(&k,begin + i,sizeof(k));
+                    k *= m;
+                    k ^= k >> 47U;
+                    k *= m;
+                    h ^= k;
+                    h *= m;
+                }
+                if (i < size)
+                {
+                    uint64_t  k = 0ULL;
+                    for (uint64_t  j = size; j > i; --j)
+                        k = (k << 8U) | begin[j - 1ULL];
+                    h ^= k;
+                    h *= m;
+                }
+                h ^= h >> 47U;
+                h *= m;
+                h ^= h >> 47U;
+                return h;
+            };
+    return (std::size_t)mix_bytes(separators.data(),separators.size(),mix_bytes(data.data(),data.size(),0x9e3779b97f4a7c15ULL));
+}
+
+instruction::instruction(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data, std::size_t const  hash)
+    : m_hash(hash)
+    , m_data_size((uint32_t)data.size())
+    , m_num_separators((uint8_t)separators.size())
+{
+    ASSUMPTION(!data.empty());
+    ASSUMPTION(data.size() <= std::numeric_limits<uint32_t>::max());
+    ASSUMPTION(separators.size() <= 0xffULL);
+    ASSUMPTION((data.size() == 1ULL && separators.empty()) ||
+               (separators.front() == 1U && separators.back() < data.size() &&
                 [](std::vector<uint8_t> const&  separators){
                     for (uint8_t  i = 1U; i < separators.size(); ++i)
                         if (separators.at(i) > separators.at(i-1U))
@@ -94,99 +253,74 @@ instruction::instruction(std::vector<uint8_t> const&  separators, std::vector<ui
                     return true;
                     }
                 ));
+    uint8_t* const  record = reinterpret_cast<uint8_t*>(this + 1);
+    std::copy(separators.cbegin(),separators.cend(),record);
+    std::copy(data.cbegin(),data.cend(),record + separators.size());
+}
+
+bool  instruction::has_content(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data) const
+{
+    return m_num_separators == separators.size() && m_data_size == data.size() &&
+           std::equal(separators.cbegin(),separators.cend(),this->separators()) &&
+           std::equal(data.cbegin(),data.cend(),this->data());
 }
 
 uint8_t  instruction::argument_size(uint64_t const  argument_index) const
 {
-    if (has_data_block() && argument_index + 1ULL >= m_separators.size())
+    if (has_data_block() && argument_index + 1ULL >= m_num_separators)
     {
-        ASSUMPTION(argument_index + 1ULL - m_separators.size() < m_data.size() - m_separators.back());
+        ASSUMPTION(argument_index + 1ULL - m_num_separators < m_data_size - separators()[m_num_separators - 1U]);
         return 1U;
     }
     else
     {
-        ASSUMPTION(argument_index < m_separators.size());
-        return argument_index + 1ULL < m_separators.size() ? m_separators.at(argument_index + 1ULL) - m_separators.at(argument_index) :
-                                                             m_data.size() - m_separators.at(argument_index);
+        ASSUMPTION(argument_index < m_num_separators);
+        return argument_index + 1ULL < m_num_separators ? separators()[argument_index + 1ULL] - separators()[argument_index] :
+                                                          m_data_size - separators()[argument_index];
     }
 }
 
 uint8_t const*  instruction::argument_begin(uint64_t const  argument_index) const
 {
-    if (has_data_block() && argument_index + 1ULL >= m_separators.size())
+    if (has_data_block() && argument_index + 1ULL >= m_num_separators)
     {
-        ASSUMPTION(argument_index + 1ULL - m_separators.size() < m_data.size() - m_separators.back());
-        return m_data.data() + m_separators.back() + (argument_index + 1ULL - m_separators.size());
+        ASSUMPTION(argument_index + 1ULL - m_num_separators < m_data_size - separators()[m_num_separators - 1U]);
+        return data() + separators()[m_num_separators - 1U] + (argument_index + 1ULL - m_num_separators);
     }
     else
     {
-        ASSUMPTION(argument_index < m_separators.size());
-        return m_data.data() + m_separators.at(argument_index);
+        ASSUMPTION(argument_index < m_num_separators);
+        return data() + separators()[argument_index];
     }
 }
 
 
 std::size_t  instruction_hash(instruction const&  I)
 {
-    std::size_t  result = 0ULL;
-    for (uint8_t i = 0ULL, n = I.data().size() < 32ULL ? I.data().size() : 32ULL; i < n; ++i)
-        result += (i + 1ULL) * 101ULL * std::hash<uint64_t>()(I.data().at(i));
-    return result;
+    return I.hash();
 }
 
 bool  instruction_equal(instruction const&  I1, instruction const&  I2)
 {
-    if (I1.data().size() != I2.data().size() || I1.separators().size() != I2.separators().size())
-        return false;
-    for (uint64_t i = 0ULL; i < I1.data().size(); ++i)
-        if (I1.data().at(i) != I2.data().at(i))
-            return false;
-    for (uint64_t i = 0ULL; i < I1.separators().size(); ++i)
-        if (I1.separators().at(i) != I2.separators().at(i))
-            return false;
-    return true;
+    return I1.hash() == I2.hash() &&
+           I1.num_separators() == I2.num_separators() &&
+           I1.data_size() == I2.data_size() &&
+           std::equal(I1.separators(),I1.separators() + I1.num_separators(),I2.separators()) &&
+           std::equal(I1.data(),I1.data() + I1.data_size(),I2.data());
 }
 
 bool  instruction_less_than(instruction const&  I1, instruction const&  I2)
 {
-    if (I1.GIK() < I2.GIK())
-        return true;
-    if (I1.GIK() == I2.GIK())
-    {
-        if (I1.separators().size() < I2.separators().size())
-            return true;
-        if (I1.separators().size() == I2.separators().size())
-        {
-            if (I1.data().size() < I2.data().size())
-                return true;
-            if (I1.data().size() == I2.data().size())
-            {
-                bool ok = true;
-                for (uint64_t i = 0ULL; i < I1.separators().size(); ++i)
-                {
-                    if (I1.separators().at(i) < I2.separators().at(i))
-                        return true;
-                    if (I1.separators().at(i) != I2.separators().at(i))
-                    {
-                        ok = false;
-                        break;
-                    }
-                }
-                if (ok)
-                    for (uint64_t i = 0ULL; i < I1.data().size(); ++i)
-                    {
-                        if (I1.data().at(i) < I2.data().at(i))
-                            return true;
-                        if (I1.data().at(i) != I2.data().at(i))
-                        {
-                            ok = false;
-                            break;
-                        }
-                    }
-            }
-        }
-    }
-    return false;
+    if (I1.GIK() != I2.GIK())
+        return I1.GIK() < I2.GIK();
+    if (I1.num_separators() != I2.num_separators())
+        return I1.num_separators() < I2.num_separators();
+    if (I1.data_size() != I2.data_size())
+        return I1.data_size() < I2.data_size();
+    if (!std::equal(I1.separators(),I1.separators() + I1.num_separators(),I2.separators()))
+        return std::lexicographical_compare(I1.separators(),I1.separators() + I1.num_separators(),
+                                            I2.separators(),I2.separators() + I2.num_separators());
+    return std::lexicographical_compare(I1.data(),I1.data() + I1.data_size(),I2.data(),I2.data() + I2.data_size());
 }
 
 bool  is_instruction_with_data(microcode::GIK const  GIK)
@@ -907,4 +1041,32 @@ instruction  create_MISCELLANEOUS__STOP()
 }
 
 
+std::vector<uint8_t>  instruction_separators(instruction const  I)
+{
+    ASSUMPTION(I.operator bool());
+    return std::vector<uint8_t>(I->separators(),I->separators() + I->num_separators());
+}
+
+std::vector<uint8_t>  instruction_data(instruction const  I)
+{
+    ASSUMPTION(I.operator bool());
+    return std::vector<uint8_t>(I->data(),I->data() + I->data_size());
+}
+
+instruction  create_instruction_from_representation(std::vector<uint8_t> const&  separators, std::vector<uint8_t> const&  data)
+{
+    if (data.empty() || data.front() >= num(GIK::NUM_GIKs) || data.size() > std::numeric_limits<uint32_t>::max() ||
+            separators.size() > 0xffULL)
+        return instruction();
+    if (separators.empty())
+        return data.size() == 1ULL ? instruction(detail::instruction::create(separators,data)) : instruction();
+    if (separators.front() != 1U || separators.back() >= data.size())
+        return instruction();
+    for (uint64_t  i = 1ULL; i < separators.size(); ++i)
+        if (separators.at(i - 1ULL) >= separators.at(i))
+            return instruction();
+    return instruction(detail::instruction::create(separators,data));
+}
+
+
 }
@@ -5,12 +5,14 @@
 #include <rebours/program/msgstream.hpp>
 #include <limits>
 #include <algorithm>
+#include <unordered_set>
 #include <mutex>
 
 namespace microcode { namespace detail {
 
 
 static std::mutex  s_mutex_for_id_generation;
+static program_component::node_id  s_last_generated_id = 0ULL;
 
 
 }}
@@ -23,6 +25,8 @@ program_component::program_component(std::string const&  program_name, std::stri
     , m_entry{generate_next_fresh_node_id()}
     , m_exits({m_entry})
     , m_name(program_name.empty() && component_name.empty() ? "" : (msgstream() << program_name << "::" << component_name << msgstream::end()))
+    , m_owners()
+    , m_version(0ULL)
 {
     graph().insert_nodes({entry()});
 }
@@ -31,18 +35,23 @@ program_component::program_component(std::string const&  program_name, std::stri
 void  program_component::mark_entry(node_id const  node)
 {
     ASSUMPTION(nodes().count(node) == 1ULL);
+    for (auto const&  owner_index : m_owners)
+        owner_index.first->on_entry_changed(owner_index.second,m_entry,node);
     m_entry = node;
 }
 
 void  program_component::insert_nodes(std::vector<node_id> const&  nodes)
 {
+    ++m_version;
     graph().insert_nodes(nodes);
     for (node_id const  n :  nodes)
         m_exits.insert(n);
+    notify_owners_about_inserted_nodes(nodes);
 }
 
 void  program_component::erase_nodes(std::vector<node_id> const&  nodes)
 {
+    ++m_version;
     for (node_id const  n :  nodes)
     {
         ASSUMPTION(n != entry());
@@ -56,17 +65,20 @@ void  program_component::erase_nodes(std::vector<node_id> const&  nodes)
             if (successors(m).empty())
                 m_exits.insert(m);
     }
+    notify_owners_about_erased_nodes(nodes);
 }
 
 void  program_component::insert_edges(std::vector< std::pair<edge_id,microcode::instruction> > const&  edges)
 {
-    graph().insert_edges(edges);
+    ++m_version;
+    graph().insert_edges(edges.cbegin(),edges.cend());
     for (auto const  id_insr : edges)
         m_exits.erase(id_insr.first.first);
 }
 
 void  program_component::erase_edges(std::vector<edge_id> const&  edges)
 {
+    ++m_version;
     graph().erase_edges(edges);
     for (auto const  id_insr : edges)
         if (successors(id_insr.first).empty())
@@ -172,8 +184,11 @@ program_component::insert_branching(GIK const  gik, uint8_t const  n, uint64_t c
 
 void  program_component::append_by_edge(program_component const&  other, node_id const  exit, microcode::instruction const I)
 {
+    ++m_version;
     ASSUMPTION(exits().count(exit) != 0ULL);
     graph().insert_nodes(other.nodes().cbegin(),other.nodes().cend());
+    if (!m_owners.empty())
+        notify_owners_about_inserted_nodes(std::vector<node_id>(other.nodes().cbegin(),other.nodes().cend()));
     graph().insert_edges(other.edges().cbegin(),other.edges().cend());
     m_exits.insert(other.exits().cbegin(),other.exits().cend());
     insert_edges({ {{exit,other.entry()},I} });
@@ -189,32 +204,100 @@ void  program_component::append_by_merging_exit_and_entry(program_component cons
         insert_edges({ {{n,exit},other.instruction({n,other.entry()})} });
 }
 
+std::shared_ptr<program_component>  program_component::copy() const
+{
+    std::shared_ptr<program_component> const  C = std::make_shared<program_component>();
+    C->graph().erase_nodes({C->entry()});
+    C->graph().insert_nodes(nodes().cbegin(),nodes().cend());
+    C->graph().insert_edges(edges().cbegin(),edges().cend());
+    C->m_entry = m_entry;
+    C->m_exits = m_exits;
+    C->m_name = m_name;
+    return C;
+}
+
+void  program_component::notify_owners_about_inserted_nodes(std::vector<node_id> const&  nodes) const
+{
+    for (auto const&  owner_index : m_owners)
+        owner_index.first->on_nodes_inserted(owner_index.second,nodes);
+}
+
+void  program_component::notify_owners_about_erased_nodes(std::vector<node_id> const&  nodes) const
+{
+    for (auto const&  owner_index : m_owners)
+        owner_index.first->on_nodes_erased(nodes);
+}
+
 program_component::node_id  generate_next_fresh_node_id()
 {
     std::lock_guard<std::mutex> lock(detail::s_mutex_for_id_generation);
     {
-        static program_component::node_id  id = 0ULL;
-        ASSUMPTION(id != std::numeric_limits<program_component::node_id>::max());
-        return ++id;
+        ASSUMPTION(detail::s_last_generated_id != std::numeric_limits<program_component::node_id>::max());
+        return ++detail::s_last_generated_id;
     }
 }
 
+void  reserve_fresh_node_ids(program_component::node_id const  last_used_id)
+{
+    std::lock_guard<std::mutex> lock(detail::s_mutex_for_id_generation);
+    detail::s_last_generated_id = std::max(detail::s_last_generated_id,last_used_id);
+}
+
 
 program::program(std::string const&  program_name, std::string const&  start_component_name)
     : m_components{std::make_shared<program_component>(program_name,start_component_name)}
     , m_name(program_name)
-{}
+    , m_component_of_node()
+    , m_component_of_entry()
+{
+    index_component(0ULL);
+}
 
 program::program(std::vector<program_component_ptr> const&  components, std::string const&  program_name)
     : m_components{components}
     , m_name(program_name)
+    , m_component_of_node()
+    , m_component_of_entry()
 {
     ASSUMPTION(!m_components.empty());
+    for (uint64_t  i = 0ULL; i < m_components.size(); ++i)
+        index_component(i);
+}
+
+program::~program()
+{
+    for (program_component_ptr const&  C : m_components)
+    {
+        auto&  owners = C->m_owners;
+        owners.erase(std::remove_if(owners.begin(),owners.end(),
+                                    [this](std::pair<program*,uint64_t> const&  owner_index) { return owner_index.first == this; }),
+                     owners.end());
+    }
 }
 
 void  program::push_back(program_component_ptr const  C)
 {
     m_components.push_back(C);
+    index_component(m_components.size() - 1ULL);
+}
+
+void  program::swap(program&  other)
+{
+    std::unordered_set<program_component*>  visited;
+    for (program* const  P : { this, &other })
+        for (program_component_ptr const&  C : P->m_components)
+            if (visited.insert(C.get()).second)
+                for (auto&  owner_index : C->m_owners)
+                {
+                    if (owner_index.first == this)
+                        owner_index.first = &other;
+                    else if (owner_index.first == &other)
+                        owner_index.first = this;
+                }
+    std::swap(m_components,other.m_components);
+    std::swap(m_name,other.m_name);
+    std::swap(m_component_of_node,other.m_component_of_node);
+    std::swap(m_component_of_entry,other.m_component_of_entry);
 }
 
 program_component const&  program::component(uint64_t const  index) const
@@ -242,31 +325,77 @@ program_component_ptr  program::share_component(uint64_t const  index)
 }
 
 
+uint64_t  program::find_component(node_id const  node) const
+{
+    uint64_t const* const  index = m_component_of_node.find(node);
+    return index == nullptr ? num_components() : *index;
+}
+
+uint64_t  program::find_component_with_entry_node(node_id const  entry) const
+{
+    uint64_t const* const  index = m_component_of_entry.find(entry);
+    return index == nullptr ? num_components() : *index;
+}
+
+void  program::index_component(uint64_t const  index)
+{
+    program_component&  C = *m_components.at(index);
+    ASSUMPTION(std::find_if(C.m_owners.cbegin(),C.m_owners.cend(),
+                            [this](std::pair<program*,uint64_t> const&  owner_index) { return owner_index.first == this; })
+               == C.m_owners.cend());
+    C.m_owners.push_back({this,index});
+    on_nodes_inserted(index,std::vector<node_id>(C.nodes().cbegin(),C.nodes().cend()));
+    on_entry_changed(index,0ULL,C.entry());
+}
+
+void  program::on_nodes_inserted(uint64_t const  index, std::vector<node_id> const&  nodes)
+{
+    for (node_id const  n : nodes)
+    {
+        bool const  inserted = m_component_of_node.insert(n,index);
+        ASSUMPTION(inserted);
+        (void)inserted;
+    }
+}
+
+void  program::on_nodes_erased(std::vector<node_id> const&  nodes)
+{
+    for (node_id const  n : nodes)
+        m_component_of_node.erase(n);
+}
+
+void  program::on_entry_changed(uint64_t const  index, node_id const  old_entry, node_id const  new_entry)
+{
+    if (old_entry != 0ULL)
+        m_component_of_entry.erase(old_entry);
+    bool const  inserted = m_component_of_entry.insert(new_entry,index);
+    ASSUMPTION(inserted);
+    (void)inserted;
+}
+
+
 std::unique_ptr<microcode::program>  create_initial_program(std::string const&  program_name, std::string const&  start_component_name)
 {
     return std::unique_ptr<microcode::program>( new program(program_name,start_component_name) );
 }
 
+std::unique_ptr<microcode::program>  copy_program(program const&  P)
+{
+    std::vector<program_component_ptr>  components;
+    for (uint64_t  i = 0ULL; i < P.num_components(); ++i)
+        components.push_back(P.component(i).copy());
+    return std::unique_ptr<microcode::program>( new program(components,P.name()) );
+}
+
 
 uint64_t  find_component_with_entry_node(program const&  P, program_component::node_id const  entry)
 {
-    for (uint64_t i = 0ULL; i < P.num_components(); ++i)
-        if (P.component(i).entry() == entry)
-            return i;
-    return P.num_components();
+    return P.find_component_with_entry_node(entry);
 }
 
 uint64_t  find_component(program const&  P, program_component::node_id const  node_id)
 {
-    if (P.num_components() == 1ULL)
-    {
-        ASSUMPTION(P.start_component().nodes().count(node_id) != 0ULL);
-        return 0ULL;
-    }
-    for (uint64_t i = 0ULL; i < P.num_components(); ++i)
-        if (P.component(i).nodes().count(node_id) != 0ULL)
-            return i;
-    return P.num_components();
+    return P.find_component(node_id);
 }
 
 
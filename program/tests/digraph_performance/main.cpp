@@ -0,0 +1,159 @@
+#include <rebours/program/test.hpp>
+#include <rebours/program/digraph.hpp>
+#include <rebours/program/flat_digraph.hpp>
+#include <rebours/program/instruction.hpp>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+
+
+using  node_id = uint64_t;
+using  hashed_graph_type = digraph<void,microcode::instruction>;
+using  flat_graph_type = flat_digraph<microcode::instruction>;
+
+
+/**
+ * Builds a graph resembling recovered code: a chain of 'num_blocks' blocks of 'block_size' nodes,
+ * where the last node of each block branches (by a pair of guards) either to the next block or back
+ * to the beginning of the current one. Node IDs are interleaved with gaps to mimic IDs shared by
+ * many components.
+ */
+template<typename graph_type>
+static node_id  build_graph(graph_type&  G, uint64_t const  num_blocks, uint64_t const  block_size)
+{
+    auto const  id_of = [](uint64_t const  i) -> node_id { return 3ULL * i + 1ULL; };
+
+    uint64_t const  num_nodes = num_blocks * block_size + 1ULL;
+    std::vector<node_id>  nodes;
+    for (uint64_t  i = 0ULL; i < num_nodes; ++i)
+        nodes.push_back(id_of(i));
+    G.insert_nodes(nodes);
+
+    microcode::instruction const  nop = microcode::create_MISCELLANEOUS__NOP();
+    microcode::instruction const  inc = microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(8U,0ULL,0ULL,1ULL);
+    microcode::instruction const  guard_zero = microcode::create_GUARDS__REG_EQUAL_TO_ZERO(1U,8ULL);
+    microcode::instruction const  guard_nonzero = microcode::create_GUARDS__REG_NOT_EQUAL_TO_ZERO(1U,8ULL);
+    for (uint64_t  b = 0ULL; b < num_blocks; ++b)
+    {
+        uint64_t const  first = b * block_size;
+        for (uint64_t  i = first; i + 1ULL < first + block_size; ++i)
+            G.insert_edges({ {{id_of(i),id_of(i + 1ULL)},(i & 1ULL) ? inc : nop} });
+        uint64_t const  last = first + block_size - 1ULL;
+        G.insert_edges({ {{id_of(last),id_of(last + 1ULL)},guard_zero}, {{id_of(last),id_of(first)},guard_nonzero} });
+    }
+    return id_of(0ULL);
+}
+
+
+/**
+ * Walks the graph like the interpreter used to: at each node it reads the successors and then looks up
+ * the instruction on the chosen edge. Each back edge is taken 'num_iterations' times before the walk continues.
+ */
+template<typename graph_type>
+static uint64_t  interpret_by_edge_lookup(graph_type const&  G, node_id  u, uint64_t const  num_iterations)
+{
+    uint64_t  checksum = 0ULL;
+    uint64_t  counter = 0ULL;
+    while (true)
+    {
+        std::vector<node_id> const&  succ = G.successors(u);
+        if (succ.empty())
+            break;
+        node_id  v = succ.front();
+        if (succ.size() == 2ULL && ++counter % (num_iterations + 1ULL) != 0ULL)
+            v = succ.back();
+        checksum += (uint64_t)G.data({u,v}).GIK();
+        u = v;
+    }
+    return checksum;
+}
+
+/**
+ * Walks the graph like the interpreter does (see 'program_component::successor_instructions'): the instructions
+ * of out-going edges are read from the node's slot at the index of the chosen successor, so no edge is looked up.
+ */
+static uint64_t  interpret_by_slot(flat_graph_type const&  G, node_id  u, uint64_t const  num_iterations)
+{
+    uint64_t  checksum = 0ULL;
+    uint64_t  counter = 0ULL;
+    while (true)
+    {
+        std::vector<node_id> const&  succ = G.successors(u);
+        if (succ.empty())
+            break;
+        std::vector<microcode::instruction> const&  instrs = G.successors_data(u);
+        uint64_t  k = 0ULL;
+        if (succ.size() == 2ULL && ++counter % (num_iterations + 1ULL) != 0ULL)
+            k = 1ULL;
+        checksum += (uint64_t)instrs.at(k).GIK();
+        u = succ.at(k);
+    }
+    return checksum;
+}
+
+
+static void test_digraph_performance()
+{
+    std::cout << "Starting: test_digraph_performance()\n";
+
+    uint64_t const  num_blocks = 2000ULL;
+    uint64_t const  block_size = 16ULL;
+    uint64_t const  num_iterations = 100ULL;
+
+    hashed_graph_type  H;
+    flat_graph_type  F;
+    node_id  H_entry, F_entry;
+
+    double const  H_build = measure_milliseconds([&]() { H_entry = build_graph(H,num_blocks,block_size); });
+    double const  F_build = measure_milliseconds([&]() { F_entry = build_graph(F,num_blocks,block_size); });
+
+    TEST_SUCCESS(H_entry == F_entry);
+    TEST_SUCCESS(H.nodes().size() == F.nodes().size());
+    TEST_SUCCESS(H.edges().size() == F.edges().size());
+
+    uint64_t  H_sum = 0ULL, F_sum = 0ULL, S_sum = 0ULL;
+    double const  H_run = measure_milliseconds([&]() { H_sum = interpret_by_edge_lookup(H,H_entry,num_iterations); });
+    double const  F_run = measure_milliseconds([&]() { F_sum = interpret_by_edge_lookup(F,F_entry,num_iterations); });
+    double const  S_run = measure_milliseconds([&]() { S_sum = interpret_by_slot(F,F_entry,num_iterations); });
+
+    TEST_SUCCESS(H_sum == F_sum);
+    TEST_SUCCESS(F_sum == S_sum);
+
+    uint64_t const  num_steps = num_blocks * (num_iterations + 1ULL) * block_size;
+    std::cout << "  nodes: " << F.nodes().size() << ", edges: " << F.edges().size() << ", interpreted steps: " << num_steps << "\n"
+              << "  build [ms]:  hashed " << H_build << ", flat " << F_build << "\n"
+              << "  interpret via edge lookups, successors()+data(e) [ms]:  hashed " << H_run << ", flat " << F_run << "\n"
+              << "  interpret as the interpreter does, successors()+successors_data() [ms]:  flat " << S_run << "\n"
+              ;
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("digraph_performance_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_digraph_performance();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
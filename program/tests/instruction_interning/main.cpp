@@ -0,0 +1,147 @@
+#include <rebours/program/test.hpp>
+#include <rebours/program/instruction.hpp>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+
+
+/**
+ * Creates a mix of instructions similar to what the recogniser and the prologue builder produce: mostly small
+ * arithmetic and data transfer instructions (a half of them is shared by all threads, the other half is unique
+ * to the thread and round), and occasionally a large data instruction with a whole page of payload.
+ * Instructions shared by all threads are stored into 'shared' (at the index 'i').
+ */
+static void  create_mixed_instructions(uint64_t const  thread_index, uint64_t const  round, uint64_t const  num_instructions,
+                                       std::vector<microcode::instruction>&  shared)
+{
+    std::vector<uint8_t>  payload(4096ULL,(uint8_t)thread_index);
+    for (uint64_t  i = 0ULL; i < num_instructions; ++i)
+    {
+        if (i % 2ULL == 0ULL)
+        {
+            uint64_t const  k = i / 2ULL;
+            shared.at(k) = (k % 3ULL == 0ULL) ?
+                                microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(8U,k,k + 8ULL,k * 7ULL) :
+                                microcode::create_DATATRANSFER__REG_ASGN_DEREF_REG(4U,k,k + 16ULL);
+        }
+        else if (i % 256ULL == 1ULL)
+        {
+            payload.at(0ULL) = (uint8_t)i;
+            payload.at(1ULL) = (uint8_t)round;
+            microcode::create_DATATRANSFER__DEREF_ADDRESS_ASGN_DATA((thread_index << 48ULL) + (round << 32ULL) + i,payload);
+        }
+        else
+            microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,i,(thread_index << 48ULL) + (round << 32ULL) + i);
+    }
+}
+
+
+/**
+ * Returns the resident set size of the process in bytes, or 0, if it cannot be determined.
+ */
+static uint64_t  resident_set_size()
+{
+    std::ifstream  istr("/proc/self/statm");
+    uint64_t  num_pages_total = 0ULL, num_pages_resident = 0ULL;
+    if (!(istr >> num_pages_total >> num_pages_resident))
+        return 0ULL;
+    return num_pages_resident * (uint64_t)sysconf(_SC_PAGESIZE);
+}
+
+
+/**
+ * Checks that instructions created concurrently are interned into the same objects. The printed times include
+ * the locking overhead of the given number of threads; how they change with the number of threads depends on
+ * the number of available cores, so they say nothing about scalability on a machine with fewer cores.
+ */
+static void test_instruction_interning()
+{
+    std::cout << "Starting: test_instruction_interning()\n";
+    std::cout << "  hardware threads: " << std::thread::hardware_concurrency() << "\n";
+
+    uint64_t const  num_instructions = 200000ULL;
+
+    uint64_t  round = 0ULL;
+    for (uint64_t  num_threads : { 1ULL, 2ULL, 4ULL, 8ULL })
+    {
+        ++round;
+        std::vector< std::vector<microcode::instruction> >  shared(num_threads,std::vector<microcode::instruction>(num_instructions / 2ULL));
+        double const  duration = measure_milliseconds([&]() {
+            std::vector<std::thread>  threads;
+            for (uint64_t  t = 0ULL; t < num_threads; ++t)
+                threads.push_back(std::thread(create_mixed_instructions,t,round,num_instructions,std::ref(shared.at(t))));
+            for (std::thread&  thread : threads)
+                thread.join();
+        });
+
+        // Equal instructions created in different threads must be the same object.
+        for (uint64_t  t = 1ULL; t < num_threads; ++t)
+            TEST_SUCCESS(shared.at(t) == shared.front());
+
+        uint64_t const  total = num_threads * num_instructions;
+        std::cout << "  threads: " << num_threads
+                  << ", created instructions: " << total
+                  << ", time [ms]: " << duration
+                  << ", throughput [instructions/ms]: " << (double)total / duration
+                  << "\n";
+    }
+
+    std::cout << "SUCCESS\n";
+}
+
+static void test_instruction_memory()
+{
+    std::cout << "Starting: test_instruction_memory()\n";
+
+    uint64_t const  num_instructions = 1000000ULL;
+
+    uint64_t const  rss_before = resident_set_size();
+    for (uint64_t  i = 0ULL; i < num_instructions; ++i)
+        switch (i % 4ULL)
+        {
+        case 0ULL: microcode::create_SETANDCOPY__REG_ASGN_NUMBER(8U,i,i ^ 0xabcdefULL); break;
+        case 1ULL: microcode::create_SETANDCOPY__REG_ASGN_REG(8U,i,i + 8ULL); break;
+        case 2ULL: microcode::create_INTEGERARITHMETICS__REG_ASGN_REG_PLUS_NUMBER(4U,i,i + 4ULL,i); break;
+        default: microcode::create_GUARDS__REG_EQUAL_TO_ZERO(1U,i); break;
+        }
+    uint64_t const  rss_after = resident_set_size();
+
+    std::cout << "  created distinct instructions: " << num_instructions
+              << ", RSS growth [MiB]: " << (double)(rss_after - rss_before) / (1024.0 * 1024.0)
+              << ", bytes per instruction: " << (double)(rss_after - rss_before) / (double)num_instructions
+              << "\n";
+
+    std::cout << "SUCCESS\n";
+}
+
+static void save_crash_report(std::string const& crash_message)
+{
+    std::cout << "ERROR: " << crash_message << "\n";
+    std::ofstream  ofile("instruction_interning_CRASH.txt", std::ios_base::app );
+    ofile << crash_message << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    try
+    {
+        test_instruction_interning();
+        test_instruction_memory();
+    }
+    catch(std::exception const& e)
+    {
+        try { save_crash_report(e.what()); } catch (...) {}
+        return -1;
+    }
+    catch(...)
+    {
+        try { save_crash_report("Unknown exception was thrown."); } catch (...) {}
+        return -2;
+    }
+    return 0;
+}
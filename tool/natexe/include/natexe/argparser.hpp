@@ -40,6 +40,12 @@ uint32_t  timeout_in_seconds();
 
 std::string const&  path_and_name_of_the_output_log_file();
 
+uint32_t  num_workers();
+
+bool  do_checkpoint();
+std::string const&  path_and_name_of_a_checkpoint_file();
+uint32_t  checkpoint_period_in_seconds();
+
 
 }
 
@@ -22,6 +22,8 @@ std::string const  KWD_SAVE_MICROCODE{ "--save-program" };
 std::string const  KWD_SAVE_DISASSEMBLY{ "--save-disassembly" };
 std::string const  KWD_TIMEOUT{ "--timeout" };
 std::string const  KWD_LOGFILE{ "--log-file" };
+std::string const  KWD_WORKERS{ "--workers" };
+std::string const  KWD_CHECKPOINT{ "--checkpoint" };
 std::unordered_set<std::string> const  KEYWORDS{
         KWD_HELP,
         KWD_VERSION,
@@ -35,6 +37,8 @@ std::unordered_set<std::string> const  KEYWORDS{
         KWD_SAVE_DISASSEMBLY,
         KWD_TIMEOUT,
         KWD_LOGFILE,
+        KWD_WORKERS,
+        KWD_CHECKPOINT,
 };
 std::unordered_map< std::string,std::vector<std::string> >  args;
 
@@ -97,6 +101,20 @@ std::string const  HELP_TEXT =
                        "        all results from the tool. It serves for user friendly browing through\n"
                        "        all results. If it is not specified, then if is automatically set to the\n"
                        "        directory './log/start.html' relative to the current directory.\n\n"
+                    << KWD_WORKERS << "= <positive-integer>\n"
+                    << "        It is the maximal number of native executions of the analysed program\n"
+                       "        performed in parallel. If not specified, then the executions are\n"
+                       "        performed one by one.\n\n"
+                    << KWD_CHECKPOINT << "= [<path>/]<name> [, <unsigned-integer>]\n"
+                    << "        It is a path-name of a file into which the state of the analysis is\n"
+                       "        saved after the first round of executions, then periodically, and at\n"
+                       "        its end. When the analysis times out, the file keeps the last saved\n"
+                       "        state. If the file already exists, then the analysis resumes from the\n"
+                       "        saved state instead of starting from scratch, so a long analysis can\n"
+                       "        be split into several runs of the tool. The file must be used with the\n"
+                       "        same executable file (or Prologue program). The optional integer is\n"
+                       "        the minimal number of seconds between two saves. If not specified (or\n"
+                       "        0), the state is saved after each round of executions.\n\n"
                     ;
 std::string const  VERSION_TEXT = "0.1";
 
@@ -234,6 +252,8 @@ void  add_default_args()
             args.insert({KWD_SEARCH,{}});
         if (args.count(KWD_LOGFILE) == 0ULL)
             args.insert({KWD_LOGFILE,{"./log/start.html"}});
+        if (args.count(KWD_WORKERS) == 0ULL)
+            args.insert({KWD_WORKERS,{"1"}});
     }
 }
 
@@ -265,6 +285,22 @@ std::string  check_argument_consistency(std::string const&  kwd, std::vector<std
         if (std::atoi(params.front().c_str()) == 0)
             return msgstream() << "The timeout cannot be 0.";
     }
+    else if (kwd == KWD_CHECKPOINT)
+    {
+        if (params.size() != 1ULL && params.size() != 2ULL)
+            return msgstream() << "The parameter '" << kwd << "' accepts 1 or 2 arguments.";
+        if (params.size() == 2ULL && !is_uint(params.at(1)))
+            return msgstream() << "The value '" << params.at(1) << "' of the parameter '" << kwd << "' is not an unsigned integer.";
+    }
+    else if (kwd == KWD_WORKERS)
+    {
+        if (params.size() != 1ULL)
+            return msgstream() << "The parameter '" << kwd << "' accepts 1 argument.";
+        if (!is_uint(params.front()))
+            return msgstream() << "The value '" << params.front() << "' of the parameter '" << kwd << "' is not an unsigned integer.";
+        if (std::atoi(params.front().c_str()) == 0)
+            return msgstream() << "The number of workers cannot be 0.";
+    }
     return "";
 }
 
@@ -443,5 +479,28 @@ std::string const&  path_and_name_of_the_output_log_file()
     return args.at(KWD_LOGFILE).front();
 }
 
+uint32_t  num_workers()
+{
+    ASSUMPTION(args.count(KWD_WORKERS) != 0ULL);
+    return std::atoi(args.at(KWD_WORKERS).front().c_str());
+}
+
+bool  do_checkpoint()
+{
+    return args.count(KWD_CHECKPOINT) != 0ULL;
+}
+
+std::string const&  path_and_name_of_a_checkpoint_file()
+{
+    ASSUMPTION(do_checkpoint());
+    return args.at(KWD_CHECKPOINT).front();
+}
+
+uint32_t  checkpoint_period_in_seconds()
+{
+    ASSUMPTION(do_checkpoint());
+    return args.at(KWD_CHECKPOINT).size() < 2ULL ? 0U : std::atoi(args.at(KWD_CHECKPOINT).at(1).c_str());
+}
+
 
 }
@@ -11,6 +11,7 @@
 #include <rebours/MAL/descriptor/dump.hpp>
 #include <rebours/MAL/prologue/builder.hpp>
 #include <rebours/MAL/recogniser/recognise.hpp>
+#include <rebours/MAL/recogniser/recognition_cache.hpp>
 #include <rebours/MAL/recogniser/dump.hpp>
 #include <rebours/analysis/native_execution/run.hpp>
 #include <rebours/MAL/encoder/encode.hpp>
@@ -229,6 +230,13 @@ int main(int argc, char* argv[])
             std::vector<uint8_t>  default_stack_init_data;
             mal::descriptor::linearise(descriptor.default_stack_init_data(),default_stack_init_data);
 
+            mal::recogniser::recognition_cache  recognition_cache;
+            mal::recogniser::recognise_callback_fn const  recognise_instruction =
+                    [&recognition_cache,&descriptor](uint64_t const  address, mal::recogniser::reg_fn_type const&  reg_fn,
+                                                     mal::recogniser::mem_fn_type const&  mem_fn) {
+                        return recognition_cache.recognise(descriptor,address,reg_fn,mem_fn);
+                    };
+
             error_message =
                     analysis::natexe::run(*prologue.first,
                                           *program,
@@ -239,12 +247,16 @@ int main(int argc, char* argv[])
                                           important_code,
                                           { { program->start_component().entry(), entry_point } },
                                           default_stack_init_data,
-                                          std::bind(&mal::recogniser::recognise,std::cref(descriptor),std::placeholders::_1,std::placeholders::_2,std::placeholders::_3),
+                                          std::bind(&mal::recogniser::recognise_basic_block,std::cref(recognise_instruction),
+                                                    std::placeholders::_1,std::placeholders::_2,std::placeholders::_3,64ULL),
                                           argparser::timeout_in_seconds(),
                                           analysis_log_root_dir,
                                           true,
                                           std::bind(&mal::recogniser::dump_details_of_recognised_instruction,std::placeholders::_1,std::placeholders::_2),
-                                          descriptor.ranges_to_registers()
+                                          descriptor.ranges_to_registers(),
+                                          argparser::num_workers(),
+                                          argparser::do_checkpoint() ? argparser::path_and_name_of_a_checkpoint_file() : "",
+                                          argparser::do_checkpoint() ? argparser::checkpoint_period_in_seconds() : 0U
                                           );
 
             if (argparser::do_save_recovered_program())
@@ -345,6 +357,13 @@ int main(int argc, char* argv[])
             std::vector<uint8_t>  default_stack_init_data;
             mal::descriptor::linearise(descriptor.default_stack_init_data(),default_stack_init_data);
 
+            mal::recogniser::recognition_cache  recognition_cache;
+            mal::recogniser::recognise_callback_fn const  recognise_instruction =
+                    [&recognition_cache,&descriptor](uint64_t const  address, mal::recogniser::reg_fn_type const&  reg_fn,
+                                                     mal::recogniser::mem_fn_type const&  mem_fn) {
+                        return recognition_cache.recognise(descriptor,address,reg_fn,mem_fn);
+                    };
+
             error_message =
                     analysis::natexe::run(*prologue.first,
                                           *recovered_program.first,
@@ -355,12 +374,16 @@ int main(int argc, char* argv[])
                                           important_code,
                                           {}, // TODO: here should be passed all unexplored exits
                                           default_stack_init_data,
-                                          std::bind(&mal::recogniser::recognise,std::cref(descriptor),std::placeholders::_1,std::placeholders::_2,std::placeholders::_3),
+                                          std::bind(&mal::recogniser::recognise_basic_block,std::cref(recognise_instruction),
+                                                    std::placeholders::_1,std::placeholders::_2,std::placeholders::_3,64ULL),
                                           argparser::timeout_in_seconds(),
                                           analysis_log_root_dir,
                                           true,
                                           std::bind(&mal::recogniser::dump_details_of_recognised_instruction,std::placeholders::_1,std::placeholders::_2),
-                                          descriptor.ranges_to_registers()
+                                          descriptor.ranges_to_registers(),
+                                          argparser::num_workers(),
+                                          argparser::do_checkpoint() ? argparser::path_and_name_of_a_checkpoint_file() : "",
+                                          argparser::do_checkpoint() ? argparser::checkpoint_period_in_seconds() : 0U
                                           );
 
             if (argparser::do_save_recovered_program())